@@ -0,0 +1,67 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RAGEDB_AGGREGATION_H
+#define RAGEDB_AGGREGATION_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <string>
+
+namespace ragedb {
+
+    // Count, sum, min and max of the values of a property, partial on each Shard and merged by the coordinator
+    struct Aggregation {
+        uint64_t count = 0;
+        bool numeric = false;
+        double sum = 0;
+        double min = std::numeric_limits<double>::max();
+        double max = std::numeric_limits<double>::lowest();
+
+        void add(double value) {
+            count++;
+            numeric = true;
+            sum += value;
+            min = std::min(min, value);
+            max = std::max(max, value);
+        }
+
+        void merge(const Aggregation &other) {
+            count += other.count;
+            numeric = numeric || other.numeric;
+            sum += other.sum;
+            min = std::min(min, other.min);
+            max = std::max(max, other.max);
+        }
+
+        [[nodiscard]] double average() const {
+            return count == 0 ? 0 : sum / static_cast<double>(count);
+        }
+    };
+
+    // Aggregations keyed by the value of the group by property, a single "" group when there is none
+    using Aggregations = std::map<std::string, Aggregation>;
+
+    inline void MergeAggregations(Aggregations &into, const Aggregations &other) {
+        for (const auto &[group, aggregation] : other) {
+            into[group].merge(aggregation);
+        }
+    }
+}
+
+#endif //RAGEDB_AGGREGATION_H
@@ -0,0 +1,65 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RAGEDB_ANALYTICS_H
+#define RAGEDB_ANALYTICS_H
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace ragedb {
+
+    enum class Algorithm : uint8_t {
+        PageRank,
+        ConnectedComponents,
+        LabelPropagation,
+        TriangleCount,
+        ClusteringCoefficient
+    };
+
+    // Messages for the nodes of one Shard, entry i of each vector in use is for ids[i]
+    struct AnalyticsMessages {
+        std::vector<uint64_t> ids;
+        std::vector<double> values;
+        std::vector<uint64_t> labels;
+        std::vector<std::vector<uint64_t>> neighbors;
+    };
+
+    // What a Shard reports after a superstep
+    struct AnalyticsStep {
+        uint64_t changed = 0;                               // Nodes whose value changed, the job ends when none did
+        double dangling = 0;                                // Rank held by nodes without relationships to follow
+    };
+
+    // State of an analytics job on one Shard, taken from the nodes and relationships it had when the job started
+    struct AnalyticsJob {
+        Algorithm algorithm = Algorithm::PageRank;
+        double damping = 0.85;
+        uint64_t step = 0;
+        uint64_t nodes = 0;                                 // Nodes across all Shards
+        std::vector<uint64_t> ids;                          // Nodes of this Shard
+        std::unordered_map<uint64_t, size_t> positions;     // Node id to position in the vectors below
+        std::vector<std::vector<uint64_t>> neighbors;       // Sorted, distinct except for PageRank
+        std::vector<double> values;                         // Ranks
+        std::vector<uint64_t> labels;                       // Components, communities or triangles
+        std::vector<bool> active;                           // Labels changed since they were last sent
+        std::map<uint16_t, AnalyticsMessages> outbox;       // Messages waiting for the next superstep
+    };
+}
+
+#endif //RAGEDB_ANALYTICS_H
@@ -0,0 +1,138 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RAGEDB_BATCHER_H
+#define RAGEDB_BATCHER_H
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <seastar/core/future.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/later.hh>
+#include <seastar/core/metrics.hh>
+
+namespace ragedb {
+
+    /**
+     * Coalesces requests for the same Shard into a single cross core message. The first request for a Shard
+     * schedules a flush behind the tasks already queued on this core, every request those tasks add for that
+     * Shard joins the batch, and the results of the batch are handed back to each request's future in order.
+     * Requests for this Shard are not batched, they are sent on their own right away.
+     *
+     * @tparam Request what a single request sends
+     * @tparam Result what a single request gets back
+     */
+    template <typename Request, typename Result>
+    class Batcher {
+    public:
+        // Sends a batch of requests to a Shard, the future holds one result per request in the same order
+        using Sender = std::function<seastar::future<std::vector<Result>>(uint16_t, std::vector<Request>)>;
+
+        Batcher(uint16_t _shard_id, uint _cpus, Sender _send) : shard_id(_shard_id), pending(_cpus), promises(_cpus), send(std::move(_send)) {}
+
+        seastar::future<Result> Add(uint16_t their_shard, Request request) {
+            if (their_shard == shard_id) {
+                std::vector<Request> requests;
+                requests.emplace_back(std::move(request));
+                return send(their_shard, std::move(requests)).then([] (std::vector<Result> results) {
+                    return std::move(results.front());
+                });
+            }
+
+            // Once Close has started nothing would flush the request, fail it instead of breaking its promise
+            if (gate.is_closed()) {
+                return seastar::make_exception_future<Result>(seastar::gate_closed_exception());
+            }
+
+            bool first = pending[their_shard].empty();
+            pending[their_shard].emplace_back(std::move(request));
+            promises[their_shard].emplace_back();
+            seastar::future<Result> result = promises[their_shard].back().get_future();
+            if (first) {
+                // The gate is open so entering it does not throw, and Flush never fails its future
+                static_cast<void>(seastar::with_gate(gate, [this, their_shard] {
+                    return seastar::yield().then([this, their_shard] {
+                        return Flush(their_shard);
+                    });
+                }));
+            }
+            return result;
+        }
+
+        /**
+         * Register how many requests and batches went out, and the largest batch, as metrics
+         *
+         * @param operation name of the operation the requests are for
+         */
+        void RegisterMetrics(const std::string& operation) {
+            namespace sm = seastar::metrics;
+            sm::label operation_label("operation");
+            metrics.add_group("ragedb_batching", {
+                sm::make_counter("requests", requests, sm::description("Requests sent to other shards"), {operation_label(operation)}),
+                sm::make_counter("batches", batches, sm::description("Messages the requests were coalesced into"), {operation_label(operation)}),
+                sm::make_gauge("largest_batch", largest, sm::description("Most requests coalesced into one message"), {operation_label(operation)})
+            });
+        }
+
+        // Flush the requests already queued and wait for the batches in flight, later requests fail
+        seastar::future<> Close() {
+            return gate.close();
+        }
+
+    private:
+        uint16_t shard_id;
+        std::vector<std::vector<Request>> pending;                  // Requests waiting for each Shard
+        std::vector<std::vector<seastar::promise<Result>>> promises;  // Promises of the requests waiting for each Shard
+        Sender send;
+        seastar::gate gate;
+        seastar::metrics::metric_groups metrics;
+        uint64_t requests = 0;
+        uint64_t batches = 0;
+        uint64_t largest = 0;
+
+        seastar::future<> Flush(uint16_t their_shard) {
+            std::vector<Request> batch = std::exchange(pending[their_shard], {});
+            std::vector<seastar::promise<Result>> waiting = std::exchange(promises[their_shard], {});
+            requests += batch.size();
+            batches++;
+            largest = std::max<uint64_t>(largest, batch.size());
+
+            return seastar::futurize_invoke(send, their_shard, std::move(batch)).then_wrapped([waiting = std::move(waiting)] (seastar::future<std::vector<Result>> future) mutable {
+                if (future.failed()) {
+                    std::exception_ptr exception = future.get_exception();
+                    for (auto& promise : waiting) {
+                        promise.set_exception(exception);
+                    }
+                    return;
+                }
+                std::vector<Result> results = future.get0();
+                for (size_t i = 0; i < waiting.size(); i++) {
+                    if (i < results.size()) {
+                        waiting[i].set_value(std::move(results[i]));
+                    } else {
+                        waiting[i].set_exception(std::out_of_range("Batch returned fewer results than requests"));
+                    }
+                }
+            });
+        }
+    };
+}
+
+#endif //RAGEDB_BATCHER_H
@@ -0,0 +1,90 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include "Cursor.h"
+
+namespace ragedb {
+
+    // Shard, type and internal id as 4, 4 and 16 hex digits
+    static const size_t CURSOR_LENGTH = 24;
+
+    std::string Cursor::encode() const {
+        if (done) {
+            return "";
+        }
+        char text[CURSOR_LENGTH + 1];
+        std::snprintf(text, sizeof(text), "%04x%04x%016llx", shard_id, type_id, static_cast<unsigned long long>(internal_id));
+        return std::string(text, CURSOR_LENGTH);
+    }
+
+    bool Cursor::decode(const std::string &text, Cursor &cursor) {
+        cursor = Cursor();
+        if (text.empty()) {
+            return true;
+        }
+        if (text.size() != CURSOR_LENGTH || !std::all_of(text.begin(), text.end(), [] (char c) { return std::isxdigit(static_cast<unsigned char>(c)) != 0; })) {
+            return false;
+        }
+        cursor.shard_id = static_cast<uint16_t>(std::stoul(text.substr(0, 4), nullptr, 16));
+        cursor.type_id = static_cast<uint16_t>(std::stoul(text.substr(4, 4), nullptr, 16));
+        cursor.internal_id = std::stoull(text.substr(8), nullptr, 16);
+        return true;
+    }
+
+    uint64_t LiveIdAt(const Roaring64Map &deleted, uint64_t slots, uint64_t position) {
+        if (deleted.isEmpty()) {
+            return std::min(position, slots);
+        }
+        // Ids up to x hold x + 1 - rank(x) live entries, find the first x where that passes position
+        uint64_t low = 0;
+        uint64_t high = slots;
+        while (low < high) {
+            uint64_t middle = low + (high - low) / 2;
+            if (middle + 1 - deleted.rank(middle) > position) {
+                high = middle;
+            } else {
+                low = middle + 1;
+            }
+        }
+        return low;
+    }
+
+    std::vector<uint64_t> LiveIds(const Roaring64Map &deleted, uint64_t slots, uint64_t from, uint64_t limit) {
+        std::vector<uint64_t> ids;
+        ids.reserve(std::min(limit, slots > from ? slots - from : 0));
+        // The deleted ids at or after from, taken in order by their rank
+        uint64_t rank = from == 0 ? 0 : deleted.rank(from - 1);
+        uint64_t next_deleted = slots;
+        if (!deleted.select(rank, &next_deleted)) {
+            next_deleted = slots;
+        }
+        for (uint64_t internal_id = from; internal_id < slots && ids.size() < limit; internal_id++) {
+            if (internal_id == next_deleted) {
+                if (!deleted.select(++rank, &next_deleted)) {
+                    next_deleted = slots;
+                }
+                continue;
+            }
+            ids.emplace_back(internal_id);
+        }
+        return ids;
+    }
+
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef RAGEDB_CURSOR_H
+#define RAGEDB_CURSOR_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <roaring/roaring64map.hh>
+
+namespace ragedb {
+
+    /**
+     * Where a page of nodes or relationships left off: the Shard, the type and the internal id to resume at.
+     * Clients get it as an opaque string, empty for the first page and again once there is nothing left.
+     */
+    struct Cursor {
+        uint16_t shard_id = 0;
+        uint16_t type_id = 0;       // 0 to start at the first type
+        uint64_t internal_id = 0;
+        bool done = false;
+
+        [[nodiscard]] std::string encode() const;
+
+        // Read back an encoded cursor, false when the text was not written by encode
+        static bool decode(const std::string &text, Cursor &cursor);
+    };
+
+    // A page of results and the cursor to get the next one
+    template<typename T>
+    struct Page {
+        std::vector<T> results;
+        Cursor next;
+    };
+
+    // Internal id of the live entry at position, counting from 0, or slots when there are not that many
+    uint64_t LiveIdAt(const Roaring64Map &deleted, uint64_t slots, uint64_t position);
+
+    // Up to limit internal ids of live entries starting at from, finding the deleted ones by rank instead of looking up every id
+    std::vector<uint64_t> LiveIds(const Roaring64Map &deleted, uint64_t slots, uint64_t from, uint64_t limit);
+}
+
+#endif //RAGEDB_CURSOR_H
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <iostream>
 #include <seastar/core/when_all.hh>
 #include "Graph.h"
@@ -30,12 +31,26 @@ namespace ragedb {
     }
 
     /**
-     * Start the Graph by creating a shard on each core
+     * Start the Graph by creating a shard on each core, and the scheduling groups its analytics and compactions run in.
+     * Metrics are registered once the shards are in place.
      *
      * @return future
      */
     seastar::future<> Graph::Start() {
-        return shard.start(seastar::smp::count);
+        return shard.start(seastar::smp::count).then([] {
+            return seastar::create_scheduling_group("analytics", 100);
+        }).then([this] (seastar::scheduling_group group) {
+            return shard.invoke_on_all([group](Shard &local_shard) {
+                local_shard.SetAnalyticsGroup(group);
+                local_shard.RegisterBatchingMetrics();
+            });
+        }).then([] {
+            return seastar::create_scheduling_group("compaction", 50);
+        }).then([this] (seastar::scheduling_group group) {
+            return shard.invoke_on_all([group](Shard &local_shard) {
+                local_shard.SetCompactionGroup(group);
+            });
+        });
     }
 
     /**
@@ -44,7 +59,18 @@ namespace ragedb {
      * @return future
      */
     seastar::future<> Graph::Stop() {
-        return shard.stop();
+        // Whatever is still waiting for a group commit goes out before the shards go away
+        return shard.invoke_on_all([](Shard &local_shard) {
+            return local_shard.StopAdjacencyMerge().then([&local_shard] {
+                return local_shard.StopCompaction();
+            }).then([&local_shard] {
+                return local_shard.StopBatching();
+            }).then([&local_shard] {
+                return local_shard.CloseLog();
+            });
+        }).then([this] {
+            return shard.stop();
+        });
     }
 
     /**
@@ -61,4 +87,101 @@ namespace ragedb {
                 }));
     }
 
-}
\ No newline at end of file
+    /**
+     * Write a snapshot of every shard in parallel
+     *
+     * @param directory where the snapshot files are kept
+     * @return future true if every shard wrote its snapshot
+     */
+    seastar::future<bool> Graph::Snapshot(const std::string& directory) {
+        return shard.map([path = directory + "/" + name](Shard &local_shard) {
+            return local_shard.Snapshot(path);
+        }).then([](const std::vector<bool>& results) {
+            return std::all_of(results.begin(), results.end(), [](bool result) { return result; });
+        });
+    }
+
+    /**
+     * Load the snapshot of every shard in parallel
+     *
+     * @param directory where the snapshot files are kept
+     * @return future true if every shard was restored, otherwise the Graph is left empty
+     */
+    seastar::future<bool> Graph::Restore(const std::string& directory) {
+        return shard.map([path = directory + "/" + name](Shard &local_shard) {
+            return local_shard.Restore(path);
+        }).then([this](const std::vector<bool>& results) {
+            if (std::all_of(results.begin(), results.end(), [](bool result) { return result; })) {
+                return seastar::make_ready_future<bool>(true);
+            }
+            // A partial restore would leave relationships pointing at missing nodes
+            return shard.invoke_on_all([](Shard &local_shard) {
+                return local_shard.Clear();
+            }).then([] {
+                return seastar::make_ready_future<bool>(false);
+            });
+        });
+    }
+
+    /**
+     * Load the snapshot and replay the write ahead log of every shard in parallel, then start logging
+     *
+     * @param directory where the snapshot and log files are kept
+     * @param commit_window how long mutations wait to be grouped into a single log write
+     * @return future true if every shard recovered, otherwise the Graph is left empty and nothing is logged
+     */
+    seastar::future<bool> Graph::Recover(const std::string& directory, std::chrono::microseconds commit_window) {
+        return shard.map([path = directory + "/" + name, commit_window](Shard &local_shard) {
+            return local_shard.Recover(path, commit_window);
+        }).then([this](const std::vector<bool>& results) {
+            if (std::all_of(results.begin(), results.end(), [](bool result) { return result; })) {
+                return seastar::make_ready_future<bool>(true);
+            }
+            // Keep the files as they are so they can be looked at, and do not log on top of them
+            return shard.invoke_on_all([](Shard &local_shard) {
+                return local_shard.CloseLog().then([&local_shard] {
+                    local_shard.Clear();
+                });
+            }).then([] {
+                return seastar::make_ready_future<bool>(false);
+            });
+        });
+    }
+
+    /**
+     * Merge new links into frozen node types on every shard on an interval
+     *
+     * @param interval time between merges, 0 to disable
+     * @return future
+     */
+    seastar::future<> Graph::AdjacencyMergeEvery(std::chrono::seconds interval) {
+        return shard.invoke_on_all([interval](Shard &local_shard) {
+            local_shard.AdjacencyMergeEvery(interval);
+        });
+    }
+
+    /**
+     * Give back the memory of deleted nodes and relationships on every shard on an interval
+     *
+     * @param interval time between compactions, 0 to disable
+     * @return future
+     */
+    seastar::future<> Graph::CompactEvery(std::chrono::seconds interval) {
+        return shard.invoke_on_all([interval](Shard &local_shard) {
+            local_shard.CompactEvery(interval);
+        });
+    }
+
+    /**
+     * Set the share of the CPU analytics get on every shard when requests are waiting as well
+     *
+     * @param shares analytics shares, the default scheduling group that runs requests has 1000
+     * @return future
+     */
+    seastar::future<> Graph::AnalyticsShares(float shares) {
+        return shard.invoke_on_all([shares](Shard &local_shard) {
+            local_shard.SetAnalyticsShares(shares);
+        });
+    }
+
+}
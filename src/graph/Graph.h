@@ -18,6 +18,7 @@
 #define RAGEDB_GRAPH_H
 
 
+#include <chrono>
 #include <string>
 #include <seastar/core/future.hh>
 #include <seastar/core/sharded.hh>
@@ -38,6 +39,12 @@ namespace ragedb {
         seastar::future<> Start();
         seastar::future<> Stop();
         void Clear();
+        seastar::future<bool> Snapshot(const std::string& directory);
+        seastar::future<bool> Restore(const std::string& directory);
+        seastar::future<bool> Recover(const std::string& directory, std::chrono::microseconds commit_window);
+        seastar::future<> AdjacencyMergeEvery(std::chrono::seconds interval);
+        seastar::future<> CompactEvery(std::chrono::seconds interval);
+        seastar::future<> AnalyticsShares(float shares);
     };
 }
 
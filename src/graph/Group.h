@@ -19,7 +19,7 @@
 
 #include <vector>
 #include <cstdint>
-#include "Link.h"
+#include "Links.h"
 
 namespace ragedb {
 
@@ -27,7 +27,7 @@ namespace ragedb {
     public:
         Group(uint16_t rel_type_id, std::vector<Link> links);
         uint16_t rel_type_id;
-        std::vector<Link> links;
+        Links links;
     };
 }
 
@@ -0,0 +1,33 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RAGEDB_HOP_H
+#define RAGEDB_HOP_H
+
+#include <cstdint>
+#include <vector>
+#include "Direction.h"
+
+namespace ragedb {
+
+    // One level of a traversal, follow the relationships of these types in this direction, all types when empty
+    struct Hop {
+        Direction direction = BOTH;
+        std::vector<uint16_t> rel_type_ids;
+    };
+}
+
+#endif //RAGEDB_HOP_H
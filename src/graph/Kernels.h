@@ -0,0 +1,334 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RAGEDB_KERNELS_H
+#define RAGEDB_KERNELS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include <roaring/roaring64map.hh>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#include "Operation.h"
+
+namespace ragedb {
+
+    // Kernels over the typed property columns. A scan produces one 64 bit word per 64 rows of the column,
+    // bit i of word w is set when row 64 * w + i matches. Words are cheap to combine, mask and count,
+    // and only turn into row numbers at the end. The validity bitmaps of the columns use the same layout. Integers and doubles are compared four rows at a time
+    // with AVX2 when the build enables it (ENABLE_AVX2), and by plain loops the compiler can vectorize otherwise.
+
+    inline size_t WordsFor(size_t rows) {
+        return (rows + 63) / 64;
+    }
+
+    template<Operation operation, typename T>
+    inline bool Matches(const T &stored, const T &value) {
+        if constexpr (operation == Operation::EQ) { return stored == value; }
+        if constexpr (operation == Operation::NEQ) { return stored != value; }
+        if constexpr (operation == Operation::GT) { return stored > value; }
+        if constexpr (operation == Operation::GTE) { return stored >= value; }
+        if constexpr (operation == Operation::LT) { return stored < value; }
+        if constexpr (operation == Operation::LTE) { return stored <= value; }
+        return false;
+    }
+
+    inline bool RowIsSet(const std::vector<uint64_t> &words, uint64_t row) {
+        return row / 64 < words.size() && ((words[row / 64] >> (row % 64)) & 1U) != 0;
+    }
+
+    inline void SetRow(std::vector<uint64_t> &words, uint64_t row) {
+        if (row / 64 >= words.size()) {
+            words.resize(row / 64 + 1, 0);
+        }
+        words[row / 64] |= uint64_t(1) << (row % 64);
+    }
+
+    inline void ClearRow(std::vector<uint64_t> &words, uint64_t row) {
+        if (row / 64 < words.size()) {
+            words[row / 64] &= ~(uint64_t(1) << (row % 64));
+        }
+    }
+
+    template<Operation operation, bool skip_tombstones, typename T>
+    inline void MatchRowsScalar(const T *data, size_t first, size_t last, const T &value, const T &tombstone, uint64_t *words) {
+        for (size_t row = first; row < last; row++) {
+            bool match = Matches<operation>(data[row], value);
+            if constexpr (skip_tombstones) {
+                match = match & (data[row] != tombstone);
+            }
+            words[row / 64] |= static_cast<uint64_t>(match) << (row % 64);
+        }
+    }
+
+#if defined(__AVX2__)
+    template<Operation operation>
+    inline __m256i CompareLanes(__m256i stored, __m256i value) {
+        if constexpr (operation == Operation::EQ) { return _mm256_cmpeq_epi64(stored, value); }
+        if constexpr (operation == Operation::NEQ) { return _mm256_xor_si256(_mm256_cmpeq_epi64(stored, value), _mm256_set1_epi64x(-1)); }
+        if constexpr (operation == Operation::GT) { return _mm256_cmpgt_epi64(stored, value); }
+        if constexpr (operation == Operation::GTE) { return _mm256_xor_si256(_mm256_cmpgt_epi64(value, stored), _mm256_set1_epi64x(-1)); }
+        if constexpr (operation == Operation::LT) { return _mm256_cmpgt_epi64(value, stored); }
+        if constexpr (operation == Operation::LTE) { return _mm256_xor_si256(_mm256_cmpgt_epi64(stored, value), _mm256_set1_epi64x(-1)); }
+        return _mm256_setzero_si256();
+    }
+
+    template<Operation operation>
+    inline __m256d CompareLanes(__m256d stored, __m256d value) {
+        if constexpr (operation == Operation::EQ) { return _mm256_cmp_pd(stored, value, _CMP_EQ_OQ); }
+        if constexpr (operation == Operation::NEQ) { return _mm256_cmp_pd(stored, value, _CMP_NEQ_UQ); }
+        if constexpr (operation == Operation::GT) { return _mm256_cmp_pd(stored, value, _CMP_GT_OQ); }
+        if constexpr (operation == Operation::GTE) { return _mm256_cmp_pd(stored, value, _CMP_GE_OQ); }
+        if constexpr (operation == Operation::LT) { return _mm256_cmp_pd(stored, value, _CMP_LT_OQ); }
+        if constexpr (operation == Operation::LTE) { return _mm256_cmp_pd(stored, value, _CMP_LE_OQ); }
+        return _mm256_setzero_pd();
+    }
+
+    template<Operation operation, bool skip_tombstones>
+    inline size_t MatchRowsVector(const int64_t *data, size_t rows, int64_t value, int64_t tombstone, uint64_t *words) {
+        const __m256i values = _mm256_set1_epi64x(value);
+        const __m256i tombstones = _mm256_set1_epi64x(tombstone);
+        size_t row = 0;
+        for (; row + 4 <= rows; row += 4) {
+            __m256i stored = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + row));
+            __m256i match = CompareLanes<operation>(stored, values);
+            if constexpr (skip_tombstones) {
+                match = _mm256_andnot_si256(_mm256_cmpeq_epi64(stored, tombstones), match);
+            }
+            auto bits = static_cast<uint64_t>(_mm256_movemask_pd(_mm256_castsi256_pd(match)));
+            words[row / 64] |= bits << (row % 64);
+        }
+        return row;
+    }
+
+    template<Operation operation, bool skip_tombstones>
+    inline size_t MatchRowsVector(const double *data, size_t rows, double value, double tombstone, uint64_t *words) {
+        const __m256d values = _mm256_set1_pd(value);
+        const __m256d tombstones = _mm256_set1_pd(tombstone);
+        size_t row = 0;
+        for (; row + 4 <= rows; row += 4) {
+            __m256d stored = _mm256_loadu_pd(data + row);
+            __m256d match = CompareLanes<operation>(stored, values);
+            if constexpr (skip_tombstones) {
+                match = _mm256_andnot_pd(_mm256_cmp_pd(stored, tombstones, _CMP_EQ_OQ), match);
+            }
+            auto bits = static_cast<uint64_t>(_mm256_movemask_pd(match));
+            words[row / 64] |= bits << (row % 64);
+        }
+        return row;
+    }
+#endif
+
+    template<Operation operation, bool skip_tombstones = true, typename T>
+    inline void MatchRows(const std::vector<T> &column, const T &value, const T &tombstone, std::vector<uint64_t> &words) {
+        size_t row = 0;
+#if defined(__AVX2__)
+        if constexpr (std::is_same_v<T, int64_t> || std::is_same_v<T, double>) {
+            row = MatchRowsVector<operation, skip_tombstones>(column.data(), column.size(), value, tombstone, words.data());
+        }
+#endif
+        MatchRowsScalar<operation, skip_tombstones>(column.data(), row, column.size(), value, tombstone, words.data());
+    }
+
+    template<bool skip_tombstones, typename T>
+    inline void MatchOperation(const std::vector<T> &column, Operation operation, const T &value, const T &tombstone, std::vector<uint64_t> &words) {
+        switch (operation) {
+            case Operation::EQ: MatchRows<Operation::EQ, skip_tombstones>(column, value, tombstone, words); break;
+            case Operation::NEQ: MatchRows<Operation::NEQ, skip_tombstones>(column, value, tombstone, words); break;
+            case Operation::GT: MatchRows<Operation::GT, skip_tombstones>(column, value, tombstone, words); break;
+            case Operation::GTE: MatchRows<Operation::GTE, skip_tombstones>(column, value, tombstone, words); break;
+            case Operation::LT: MatchRows<Operation::LT, skip_tombstones>(column, value, tombstone, words); break;
+            case Operation::LTE: MatchRows<Operation::LTE, skip_tombstones>(column, value, tombstone, words); break;
+            default: break;
+        }
+    }
+
+    /**
+     * Compare every value of a column, skipping tombstones
+     *
+     * @param column integer or double column
+     * @param operation comparison
+     * @param value value to compare to
+     * @param tombstone value of rows without the property
+     * @return one word per 64 rows with the bits of the matching rows set
+     */
+    template<typename T>
+    std::vector<uint64_t> MatchColumn(const std::vector<T> &column, Operation operation, const T &value, const T &tombstone) {
+        std::vector<uint64_t> words(WordsFor(column.size()), 0);
+        MatchOperation<true>(column, operation, value, tombstone, words);
+        return words;
+    }
+
+    /**
+     * Compare the values of the valid rows of a column
+     *
+     * @param column integer or double column
+     * @param operation comparison
+     * @param value value to compare to
+     * @param valid validity bitmap of the column, one word per 64 rows with the bits of the rows holding a value set
+     * @return one word per 64 rows with the bits of the matching rows set
+     */
+    template<typename T>
+    std::vector<uint64_t> MatchColumn(const std::vector<T> &column, Operation operation, const T &value, const std::vector<uint64_t> &valid) {
+        std::vector<uint64_t> words(WordsFor(column.size()), 0);
+        MatchOperation<false>(column, operation, value, value, words);
+        for (size_t word = 0; word < words.size(); word++) {
+            words[word] &= word < valid.size() ? valid[word] : 0;
+        }
+        return words;
+    }
+
+    /**
+     * Check every value of a column against a range, skipping tombstones
+     *
+     * @param column integer or double column
+     * @param low smallest value in the range
+     * @param high largest value in the range
+     * @param tombstone value of rows without the property
+     * @return one word per 64 rows with the bits of the rows with low <= value <= high set
+     */
+    template<typename T>
+    std::vector<uint64_t> MatchColumnRange(const std::vector<T> &column, const T &low, const T &high, const T &tombstone) {
+        std::vector<uint64_t> words = MatchColumn(column, Operation::GTE, low, tombstone);
+        std::vector<uint64_t> below = MatchColumn(column, Operation::LTE, high, tombstone);
+        for (size_t word = 0; word < words.size(); word++) {
+            words[word] &= below[word];
+        }
+        return words;
+    }
+
+    /**
+     * Find the rows of a column that hold a value
+     *
+     * @param column integer or double column
+     * @param tombstone value of rows without the property
+     * @return one word per 64 rows with the bits of the rows that are not tombstones set
+     */
+    template<typename T>
+    std::vector<uint64_t> PresentInColumn(const std::vector<T> &column, const T &tombstone) {
+        std::vector<uint64_t> words(WordsFor(column.size()), 0);
+        MatchRows<Operation::NEQ>(column, tombstone, tombstone, words);
+        return words;
+    }
+
+    // Clear the bits of the given rows, used to leave deleted ids out of a scan
+    inline void MaskRows(std::vector<uint64_t> &words, const Roaring64Map &rows) {
+        for (uint64_t row : rows) {
+            if (row / 64 >= words.size()) {
+                break;
+            }
+            words[row / 64] &= ~(uint64_t(1) << (row % 64));
+        }
+    }
+
+    inline uint64_t CountRows(const std::vector<uint64_t> &words) {
+        uint64_t count = 0;
+        for (uint64_t word : words) {
+            count += static_cast<uint64_t>(__builtin_popcountll(word));
+        }
+        return count;
+    }
+
+    // The selected rows in order, as a selection vector
+    inline std::vector<uint64_t> SelectRows(const std::vector<uint64_t> &words) {
+        std::vector<uint64_t> rows;
+        rows.reserve(CountRows(words));
+        for (size_t word = 0; word < words.size(); word++) {
+            uint64_t bits = words[word];
+            while (bits != 0) {
+                rows.emplace_back(word * 64 + static_cast<uint64_t>(__builtin_ctzll(bits)));
+                bits &= bits - 1;
+            }
+        }
+        return rows;
+    }
+
+    inline std::vector<uint64_t> BitmapToWords(const Roaring64Map &bitmap, size_t rows) {
+        std::vector<uint64_t> words(WordsFor(rows), 0);
+        for (uint64_t row : bitmap) {
+            if (row >= rows) {
+                break;
+            }
+            words[row / 64] |= uint64_t(1) << (row % 64);
+        }
+        return words;
+    }
+
+    inline Roaring64Map RowsToBitmap(const std::vector<uint64_t> &words) {
+        std::vector<uint64_t> rows = SelectRows(words);
+        Roaring64Map bitmap;
+        bitmap.addMany(rows.size(), rows.data());
+        return bitmap;
+    }
+
+    /**
+     * Add up the values of the selected rows of a column
+     *
+     * @param column integer or double column
+     * @param words selected rows, from MatchColumn or PresentInColumn
+     * @return the sum, zero when no row is selected
+     */
+    template<typename T>
+    T SumColumn(const std::vector<T> &column, const std::vector<uint64_t> &words) {
+        T sum = 0;
+        size_t rows = std::min(column.size(), words.size() * 64);
+        for (size_t row = 0; row < rows; row++) {
+            // Branch free so the loop vectorizes, unselected rows add zero
+            bool selected = (words[row / 64] >> (row % 64)) & 1U;
+            sum += selected ? column[row] : T(0);
+        }
+        return sum;
+    }
+
+    /**
+     * Find the smallest value of the selected rows of a column
+     *
+     * @param column integer or double column
+     * @param words selected rows
+     * @param minimum set to the smallest value when a row is selected
+     * @return true if a row is selected
+     */
+    template<typename T>
+    bool MinColumn(const std::vector<T> &column, const std::vector<uint64_t> &words, T &minimum) {
+        bool found = false;
+        size_t rows = std::min(column.size(), words.size() * 64);
+        for (size_t row = 0; row < rows; row++) {
+            if ((words[row / 64] >> (row % 64)) & 1U) {
+                minimum = found ? std::min(minimum, column[row]) : column[row];
+                found = true;
+            }
+        }
+        return found;
+    }
+
+    template<typename T>
+    bool MaxColumn(const std::vector<T> &column, const std::vector<uint64_t> &words, T &maximum) {
+        bool found = false;
+        size_t rows = std::min(column.size(), words.size() * 64);
+        for (size_t row = 0; row < rows; row++) {
+            if ((words[row / 64] >> (row % 64)) & 1U) {
+                maximum = found ? std::max(maximum, column[row]) : column[row];
+                found = true;
+            }
+        }
+        return found;
+    }
+}
+
+#endif //RAGEDB_KERNELS_H
@@ -0,0 +1,427 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <algorithm>
+#include <array>
+#include <utility>
+#include "Links.h"
+
+namespace ragedb {
+
+    static bool ByNodeId(const Link &a, const Link &b) {
+        return a.node_id < b.node_id;
+    }
+
+    static const size_t RADIX_MIN_LINKS = 1024;
+
+    /**
+     * Stable sort of Links by node id in linear time, a byte at a time, skipping the bytes every node id shares.
+     * Short runs are left to std::stable_sort.
+     *
+     * @param first start of the Links
+     * @param last end of the Links
+     */
+    static void SortByNodeId(Link *first, Link *last) {
+        auto count = static_cast<size_t>(last - first);
+        if (count < RADIX_MIN_LINKS) {
+            std::stable_sort(first, last, ByNodeId);
+            return;
+        }
+        std::array<std::array<size_t, 256>, sizeof(uint64_t)> histograms{};
+        for (const Link *link = first; link != last; ++link) {
+            for (size_t byte = 0; byte < sizeof(uint64_t); byte++) {
+                histograms[byte][(link->node_id >> (8 * byte)) & 0xFFU]++;
+            }
+        }
+        std::vector<Link> buffer(count, Link(0, 0));
+        Link *from = first;
+        Link *to = buffer.data();
+        for (size_t byte = 0; byte < sizeof(uint64_t); byte++) {
+            auto &histogram = histograms[byte];
+            if (histogram[(from->node_id >> (8 * byte)) & 0xFFU] == count) {
+                continue;
+            }
+            size_t offset = 0;
+            for (auto &bucket : histogram) {
+                offset += std::exchange(bucket, offset);
+            }
+            for (size_t position = 0; position < count; position++) {
+                to[histogram[(from[position].node_id >> (8 * byte)) & 0xFFU]++] = from[position];
+            }
+            std::swap(from, to);
+        }
+        if (from != first) {
+            std::copy(from, from + count, first);
+        }
+    }
+
+    Links::Links(std::vector<Link> links) : owned(std::move(links)) {
+        sort();
+    }
+
+    Links::Links(const Links &other) : owned(other.data(), other.data() + other.stored()), sorted_size(other.sorted_size), tombstones(other.tombstones),
+                                       tail_index(other.tail_index ? std::make_unique<std::unordered_multimap<uint64_t, size_t>>(*other.tail_index) : nullptr) {}
+
+    Links::Links(Links &&other) noexcept : owned(std::move(other.owned)), packed(other.packed), packed_size(other.packed_size), sorted_size(other.sorted_size),
+                                           tombstones(other.tombstones), tail_index(std::move(other.tail_index)) {
+        other.packed = nullptr;
+        other.packed_size = 0;
+        other.sorted_size = 0;
+        other.tombstones = 0;
+    }
+
+    Links &Links::operator=(const Links &other) {
+        if (this != &other) {
+            owned.assign(other.data(), other.data() + other.stored());
+            packed = nullptr;
+            packed_size = 0;
+            sorted_size = other.sorted_size;
+            tombstones = other.tombstones;
+            tail_index = other.tail_index ? std::make_unique<std::unordered_multimap<uint64_t, size_t>>(*other.tail_index) : nullptr;
+        }
+        return *this;
+    }
+
+    Links &Links::operator=(Links &&other) noexcept {
+        if (this != &other) {
+            owned = std::move(other.owned);
+            packed = other.packed;
+            packed_size = other.packed_size;
+            sorted_size = other.sorted_size;
+            tombstones = other.tombstones;
+            tail_index = std::move(other.tail_index);
+            other.packed = nullptr;
+            other.packed_size = 0;
+            other.sorted_size = 0;
+            other.tombstones = 0;
+        }
+        return *this;
+    }
+
+    Link *Links::data() {
+        return packed != nullptr ? packed : owned.data();
+    }
+
+    const Link *Links::data() const {
+        return packed != nullptr ? packed : owned.data();
+    }
+
+    // Number of Links stored, tombstones included
+    size_t Links::stored() const {
+        return packed != nullptr ? packed_size : owned.size();
+    }
+
+    void Links::thaw() {
+        if (packed != nullptr) {
+            owned.assign(packed, packed + packed_size);
+            packed = nullptr;
+            packed_size = 0;
+        }
+    }
+
+    Links::const_iterator Links::begin() const {
+        return {data(), data() + stored()};
+    }
+
+    Links::const_iterator Links::end() const {
+        return {data() + stored(), data() + stored()};
+    }
+
+    size_t Links::size() const {
+        return stored() - tombstones;
+    }
+
+    bool Links::empty() const {
+        return size() == 0;
+    }
+
+    size_t Links::dead() const {
+        return tombstones;
+    }
+
+    void Links::emplace_back(uint64_t node_id, uint64_t rel_id) {
+        thaw();
+        owned.emplace_back(node_id, rel_id);
+        index(owned.size() - 1);
+        // Merging is linear, waiting for the tail to reach a quarter of the sorted run keeps inserts O(1) amortized
+        size_t tail = owned.size() - sorted_size;
+        if (owned.size() >= SORTED_MIN_LINKS && tail >= std::max(SORTED_MIN_LINKS, sorted_size / 4)) {
+            merge();
+        }
+    }
+
+    bool Links::frozen() const {
+        return packed != nullptr;
+    }
+
+    /**
+     * Pack these Links into the blocks of a freeze, read them from there from now on and release their own vector.
+     * Tombstones are dropped and the unsorted tail is merged first.
+     *
+     * @param frozen blocks of the freeze in progress
+     */
+    void Links::freeze(FrozenLinks &frozen) {
+        if (compact()) {
+            reindex();
+        }
+        sort();
+        Link *copy = frozen.pack(data(), data() + stored());
+        packed_size = stored();
+        packed = packed_size > 0 ? copy : nullptr;
+        std::vector<Link>().swap(owned);
+    }
+
+    // Drop the tombstones, keeping the order of the other Links. Returns true if any were dropped, the tail index then has to be rebuilt.
+    bool Links::compact() {
+        if (tombstones == 0) {
+            return false;
+        }
+        Link *links = data();
+        size_t count = stored();
+        size_t kept = 0;
+        size_t kept_sorted = 0;
+        for (size_t position = 0; position < count; position++) {
+            if (links[position].rel_id != 0) {
+                if (position < sorted_size) {
+                    kept_sorted++;
+                }
+                links[kept++] = links[position];
+            }
+        }
+        if (packed != nullptr) {
+            // The packed range belongs to this Group alone, so it can be shrunk in place
+            packed_size = kept;
+            if (packed_size == 0) {
+                packed = nullptr;
+            }
+        } else {
+            owned.erase(owned.begin() + static_cast<std::ptrdiff_t>(kept), owned.end());
+        }
+        sorted_size = kept_sorted;
+        tombstones = 0;
+        return true;
+    }
+
+    // After removing Links, compact small Groups right away and supernodes once a quarter of them are tombstones
+    void Links::settle() {
+        if (tombstones > 0 && (stored() < SUPERNODE_MIN_LINKS || tombstones * 4 > stored()) && compact()) {
+            reindex();
+        }
+    }
+
+    // Sort the unsorted tail and merge it into the sorted run
+    void Links::merge() {
+        compact();
+        Link *links = data();
+        SortByNodeId(links + sorted_size, links + stored());
+        std::inplace_merge(links, links + sorted_size, links + stored(), ByNodeId);
+        sorted_size = stored();
+        tail_index.reset();
+    }
+
+    // Add the Link at a position of the tail to the index, small Groups without a sorted run are scanned instead
+    void Links::index(size_t position) {
+        if (sorted_size == 0) {
+            return;
+        }
+        if (!tail_index) {
+            // Sized for the tail a merge allows, so it does not rehash on the way
+            tail_index = std::make_unique<std::unordered_multimap<uint64_t, size_t>>();
+            tail_index->reserve(std::max(SORTED_MIN_LINKS, sorted_size / 4));
+        }
+        tail_index->emplace(data()[position].node_id, position);
+    }
+
+    // Index the tail again after its Links moved
+    void Links::reindex() {
+        tail_index.reset();
+        for (size_t position = sorted_size; position < stored(); position++) {
+            index(position);
+        }
+    }
+
+    /**
+     * Call visit with the position of each Link to a node in the unsorted tail, through the index when there is one
+     *
+     * @param node_id id of the node at the other end
+     * @param visit called with a position, returns true to stop
+     * @return true if visit stopped early
+     */
+    template <typename Visit>
+    bool Links::visitTail(uint64_t node_id, Visit visit) const {
+        if (sorted_size > 0) {
+            if (tail_index) {
+                auto [first, last] = tail_index->equal_range(node_id);
+                for (auto entry = first; entry != last; ++entry) {
+                    if (visit(entry->second)) {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+        const Link *links = data();
+        for (size_t position = 0; position < stored(); position++) {
+            if (links[position].node_id == node_id && visit(position)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Put the Links of a large Group in node id order, small Groups keep the order their Links were added in
+    void Links::sort() {
+        if (size() >= SORTED_MIN_LINKS && sorted_size < stored()) {
+            merge();
+        }
+    }
+
+    /**
+     * Check for a Link to a node, by binary search in the sorted run and a lookup in the unsorted tail
+     *
+     * @param node_id id of the node at the other end
+     * @return true if any Link goes to the node
+     */
+    bool Links::contains(uint64_t node_id) const {
+        const Link *links = data();
+        auto [first, last] = std::equal_range(links, links + sorted_size, Link(node_id, 0), ByNodeId);
+        if (std::any_of(first, last, [] (const Link& link) { return link.rel_id != 0; })) {
+            return true;
+        }
+        return visitTail(node_id, [links] (size_t position) { return links[position].rel_id != 0; });
+    }
+
+    // Position of a Link in the stored Links, or stored() when there is none. Tombstones never match, their rel_id is 0.
+    size_t Links::locate(uint64_t node_id, uint64_t rel_id) const {
+        const Link *links = data();
+        auto [first, last] = std::equal_range(links, links + sorted_size, Link(node_id, 0), ByNodeId);
+        const Link *found = std::find_if(first, last, [rel_id] (const Link& link) { return link.rel_id == rel_id; });
+        if (found != last) {
+            return static_cast<size_t>(found - links);
+        }
+        size_t position = stored();
+        visitTail(node_id, [links, rel_id, &position] (size_t candidate) {
+            if (links[candidate].rel_id == rel_id) {
+                position = candidate;
+                return true;
+            }
+            return false;
+        });
+        return position;
+    }
+
+    /**
+     * Find a single Link, by binary search in the sorted run and a lookup in the unsorted tail
+     *
+     * @param node_id id of the node at the other end
+     * @param rel_id relationship id
+     * @return the Link, or end() when there is none
+     */
+    Links::const_iterator Links::find(uint64_t node_id, uint64_t rel_id) const {
+        return {data() + locate(node_id, rel_id), data() + stored()};
+    }
+
+    bool Links::remove(uint64_t node_id, uint64_t rel_id) {
+        size_t position = locate(node_id, rel_id);
+        if (position == stored()) {
+            return false;
+        }
+        data()[position].rel_id = 0;
+        tombstones++;
+        settle();
+        return true;
+    }
+
+    /**
+     * Remove the Links to a node that match a predicate, looking only at the Links to that node
+     * in the sorted run and in the unsorted tail
+     *
+     * @param node_id id of the node at the other end
+     * @param predicate called once per Link to the node, true to remove it
+     * @return number of Links removed
+     */
+    size_t Links::remove_if(uint64_t node_id, const std::function<bool(const Link&)> &predicate) {
+        Link *links = data();
+        size_t removed = 0;
+        auto bury = [&removed, node_id, &predicate] (Link& link) {
+            if (link.node_id == node_id && link.rel_id != 0 && predicate(link)) {
+                link.rel_id = 0;
+                removed++;
+            }
+        };
+        // The Links to the node in the sorted run are next to each other
+        auto [first, last] = std::equal_range(links, links + sorted_size, Link(node_id, 0), ByNodeId);
+        std::for_each(first, last, bury);
+        visitTail(node_id, [links, &bury] (size_t position) {
+            bury(links[position]);
+            return false;
+        });
+        tombstones += removed;
+        settle();
+        return removed;
+    }
+
+    /**
+     * Remove the Links that match a predicate, keeping the order of the others
+     *
+     * @param predicate called once per Link, true to remove it
+     * @return number of Links removed
+     */
+    size_t Links::remove_if(const std::function<bool(const Link&)> &predicate) {
+        Link *links = data();
+        size_t removed = 0;
+        for (size_t position = 0; position < stored(); position++) {
+            if (links[position].rel_id != 0 && predicate(links[position])) {
+                links[position].rel_id = 0;
+                removed++;
+            }
+        }
+        tombstones += removed;
+        settle();
+        return removed;
+    }
+
+    /**
+     * Copy Links to the end of the last block, starting a new block when they do not fit
+     *
+     * @param first start of the Links
+     * @param last end of the Links
+     * @return start of the copy, nullptr when there is nothing to copy
+     */
+    Link *FrozenLinks::pack(const Link *first, const Link *last) {
+        auto size = static_cast<size_t>(last - first);
+        if (size == 0) {
+            return nullptr;
+        }
+        if (blocks.empty() || blocks.back().capacity() - blocks.back().size() < size) {
+            blocks.emplace_back().reserve(std::max(BLOCK_SIZE, size));
+        }
+        auto &block = blocks.back();
+        size_t start = block.size();
+        block.insert(block.end(), first, last);
+        count += size;
+        return block.data() + start;
+    }
+
+    uint64_t FrozenLinks::size() const {
+        return count;
+    }
+
+    bool FrozenLinks::empty() const {
+        return blocks.empty();
+    }
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef RAGEDB_LINKS_H
+#define RAGEDB_LINKS_H
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "Link.h"
+
+namespace ragedb {
+
+    class FrozenLinks;
+
+    /**
+     * The Links of a Group. They either live in their own vector, or are frozen: packed next to the
+     * Links of the other nodes of the same type in a FrozenLinks block and read in place.
+     * Frozen Links can shrink in place, adding a Link copies them back into their own vector,
+     * which acts as the delta until the next freeze packs them again.
+     *
+     * Once a Group reaches SORTED_MIN_LINKS, its Links are kept in node id order so a Link to a given
+     * node is found by binary search. New Links go to an unsorted tail indexed by node id, so finding
+     * a Link takes O(log d) for a Group of d Links. The tail is radix sorted and merged into the sorted
+     * run once it reaches a quarter of the run, and freezing merges it as well. Each merge is linear
+     * and follows d / 4 inserts, so inserting is O(1) amortized.
+     * Smaller Groups keep the order their Links were added in.
+     *
+     * Removed Links are turned into tombstones, a Link with a rel_id of 0, which iteration skips.
+     * Groups under SUPERNODE_MIN_LINKS are compacted right away, larger ones only once a quarter of
+     * their Links are tombstones or when they are frozen. Removing a Link from a supernode costs the
+     * O(log d) search for it, and the linear compaction adds O(1) amortized.
+     */
+    class Links {
+    private:
+        std::vector<Link> owned;
+        Link* packed{nullptr};
+        size_t packed_size{0};
+        size_t sorted_size{0}; // Links before this are in node id order, the ones after are the unsorted tail
+        size_t tombstones{0};
+        std::unique_ptr<std::unordered_multimap<uint64_t, size_t>> tail_index; // Positions of the tail Links by node id, while there is a sorted run
+
+        [[nodiscard]] Link* data();
+        [[nodiscard]] const Link* data() const;
+        [[nodiscard]] size_t stored() const;
+        void thaw();
+        void merge();
+        bool compact();
+        void settle();
+        void index(size_t position);
+        void reindex();
+        [[nodiscard]] size_t locate(uint64_t node_id, uint64_t rel_id) const;
+        template <typename Visit> bool visitTail(uint64_t node_id, Visit visit) const;
+
+    public:
+        // Walks the stored Links, skipping tombstones
+        class const_iterator {
+        private:
+            const Link* current;
+            const Link* last;
+
+            void skip() {
+                while (current != last && current->rel_id == 0) {
+                    ++current;
+                }
+            }
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Link;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const Link*;
+            using reference = const Link&;
+
+            const_iterator(const Link* first, const Link* end) : current(first), last(end) { skip(); }
+            reference operator*() const { return *current; }
+            pointer operator->() const { return current; }
+            const_iterator& operator++() { ++current; skip(); return *this; }
+            const_iterator operator++(int) { const_iterator previous = *this; ++(*this); return previous; }
+            bool operator==(const const_iterator& other) const { return current == other.current; }
+            bool operator!=(const const_iterator& other) const { return current != other.current; }
+        };
+        using iterator = const_iterator;
+
+        Links() = default;
+        Links(std::vector<Link> links); // NOLINT(google-explicit-constructor)
+        Links(const Links& other);
+        Links(Links&& other) noexcept;
+        Links& operator=(const Links& other);
+        Links& operator=(Links&& other) noexcept;
+
+        [[nodiscard]] const_iterator begin() const;
+        [[nodiscard]] const_iterator end() const;
+        [[nodiscard]] size_t size() const;
+        [[nodiscard]] bool empty() const;
+
+        void emplace_back(uint64_t node_id, uint64_t rel_id);
+
+        [[nodiscard]] bool frozen() const;
+        void freeze(FrozenLinks& frozen);
+
+        static constexpr size_t SORTED_MIN_LINKS = 64;
+        static constexpr size_t SUPERNODE_MIN_LINKS = 4096;
+
+        void sort();
+        [[nodiscard]] bool contains(uint64_t node_id) const;
+        [[nodiscard]] const_iterator find(uint64_t node_id, uint64_t rel_id) const;
+        bool remove(uint64_t node_id, uint64_t rel_id);
+        size_t remove_if(uint64_t node_id, const std::function<bool(const Link&)> &predicate);
+        size_t remove_if(const std::function<bool(const Link&)> &predicate);
+        [[nodiscard]] size_t dead() const;
+    };
+
+    /**
+     * Packed storage of the frozen Links of a node type. Blocks never grow past the capacity they are
+     * created with, so the Links pointing into them stay valid until the FrozenLinks are destroyed.
+     */
+    class FrozenLinks {
+    private:
+        std::vector<std::vector<Link>> blocks;
+        uint64_t count{0};
+
+    public:
+        static constexpr size_t BLOCK_SIZE = 1 << 16;
+
+        Link* pack(const Link* first, const Link* last);
+        [[nodiscard]] uint64_t size() const;
+        [[nodiscard]] bool empty() const;
+    };
+}
+
+#endif //RAGEDB_LINKS_H
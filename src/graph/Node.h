@@ -22,6 +22,7 @@
 #include <string>
 #include <map>
 #include <sol/sol.hpp>
+#include "PropertyRecord.h"
 
 namespace ragedb {
 
@@ -30,7 +31,7 @@ namespace ragedb {
         uint64_t id{};
         std::string type{};
         std::string key{};
-        std::map<std::string, std::any> properties{};
+        PropertyRecord properties{};
 
     public:
         Node();
@@ -39,6 +40,8 @@ namespace ragedb {
 
         Node(uint64_t id, std::string type, std::string key, std::map<std::string, std::any> );
 
+        Node(uint64_t id, std::string type, std::string key, PropertyRecord properties);
+
         [[nodiscard]] uint64_t getId() const;
 
         [[nodiscard]] uint16_t getTypeId() const;
@@ -49,6 +52,8 @@ namespace ragedb {
 
         [[nodiscard]] std::map<std::string, std::any> getProperties() const;
 
+        [[nodiscard]] const PropertyRecord& getPropertyRecord() const;
+
         [[nodiscard]] sol::table getPropertiesLua(sol::this_state);
 
         [[nodiscard]] std::any getProperty(const std::string& property);
@@ -56,6 +61,9 @@ namespace ragedb {
         friend std::ostream& operator<<(std::ostream& os, const Node& node);
 
     };
+
+    // Node and Relationship properties as a Lua table, lists become nested tables
+    sol::table PropertyRecordToLua(sol::state_view lua, const PropertyRecord& record);
 }
 
 #endif //RAGEDB_NODE_H
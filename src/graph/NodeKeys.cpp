@@ -0,0 +1,213 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <algorithm>
+#include "NodeKeys.h"
+
+namespace ragedb {
+
+    NodeKeys::NodeKeys() = default;
+
+    void NodeKeys::clear() {
+        std::vector<char>().swap(arena);
+        std::vector<uint64_t>().swap(offsets);
+        std::vector<uint32_t>().swap(lengths);
+        hash_to_id.clear();
+        colliding.clear();
+        live_bytes = 0;
+        stopPacking();
+    }
+
+    uint64_t NodeKeys::Hash(std::string_view key) {
+        // FNV-1a rather than std::hash, which may differ between builds and would strand the index of a snapshot
+        uint64_t hash = 14695981039346656037U;
+        for (char c : key) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 1099511628211U;
+        }
+        return hash;
+    }
+
+    bool NodeKeys::find(std::string_view key, uint64_t &internal_id) const {
+        auto hash_search = hash_to_id.find(Hash(key));
+        if (hash_search != hash_to_id.end() && get(hash_search->second) == key) {
+            internal_id = hash_search->second;
+            return true;
+        }
+        if (!colliding.empty()) {
+            auto key_search = colliding.find(std::string(key));
+            if (key_search != colliding.end()) {
+                internal_id = key_search->second;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::string_view NodeKeys::get(uint64_t internal_id) const {
+        if (internal_id < offsets.size()) {
+            return { arena.data() + offsets[internal_id], lengths[internal_id] };
+        }
+        return {};
+    }
+
+    bool NodeKeys::set(uint64_t internal_id, std::string_view key) {
+        if (internal_id > offsets.size()) {
+            return false;
+        }
+        if (internal_id == offsets.size()) {
+            offsets.emplace_back(0);
+            lengths.emplace_back(0);
+        }
+        // A key given to an internal id that still held one leaves the old bytes behind
+        live_bytes -= lengths[internal_id];
+        live_bytes += key.size();
+        // The copy of its old key in the packed arena is stale, copy the new one once the rest is done
+        if (packing && internal_id < moved.size()) {
+            repacked.emplace_back(internal_id);
+        }
+        offsets[internal_id] = arena.size();
+        lengths[internal_id] = static_cast<uint32_t>(key.size());
+        arena.insert(arena.end(), key.begin(), key.end());
+
+        auto [entry, inserted] = hash_to_id.emplace(Hash(key), internal_id);
+        if (!inserted) {
+            colliding.emplace(std::string(key), internal_id);
+        }
+        return true;
+    }
+
+    void NodeKeys::remove(uint64_t internal_id) {
+        if (internal_id >= offsets.size()) {
+            return;
+        }
+        std::string_view key = get(internal_id);
+        auto hash_search = hash_to_id.find(Hash(key));
+        if (hash_search != hash_to_id.end() && hash_search->second == internal_id) {
+            hash_to_id.erase(hash_search);
+        } else {
+            auto key_search = colliding.find(std::string(key));
+            if (key_search != colliding.end() && key_search->second == internal_id) {
+                colliding.erase(key_search);
+            }
+        }
+        live_bytes -= lengths[internal_id];
+        lengths[internal_id] = 0;
+    }
+
+    uint64_t NodeKeys::size() const {
+        return hash_to_id.size() + colliding.size();
+    }
+
+    uint64_t NodeKeys::slots() const {
+        return offsets.size();
+    }
+
+    void NodeKeys::truncate(uint64_t count) {
+        if (count >= offsets.size()) {
+            return;
+        }
+        for (uint64_t internal_id = count; internal_id < offsets.size(); internal_id++) {
+            live_bytes -= lengths[internal_id];
+        }
+        stopPacking();
+        offsets.resize(count);
+        lengths.resize(count);
+        // Keep the room of a recent growth, only give back memory once less than half of it is used
+        if (count * 2 < offsets.capacity()) {
+            offsets.shrink_to_fit();
+            lengths.shrink_to_fit();
+        }
+    }
+
+    bool NodeKeys::compact(uint64_t count) {
+        if (!packing) {
+            if ((arena.size() - live_bytes) * 4 <= arena.size()) {
+                return true;
+            }
+            packing = true;
+            packed.reserve(live_bytes);
+            moved.reserve(offsets.size());
+        }
+        // Copy the live keys into a new arena in internal id order, the index only holds ids so it stays as is
+        uint64_t last = std::min<uint64_t>(offsets.size(), moved.size() + count);
+        while (moved.size() < last) {
+            uint64_t internal_id = moved.size();
+            const char *key = arena.data() + offsets[internal_id];
+            moved.emplace_back(packed.size());
+            packed.insert(packed.end(), key, key + lengths[internal_id]);
+        }
+        if (moved.size() < offsets.size()) {
+            return false;
+        }
+        for (uint64_t internal_id : repacked) {
+            const char *key = arena.data() + offsets[internal_id];
+            moved[internal_id] = packed.size();
+            packed.insert(packed.end(), key, key + lengths[internal_id]);
+        }
+        arena.swap(packed);
+        offsets.swap(moved);
+        stopPacking();
+        return true;
+    }
+
+    void NodeKeys::stopPacking() {
+        packing = false;
+        std::vector<char>().swap(packed);
+        std::vector<uint64_t>().swap(moved);
+        std::vector<uint64_t>().swap(repacked);
+    }
+
+    void NodeKeys::reserve(uint64_t count) {
+        // Grow at least geometrically, so a long run of batches stays amortized linear
+        uint64_t needed = offsets.size() + count;
+        if (offsets.capacity() < needed) {
+            uint64_t capacity = std::max(needed, 2 * offsets.capacity());
+            offsets.reserve(capacity);
+            lengths.reserve(capacity);
+        }
+        needed = hash_to_id.size() + count;
+        if (static_cast<float>(hash_to_id.bucket_count()) * hash_to_id.max_load_factor() < static_cast<float>(needed)) {
+            hash_to_id.reserve(std::max(needed, 2 * hash_to_id.size()));
+        }
+    }
+
+    void NodeKeys::writeSnapshot(SnapshotWriter &writer) const {
+        writer.write(arena);
+        writer.write(offsets);
+        writer.write(lengths);
+        hash_to_id.serialize(writer);
+        colliding.serialize(writer);
+    }
+
+    bool NodeKeys::readSnapshot(SnapshotReader &reader) {
+        // The index is read back without hashing the keys again, but its buckets are laid out anew
+        // since where std::hash places an entry may differ from the build that wrote the snapshot
+        arena = reader.read<std::vector<char>>();
+        offsets = reader.read<std::vector<uint64_t>>();
+        lengths = reader.read<std::vector<uint32_t>>();
+        hash_to_id = tsl::sparse_map<uint64_t, uint64_t>::deserialize(reader, false);
+        colliding = tsl::sparse_map<std::string, uint64_t>::deserialize(reader, false);
+        live_bytes = 0;
+        for (uint32_t length : lengths) {
+            live_bytes += length;
+        }
+        stopPacking();
+        return reader.ok() && offsets.size() == lengths.size();
+    }
+
+}
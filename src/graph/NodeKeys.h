@@ -0,0 +1,91 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef RAGEDB_NODEKEYS_H
+#define RAGEDB_NODEKEYS_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <tsl/sparse_map.h>
+#include "Snapshot.h"
+
+namespace ragedb {
+
+    /**
+     * The keys of the nodes of one type. Each key is stored once, appended to a single arena of bytes,
+     * and the index maps the FNV-1a hash of a key to the internal id of its node, whose key in the arena settles
+     * a match. The rare key whose hash is already taken by another key goes to a small overflow map.
+     * Bytes of removed keys stay in the arena until the keys are compacted, which packs it once they are a quarter of it.
+     */
+    class NodeKeys {
+    private:
+        std::vector<char> arena;                         // Bytes of every key, one after another
+        std::vector<uint64_t> offsets;                   // Start of the key of each internal id in the arena
+        std::vector<uint32_t> lengths;                   // Length of the key of each internal id, 0 once removed
+        tsl::sparse_map<uint64_t, uint64_t> hash_to_id;  // Hash of a key to the internal id holding it
+        tsl::sparse_map<std::string, uint64_t> colliding; // Keys whose hash was taken when they were added
+        uint64_t live_bytes = 0;                         // Bytes of the arena held by keys that were not removed
+
+        // While the arena is packed in steps: the keys copied so far, where they went,
+        // and the internal ids given a key again after theirs was copied
+        bool packing = false;
+        std::vector<char> packed;
+        std::vector<uint64_t> moved;
+        std::vector<uint64_t> repacked;
+
+        void stopPacking();
+
+        static uint64_t Hash(std::string_view key);
+
+    public:
+        NodeKeys();
+
+        void clear();
+
+        // Find the internal id of the node with a key, false when there is none
+        bool find(std::string_view key, uint64_t &internal_id) const;
+
+        [[nodiscard]] std::string_view get(uint64_t internal_id) const;
+
+        // Give a key no node holds yet to the next internal id or to one whose key was removed
+        bool set(uint64_t internal_id, std::string_view key);
+
+        void remove(uint64_t internal_id);
+
+        // Number of keys held, not counting removed ones
+        [[nodiscard]] uint64_t size() const;
+
+        // Number of internal ids handed out, counting the ones whose key was removed
+        [[nodiscard]] uint64_t slots() const;
+
+        // Drop the internal ids from count on, which must all be removed
+        void truncate(uint64_t count);
+
+        // Pack up to count more keys into a new arena, true once it is packed or too little of it is removed keys to bother
+        bool compact(uint64_t count);
+
+        // Make room for count more keys before adding them in a batch
+        void reserve(uint64_t count);
+
+        void writeSnapshot(SnapshotWriter &writer) const;
+        bool readSnapshot(SnapshotReader &reader);
+    };
+}
+
+#endif //RAGEDB_NODEKEYS_H
@@ -0,0 +1,35 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef RAGEDB_NODEREMOVAL_H
+#define RAGEDB_NODEREMOVAL_H
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace ragedb {
+
+    // Counterparts of the links of a removed node held by another Shard, the ids of the nodes at the other end by relationship type id
+    struct NodeRemoval {
+        uint64_t id = 0;
+        std::map<uint16_t, std::vector<uint64_t>> incoming;    // Incoming links of these nodes from the removed node
+        std::map<uint16_t, std::vector<uint64_t>> outgoing;    // Outgoing links of these nodes to the removed node
+    };
+}
+
+#endif //RAGEDB_NODEREMOVAL_H
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <tsl/sparse_map.h>
 #include <iostream>
 #include <utility>
@@ -35,20 +36,26 @@ namespace ragedb {
         // start with empty blank type 0
         type_to_id.emplace("", 0);
         id_to_type.emplace_back();
-        key_to_node_id.emplace_back(tsl::sparse_map<std::string, uint64_t>());
-        keys.emplace_back(std::vector<std::string>());
+        addTypeStorage();
+    }
+
+    // Every per type vector gets its entry here, so they all stay in step with id_to_type
+    void NodeTypes::addTypeStorage() {
+        keys.emplace_back();
         properties.emplace_back();
-        outgoing_relationships.emplace_back(std::vector<std::vector<Group>>());
-        incoming_relationships.emplace_back(std::vector<std::vector<Group>>());
-        deleted_ids.emplace_back(Roaring64Map());
+        outgoing_relationships.emplace_back();
+        incoming_relationships.emplace_back();
+        outgoing_degrees.emplace_back();
+        incoming_degrees.emplace_back();
+        deleted_ids.emplace_back();
+        frozen_outgoing.emplace_back();
+        frozen_incoming.emplace_back();
     }
 
     void NodeTypes::Clear() {
         type_to_id.clear();
         id_to_type.clear();
         id_to_type.shrink_to_fit();
-        key_to_node_id.clear();
-        key_to_node_id.shrink_to_fit();
         keys.clear();
         keys.shrink_to_fit();
         properties.clear();
@@ -57,16 +64,128 @@ namespace ragedb {
         outgoing_relationships.shrink_to_fit();
         incoming_relationships.clear();
         incoming_relationships.shrink_to_fit();
+        outgoing_degrees.clear();
+        outgoing_degrees.shrink_to_fit();
+        incoming_degrees.clear();
+        incoming_degrees.shrink_to_fit();
         deleted_ids.clear();
         deleted_ids.shrink_to_fit();
+        frozen_outgoing.clear();
+        frozen_outgoing.shrink_to_fit();
+        frozen_incoming.clear();
+        frozen_incoming.shrink_to_fit();
 
         // start with empty blank type 0
         type_to_id.emplace("", 0);
         id_to_type.emplace_back();
-        key_to_node_id.emplace_back(tsl::sparse_map<std::string, uint64_t>());
-        keys.emplace_back(std::vector<std::string>());
-        outgoing_relationships.emplace_back(std::vector<std::vector<Group>>());
-        incoming_relationships.emplace_back(std::vector<std::vector<Group>>());
+        addTypeStorage();
+    }
+
+    static void writeGroups(SnapshotWriter &writer, const std::vector<std::vector<Group>> &nodes) {
+        writer(static_cast<uint64_t>(nodes.size()));
+        for (const auto &groups : nodes) {
+            writer(static_cast<uint64_t>(groups.size()));
+            for (const auto &group : groups) {
+                writer(group.rel_type_id);
+                writer(static_cast<uint64_t>(group.links.size()));
+                for (const auto &link : group.links) {
+                    writer(link.node_id);
+                    writer(link.rel_id);
+                }
+            }
+        }
+    }
+
+    static std::vector<std::vector<Group>> readGroups(SnapshotReader &reader) {
+        std::vector<std::vector<Group>> nodes;
+        auto node_count = reader.read<uint64_t>();
+        nodes.reserve(node_count);
+        for (uint64_t i = 0; i < node_count && reader.ok(); i++) {
+            auto &groups = nodes.emplace_back();
+            auto group_count = reader.read<uint64_t>();
+            groups.reserve(group_count);
+            for (uint64_t j = 0; j < group_count && reader.ok(); j++) {
+                auto rel_type_id = reader.read<uint16_t>();
+                auto link_count = reader.read<uint64_t>();
+                std::vector<Link> links;
+                links.reserve(link_count);
+                for (uint64_t k = 0; k < link_count && reader.ok(); k++) {
+                    auto node_id = reader.read<uint64_t>();
+                    links.emplace_back(node_id, reader.read<uint64_t>());
+                }
+                groups.emplace_back(rel_type_id, std::move(links));
+            }
+        }
+        return nodes;
+    }
+
+    static std::vector<uint64_t> countLinks(const std::vector<std::vector<Group>> &nodes) {
+        std::vector<uint64_t> degrees;
+        degrees.reserve(nodes.size());
+        for (const auto &groups : nodes) {
+            uint64_t count = 0;
+            for (const auto &group : groups) {
+                count += group.links.size();
+            }
+            degrees.emplace_back(count);
+        }
+        return degrees;
+    }
+
+    void NodeTypes::writeSnapshot(SnapshotWriter &writer) const {
+        writer(static_cast<uint64_t>(type_to_id.size()));
+        for (const auto &[type, type_id] : type_to_id) {
+            writer.write(type);
+            writer(type_id);
+        }
+        writer.write(id_to_type);
+        for (size_t type_id = 0; type_id < id_to_type.size(); type_id++) {
+            keys[type_id].writeSnapshot(writer);
+            properties[type_id].writeSnapshot(writer);
+            writeGroups(writer, outgoing_relationships[type_id]);
+            writeGroups(writer, incoming_relationships[type_id]);
+            writer.write(deleted_ids[type_id]);
+        }
+    }
+
+    bool NodeTypes::readSnapshot(SnapshotReader &reader) {
+        type_to_id.clear();
+        auto type_count = reader.read<uint64_t>();
+        for (uint64_t i = 0; i < type_count && reader.ok(); i++) {
+            auto type = reader.read<std::string>();
+            type_to_id.emplace(type, reader.read<uint16_t>());
+        }
+        id_to_type = reader.read<std::vector<std::string>>();
+        if (!reader.ok() || id_to_type.empty()) {
+            return false;
+        }
+
+        // Load each type directly into its final layout, the key index is rebuilt without rehashing
+        keys.clear();
+        properties.clear();
+        outgoing_relationships.clear();
+        incoming_relationships.clear();
+        outgoing_degrees.clear();
+        incoming_degrees.clear();
+        deleted_ids.clear();
+        keys.resize(id_to_type.size());
+        properties.resize(id_to_type.size());
+        for (size_t type_id = 0; type_id < id_to_type.size() && reader.ok(); type_id++) {
+            keys[type_id].readSnapshot(reader);
+            properties[type_id].readSnapshot(reader);
+            outgoing_relationships.emplace_back(readGroups(reader));
+            incoming_relationships.emplace_back(readGroups(reader));
+            // Degrees are not written, they are counted again from the links
+            outgoing_degrees.emplace_back(countLinks(outgoing_relationships.back()));
+            incoming_degrees.emplace_back(countLinks(incoming_relationships.back()));
+            deleted_ids.emplace_back(reader.readBitmap());
+        }
+        // Restored links live in their own vectors until the type is frozen again
+        frozen_outgoing.clear();
+        frozen_incoming.clear();
+        frozen_outgoing.resize(id_to_type.size());
+        frozen_incoming.resize(id_to_type.size());
+        return reader.ok();
     }
 
     uint64_t NodeTypes::internalToExternal(uint16_t type_id, uint64_t internal_id) const {
@@ -93,12 +212,7 @@ namespace ragedb {
         }
         type_to_id.emplace(type, type_id);
         id_to_type.emplace_back(type);
-        key_to_node_id.emplace_back(tsl::sparse_map<std::string, uint64_t>());
-        keys.emplace_back(std::vector<std::string>());
-        properties.emplace_back(Properties());
-        outgoing_relationships.emplace_back(std::vector<std::vector<Group>>());
-        incoming_relationships.emplace_back(std::vector<std::vector<Group>>());
-        deleted_ids.emplace_back(Roaring64Map());
+        addTypeStorage();
         return true;
     }
 
@@ -120,12 +234,7 @@ namespace ragedb {
         auto type_id = type_to_id.size();
         type_to_id.emplace(type, type_id);
         id_to_type.emplace_back(type);
-        key_to_node_id.emplace_back(tsl::sparse_map<std::string, uint64_t>());
-        keys.emplace_back(std::vector<std::string>());
-        properties.emplace_back(Properties());
-        outgoing_relationships.emplace_back(std::vector<std::vector<Group>>());
-        incoming_relationships.emplace_back(std::vector<std::vector<Group>>());
-        deleted_ids.emplace_back(Roaring64Map());
+        addTypeStorage();
         return type_id;
     }
 
@@ -152,12 +261,15 @@ namespace ragedb {
             if (getCount(type_id) == 0) {
                 type_to_id[type] = 0;
                 id_to_type[type_id].clear();
-                key_to_node_id[type_id].clear();
                 keys[type_id].clear();
                 properties[type_id].clear();
                 outgoing_relationships[type_id].clear();
                 incoming_relationships[type_id].clear();
+                outgoing_degrees[type_id].clear();
+                incoming_degrees[type_id].clear();
                 deleted_ids[type_id].clear();
+                frozen_outgoing[type_id] = FrozenLinks();
+                frozen_incoming[type_id] = FrozenLinks();
                 return true;
             }
         }
@@ -192,132 +304,84 @@ namespace ragedb {
         return false;
     }
 
+    /**
+     * Internal ids of live nodes of a type from an internal id on
+     *
+     * @param type_id node type id
+     * @param from first internal id to look at
+     * @param limit most ids to return
+     * @return internal ids in order, deleted ones left out
+     */
+    std::vector<uint64_t> NodeTypes::getInternalIds(uint16_t type_id, uint64_t from, uint64_t limit) const {
+        if (!ValidTypeId(type_id)) {
+            return std::vector<uint64_t>();
+        }
+        return LiveIds(deleted_ids[type_id], keys[type_id].slots(), from, limit);
+    }
+
+    /**
+     * Internal ids of live nodes of a type after skipping some of them.
+     * Where the skipped ones end is found by the rank of the deleted ids, not by walking past them.
+     *
+     * @param type_id node type id
+     * @param skip live nodes to skip
+     * @param limit most ids to return
+     * @return internal ids in order, deleted ones left out
+     */
+    std::vector<uint64_t> NodeTypes::skipInternalIds(uint16_t type_id, uint64_t skip, uint64_t limit) const {
+        if (!ValidTypeId(type_id)) {
+            return std::vector<uint64_t>();
+        }
+        uint64_t slots = keys[type_id].slots();
+        return LiveIds(deleted_ids[type_id], slots, LiveIdAt(deleted_ids[type_id], slots, skip), limit);
+    }
+
     std::vector<uint64_t> NodeTypes::getIds(uint64_t skip, uint64_t limit) const {
         std::vector<uint64_t> allIds;
-        int current = 1;
-        // links are internal links, we need to switch to external links
-        for (size_t type_id=1; type_id < id_to_type.size(); type_id++) {
-            uint64_t max_id = key_to_node_id[type_id].size();
-            if (deleted_ids[type_id].isEmpty()) {
-                for (uint64_t internal_id=0; internal_id < max_id; ++internal_id) {
-                    if (current > (skip + limit)) {
-                        return allIds;
-                    }
-                    if (current > skip) {
-                        allIds.emplace_back(internalToExternal(type_id, internal_id));
-                    }
-                    current++;
-                }
-            } else {
-                for (uint64_t internal_id=0; internal_id < max_id; ++internal_id) {
-                    if (current > (skip + limit)) {
-                        return allIds;
-                    }
-                    if (current > skip) {
-                        if (!deleted_ids[type_id].contains(internal_id)) {
-                            allIds.emplace_back(internalToExternal(type_id, internal_id));
-                        }
-                    }
-                    current++;
-                }
+        // Whole types are skipped by their count
+        for (size_t type_id=1; type_id < id_to_type.size() && allIds.size() < limit; type_id++) {
+            uint64_t count = keys[type_id].slots() - deleted_ids[type_id].cardinality();
+            if (skip >= count) {
+                skip -= count;
+                continue;
+            }
+            for (uint64_t internal_id : skipInternalIds(type_id, skip, limit - allIds.size())) {
+                allIds.emplace_back(internalToExternal(type_id, internal_id));
             }
+            skip = 0;
         }
         return allIds;
     }
 
     std::vector<uint64_t>  NodeTypes::getIds(uint16_t type_id, uint64_t skip, uint64_t limit) {
         std::vector<uint64_t>  allIds;
-        if (ValidTypeId(type_id)) {
-            int current = 1;
-            uint64_t max_id = key_to_node_id[type_id].size();
-            if (deleted_ids[type_id].isEmpty()) {
-                for (uint64_t internal_id=0; internal_id < max_id; ++internal_id) {
-                    if (current > (skip + limit)) {
-                        return allIds;
-                    }
-                    if (current > skip) {
-                        allIds.emplace_back(internalToExternal(type_id, internal_id));
-                    }
-                    current++;
-                }
-            } else {
-                for (uint64_t internal_id=0; internal_id < max_id; ++internal_id) {
-                    if (current > (skip + limit)) {
-                        return allIds;
-                    }
-                    if (current > skip) {
-                        if (!deleted_ids[type_id].contains(internal_id)) {
-                            allIds.emplace_back(internalToExternal(type_id, internal_id));
-                        }
-                    }
-                    current++;
-                }
-            }
+        for (uint64_t internal_id : skipInternalIds(type_id, skip, limit)) {
+            allIds.emplace_back(internalToExternal(type_id, internal_id));
         }
         return allIds;
     }
 
     std::vector<Node> NodeTypes::getNodes(uint64_t skip, uint64_t limit) {
         std::vector<Node> allNodes;
-        int current = 1;
-        // links are internal links, we need to switch to external links
-        for (size_t type_id=1; type_id < id_to_type.size(); type_id++) {
-            uint64_t max_id = key_to_node_id[type_id].size();
-            if (deleted_ids[type_id].isEmpty()) {
-                for (uint64_t internal_id=0; internal_id < max_id; ++internal_id) {
-                    if (current > (skip + limit)) {
-                        return allNodes;
-                    }
-                    if (current > skip) {
-                        allNodes.emplace_back(getNode(type_id, internal_id));
-                    }
-                    current++;
-                }
-            } else {
-                for (uint64_t internal_id=0; internal_id < max_id; ++internal_id) {
-                    if (current > (skip + limit)) {
-                        return allNodes;
-                    }
-                    if (current > skip) {
-                        if (!deleted_ids[type_id].contains(internal_id)) {
-                            allNodes.emplace_back(getNode(type_id, internal_id));
-                        }
-                    }
-                    current++;
-                }
+        // Whole types are skipped by their count
+        for (size_t type_id=1; type_id < id_to_type.size() && allNodes.size() < limit; type_id++) {
+            uint64_t count = getCount(type_id);
+            if (skip >= count) {
+                skip -= count;
+                continue;
+            }
+            for (uint64_t internal_id : skipInternalIds(type_id, skip, limit - allNodes.size())) {
+                allNodes.emplace_back(getNode(type_id, internal_id));
             }
+            skip = 0;
         }
         return allNodes;
     }
 
     std::vector<Node> NodeTypes::getNodes(uint16_t type_id, uint64_t skip, uint64_t limit) {
         std::vector<Node>  allNodes;
-        if (ValidTypeId(type_id)) {
-            int current = 1;
-            uint64_t max_id = key_to_node_id[type_id].size();
-            if (deleted_ids[type_id].isEmpty()) {
-                for (uint64_t internal_id=0; internal_id < max_id; ++internal_id) {
-                    if (current > (skip + limit)) {
-                        return allNodes;
-                    }
-                    if (current > skip) {
-                        allNodes.emplace_back(getNode(type_id, internal_id));
-                    }
-                    current++;
-                }
-            } else {
-                for (uint64_t internal_id=0; internal_id < max_id; ++internal_id) {
-                    if (current > (skip + limit)) {
-                        return allNodes;
-                    }
-                    if (current > skip) {
-                        if (!deleted_ids[type_id].contains(internal_id)) {
-                            allNodes.emplace_back(getNode(type_id, internal_id));
-                        }
-                    }
-                    current++;
-                }
-            }
+        for (uint64_t internal_id : skipInternalIds(type_id, skip, limit)) {
+            allNodes.emplace_back(getNode(type_id, internal_id));
         }
         return allNodes;
     }
@@ -356,14 +420,14 @@ namespace ragedb {
     bool NodeTypes::ValidNodeId(uint16_t type_id, uint64_t internal_id) {
         // If the type is valid, is the internal id within the vector size and is it not deleted?
         if (ValidTypeId(type_id)) {
-            return key_to_node_id[type_id].size() > internal_id && !deleted_ids[type_id].contains(internal_id);
+            return keys[type_id].slots() > internal_id && !deleted_ids[type_id].contains(internal_id);
         }
         return false;
     }
 
     uint64_t NodeTypes::getCount(uint16_t type_id) {
         if (ValidTypeId(type_id)) {
-            return key_to_node_id[type_id].size() - deleted_ids[type_id].cardinality();
+            return keys[type_id].slots() - deleted_ids[type_id].cardinality();
         }
         // If not valid return 0
         return 0;
@@ -406,40 +470,27 @@ namespace ragedb {
     std::map<uint16_t,uint64_t> NodeTypes::getCounts() {
         std::map<uint16_t,uint64_t> counts;
         for (size_t type_id=1; type_id < type_to_id.size(); type_id++) {
-            counts.insert({type_id, key_to_node_id[type_id].size() - deleted_ids[type_id].cardinality()});
+            counts.insert({type_id, keys[type_id].slots() - deleted_ids[type_id].cardinality()});
         }
 
         return counts;
     }
 
-    tsl::sparse_map<std::string, uint64_t> &NodeTypes::getKeysToNodeId(uint16_t type_id) {
-        return key_to_node_id[type_id];
-    }
-
     uint64_t NodeTypes::getNodeId(uint16_t type_id, const std::string& key) {
-        if(ValidTypeId(type_id)) {
-            auto key_search = key_to_node_id[type_id].find(key);
-            if (key_search != std::end(key_to_node_id[type_id])) {
-                return key_search->second;
-            }
+        uint64_t internal_id;
+        if(ValidTypeId(type_id) && keys[type_id].find(key, internal_id)) {
+            return internalToExternal(type_id, internal_id);
         }
         return 0;
     }
 
     uint64_t NodeTypes::getNodeId(const std::string& type, const std::string& key) {
-        uint16_t type_id = getTypeId(type);
-        if(ValidTypeId(type_id)) {
-            auto key_search = key_to_node_id[type_id].find(key);
-            if (key_search != std::end(key_to_node_id[type_id])) {
-                return key_search->second;
-            }
-        }
-        return 0;
+        return getNodeId(getTypeId(type), key);
     }
 
     std::string NodeTypes::getNodeKey(uint16_t type_id, uint64_t internal_id) {
         if(ValidTypeId(type_id)) {
-            return keys[type_id][internal_id];
+            return std::string(keys[type_id].get(internal_id));
         }
         return id_to_type[0];
     }
@@ -451,16 +502,23 @@ namespace ragedb {
         return std::map<std::string, std::any>();
     }
 
+    PropertyRecord NodeTypes::getNodePropertyRecord(uint16_t type_id, uint64_t internal_id) {
+        if(ValidTypeId(type_id)) {
+            return properties[type_id].getPropertyRecord(internal_id);
+        }
+        return PropertyRecord();
+    }
+
     Node NodeTypes::getNode(uint64_t external_id) {
         return getNode(externalToTypeId(external_id), externalToInternal(external_id), external_id);
     }
 
     Node NodeTypes::getNode(uint16_t type_id, uint64_t internal_id) {
-        return Node( internalToExternal(type_id, internal_id), getType(type_id), getKeys(type_id)[internal_id], getNodeProperties(type_id, internal_id));
+        return Node( internalToExternal(type_id, internal_id), getType(type_id), std::string(keys[type_id].get(internal_id)), getNodePropertyRecord(type_id, internal_id));
     }
 
     Node NodeTypes::getNode(uint16_t type_id, uint64_t internal_id, uint64_t external_id) {
-        return Node( external_id, getType(type_id), getKeys(type_id)[internal_id], getNodeProperties(type_id, internal_id));
+        return Node( external_id, getType(type_id), std::string(keys[type_id].get(internal_id)), getNodePropertyRecord(type_id, internal_id));
     }
 
     std::any NodeTypes::getNodeProperty(uint16_t type_id, uint64_t internal_id, const std::string &property) {
@@ -480,36 +538,77 @@ namespace ragedb {
         return properties[type_id];
     }
 
+    /**
+     * Find the nodes of a type by the value of a property
+     *
+     * @param type_id node type id
+     * @param property property to look at
+     * @param operation comparison
+     * @param value value to compare to
+     * @return internal ids of the nodes that match
+     */
+    Roaring64Map NodeTypes::findIds(uint16_t type_id, const std::string &property, Operation operation, const std::any &value) {
+        if (!ValidTypeId(type_id)) {
+            return Roaring64Map();
+        }
+        Roaring64Map ids = properties[type_id].findIds(property, operation, value);
+        // Deleted nodes keep tombstones in their rows until they are reused
+        ids -= deleted_ids[type_id];
+        return ids;
+    }
+
+    Roaring64Map NodeTypes::findIds(uint16_t type_id, const std::vector<Condition> &conditions) {
+        if (!ValidTypeId(type_id)) {
+            return Roaring64Map();
+        }
+        Roaring64Map ids;
+        if (conditions.empty()) {
+            ids.addRange(0, keys[type_id].slots());
+        } else {
+            ids = properties[type_id].findIds(conditions);
+        }
+        ids -= deleted_ids[type_id];
+        return ids;
+    }
+
+    Aggregations NodeTypes::aggregate(uint16_t type_id, const std::string &property, const std::string &group_by, const std::vector<Condition> &conditions) {
+        if (!ValidTypeId(type_id)) {
+            return Aggregations();
+        }
+        return properties[type_id].aggregate(property, group_by, findIds(type_id, conditions));
+    }
+
     bool NodeTypes::setNodeProperty(uint16_t type_id, uint64_t internal_id, const std::string &property, const std::any& value) {
         // find out what data_type property is supposed to be, cast value to that.
 
-        switch (properties[type_id].getPropertyTypeId(property)) {
+        uint16_t property_id = properties[type_id].getPropertyId(property);
+        switch (properties[type_id].getPropertyTypeId(property_id)) {
             case Properties::getBooleanPropertyType(): {
-                return properties[type_id].setBooleanProperty(property, internal_id, std::any_cast<bool>(value));
+                return properties[type_id].setBooleanProperty(property_id, internal_id, std::any_cast<bool>(value));
             }
             case Properties::getIntegerPropertyType(): {
-                return properties[type_id].setIntegerProperty(property, internal_id, std::any_cast<int64_t>(value));
+                return properties[type_id].setIntegerProperty(property_id, internal_id, std::any_cast<int64_t>(value));
             }
             case Properties::getDoublePropertyType(): {
-                return properties[type_id].setDoubleProperty(property, internal_id, std::any_cast<double>(value));
+                return properties[type_id].setDoubleProperty(property_id, internal_id, std::any_cast<double>(value));
             }
             case Properties::getStringPropertyType(): {
                 if (value.type() != typeid(std::string)) {
-                    return properties[type_id].setStringProperty(property, internal_id, std::string(std::any_cast<const char*>(value)));
+                    return properties[type_id].setStringProperty(property_id, internal_id, std::string(std::any_cast<const char*>(value)));
                 }
-                return properties[type_id].setStringProperty(property, internal_id, std::any_cast<std::string>(value));
+                return properties[type_id].setStringProperty(property_id, internal_id, std::any_cast<std::string>(value));
             }
             case Properties::getBooleanListPropertyType(): {
-                return properties[type_id].setListOfBooleanProperty(property, internal_id, std::any_cast<std::vector<bool>>(value));
+                return properties[type_id].setListOfBooleanProperty(property_id, internal_id, std::any_cast<std::vector<bool>>(value));
             }
             case Properties::getIntegerListPropertyType(): {
-                return properties[type_id].setListOfIntegerProperty(property, internal_id, std::any_cast<std::vector<int64_t>>(value));
+                return properties[type_id].setListOfIntegerProperty(property_id, internal_id, std::any_cast<std::vector<int64_t>>(value));
             }
             case Properties::getDoubleListPropertyType(): {
-                return properties[type_id].setListOfDoubleProperty(property, internal_id, std::any_cast<std::vector<double>>(value));
+                return properties[type_id].setListOfDoubleProperty(property_id, internal_id, std::any_cast<std::vector<double>>(value));
             }
             case Properties::getStringListPropertyType(): {
-                return properties[type_id].setListOfStringProperty(property, internal_id, std::any_cast<std::vector<std::string>>(value));
+                return properties[type_id].setListOfStringProperty(property_id, internal_id, std::any_cast<std::vector<std::string>>(value));
             }
         }
         return false;
@@ -524,48 +623,49 @@ namespace ragedb {
             simdjson::dom::element value;
             simdjson::error_code error = parser.parse(json).get(value);
             if (error == 0U) {
-                uint16_t data_type_id = properties[type_id].getPropertyTypeId(property);
+                uint16_t property_id = properties[type_id].getPropertyId(property);
+                uint16_t data_type_id = properties[type_id].getPropertyTypeId(property_id);
                 switch (data_type_id) {
                     case Properties::getBooleanPropertyType(): {
-                        return properties[type_id].setBooleanProperty(property, internal_id, bool(value));
+                        return properties[type_id].setBooleanProperty(property_id, internal_id, bool(value));
                     }
                     case Properties::getIntegerPropertyType(): {
-                        return properties[type_id].setIntegerProperty(property, internal_id,
+                        return properties[type_id].setIntegerProperty(property_id, internal_id,
                                                                       static_cast<std::make_signed_t<uint64_t>>(value));
                     }
                     case Properties::getDoublePropertyType(): {
-                        return properties[type_id].setDoubleProperty(property, internal_id, double(value));
+                        return properties[type_id].setDoubleProperty(property_id, internal_id, double(value));
                     }
                     case Properties::getStringPropertyType(): {
-                        return properties[type_id].setStringProperty(property, internal_id, std::string(value));
+                        return properties[type_id].setStringProperty(property_id, internal_id, std::string(value));
                     }
                     case Properties::getBooleanListPropertyType(): {
                         std::vector<bool> bool_vector;
                         for (simdjson::dom::element child : simdjson::dom::array(value)) {
                             bool_vector.emplace_back(bool(child));
                         }
-                        return properties[type_id].setListOfBooleanProperty(property, internal_id, bool_vector);
+                        return properties[type_id].setListOfBooleanProperty(property_id, internal_id, bool_vector);
                     }
                     case Properties::getIntegerListPropertyType(): {
                         std::vector<int64_t> int_vector;
                         for (simdjson::dom::element child : simdjson::dom::array(value)) {
                             int_vector.emplace_back(int64_t(child));
                         }
-                        return properties[type_id].setListOfIntegerProperty(property, internal_id, int_vector);
+                        return properties[type_id].setListOfIntegerProperty(property_id, internal_id, int_vector);
                     }
                     case Properties::getDoubleListPropertyType(): {
                         std::vector<double> double_vector;
                         for (simdjson::dom::element child : simdjson::dom::array(value)) {
                             double_vector.emplace_back(double(child));
                         }
-                        return properties[type_id].setListOfDoubleProperty(property, internal_id, double_vector);
+                        return properties[type_id].setListOfDoubleProperty(property_id, internal_id, double_vector);
                     }
                     case Properties::getStringListPropertyType(): {
                         std::vector<std::string> string_vector;
                         for (simdjson::dom::element child : simdjson::dom::array(value)) {
                             string_vector.emplace_back(child);
                         }
-                        return properties[type_id].setListOfStringProperty(property, internal_id, string_vector);
+                        return properties[type_id].setListOfStringProperty(property_id, internal_id, string_vector);
                     }
                     default: {
                         return false;
@@ -589,23 +689,24 @@ namespace ragedb {
             if (!error) {
                 // Add the node properties
                 for (auto[key, value] : object) {
-                    auto property = static_cast<std::string>(key);
+                    // Look the key up once, the setters below work on its id
+                    uint16_t property_id = properties[type_id].getPropertyId(static_cast<std::string>(key));
                     switch (value.type()) {
                         case simdjson::dom::element_type::INT64:
-                            properties[type_id].setIntegerProperty(property, internal_id, int64_t(value));
+                            properties[type_id].setIntegerProperty(property_id, internal_id, int64_t(value));
                             break;
                         case simdjson::dom::element_type::UINT64:
                             // Unsigned Integer Values are not allowed, convert to signed
-                            properties[type_id].setIntegerProperty(property, internal_id, static_cast<std::make_signed_t<uint64_t>>(value));
+                            properties[type_id].setIntegerProperty(property_id, internal_id, static_cast<std::make_signed_t<uint64_t>>(value));
                             break;
                         case simdjson::dom::element_type::DOUBLE:
-                            properties[type_id].setDoubleProperty(property, internal_id, double(value));
+                            properties[type_id].setDoubleProperty(property_id, internal_id, double(value));
                             break;
                         case simdjson::dom::element_type::STRING:
-                            properties[type_id].setStringProperty(property, internal_id, std::string(value));
+                            properties[type_id].setStringProperty(property_id, internal_id, std::string(value));
                             break;
                         case simdjson::dom::element_type::BOOL:
-                            properties[type_id].setBooleanProperty(property, internal_id, bool(value));
+                            properties[type_id].setBooleanProperty(property_id, internal_id, bool(value));
                             break;
                         case simdjson::dom::element_type::NULL_VALUE:
                             // Null Values are not allowed, just ignore them
@@ -631,31 +732,31 @@ namespace ragedb {
                                         for (simdjson::dom::element child : simdjson::dom::array(value)) {
                                             int_vector.emplace_back(int64_t(child));
                                         }
-                                        properties[type_id].setListOfIntegerProperty(property, internal_id, int_vector);
+                                        properties[type_id].setListOfIntegerProperty(property_id, internal_id, int_vector);
                                         break;
                                     case simdjson::dom::element_type::UINT64:
                                         for (simdjson::dom::element child : simdjson::dom::array(value)) {
                                             int_vector.emplace_back(static_cast<std::make_signed_t<uint64_t>>(child));
                                         }
-                                        properties[type_id].setListOfIntegerProperty(property, internal_id, int_vector);
+                                        properties[type_id].setListOfIntegerProperty(property_id, internal_id, int_vector);
                                         break;
                                     case simdjson::dom::element_type::DOUBLE:
                                         for (simdjson::dom::element child : simdjson::dom::array(value)) {
                                             double_vector.emplace_back(double(child));
                                         }
-                                        properties[type_id].setListOfDoubleProperty(property, internal_id, double_vector);
+                                        properties[type_id].setListOfDoubleProperty(property_id, internal_id, double_vector);
                                         break;
                                     case simdjson::dom::element_type::STRING:
                                         for (simdjson::dom::element child : simdjson::dom::array(value)) {
                                             string_vector.emplace_back(child);
                                         }
-                                        properties[type_id].setListOfStringProperty(property, internal_id, string_vector);
+                                        properties[type_id].setListOfStringProperty(property_id, internal_id, string_vector);
                                         break;
                                     case simdjson::dom::element_type::BOOL:
                                         for (simdjson::dom::element child : simdjson::dom::array(value)) {
                                             bool_vector.emplace_back(bool(child));
                                         }
-                                        properties[type_id].setListOfBooleanProperty(property, internal_id, bool_vector);
+                                        properties[type_id].setListOfBooleanProperty(property_id, internal_id, bool_vector);
                                         break;
                                     case simdjson::dom::element_type::NULL_VALUE:
                                         // Null Values are not allowed, just ignore them
@@ -683,7 +784,7 @@ namespace ragedb {
         return properties[type_id].deleteProperties(internal_id);
     }
 
-    std::vector<std::string>& NodeTypes::getKeys(uint16_t type_id) {
+    NodeKeys& NodeTypes::getKeys(uint16_t type_id) {
         return keys[type_id];
     }
 
@@ -695,4 +796,309 @@ namespace ragedb {
         return incoming_relationships[type_id];
     }
 
+    std::vector<uint64_t>& NodeTypes::getOutgoingDegrees(uint16_t type_id) {
+        return outgoing_degrees[type_id];
+    }
+
+    std::vector<uint64_t>& NodeTypes::getIncomingDegrees(uint16_t type_id) {
+        return incoming_degrees[type_id];
+    }
+
+    static void addLink(std::vector<Group> &groups, uint16_t rel_type_id, uint64_t node_id, uint64_t rel_id) {
+        auto group = std::find_if(std::begin(groups), std::end(groups), [rel_type_id] (const Group& g) { return g.rel_type_id == rel_type_id; } );
+        // See if the relationship type is already there
+        if (group != std::end(groups)) {
+            group->links.emplace_back(node_id, rel_id);
+        } else {
+            // otherwise create a new type with the links
+            groups.emplace_back(Group(rel_type_id, std::vector<Link>({Link(node_id, rel_id)})));
+        }
+    }
+
+    static uint64_t removeLinks(std::vector<Group> &groups, uint16_t rel_type_id, const std::function<bool(const Link&)> &predicate) {
+        auto group = std::find_if(std::begin(groups), std::end(groups), [rel_type_id] (const Group& g) { return g.rel_type_id == rel_type_id; } );
+        if (group == std::end(groups)) {
+            return 0;
+        }
+        return group->links.remove_if(predicate);
+    }
+
+    static uint64_t removeLinks(std::vector<Group> &groups, uint16_t rel_type_id, uint64_t node_id, const std::function<bool(const Link&)> &predicate) {
+        auto group = std::find_if(std::begin(groups), std::end(groups), [rel_type_id] (const Group& g) { return g.rel_type_id == rel_type_id; } );
+        if (group == std::end(groups)) {
+            return 0;
+        }
+        return group->links.remove_if(node_id, predicate);
+    }
+
+    static bool hasLink(const std::vector<Group> &groups, uint16_t rel_type_id, uint64_t node_id) {
+        auto group = std::find_if(std::begin(groups), std::end(groups), [rel_type_id] (const Group& g) { return g.rel_type_id == rel_type_id; } );
+        return group != std::end(groups) && group->links.contains(node_id);
+    }
+
+    static uint64_t groupSize(const std::vector<Group> &groups, uint16_t rel_type_id) {
+        auto group = std::find_if(std::begin(groups), std::end(groups), [rel_type_id] (const Group& g) { return g.rel_type_id == rel_type_id; } );
+        return group != std::end(groups) ? group->links.size() : 0;
+    }
+
+    /**
+     * Add a link to the outgoing relationships of a node and count it in its degree
+     *
+     * @param type_id node type id
+     * @param internal_id internal node id
+     * @param rel_type_id relationship type id
+     * @param node_id id of the node at the other end
+     * @param rel_id relationship id
+     */
+    void NodeTypes::addOutgoingLink(uint16_t type_id, uint64_t internal_id, uint16_t rel_type_id, uint64_t node_id, uint64_t rel_id) {
+        addLink(outgoing_relationships[type_id].at(internal_id), rel_type_id, node_id, rel_id);
+        outgoing_degrees[type_id][internal_id]++;
+    }
+
+    void NodeTypes::addIncomingLink(uint16_t type_id, uint64_t internal_id, uint16_t rel_type_id, uint64_t node_id, uint64_t rel_id) {
+        addLink(incoming_relationships[type_id].at(internal_id), rel_type_id, node_id, rel_id);
+        incoming_degrees[type_id][internal_id]++;
+    }
+
+    /**
+     * Remove the links of one relationship type of a node that match a predicate, and take them out of its degree
+     *
+     * @param type_id node type id
+     * @param internal_id internal node id
+     * @param rel_type_id relationship type id
+     * @param predicate called once per link, true to remove it
+     * @return number of links removed
+     */
+    uint64_t NodeTypes::removeOutgoingLinks(uint16_t type_id, uint64_t internal_id, uint16_t rel_type_id, const std::function<bool(const Link&)> &predicate) {
+        uint64_t count = removeLinks(outgoing_relationships[type_id].at(internal_id), rel_type_id, predicate);
+        outgoing_degrees[type_id][internal_id] -= count;
+        return count;
+    }
+
+    uint64_t NodeTypes::removeIncomingLinks(uint16_t type_id, uint64_t internal_id, uint16_t rel_type_id, const std::function<bool(const Link&)> &predicate) {
+        uint64_t count = removeLinks(incoming_relationships[type_id].at(internal_id), rel_type_id, predicate);
+        incoming_degrees[type_id][internal_id] -= count;
+        return count;
+    }
+
+    /**
+     * Remove the links of one relationship type of a node to another node that match a predicate.
+     * Only the links to the other node are looked at, found by binary search in large groups.
+     *
+     * @param type_id node type id
+     * @param internal_id internal node id
+     * @param rel_type_id relationship type id
+     * @param node_id id of the node at the other end
+     * @param predicate called once per link to the other node, true to remove it
+     * @return number of links removed
+     */
+    uint64_t NodeTypes::removeOutgoingLinks(uint16_t type_id, uint64_t internal_id, uint16_t rel_type_id, uint64_t node_id, const std::function<bool(const Link&)> &predicate) {
+        uint64_t count = removeLinks(outgoing_relationships[type_id].at(internal_id), rel_type_id, node_id, predicate);
+        outgoing_degrees[type_id][internal_id] -= count;
+        return count;
+    }
+
+    uint64_t NodeTypes::removeIncomingLinks(uint16_t type_id, uint64_t internal_id, uint16_t rel_type_id, uint64_t node_id, const std::function<bool(const Link&)> &predicate) {
+        uint64_t count = removeLinks(incoming_relationships[type_id].at(internal_id), rel_type_id, node_id, predicate);
+        incoming_degrees[type_id][internal_id] -= count;
+        return count;
+    }
+
+    /**
+     * Check for a link of one relationship type from a node to another node
+     *
+     * @param type_id node type id
+     * @param internal_id internal node id
+     * @param direction OUT for outgoing links, IN for incoming links, BOTH for either
+     * @param rel_type_id relationship type id
+     * @param node_id id of the node at the other end
+     * @return true if there is such a link
+     */
+    bool NodeTypes::hasLinkTo(uint16_t type_id, uint64_t internal_id, Direction direction, uint16_t rel_type_id, uint64_t node_id) const {
+        if (direction != IN && hasLink(outgoing_relationships[type_id].at(internal_id), rel_type_id, node_id)) {
+            return true;
+        }
+        return direction != OUT && hasLink(incoming_relationships[type_id].at(internal_id), rel_type_id, node_id);
+    }
+
+    /**
+     * Drop every link of a node, once its counterparts have been taken care of
+     *
+     * @param type_id node type id
+     * @param internal_id internal node id
+     */
+    void NodeTypes::clearLinks(uint16_t type_id, uint64_t internal_id) {
+        outgoing_relationships[type_id].at(internal_id).clear();
+        incoming_relationships[type_id].at(internal_id).clear();
+        outgoing_degrees[type_id][internal_id] = 0;
+        incoming_degrees[type_id][internal_id] = 0;
+    }
+
+    /**
+     * Number of relationships of a node without looking at its links
+     *
+     * @param type_id node type id
+     * @param internal_id internal node id
+     * @param direction direction of the relationships
+     * @return degree of the node
+     */
+    uint64_t NodeTypes::getDegree(uint16_t type_id, uint64_t internal_id, Direction direction) const {
+        uint64_t count = 0;
+        // Use the two ifs to handle ALL for a direction
+        if (direction != IN) {
+            count += outgoing_degrees[type_id].at(internal_id);
+        }
+        if (direction != OUT) {
+            count += incoming_degrees[type_id].at(internal_id);
+        }
+        return count;
+    }
+
+    uint64_t NodeTypes::getDegree(uint16_t type_id, uint64_t internal_id, Direction direction, uint16_t rel_type_id) const {
+        uint64_t count = 0;
+        if (direction != IN) {
+            count += groupSize(outgoing_relationships[type_id].at(internal_id), rel_type_id);
+        }
+        if (direction != OUT) {
+            count += groupSize(incoming_relationships[type_id].at(internal_id), rel_type_id);
+        }
+        return count;
+    }
+
+    static uint64_t freezeGroups(std::vector<Group> &groups, FrozenLinks &frozen) {
+        // Pack the links of a node in relationship type order
+        std::sort(std::begin(groups), std::end(groups), [] (const Group& a, const Group& b) { return a.rel_type_id < b.rel_type_id; });
+        uint64_t count = 0;
+        for (auto &group : groups) {
+            group.links.freeze(frozen);
+            count += group.links.size();
+        }
+        groups.shrink_to_fit();
+        return count;
+    }
+
+    /**
+     * Pack the links of a node into the blocks of a freeze in progress
+     *
+     * @param type_id node type id
+     * @param internal_id internal node id
+     * @param outgoing blocks for the outgoing links
+     * @param incoming blocks for the incoming links
+     * @return number of links packed
+     */
+    uint64_t NodeTypes::freezeNode(uint16_t type_id, uint64_t internal_id, FrozenLinks &outgoing, FrozenLinks &incoming) {
+        return freezeGroups(outgoing_relationships[type_id].at(internal_id), outgoing)
+               + freezeGroups(incoming_relationships[type_id].at(internal_id), incoming);
+    }
+
+    /**
+     * Finish a freeze by keeping its blocks and releasing the blocks of the previous one
+     *
+     * @param type_id node type id
+     * @param outgoing blocks every outgoing link of the type was packed into
+     * @param incoming blocks every incoming link of the type was packed into
+     * @return false if the type was cleared while the freeze was running, along with the links pointing into the blocks
+     */
+    bool NodeTypes::setFrozenLinks(uint16_t type_id, FrozenLinks outgoing, FrozenLinks incoming) {
+        if (!ValidTypeId(type_id)) {
+            return false;
+        }
+        // Every valid type has a place for its blocks, throw rather than leave its links pointing at released ones
+        frozen_outgoing.at(type_id) = std::move(outgoing);
+        frozen_incoming.at(type_id) = std::move(incoming);
+        return true;
+    }
+
+    bool NodeTypes::isFrozen(uint16_t type_id) const {
+        return type_id < frozen_outgoing.size() && (!frozen_outgoing[type_id].empty() || !frozen_incoming[type_id].empty());
+    }
+
+    /**
+     * Make room for count more nodes of a type before adding them in a batch
+     *
+     * @param type_id node type id
+     * @param count number of nodes about to be added
+     */
+    void NodeTypes::reserve(uint16_t type_id, uint64_t count) {
+        // Grow at least geometrically, so a long run of batches stays amortized linear
+        keys[type_id].reserve(count);
+        uint64_t needed = outgoing_relationships[type_id].size() + count;
+        if (outgoing_relationships[type_id].capacity() < needed) {
+            uint64_t capacity = std::max(needed, 2 * static_cast<uint64_t>(outgoing_relationships[type_id].capacity()));
+            outgoing_relationships[type_id].reserve(capacity);
+            incoming_relationships[type_id].reserve(capacity);
+            outgoing_degrees[type_id].reserve(capacity);
+            incoming_degrees[type_id].reserve(capacity);
+        }
+    }
+
+    /**
+     * Give back the memory held by the deleted nodes of a type. Deleted ids past the last live node
+     * are dropped: the next node added would take the lowest of them anyway, so the ids handed out
+     * and the ids of live nodes stay the same. Deleted ids in between keep their slot until they are
+     * reused, but not the links they held. Key bytes and string values of deleted nodes are packed away
+     * once they are a quarter of their arena or dictionary, so a type with little garbage costs next to nothing.
+     *
+     * @param type_id node type id
+     * @param pause called every so many keys, properties and deleted ids so a long compaction can give way to other work
+     * @return number of deleted ids dropped from the end of the type
+     */
+    uint64_t NodeTypes::compact(uint16_t type_id, const std::function<void()> &pause) {
+        if (!ValidTypeId(type_id)) {
+            return 0;
+        }
+        uint64_t slots = keys[type_id].slots();
+        uint64_t end = slots;
+        while (end > 0 && deleted_ids[type_id].contains(end - 1)) {
+            end--;
+        }
+        // Cut the end off everything before the first pause, a node added during one takes internal id end
+        if (end < slots) {
+            for (uint64_t internal_id = end; internal_id < slots; internal_id++) {
+                deleted_ids[type_id].remove(internal_id);
+            }
+            deleted_ids[type_id].runOptimize();
+            deleted_ids[type_id].shrinkToFit();
+            outgoing_relationships[type_id].resize(end);
+            incoming_relationships[type_id].resize(end);
+            outgoing_degrees[type_id].resize(end);
+            incoming_degrees[type_id].resize(end);
+            // Keep the room of a recent growth, only give back memory once less than half of it is used
+            if (end * 2 < outgoing_relationships[type_id].capacity()) {
+                outgoing_relationships[type_id].shrink_to_fit();
+                incoming_relationships[type_id].shrink_to_fit();
+                outgoing_degrees[type_id].shrink_to_fit();
+                incoming_degrees[type_id].shrink_to_fit();
+            }
+            keys[type_id].truncate(end);
+            properties[type_id].truncate(end);
+        }
+
+        // Keys and properties move when a type is added, so they are packed in steps and looked up again after each pause
+        while (ValidTypeId(type_id) && !keys[type_id].compact(1024)) {
+            pause();
+        }
+        for (uint16_t property_id = 1; ValidTypeId(type_id) && properties[type_id].compact(property_id); property_id++) {
+            pause();
+        }
+        if (!ValidTypeId(type_id) || deleted_ids[type_id].isEmpty()) {
+            return slots - end;
+        }
+
+        // Work on a copy, nodes may be added or removed during a pause
+        Roaring64Map holes = deleted_ids[type_id];
+        uint64_t done = 0;
+        for (Roaring64MapSetBitForwardIterator iterator = holes.begin(); iterator != holes.end(); ++iterator) {
+            uint64_t internal_id = *iterator;
+            if (ValidTypeId(type_id) && internal_id < outgoing_relationships[type_id].size() && deleted_ids[type_id].contains(internal_id)) {
+                std::vector<Group>().swap(outgoing_relationships[type_id][internal_id]);
+                std::vector<Group>().swap(incoming_relationships[type_id][internal_id]);
+            }
+            if ((++done & 1023U) == 0) {
+                pause();
+            }
+        }
+        return slots - end;
+    }
+
 }
\ No newline at end of file
@@ -18,10 +18,14 @@
 #define RAGEDB_NODETYPES_H
 
 #include <cstdint>
+#include <functional>
 #include <roaring/roaring64map.hh>
 #include <set>
+#include "Cursor.h"
+#include "Direction.h"
 #include "Group.h"
 #include "Node.h"
+#include "NodeKeys.h"
 #include "Properties.h"
 
 namespace ragedb {
@@ -30,12 +34,15 @@ namespace ragedb {
     private:
         std::unordered_map<std::string, uint16_t> type_to_id;
         std::vector<std::string> id_to_type;
-        std::vector<tsl::sparse_map<std::string, uint64_t>> key_to_node_id;  // "Index" to get node id by type:key
-        std::vector<std::vector<std::string>> keys;                          // Store of the keys of Nodes
+        std::vector<NodeKeys> keys;                                          // Keys of Nodes and the index to get node id by type:key
         std::vector<Properties> properties;                             // Store of the properties of Nodes
         std::vector<std::vector<std::vector<Group>>> outgoing_relationships; // Outgoing relationships of each node
         std::vector<std::vector<std::vector<Group>>> incoming_relationships; // Incoming relationships of each node
+        std::vector<std::vector<uint64_t>> outgoing_degrees;                 // Outgoing relationship count of each node
+        std::vector<std::vector<uint64_t>> incoming_degrees;                 // Incoming relationship count of each node
         std::vector<Roaring64Map> deleted_ids; // all links are internal links
+        std::vector<FrozenLinks> frozen_outgoing;                            // Packed outgoing links of frozen types
+        std::vector<FrozenLinks> frozen_incoming;                            // Packed incoming links of frozen types
 
         simdjson::dom::parser parser;
         uint shard_id;
@@ -43,10 +50,13 @@ namespace ragedb {
         uint64_t internalToExternal(uint16_t type_id, uint64_t internal_id) const;
         static uint64_t externalToInternal(uint64_t id);
         static uint16_t externalToTypeId(uint64_t id);
+        void addTypeStorage();
 
     public:
         NodeTypes();
         void Clear();
+        void writeSnapshot(SnapshotWriter &writer) const;
+        bool readSnapshot(SnapshotReader &reader);
 
         bool addTypeId(const std::string &type, uint16_t type_id);
         uint16_t getTypeId(const std::string &type);
@@ -59,6 +69,8 @@ namespace ragedb {
         bool removeId(uint16_t type_id, uint64_t internal_id);
         bool containsId(uint16_t type_id, uint64_t internal_id);
 
+        std::vector<uint64_t> getInternalIds(uint16_t type_id, uint64_t from, uint64_t limit) const;
+        std::vector<uint64_t> skipInternalIds(uint16_t type_id, uint64_t skip, uint64_t limit) const;
         std::vector<uint64_t> getIds(uint64_t skip, uint64_t limit) const;
         std::vector<uint64_t> getIds(uint16_t type_id, uint64_t skip, uint64_t limit);
         std::vector<Node> getNodes(uint64_t skip, uint64_t limit);
@@ -84,6 +96,7 @@ namespace ragedb {
         uint64_t getNodeId(const std::string &type, const std::string &key);
         std::string getNodeKey(uint16_t type_id, uint64_t internal_id);
         std::map<std::string, std::any> getNodeProperties(uint16_t type_id, uint64_t internal_id);
+        PropertyRecord getNodePropertyRecord(uint16_t type_id, uint64_t internal_id);
         Node getNode(uint64_t external_id);
         Node getNode(uint16_t type_id, uint64_t internal_id);
         Node getNode(uint16_t type_id, uint64_t internal_id, uint64_t external_id);
@@ -97,13 +110,34 @@ namespace ragedb {
         bool deleteNodeProperty(uint64_t external_id, const std::string &property);
 
         Properties &getNodeTypeProperties(uint16_t type_id);
+        Roaring64Map findIds(uint16_t type_id, const std::string &property, Operation operation, const std::any &value);
+        Roaring64Map findIds(uint16_t type_id, const std::vector<Condition> &conditions);
+        Aggregations aggregate(uint16_t type_id, const std::string &property, const std::string &group_by, const std::vector<Condition> &conditions);
         bool setPropertiesFromJSON(uint16_t type_id, uint64_t internal_id, const std::string &json);
         bool deleteProperties(uint16_t type_id, uint64_t internal_id);
 
-        tsl::sparse_map<std::string, uint64_t> &getKeysToNodeId(uint16_t type_id);
-        std::vector<std::string> &getKeys(uint16_t type_id);
+        NodeKeys &getKeys(uint16_t type_id);
         std::vector<std::vector<Group>> &getOutgoingRelationships(uint16_t type_id);
         std::vector<std::vector<Group>> &getIncomingRelationships(uint16_t type_id);
+        std::vector<uint64_t> &getOutgoingDegrees(uint16_t type_id);
+        std::vector<uint64_t> &getIncomingDegrees(uint16_t type_id);
+        void reserve(uint16_t type_id, uint64_t count);
+        uint64_t compact(uint16_t type_id, const std::function<void()> &pause = [] {});
+
+        void addOutgoingLink(uint16_t type_id, uint64_t internal_id, uint16_t rel_type_id, uint64_t node_id, uint64_t rel_id);
+        void addIncomingLink(uint16_t type_id, uint64_t internal_id, uint16_t rel_type_id, uint64_t node_id, uint64_t rel_id);
+        uint64_t removeOutgoingLinks(uint16_t type_id, uint64_t internal_id, uint16_t rel_type_id, const std::function<bool(const Link&)> &predicate);
+        uint64_t removeIncomingLinks(uint16_t type_id, uint64_t internal_id, uint16_t rel_type_id, const std::function<bool(const Link&)> &predicate);
+        uint64_t removeOutgoingLinks(uint16_t type_id, uint64_t internal_id, uint16_t rel_type_id, uint64_t node_id, const std::function<bool(const Link&)> &predicate);
+        uint64_t removeIncomingLinks(uint16_t type_id, uint64_t internal_id, uint16_t rel_type_id, uint64_t node_id, const std::function<bool(const Link&)> &predicate);
+        bool hasLinkTo(uint16_t type_id, uint64_t internal_id, Direction direction, uint16_t rel_type_id, uint64_t node_id) const;
+        void clearLinks(uint16_t type_id, uint64_t internal_id);
+        uint64_t getDegree(uint16_t type_id, uint64_t internal_id, Direction direction) const;
+        uint64_t getDegree(uint16_t type_id, uint64_t internal_id, Direction direction, uint16_t rel_type_id) const;
+
+        uint64_t freezeNode(uint16_t type_id, uint64_t internal_id, FrozenLinks &outgoing, FrozenLinks &incoming);
+        bool setFrozenLinks(uint16_t type_id, FrozenLinks outgoing, FrozenLinks incoming);
+        bool isFrozen(uint16_t type_id) const;
     };
 }
 
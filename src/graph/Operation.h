@@ -0,0 +1,95 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RAGEDB_OPERATION_H
+#define RAGEDB_OPERATION_H
+
+#include <any>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ragedb {
+
+    enum class Operation : uint8_t {
+        UNKNOWN, EQ, NEQ, GT, GTE, LT, LTE
+    };
+
+    // One comparison of a filter, a filter matches when all of its conditions do
+    struct Condition {
+        std::string property;
+        Operation operation;
+        std::any value;
+    };
+
+    /**
+     * Parse a comparison as written in Lua scripts and HTTP requests, either as a symbol or a name
+     *
+     * @param operation "==", "!=", ">", ">=", "<", "<=" or "EQ", "NEQ", "GT", "GTE", "LT", "LTE"
+     * @return the Operation, UNKNOWN if it is not one of the above
+     */
+    inline Operation ParseOperation(const std::string &operation) {
+        if (operation == "==" || operation == "EQ") {
+            return Operation::EQ;
+        }
+        if (operation == "!=" || operation == "NEQ") {
+            return Operation::NEQ;
+        }
+        if (operation == ">" || operation == "GT") {
+            return Operation::GT;
+        }
+        if (operation == ">=" || operation == "GTE") {
+            return Operation::GTE;
+        }
+        if (operation == "<" || operation == "LT") {
+            return Operation::LT;
+        }
+        if (operation == "<=" || operation == "LTE") {
+            return Operation::LTE;
+        }
+        return Operation::UNKNOWN;
+    }
+
+    /**
+     * Compare a stored value to the value of a query
+     *
+     * @param stored value of a property
+     * @param operation comparison to make
+     * @param value value asked for
+     * @return true if stored compares to value as asked
+     */
+    template<typename T>
+    bool Compare(const T &stored, Operation operation, const T &value) {
+        switch (operation) {
+            case Operation::EQ:
+                return stored == value;
+            case Operation::NEQ:
+                return stored != value;
+            case Operation::GT:
+                return stored > value;
+            case Operation::GTE:
+                return stored >= value;
+            case Operation::LT:
+                return stored < value;
+            case Operation::LTE:
+                return stored <= value;
+            default:
+                return false;
+        }
+    }
+}
+
+#endif //RAGEDB_OPERATION_H
@@ -0,0 +1,40 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RAGEDB_PATH_H
+#define RAGEDB_PATH_H
+
+#include <cstdint>
+#include <vector>
+
+namespace ragedb {
+
+    // A relationship followed out of a node while looking for a path
+    struct PathStep {
+        uint64_t node_id;
+        uint64_t rel_id;
+        double weight;
+    };
+
+    // The nodes of a path in order and the relationships between them, empty when there is no path
+    struct Path {
+        std::vector<uint64_t> node_ids;
+        std::vector<uint64_t> rel_ids;
+        double weight = 0;
+    };
+}
+
+#endif //RAGEDB_PATH_H
@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <sstream>
+#include "Kernels.h"
 #include "Properties.h"
 
 namespace ragedb {
@@ -27,6 +30,177 @@ namespace ragedb {
     const static uint8_t double_list_type = 7;
     const static uint8_t string_list_type = 8;
 
+    template<typename Index, typename T>
+    static void unindexValue(Index &index, uint64_t row, const T &value) {
+        auto entry = index.find(value);
+        if (entry != index.end()) {
+            entry->second.remove(row);
+            if (entry->second.isEmpty()) {
+                index.erase(entry);
+            }
+        }
+    }
+
+    // Move a row of an indexed column to its new value, call before the column is written
+    template<typename Index, typename Column, typename T>
+    static void reindex(Index &index, const Column &column, uint64_t row, bool present, const T &value) {
+        if (present) {
+            unindexValue(index, row, static_cast<T>(column[row]));
+        }
+        index[value].add(row);
+    }
+
+    template<typename T, typename Index, typename Column>
+    static void buildIndex(Index &index, const Column &column, const std::vector<uint64_t> &valid) {
+        for (uint64_t row : SelectRows(valid)) {
+            index[static_cast<T>(column[row])].add(row);
+        }
+    }
+
+    template<typename T>
+    static Roaring64Map findInIndex(const std::map<T, Roaring64Map> &index, Operation operation, const T &value) {
+        Roaring64Map rows;
+        auto first = index.begin();
+        auto last = index.end();
+        switch (operation) {
+            case Operation::EQ: {
+                first = index.lower_bound(value);
+                last = index.upper_bound(value);
+                break;
+            }
+            case Operation::GT: {
+                first = index.upper_bound(value);
+                break;
+            }
+            case Operation::GTE: {
+                first = index.lower_bound(value);
+                break;
+            }
+            case Operation::LT: {
+                last = index.lower_bound(value);
+                break;
+            }
+            case Operation::LTE: {
+                last = index.upper_bound(value);
+                break;
+            }
+            case Operation::NEQ: {
+                break;
+            }
+            default: {
+                return rows;
+            }
+        }
+        for (auto entry = first; entry != last; ++entry) {
+            if (operation != Operation::NEQ || entry->first != value) {
+                rows |= entry->second;
+            }
+        }
+        return rows;
+    }
+
+    static Roaring64Map findInIndex(const std::unordered_map<std::string, Roaring64Map> &index, Operation operation, const std::string &value) {
+        if (operation == Operation::EQ) {
+            auto entry = index.find(value);
+            return entry != index.end() ? entry->second : Roaring64Map();
+        }
+        // Strings are hashed, anything but equality looks at every distinct value
+        Roaring64Map rows;
+        for (const auto &[stored, stored_rows] : index) {
+            if (Compare(stored, operation, value)) {
+                rows |= stored_rows;
+            }
+        }
+        return rows;
+    }
+
+    // Compare the values of the valid rows of a column in place, only at the candidate rows when given
+    template<typename Column, typename T>
+    static Roaring64Map scanColumn(const Column &column, Operation operation, const T &value, const std::vector<uint64_t> &valid,
+                                   const Roaring64Map *candidates) {
+        Roaring64Map rows;
+        if (candidates != nullptr) {
+            for (uint64_t row : *candidates) {
+                if (row >= column.size()) {
+                    break;
+                }
+                if (RowIsSet(valid, row) && Compare(static_cast<T>(column[row]), operation, value)) {
+                    rows.add(row);
+                }
+            }
+            return rows;
+        }
+        for (uint64_t row : SelectRows(valid)) {
+            if (Compare(static_cast<T>(column[row]), operation, value)) {
+                rows.add(row);
+            }
+        }
+        return rows;
+    }
+
+    template<typename Index, typename T>
+    static Roaring64Map findInIndex(const Index &index, Operation operation, const T &value, const Roaring64Map *candidates) {
+        Roaring64Map rows = findInIndex(index, operation, value);
+        if (candidates != nullptr) {
+            rows &= *candidates;
+        }
+        return rows;
+    }
+
+    static bool fromAny(const std::any &value, bool &converted) {
+        if (value.type() == typeid(bool)) {
+            converted = std::any_cast<bool>(value);
+            return true;
+        }
+        return false;
+    }
+
+    static bool fromAny(const std::any &value, int64_t &converted) {
+        if (value.type() == typeid(int64_t)) {
+            converted = std::any_cast<int64_t>(value);
+            return true;
+        }
+        if (value.type() == typeid(int)) {
+            converted = std::any_cast<int>(value);
+            return true;
+        }
+        // Numbers from Lua and json may arrive as doubles, only whole ones can match an integer
+        if (value.type() == typeid(double)) {
+            double number = std::any_cast<double>(value);
+            converted = static_cast<int64_t>(number);
+            return static_cast<double>(converted) == number;
+        }
+        return false;
+    }
+
+    static bool fromAny(const std::any &value, double &converted) {
+        if (value.type() == typeid(double)) {
+            converted = std::any_cast<double>(value);
+            return true;
+        }
+        if (value.type() == typeid(int64_t)) {
+            converted = static_cast<double>(std::any_cast<int64_t>(value));
+            return true;
+        }
+        if (value.type() == typeid(int)) {
+            converted = std::any_cast<int>(value);
+            return true;
+        }
+        return false;
+    }
+
+    static bool fromAny(const std::any &value, std::string &converted) {
+        if (value.type() == typeid(std::string)) {
+            converted = std::any_cast<std::string>(value);
+            return true;
+        }
+        if (value.type() == typeid(const char*)) {
+            converted = std::any_cast<const char*>(value);
+            return true;
+        }
+        return false;
+    }
+
     Properties::Properties()  {
         type_map = {
                 {"boolean",      getBooleanPropertyType()},
@@ -41,126 +215,145 @@ namespace ragedb {
 
         allowed_types = {"", "boolean", "integer", "double", "string", "boolean_list", "integer_list", "double_list", "string_list"};
 
-        types.insert({"", 0});
+        clear();
     }
 
     void Properties::clear() {
-        types.clear();
-        types.insert({"", 0});
-        booleans.clear();
-        integers.clear();
-        doubles.clear();
-        strings.clear();
-        booleans_list.clear();
-        integers_list.clear();
-        doubles_list.clear();
-        strings_list.clear();
+        // Property id 0 is the empty key, it has no type and an empty column
+        property_ids.clear();
+        property_keys.assign(1, "");
+        property_types.assign(1, 0);
+        booleans.assign(1, {});
+        integers.assign(1, {});
+        doubles.assign(1, {});
+        strings.assign(1, {});
+        booleans_list.assign(1, {});
+        integers_list.assign(1, {});
+        doubles_list.assign(1, {});
+        strings_list.assign(1, {});
+        validity.assign(1, {});
+        boolean_indexes.clear();
+        integer_indexes.clear();
+        double_indexes.clear();
+        string_indexes.clear();
     }
 
     std::map<std::string, std::string> Properties::getPropertyTypes() {
         std::map<std::string, std::string> map;
-        for (auto [type, type_id]: types) {
-            map.insert({type, allowed_types[type_id]});
+        for (const auto& [key, property_id] : property_ids) {
+            map.insert({key, allowed_types[property_types[property_id]]});
         }
-        map.erase("");
         return map;
     }
 
+    // The interned id of a property, 0 if there is no such property
+    uint16_t Properties::getPropertyId(const std::string &key) const {
+        auto search = property_ids.find(key);
+        if (search != property_ids.end()) {
+            return search->second;
+        }
+        return 0;
+    }
+
+    const std::string& Properties::getPropertyKey(uint16_t property_id) const {
+        if (property_id < property_keys.size()) {
+            return property_keys[property_id];
+        }
+        return property_keys[0];
+    }
+
     uint8_t Properties::getPropertyTypeId(const std::string& key) {
-        if (types.find(key) != types.end()) {
-            return types[key];
+        return getPropertyTypeId(getPropertyId(key));
+    }
+
+    uint8_t Properties::getPropertyTypeId(uint16_t property_id) const {
+        if (property_id < property_types.size()) {
+            return property_types[property_id];
         }
         return 0;
     }
 
+    bool Properties::isPropertyType(uint16_t property_id, uint8_t type_id) const {
+        return property_id > 0 && property_id < property_types.size() && property_types[property_id] == type_id;
+    }
+
     uint8_t Properties::setPropertyTypeId(const std::string &key, uint8_t property_type_id) {
-        if (types.find(key) != types.end()) {
-            if (types[key] == property_type_id) {
+        uint16_t property_id = getPropertyId(key);
+        if (property_id > 0) {
+            if (property_types[property_id] == property_type_id) {
                 return property_type_id;
             }
             // Type already exists and it is not what we asked for
             return 0;
         }
 
-        types.emplace(key, property_type_id);
+        if (property_type_id == 0 || property_type_id >= allowed_types.size()) {
+            return 0;
+        }
 
-        addPropertyTypeVectors(key, property_type_id);
+        addPropertyId(key, property_type_id);
 
         return property_type_id;
     }
 
-    void Properties::addPropertyTypeVectors(const std::string &key, uint8_t type_id) {
-        switch (type_id) {
-            case boolean_type: {
-                booleans.emplace(key, std::vector<bool>());
-                break;
-            }
-            case integer_type: {
-                integers.emplace(key, std::vector<int64_t>());
-                break;
-            }
-            case double_type: {
-                doubles.emplace(key, std::vector<double>());
-                break;
-            }
-            case string_type: {
-                strings.emplace(key, std::vector<std::string>());
-                break;
-            }
-            case boolean_list_type: {
-                booleans_list.emplace(key, std::vector<std::vector<bool>>());
-                break;
-            }
-            case integer_list_type: {
-                integers_list.emplace(key, std::vector<std::vector<int64_t>>());
-                break;
-            }
-            case double_list_type: {
-                doubles_list.emplace(key, std::vector<std::vector<double>>());
-                break;
-            }
-            case string_list_type: {
-                strings_list.emplace(key, std::vector<std::vector<std::string>>());
-                break;
-            }
-            default: {
-                return;
-            }
-        }
+    /**
+     * Intern a new property key, giving it the next property id and an empty column of its type.
+     * The ids of removed properties are not reused so ids held by callers never change meaning.
+     *
+     * @param key new property
+     * @param type_id data type of the property
+     * @return the property id
+     */
+    uint16_t Properties::addPropertyId(const std::string &key, uint8_t type_id) {
+        auto property_id = static_cast<uint16_t>(property_keys.size());
+        property_ids.emplace(key, property_id);
+        property_keys.emplace_back(key);
+        property_types.emplace_back(type_id);
+        booleans.emplace_back();
+        integers.emplace_back();
+        doubles.emplace_back();
+        strings.emplace_back();
+        booleans_list.emplace_back();
+        integers_list.emplace_back();
+        doubles_list.emplace_back();
+        strings_list.emplace_back();
+        validity.emplace_back();
+        return property_id;
     }
 
-    void Properties::removePropertyTypeVectors(const std::string &key, uint8_t type_id) {
-        switch (type_id) {
+    void Properties::removePropertyTypeVectors(uint16_t property_id) {
+        std::vector<uint64_t>().swap(validity[property_id]);
+        switch (property_types[property_id]) {
             case boolean_type: {
-                booleans.erase(key);
+                std::vector<bool>().swap(booleans[property_id]);
                 break;
             }
             case integer_type: {
-                integers.erase(key);
+                std::vector<int64_t>().swap(integers[property_id]);
                 break;
             }
             case double_type: {
-                doubles.erase(key);
+                std::vector<double>().swap(doubles[property_id]);
                 break;
             }
             case string_type: {
-                strings.erase(key);
+                strings[property_id] = StringColumn();
                 break;
             }
             case boolean_list_type: {
-                booleans_list.erase(key);
+                std::vector<std::vector<bool>>().swap(booleans_list[property_id]);
                 break;
             }
             case integer_list_type: {
-                integers_list.erase(key);
+                std::vector<std::vector<int64_t>>().swap(integers_list[property_id]);
                 break;
             }
             case double_list_type: {
-                doubles_list.erase(key);
+                std::vector<std::vector<double>>().swap(doubles_list[property_id]);
                 break;
             }
             case string_list_type: {
-                strings_list.erase(key);
+                std::vector<std::vector<std::string>>().swap(strings_list[property_id]);
                 break;
             }
             default: {
@@ -174,7 +367,7 @@ namespace ragedb {
         uint8_t type_id = 0;
         auto type_search = type_map.find(type);
         if (type_search != type_map.end()) {
-            type_id = type_map[type];
+            type_id = type_search->second;
         }
 
         if (type_id == 0) {
@@ -182,337 +375,336 @@ namespace ragedb {
             return 0;
         }
 
-        // See if we already have it set
-        if (types.find(key) != types.end()) {
-            if (types[key] == type_id) {
-                return type_id;
-            }
-            // Type already exists and it is not what we asked for
-            return 0;
+        return setPropertyTypeId(key, type_id);
+    }
+
+    bool Properties::removePropertyType(const std::string& key) {
+        uint16_t property_id = getPropertyId(key);
+        if (property_id > 0) {
+            removeIndex(key);
+            removePropertyTypeVectors(property_id);
+            property_types[property_id] = 0;
+            property_keys[property_id].clear();
+            property_ids.erase(key);
         }
+        return false;
+    }
+
+    bool Properties::getBooleanProperty(const std::string &key, uint64_t index) {
+        return getBooleanProperty(getPropertyId(key), index);
+    }
 
-        types.emplace(key, type_id);
+    int64_t Properties::getIntegerProperty(const std::string &key, uint64_t index) {
+        return getIntegerProperty(getPropertyId(key), index);
+    }
 
-        addPropertyTypeVectors(key, type_id);
+    double Properties::getDoubleProperty(const std::string &key, uint64_t index) {
+        return getDoubleProperty(getPropertyId(key), index);
+    }
 
-        return type_id;
+    std::string Properties::getStringProperty(const std::string &key, uint64_t index) {
+        return getStringProperty(getPropertyId(key), index);
     }
 
-    bool Properties::removePropertyType(const std::string& key) {
-        if (types.find(key) != types.end()) {
-            removePropertyTypeVectors(key, types[key]);
-            types.erase(key);
-        }
-        return false;
+    std::vector<bool> Properties::getListOfBooleanProperty(const std::string &key, uint64_t index) {
+        return getListOfBooleanProperty(getPropertyId(key), index);
     }
 
-    tsl::sparse_map<std::string, std::vector<bool>> &Properties::getAllBooleanProperties() {
-        return booleans;
+    std::vector<int64_t> Properties::getListOfIntegerProperty(const std::string &key, uint64_t index) {
+        return getListOfIntegerProperty(getPropertyId(key), index);
     }
 
-    bool Properties::getBooleanProperty(const std::string &key, uint64_t index) {
-        auto search = booleans.find(key);
+    std::vector<double> Properties::getListOfDoubleProperty(const std::string &key, uint64_t index) {
+        return getListOfDoubleProperty(getPropertyId(key), index);
+    }
 
-        if (search != booleans.end()) {
-            if (index < booleans[key].size()) {
-                return booleans[key][index];
-            }
+    std::vector<std::string> Properties::getListOfStringProperty(const std::string &key, uint64_t index) {
+        return getListOfStringProperty(getPropertyId(key), index);
+    }
+
+    bool Properties::getBooleanProperty(uint16_t property_id, uint64_t index) {
+        if (isPropertyType(property_id, boolean_type) && RowIsSet(validity[property_id], index)) {
+            return booleans[property_id][index];
         }
         return tombstone_boolean;
     }
 
-    int64_t Properties::getIntegerProperty(const std::string &key, uint64_t index) {
-        auto search = integers.find(key);
-
-        if (search != integers.end()) {
-            if (index < integers[key].size()) {
-                return integers[key][index];
-            }
+    int64_t Properties::getIntegerProperty(uint16_t property_id, uint64_t index) {
+        if (isPropertyType(property_id, integer_type) && RowIsSet(validity[property_id], index)) {
+            return integers[property_id][index];
         }
         return tombstone_int;
     }
 
-    double Properties::getDoubleProperty(const std::string &key, uint64_t index) {
-        auto search = doubles.find(key);
-
-        if (search != doubles.end()) {
-            if (index < doubles[key].size()) {
-                return doubles[key][index];
-            }
+    double Properties::getDoubleProperty(uint16_t property_id, uint64_t index) {
+        if (isPropertyType(property_id, double_type) && RowIsSet(validity[property_id], index)) {
+            return doubles[property_id][index];
         }
         return tombstone_double;
     }
 
-    std::string Properties::getStringProperty(const std::string &key, uint64_t index) {
-        auto search = strings.find(key);
-
-        if (search != strings.end()) {
-            if (index < strings[key].size()) {
-                return strings[key][index];
-            }
+    std::string Properties::getStringProperty(uint16_t property_id, uint64_t index) {
+        if (isPropertyType(property_id, string_type) && RowIsSet(validity[property_id], index)) {
+            return strings[property_id][index];
         }
         return tombstone_string;
     }
 
-    std::vector<bool> Properties::getListOfBooleanProperty(const std::string &key, uint64_t index) {
-        auto search = booleans_list.find(key);
-
-        if (search != booleans_list.end()) {
-            if (index < booleans_list[key].size()) {
-                return booleans_list[key][index];
-            }
+    std::vector<bool> Properties::getListOfBooleanProperty(uint16_t property_id, uint64_t index) {
+        if (isPropertyType(property_id, boolean_list_type) && RowIsSet(validity[property_id], index)) {
+            return booleans_list[property_id][index];
         }
         return tombstone_booleans_list;
     }
 
-    std::vector<int64_t> Properties::getListOfIntegerProperty(const std::string &key, uint64_t index) {
-        auto search = integers_list.find(key);
-
-        if (search != integers_list.end()) {
-            if (index < integers_list[key].size()) {
-                return integers_list[key][index];
-            }
+    std::vector<int64_t> Properties::getListOfIntegerProperty(uint16_t property_id, uint64_t index) {
+        if (isPropertyType(property_id, integer_list_type) && RowIsSet(validity[property_id], index)) {
+            return integers_list[property_id][index];
         }
         return tombstone_integers_list;
     }
 
-    std::vector<double> Properties::getListOfDoubleProperty(const std::string &key, uint64_t index) {
-        auto search = doubles_list.find(key);
-
-        if (search != doubles_list.end()) {
-            if (index < doubles_list[key].size()) {
-                return doubles_list[key][index];
-            }
+    std::vector<double> Properties::getListOfDoubleProperty(uint16_t property_id, uint64_t index) {
+        if (isPropertyType(property_id, double_list_type) && RowIsSet(validity[property_id], index)) {
+            return doubles_list[property_id][index];
         }
         return tombstone_doubles_list;
     }
 
-    std::vector<std::string> Properties::getListOfStringProperty(const std::string &key, uint64_t index) {
-        auto search = strings_list.find(key);
-
-        if (search != strings_list.end()) {
-            if (index < strings_list[key].size()) {
-                return strings_list[key][index];
-            }
+    std::vector<std::string> Properties::getListOfStringProperty(uint16_t property_id, uint64_t index) {
+        if (isPropertyType(property_id, string_list_type) && RowIsSet(validity[property_id], index)) {
+            return strings_list[property_id][index];
         }
         return tombstone_strings_list;
     }
 
     bool Properties::setBooleanProperty(const std::string &key, uint64_t index, bool value) {
-        if(types.empty()) {
-            return false;
-        }
-        auto type_check = types.find(key);
-        if (type_check == types.end()) {
+        return setBooleanProperty(getPropertyId(key), index, value);
+    }
+
+    bool Properties::setIntegerProperty(const std::string &key, uint64_t index, int64_t value) {
+        return setIntegerProperty(getPropertyId(key), index, value);
+    }
+
+    bool Properties::setDoubleProperty(const std::string &key, uint64_t index, double value) {
+        return setDoubleProperty(getPropertyId(key), index, value);
+    }
+
+    bool Properties::setStringProperty(const std::string &key, uint64_t index, const std::string &value) {
+        return setStringProperty(getPropertyId(key), index, value);
+    }
+
+    bool Properties::setListOfBooleanProperty(const std::string &key, uint64_t index, const std::vector<bool> &value) {
+        return setListOfBooleanProperty(getPropertyId(key), index, value);
+    }
+
+    bool Properties::setListOfIntegerProperty(const std::string &key, uint64_t index, const std::vector<int64_t> &value) {
+        return setListOfIntegerProperty(getPropertyId(key), index, value);
+    }
+
+    bool Properties::setListOfDoubleProperty(const std::string &key, uint64_t index, const std::vector<double> &value) {
+        return setListOfDoubleProperty(getPropertyId(key), index, value);
+    }
+
+    bool Properties::setListOfStringProperty(const std::string &key, uint64_t index, const std::vector<std::string> &value) {
+        return setListOfStringProperty(getPropertyId(key), index, value);
+    }
+
+    bool Properties::setBooleanProperty(uint16_t property_id, uint64_t index, bool value) {
+        if (!isPropertyType(property_id, boolean_type)) {
             return false;
         }
-        if (types[key] != boolean_type) {
-            return false;
+        std::vector<bool> &column = booleans[property_id];
+
+        auto index_search = boolean_indexes.find(property_id);
+        if (index_search != boolean_indexes.end()) {
+            reindex(index_search.value(), column, index, RowIsSet(validity[property_id], index), value);
         }
 
-        if (booleans[key].size() <= index) {
-            booleans[key].resize(1 + index);
+        if (column.size() <= index) {
+            column.resize(1 + index);
         }
-        booleans[key][index] = value;
+        column[index] = value;
+        SetRow(validity[property_id], index);
 
         return true;
     }
 
-    bool Properties::setIntegerProperty(const std::string &key, uint64_t index, int64_t value) {
-        if(types.empty()) {
-            return false;
-        }
-        auto type_check = types.find(key);
-        if (type_check == types.end()) {
+    bool Properties::setIntegerProperty(uint16_t property_id, uint64_t index, int64_t value) {
+        if (!isPropertyType(property_id, integer_type)) {
             return false;
         }
-        if (types[key] != integer_type) {
-            return false;
+        std::vector<int64_t> &column = integers[property_id];
+
+        auto index_search = integer_indexes.find(property_id);
+        if (index_search != integer_indexes.end()) {
+            reindex(index_search.value(), column, index, RowIsSet(validity[property_id], index), value);
         }
 
-        if (integers[key].size() <= index) {
-            integers[key].resize(1 + index);
+        if (column.size() <= index) {
+            column.resize(1 + index);
         }
-        integers[key][index] = value;
+        column[index] = value;
+        SetRow(validity[property_id], index);
 
         return true;
     }
 
-    bool Properties::setDoubleProperty(const std::string &key, uint64_t index, double value) {
-        if(types.empty()) {
-            return false;
-        }
-        auto type_check = types.find(key);
-        if (type_check == types.end()) {
+    bool Properties::setDoubleProperty(uint16_t property_id, uint64_t index, double value) {
+        if (!isPropertyType(property_id, double_type)) {
             return false;
         }
-        if (types[key] != double_type) {
-            return false;
+        std::vector<double> &column = doubles[property_id];
+
+        auto index_search = double_indexes.find(property_id);
+        if (index_search != double_indexes.end()) {
+            reindex(index_search.value(), column, index, RowIsSet(validity[property_id], index), value);
         }
 
-        if (doubles[key].size() <= index) {
-            doubles[key].resize(1 + index);
+        if (column.size() <= index) {
+            column.resize(1 + index);
         }
-        doubles[key][index] = value;
+        column[index] = value;
+        SetRow(validity[property_id], index);
 
         return true;
     }
 
-    bool Properties::setStringProperty(const std::string &key, uint64_t index, const std::string &value) {
-        if(types.empty()) {
-            return false;
-        }
-        if (types.find(key) == types.end()) {
+    bool Properties::setStringProperty(uint16_t property_id, uint64_t index, const std::string &value) {
+        if (!isPropertyType(property_id, string_type)) {
             return false;
         }
-        if (types[key] != string_type) {
-            return false;
+        StringColumn &column = strings[property_id];
+
+        auto index_search = string_indexes.find(property_id);
+        if (index_search != string_indexes.end()) {
+            reindex(index_search.value(), column, index, RowIsSet(validity[property_id], index), value);
         }
 
-        if (strings[key].size() <= index) {
-            strings[key].resize(1 + index);
+        if (column.size() <= index) {
+            column.resize(1 + index);
         }
-        strings[key][index] = value;
+        column.set(index, value);
+        SetRow(validity[property_id], index);
 
         return true;
     }
 
-    bool Properties::setListOfBooleanProperty(const std::string &key, uint64_t index, const std::vector<bool> &value) {
-        if(types.empty()) {
-            return false;
-        }
-        auto type_check = types.find(key);
-        if (type_check == types.end()) {
-            return false;
-        }
-        if (types[key] != boolean_list_type) {
+    bool Properties::setListOfBooleanProperty(uint16_t property_id, uint64_t index, const std::vector<bool> &value) {
+        if (!isPropertyType(property_id, boolean_list_type)) {
             return false;
         }
+        std::vector<std::vector<bool>> &column = booleans_list[property_id];
 
-        if (booleans_list[key].size() <= index) {
-            booleans_list[key].resize(1 + index);
+        if (column.size() <= index) {
+            column.resize(1 + index);
         }
-        booleans_list[key][index] = value;
+        column[index] = value;
+        SetRow(validity[property_id], index);
 
         return true;
     }
 
-    bool
-    Properties::setListOfIntegerProperty(const std::string &key, uint64_t index, const std::vector<int64_t> &value) {
-        if(types.empty()) {
-            return false;
-        }
-        auto type_check = types.find(key);
-        if (type_check == types.end()) {
-            return false;
-        }
-        if (types[key] != integer_list_type) {
+    bool Properties::setListOfIntegerProperty(uint16_t property_id, uint64_t index, const std::vector<int64_t> &value) {
+        if (!isPropertyType(property_id, integer_list_type)) {
             return false;
         }
+        std::vector<std::vector<int64_t>> &column = integers_list[property_id];
 
-        if (integers_list[key].size() <= index) {
-            integers_list[key].resize(1 + index);
+        if (column.size() <= index) {
+            column.resize(1 + index);
         }
-        integers_list[key][index] = value;
+        column[index] = value;
+        SetRow(validity[property_id], index);
 
         return true;
     }
 
-    bool Properties::setListOfDoubleProperty(const std::string &key, uint64_t index, const std::vector<double> &value) {
-        if(types.empty()) {
-            return false;
-        }
-        auto type_check = types.find(key);
-        if (type_check == types.end()) {
-            return false;
-        }
-        if (types[key] != double_list_type) {
+    bool Properties::setListOfDoubleProperty(uint16_t property_id, uint64_t index, const std::vector<double> &value) {
+        if (!isPropertyType(property_id, double_list_type)) {
             return false;
         }
+        std::vector<std::vector<double>> &column = doubles_list[property_id];
 
-        if (doubles_list[key].size() <= index) {
-            doubles_list[key].resize(1 + index);
+        if (column.size() <= index) {
+            column.resize(1 + index);
         }
-        doubles_list[key][index] = value;
+        column[index] = value;
+        SetRow(validity[property_id], index);
 
         return true;
     }
 
-    bool
-    Properties::setListOfStringProperty(const std::string &key, uint64_t index, const std::vector<std::string> &value) {
-        if(types.empty()) {
-            return false;
-        }
-        auto type_check = types.find(key);
-        if (type_check == types.end()) {
-            return false;
-        }
-        if (types[key] != string_list_type) {
+    bool Properties::setListOfStringProperty(uint16_t property_id, uint64_t index, const std::vector<std::string> &value) {
+        if (!isPropertyType(property_id, string_list_type)) {
             return false;
         }
+        std::vector<std::vector<std::string>> &column = strings_list[property_id];
 
-        if (strings_list[key].size() <= index) {
-            strings_list[key].resize(1 + index);
+        if (column.size() <= index) {
+            column.resize(1 + index);
         }
-        strings_list[key][index] = value;
+        column[index] = value;
+        SetRow(validity[property_id], index);
 
         return true;
     }
 
     std::map<std::string, std::any> Properties::getProperties(uint64_t index) {
         std::map<std::string, std::any> properties;
-        for (auto const&[key, type_id] : types) {
-            switch (type_id) {
+        for (uint16_t property_id = 1; property_id < property_types.size(); property_id++) {
+            const std::string &key = property_keys[property_id];
+            switch (property_types[property_id]) {
                 case boolean_type: {
-                    if (booleans[key].size() > index) {
-                        properties.emplace(key, booleans[key][index]);
+                    if (RowIsSet(validity[property_id], index)) {
+                        properties.emplace(key, booleans[property_id][index]);
                     }
                     break;
                 }
                 case integer_type: {
-                    if (integers[key].size() > index) {
-                        properties.emplace(key, integers[key][index]);
+                    if (RowIsSet(validity[property_id], index)) {
+                        properties.emplace(key, integers[property_id][index]);
                     }
                     break;
                 }
                 case double_type: {
-                    if (doubles[key].size() > index) {
-                        properties.emplace(key, doubles[key][index]);
+                    if (RowIsSet(validity[property_id], index)) {
+                        properties.emplace(key, doubles[property_id][index]);
                     }
                     break;
                 }
                 case string_type: {
-                    if (strings[key].size() > index) {
-                        properties.emplace(key, strings[key][index]);
+                    if (RowIsSet(validity[property_id], index)) {
+                        properties.emplace(key, strings[property_id][index]);
                     }
                     break;
                 }
                 case boolean_list_type: {
-                    if (booleans_list[key].size() > index) {
-                        properties.emplace(key, booleans_list[key][index]);
+                    if (RowIsSet(validity[property_id], index)) {
+                        properties.emplace(key, booleans_list[property_id][index]);
                     }
                     break;
                 }
                 case integer_list_type: {
-                    if (integers_list[key].size() > index) {
-                        properties.emplace(key, integers_list[key][index]);
+                    if (RowIsSet(validity[property_id], index)) {
+                        properties.emplace(key, integers_list[property_id][index]);
                     }
                     break;
                 }
                 case double_list_type: {
-                    if (doubles_list[key].size() > index) {
-                        properties.emplace(key, doubles_list[key][index]);
+                    if (RowIsSet(validity[property_id], index)) {
+                        properties.emplace(key, doubles_list[property_id][index]);
                     }
                     break;
                 }
                 case string_list_type: {
-                    if (strings_list[key].size() > index) {
-                        properties.emplace(key, strings_list[key][index]);
+                    if (RowIsSet(validity[property_id], index)) {
+                        properties.emplace(key, strings_list[property_id][index]);
                     }
                     break;
                 }
                 default: {
-
+                    // Removed properties keep their id but have no type
                 }
             }
 
@@ -520,200 +712,807 @@ namespace ragedb {
         return properties;
     }
 
-    std::any Properties::getProperty(const std::string& key, uint64_t index) {
-        if (types.find(key) != types.end()) {
-            switch (types[key]) {
+    /**
+     * Read every property of a row into a flat record, without going through std::any
+     *
+     * @param index row
+     * @return the properties of the row sorted by key
+     */
+    PropertyRecord Properties::getPropertyRecord(uint64_t index) {
+        PropertyRecord record;
+        record.reserve(property_ids.size());
+        for (uint16_t property_id = 1; property_id < property_types.size(); property_id++) {
+            const std::string &key = property_keys[property_id];
+            switch (property_types[property_id]) {
                 case boolean_type: {
-                    if (booleans[key].size() > index) {
-                        // std::any and vector<bool> don't play nice together due to how vector<bool> is optimized
-                        // so this cast makes sure we return the value typed correctly
-                        return static_cast<bool>(booleans[key][index]);
+                    auto const& column = booleans[property_id];
+                    if (RowIsSet(validity[property_id], index)) {
+                        record.add(key, static_cast<bool>(column[index]));
                     }
-                    return tombstone_boolean;
+                    break;
                 }
                 case integer_type: {
-                    if (integers[key].size() > index) {
-                        return integers[key][index];
+                    auto const& column = integers[property_id];
+                    if (RowIsSet(validity[property_id], index)) {
+                        record.add(key, column[index]);
                     }
-                    return tombstone_int;
+                    break;
                 }
                 case double_type: {
-                    if (doubles[key].size() > index) {
-                        return doubles[key][index];
+                    auto const& column = doubles[property_id];
+                    if (RowIsSet(validity[property_id], index)) {
+                        record.add(key, column[index]);
                     }
-                    return tombstone_double;
+                    break;
                 }
                 case string_type: {
-                    if (strings[key].size() > index) {
-                        return strings[key][index];
+                    auto const& column = strings[property_id];
+                    if (RowIsSet(validity[property_id], index)) {
+                        record.add(key, column[index]);
                     }
-                    return tombstone_string;
+                    break;
                 }
                 case boolean_list_type: {
-                    if (booleans_list[key].size() > index) {
-                        return booleans_list[key][index];
+                    auto const& column = booleans_list[property_id];
+                    if (RowIsSet(validity[property_id], index)) {
+                        record.add(key, column[index]);
                     }
-                    return tombstone_booleans_list;
+                    break;
                 }
                 case integer_list_type: {
-                    if (integers[key].size() > index) {
-                        return integers_list[key][index];
+                    auto const& column = integers_list[property_id];
+                    if (RowIsSet(validity[property_id], index)) {
+                        record.add(key, column[index]);
                     }
-                    return tombstone_integers_list;
+                    break;
                 }
                 case double_list_type: {
-                    if (doubles_list[key].size() > index) {
-                        return doubles_list[key][index];
+                    auto const& column = doubles_list[property_id];
+                    if (RowIsSet(validity[property_id], index)) {
+                        record.add(key, column[index]);
                     }
-                    return tombstone_doubles_list;
+                    break;
                 }
                 case string_list_type: {
-                    if (strings_list[key].size() > index) {
-                        return strings_list[key][index];
+                    auto const& column = strings_list[property_id];
+                    if (RowIsSet(validity[property_id], index)) {
+                        record.add(key, column[index]);
                     }
-                    return tombstone_strings_list;
+                    break;
                 }
                 default: {
 
                 }
             }
         }
-        return tombstone_any;
+        record.sort();
+        return record;
     }
 
-    bool Properties::setProperty(const std::string &key, uint64_t index, bool value) {
-        return setBooleanProperty(key, index, value);
+    bool Properties::getNumericProperty(const std::string &key, uint64_t index, double &value) {
+        return getNumericProperty(getPropertyId(key), index, value);
     }
 
-    bool Properties::setProperty(const std::string &key, uint64_t index, int64_t value) {
-        return setIntegerProperty(key, index, value);
+    /**
+     * Read an integer or double property as a double, without going through std::any
+     *
+     * @param property_id property
+     * @param index row
+     * @param value set to the value of the property
+     * @return false if the property is not numeric or the row does not have a value
+     */
+    bool Properties::getNumericProperty(uint16_t property_id, uint64_t index, double &value) {
+        switch (getPropertyTypeId(property_id)) {
+            case integer_type: {
+                const std::vector<int64_t> &column = integers[property_id];
+                if (RowIsSet(validity[property_id], index)) {
+                    value = static_cast<double>(column[index]);
+                    return true;
+                }
+                return false;
+            }
+            case double_type: {
+                const std::vector<double> &column = doubles[property_id];
+                if (RowIsSet(validity[property_id], index)) {
+                    value = column[index];
+                    return true;
+                }
+                return false;
+            }
+            default: {
+                return false;
+            }
+        }
     }
 
-    bool Properties::setProperty(const std::string &key, uint64_t index, double value) {
-        return setDoubleProperty(key, index, value);
+    std::any Properties::getProperty(const std::string& key, uint64_t index) {
+        return getProperty(getPropertyId(key), index);
     }
 
-    bool Properties::setProperty(const std::string &key, uint64_t index, const std::string& value) {
-        return setStringProperty(key, index, value);
-    }
+    std::any Properties::getProperty(uint16_t property_id, uint64_t index) {
+        switch (getPropertyTypeId(property_id)) {
+            case boolean_type: {
+                if (RowIsSet(validity[property_id], index)) {
+                    // std::any and vector<bool> don't play nice together due to how vector<bool> is optimized
+                    // so this cast makes sure we return the value typed correctly
+                    return static_cast<bool>(booleans[property_id][index]);
+                }
+                return tombstone_boolean;
+            }
+            case integer_type: {
+                if (RowIsSet(validity[property_id], index)) {
+                    return integers[property_id][index];
+                }
+                return tombstone_int;
+            }
+            case double_type: {
+                if (RowIsSet(validity[property_id], index)) {
+                    return doubles[property_id][index];
+                }
+                return tombstone_double;
+            }
+            case string_type: {
+                if (RowIsSet(validity[property_id], index)) {
+                    return strings[property_id][index];
+                }
+                return tombstone_string;
+            }
+            case boolean_list_type: {
+                if (RowIsSet(validity[property_id], index)) {
+                    return booleans_list[property_id][index];
+                }
+                return tombstone_booleans_list;
+            }
+            case integer_list_type: {
+                if (RowIsSet(validity[property_id], index)) {
+                    return integers_list[property_id][index];
+                }
+                return tombstone_integers_list;
+            }
+            case double_list_type: {
+                if (RowIsSet(validity[property_id], index)) {
+                    return doubles_list[property_id][index];
+                }
+                return tombstone_doubles_list;
+            }
+            case string_list_type: {
+                if (RowIsSet(validity[property_id], index)) {
+                    return strings_list[property_id][index];
+                }
+                return tombstone_strings_list;
+            }
+            default: {
+
+            }
+        }
+        return tombstone_any;
+    }
+
+    bool Properties::setProperty(const std::string &key, uint64_t index, bool value) {
+        return setBooleanProperty(key, index, value);
+    }
+
+    bool Properties::setProperty(const std::string &key, uint64_t index, int64_t value) {
+        return setIntegerProperty(key, index, value);
+    }
+
+    bool Properties::setProperty(const std::string &key, uint64_t index, double value) {
+        return setDoubleProperty(key, index, value);
+    }
+
+    bool Properties::setProperty(const std::string &key, uint64_t index, const std::string& value) {
+        return setStringProperty(key, index, value);
+    }
 
     bool Properties::deleteProperties(uint64_t index) {
-        for (auto[key, value] : types) {
-            switch (value) {
+        for (uint16_t property_id = 1; property_id < property_types.size(); property_id++) {
+            if (property_types[property_id] != 0) {
+                deleteProperty(property_id, index);
+            }
+        }
+        return true;
+    }
+
+    // Cut a column to at most rows entries, giving back its memory once less than half of it is used
+    template<typename Column>
+    static void truncateColumn(Column &column, uint64_t rows) {
+        if (column.size() > rows) {
+            column.resize(rows);
+            if (rows * 2 < column.capacity()) {
+                column.shrink_to_fit();
+            }
+        }
+    }
+
+    /**
+     * Drop every row from rows on. The rows dropped must have had their properties deleted already,
+     * so no index holds them. Only the rows dropped are touched, columns that are short enough stay as they are.
+     *
+     * @param rows number of rows to keep
+     */
+    void Properties::truncate(uint64_t rows) {
+        for (uint16_t property_id = 1; property_id < property_types.size(); property_id++) {
+            switch (property_types[property_id]) {
                 case boolean_type: {
-                    if (booleans[key].size() > index) {
-                        booleans[key][index] = tombstone_boolean;
-                    }
+                    truncateColumn(booleans[property_id], rows);
                     break;
                 }
                 case integer_type: {
-                    if (integers[key].size() > index) {
-                        integers[key][index] = tombstone_int;
-                    }
+                    truncateColumn(integers[property_id], rows);
                     break;
                 }
                 case double_type: {
-                    if (doubles[key].size() > index) {
-                        doubles[key][index] = tombstone_double;
-                    }
+                    truncateColumn(doubles[property_id], rows);
                     break;
                 }
                 case string_type: {
-                    if (strings[key].size() > index) {
-                        strings[key][index] = tombstone_string;
-                    }
+                    truncateColumn(strings[property_id], rows);
                     break;
                 }
                 case boolean_list_type: {
-                    if (booleans_list[key].size() > index) {
-                        booleans_list[key][index] = tombstone_booleans_list;
-                    }
+                    truncateColumn(booleans_list[property_id], rows);
                     break;
                 }
                 case integer_list_type: {
-                    if (integers_list[key].size() > index) {
-                        integers_list[key][index] = tombstone_integers_list;
-                    }
+                    truncateColumn(integers_list[property_id], rows);
                     break;
                 }
                 case double_list_type: {
-                    if (doubles_list[key].size() > index) {
-                        doubles_list[key][index] = tombstone_doubles_list;
-                    }
+                    truncateColumn(doubles_list[property_id], rows);
                     break;
                 }
                 case string_list_type: {
-                    if (strings_list[key].size() > index) {
-                        strings_list[key][index] = tombstone_strings_list;
-                    }
+                    truncateColumn(strings_list[property_id], rows);
                     break;
                 }
                 default: {
-                    // The empty key will hit this, do nothing.
+                    // Removed properties hold no rows
+                    continue;
                 }
             }
+            std::vector<uint64_t> &words = validity[property_id];
+            truncateColumn(words, WordsFor(rows));
+            if (rows % 64 != 0 && words.size() == WordsFor(rows)) {
+                words.back() &= (uint64_t(1) << (rows % 64)) - 1;
+            }
+        }
+    }
+
+    /**
+     * Give back the dictionary entries of the string values of a property no row holds anymore.
+     * A column only looks at its dictionary, and only once a quarter of it is stale, so rows are never copied.
+     *
+     * @param property_id property id, one property at a time so a long compaction can give way in between
+     * @return false once property_id is past the last property
+     */
+    bool Properties::compact(uint16_t property_id) {
+        if (property_id >= property_types.size()) {
+            return false;
+        }
+        if (property_types[property_id] == string_type) {
+            strings[property_id].compact();
         }
         return true;
     }
 
     bool Properties::deleteProperty(const std::string& key, uint64_t index) {
-        if (types.find(key) != types.end()) {
-            switch (types[key]) {
-                case boolean_type: {
-                    if (booleans[key].size() > index) {
-                        booleans[key][index] = tombstone_boolean;
+        return deleteProperty(getPropertyId(key), index);
+    }
+
+    bool Properties::deleteProperty(uint16_t property_id, uint64_t index) {
+        uint8_t type_id = getPropertyTypeId(property_id);
+        if (type_id == 0) {
+            return false;
+        }
+        if (!RowIsSet(validity[property_id], index)) {
+            return true;
+        }
+        switch (type_id) {
+            case boolean_type: {
+                auto index_search = boolean_indexes.find(property_id);
+                if (index_search != boolean_indexes.end()) {
+                    unindexValue(index_search.value(), index, static_cast<bool>(booleans[property_id][index]));
+                }
+                booleans[property_id][index] = tombstone_boolean;
+                break;
+            }
+            case integer_type: {
+                auto index_search = integer_indexes.find(property_id);
+                if (index_search != integer_indexes.end()) {
+                    unindexValue(index_search.value(), index, integers[property_id][index]);
+                }
+                integers[property_id][index] = tombstone_int;
+                break;
+            }
+            case double_type: {
+                auto index_search = double_indexes.find(property_id);
+                if (index_search != double_indexes.end()) {
+                    unindexValue(index_search.value(), index, doubles[property_id][index]);
+                }
+                doubles[property_id][index] = tombstone_double;
+                break;
+            }
+            case string_type: {
+                auto index_search = string_indexes.find(property_id);
+                if (index_search != string_indexes.end()) {
+                    unindexValue(index_search.value(), index, strings[property_id][index]);
+                }
+                strings[property_id].set(index, tombstone_string);
+                break;
+            }
+            case boolean_list_type: {
+                std::vector<bool>().swap(booleans_list[property_id][index]);
+                break;
+            }
+            case integer_list_type: {
+                std::vector<int64_t>().swap(integers_list[property_id][index]);
+                break;
+            }
+            case double_list_type: {
+                std::vector<double>().swap(doubles_list[property_id][index]);
+                break;
+            }
+            case string_list_type: {
+                std::vector<std::string>().swap(strings_list[property_id][index]);
+                break;
+            }
+            default: {
+                return false;
+            }
+        }
+        ClearRow(validity[property_id], index);
+        return true;
+    }
+
+    /**
+     * Index a property so it can be found by value without scanning its column.
+     * Booleans, integers and doubles are kept ordered for range queries, strings are hashed.
+     *
+     * @param key property to index
+     * @return true if the property is indexed, false if it does not exist or is a list
+     */
+    bool Properties::addIndex(const std::string &key) {
+        uint16_t property_id = getPropertyId(key);
+        if (hasIndex(property_id)) {
+            return true;
+        }
+        switch (getPropertyTypeId(property_id)) {
+            case boolean_type: {
+                buildIndex<bool>(boolean_indexes[property_id], booleans[property_id], validity[property_id]);
+                return true;
+            }
+            case integer_type: {
+                buildIndex<int64_t>(integer_indexes[property_id], integers[property_id], validity[property_id]);
+                return true;
+            }
+            case double_type: {
+                buildIndex<double>(double_indexes[property_id], doubles[property_id], validity[property_id]);
+                return true;
+            }
+            case string_type: {
+                buildIndex<std::string>(string_indexes[property_id], strings[property_id], validity[property_id]);
+                return true;
+            }
+            default: {
+                return false;
+            }
+        }
+    }
+
+    bool Properties::removeIndex(const std::string &key) {
+        uint16_t property_id = getPropertyId(key);
+        return boolean_indexes.erase(property_id) + integer_indexes.erase(property_id) + double_indexes.erase(property_id) + string_indexes.erase(property_id) > 0;
+    }
+
+    bool Properties::hasIndex(const std::string &key) const {
+        return hasIndex(getPropertyId(key));
+    }
+
+    bool Properties::hasIndex(uint16_t property_id) const {
+        return boolean_indexes.count(property_id) + integer_indexes.count(property_id) + double_indexes.count(property_id) + string_indexes.count(property_id) > 0;
+    }
+
+    std::set<std::string> Properties::getIndexes() const {
+        std::set<std::string> keys;
+        for (const auto &[property_id, index] : boolean_indexes) {
+            keys.insert(property_keys[property_id]);
+        }
+        for (const auto &[property_id, index] : integer_indexes) {
+            keys.insert(property_keys[property_id]);
+        }
+        for (const auto &[property_id, index] : double_indexes) {
+            keys.insert(property_keys[property_id]);
+        }
+        for (const auto &[property_id, index] : string_indexes) {
+            keys.insert(property_keys[property_id]);
+        }
+        return keys;
+    }
+
+    /**
+     * Find the rows whose value of a property compares to a value, using its index when there is one
+     *
+     * @param key property
+     * @param operation comparison
+     * @param value value to compare to, of the type of the property
+     * @return rows that match, including rows of deleted entries which the caller filters out
+     */
+    Roaring64Map Properties::findIds(const std::string &key, Operation operation, const std::any &value) {
+        return findIds(getPropertyId(key), operation, value, nullptr);
+    }
+
+    /**
+     * Find the rows that match every condition of a filter. Conditions on indexed properties go first,
+     * the ones after them only compare the column values of the rows still matching.
+     *
+     * @param conditions conditions that must all match, at least one
+     * @return rows that match, including rows of deleted entries which the caller filters out
+     */
+    Roaring64Map Properties::findIds(const std::vector<Condition> &conditions) {
+        std::vector<std::pair<uint16_t, const Condition*>> ordered;
+        ordered.reserve(conditions.size());
+        for (const auto &condition : conditions) {
+            ordered.emplace_back(getPropertyId(condition.property), &condition);
+        }
+        std::stable_partition(ordered.begin(), ordered.end(), [this] (const std::pair<uint16_t, const Condition*> &condition) {
+            return hasIndex(condition.first);
+        });
+
+        Roaring64Map rows;
+        for (size_t i = 0; i < ordered.size(); i++) {
+            const auto &[property_id, condition] = ordered[i];
+            rows = findIds(property_id, condition->operation, condition->value, i == 0 ? nullptr : &rows);
+            if (rows.isEmpty()) {
+                break;
+            }
+        }
+        return rows;
+    }
+
+    Roaring64Map Properties::findIds(uint16_t property_id, Operation operation, const std::any &value, const Roaring64Map *candidates) {
+        switch (getPropertyTypeId(property_id)) {
+            case boolean_type: {
+                bool typed;
+                if (!fromAny(value, typed)) {
+                    break;
+                }
+                auto index_search = boolean_indexes.find(property_id);
+                if (index_search != boolean_indexes.end()) {
+                    return findInIndex(index_search->second, operation, typed, candidates);
+                }
+                return scanColumn(booleans[property_id], operation, typed, validity[property_id], candidates);
+            }
+            case integer_type: {
+                int64_t typed;
+                if (!fromAny(value, typed)) {
+                    break;
+                }
+                auto index_search = integer_indexes.find(property_id);
+                if (index_search != integer_indexes.end()) {
+                    return findInIndex(index_search->second, operation, typed, candidates);
+                }
+                if (candidates == nullptr) {
+                    return RowsToBitmap(MatchColumn(integers[property_id], operation, typed, validity[property_id]));
+                }
+                return scanColumn(integers[property_id], operation, typed, validity[property_id], candidates);
+            }
+            case double_type: {
+                double typed;
+                if (!fromAny(value, typed)) {
+                    break;
+                }
+                auto index_search = double_indexes.find(property_id);
+                if (index_search != double_indexes.end()) {
+                    return findInIndex(index_search->second, operation, typed, candidates);
+                }
+                if (candidates == nullptr) {
+                    return RowsToBitmap(MatchColumn(doubles[property_id], operation, typed, validity[property_id]));
+                }
+                return scanColumn(doubles[property_id], operation, typed, validity[property_id], candidates);
+            }
+            case string_type: {
+                std::string typed;
+                if (!fromAny(value, typed)) {
+                    break;
+                }
+                auto index_search = string_indexes.find(property_id);
+                if (index_search != string_indexes.end()) {
+                    return findInIndex(index_search->second, operation, typed, candidates);
+                }
+                const StringColumn &column = strings[property_id];
+                if (column.isEncoded() && (operation == Operation::EQ || operation == Operation::NEQ)) {
+                    // Equality compares dictionary codes, a value missing from the dictionary gets a code no row holds
+                    uint32_t code = std::numeric_limits<uint32_t>::max();
+                    column.findCode(typed, code);
+                    if (candidates == nullptr) {
+                        return RowsToBitmap(MatchColumn(column.getCodes(), operation, code, validity[property_id]));
                     }
+                    return scanColumn(column.getCodes(), operation, code, validity[property_id], candidates);
+                }
+                return scanColumn(column, operation, typed, validity[property_id], candidates);
+            }
+            default: {
+                // Lists are not searchable
+            }
+        }
+        return Roaring64Map();
+    }
+
+    // The validity bitmap of a property cut or padded to the words of a column of the given size
+    std::vector<uint64_t> Properties::presentRows(uint16_t property_id, size_t rows) const {
+        std::vector<uint64_t> words(validity[property_id].begin(), validity[property_id].begin() + static_cast<std::ptrdiff_t>(std::min(validity[property_id].size(), WordsFor(rows))));
+        words.resize(WordsFor(rows), 0);
+        return words;
+    }
+
+    /**
+     * Aggregate the values of a property over some rows, optionally grouped by the value of another property.
+     * Integer and double columns without a group by are reduced by the column kernels.
+     *
+     * @param key property to aggregate, empty to only count the rows
+     * @param group_by property to group by, empty for a single group
+     * @param rows rows to aggregate, without deleted entries
+     * @return the aggregation of each group
+     */
+    Aggregations Properties::aggregate(const std::string &key, const std::string &group_by, const Roaring64Map &rows) {
+        Aggregations aggregations;
+        uint16_t property_id = getPropertyId(key);
+        uint16_t group_property_id = getPropertyId(group_by);
+        uint8_t type_id = getPropertyTypeId(property_id);
+        uint8_t group_type_id = getPropertyTypeId(group_property_id);
+        if ((!key.empty() && type_id == 0) || (!group_by.empty() && group_type_id == 0)) {
+            return aggregations;
+        }
+
+        if (group_type_id == 0 && (type_id == integer_type || type_id == double_type)) {
+            Aggregation &aggregation = aggregations[""];
+            if (type_id == integer_type) {
+                const std::vector<int64_t> &column = integers[property_id];
+                std::vector<uint64_t> words = presentRows(property_id, column.size());
+                std::vector<uint64_t> selected = BitmapToWords(rows, column.size());
+                for (size_t word = 0; word < words.size(); word++) {
+                    words[word] &= selected[word];
+                }
+                aggregation.count = CountRows(words);
+                if (aggregation.count > 0) {
+                    int64_t minimum = 0;
+                    int64_t maximum = 0;
+                    MinColumn(column, words, minimum);
+                    MaxColumn(column, words, maximum);
+                    aggregation.numeric = true;
+                    aggregation.sum = static_cast<double>(SumColumn(column, words));
+                    aggregation.min = static_cast<double>(minimum);
+                    aggregation.max = static_cast<double>(maximum);
+                }
+            } else {
+                const std::vector<double> &column = doubles[property_id];
+                std::vector<uint64_t> words = presentRows(property_id, column.size());
+                std::vector<uint64_t> selected = BitmapToWords(rows, column.size());
+                for (size_t word = 0; word < words.size(); word++) {
+                    words[word] &= selected[word];
+                }
+                aggregation.count = CountRows(words);
+                if (aggregation.count > 0) {
+                    MinColumn(column, words, aggregation.min);
+                    MaxColumn(column, words, aggregation.max);
+                    aggregation.numeric = true;
+                    aggregation.sum = SumColumn(column, words);
+                }
+            }
+            return aggregations;
+        }
+
+        if (group_type_id == string_type && strings[group_property_id].isEncoded()) {
+            // Group on dictionary codes and name the groups once at the end, rows without a value join the "" group of code 0
+            const StringColumn &group_column = strings[group_property_id];
+            const std::vector<uint32_t> &codes = group_column.getCodes();
+            std::vector<Aggregation> coded(group_column.getDictionary().size());
+            std::vector<bool> used(coded.size(), false);
+            for (uint64_t row : rows) {
+                uint32_t code = RowIsSet(validity[group_property_id], row) ? codes[row] : 0;
+                aggregateRow(property_id, row, coded[code]);
+                used[code] = true;
+            }
+            for (size_t code = 0; code < coded.size(); code++) {
+                if (used[code]) {
+                    aggregations[group_column.getDictionary()[code]].merge(coded[code]);
+                }
+            }
+            return aggregations;
+        }
+
+        for (uint64_t row : rows) {
+            std::string group = group_type_id == 0 ? "" : groupOf(group_property_id, row);
+            aggregateRow(property_id, row, aggregations[group]);
+        }
+        return aggregations;
+    }
+
+    // The value of a row as a group name, empty when the row does not have one
+    std::string Properties::groupOf(uint16_t property_id, uint64_t row) {
+        switch (getPropertyTypeId(property_id)) {
+            case boolean_type: {
+                if (!RowIsSet(validity[property_id], row)) {
+                    return "";
+                }
+                return booleans[property_id][row] ? "true" : "false";
+            }
+            case integer_type: {
+                const std::vector<int64_t> &column = integers[property_id];
+                return RowIsSet(validity[property_id], row) ? std::to_string(column[row]) : "";
+            }
+            case double_type: {
+                const std::vector<double> &column = doubles[property_id];
+                if (RowIsSet(validity[property_id], row)) {
+                    std::ostringstream group;
+                    group << column[row];
+                    return group.str();
+                }
+                return "";
+            }
+            case string_type: {
+                return RowIsSet(validity[property_id], row) ? strings[property_id][row] : "";
+            }
+            default: {
+                return "";
+            }
+        }
+    }
+
+    void Properties::aggregateRow(uint16_t property_id, uint64_t row, Aggregation &aggregation) {
+        switch (getPropertyTypeId(property_id)) {
+            case 0: {
+                // No property, count the rows
+                aggregation.count++;
+                break;
+            }
+            case integer_type: {
+                const std::vector<int64_t> &column = integers[property_id];
+                if (RowIsSet(validity[property_id], row)) {
+                    aggregation.add(static_cast<double>(column[row]));
+                }
+                break;
+            }
+            case double_type: {
+                const std::vector<double> &column = doubles[property_id];
+                if (RowIsSet(validity[property_id], row)) {
+                    aggregation.add(column[row]);
+                }
+                break;
+            }
+            case string_type: {
+                if (RowIsSet(validity[property_id], row)) {
+                    aggregation.count++;
+                }
+                break;
+            }
+            case boolean_type: {
+                // Booleans add up to the number of true values
+                if (RowIsSet(validity[property_id], row)) {
+                    aggregation.add(booleans[property_id][row] ? 1 : 0);
+                }
+                break;
+            }
+            default: {
+                if (RowIsSet(validity[property_id], row)) {
+                    aggregation.count++;
+                }
+            }
+        }
+    }
+
+    void Properties::writeSnapshot(SnapshotWriter &writer) const {
+        // Property ids are not written, they are handed out again in order when the snapshot is read
+        writer(static_cast<uint64_t>(property_ids.size()));
+        for (uint16_t property_id = 1; property_id < property_types.size(); property_id++) {
+            uint8_t type_id = property_types[property_id];
+            if (type_id == 0) {
+                continue;
+            }
+            writer.write(property_keys[property_id]);
+            writer(type_id);
+            switch (type_id) {
+                case boolean_type: {
+                    writer.write(booleans[property_id]);
                     break;
                 }
                 case integer_type: {
-                    if (integers[key].size() > index) {
-                        integers[key][index] = tombstone_int;
-                    }
+                    writer.write(integers[property_id]);
                     break;
                 }
                 case double_type: {
-                    if (doubles[key].size() > index) {
-                        doubles[key][index] = tombstone_double;
-                    }
+                    writer.write(doubles[property_id]);
                     break;
                 }
                 case string_type: {
-                    if (strings[key].size() > index) {
-                        strings[key][index] = tombstone_string;
-                    }
+                    strings[property_id].write(writer);
                     break;
                 }
                 case boolean_list_type: {
-                    if (booleans_list[key].size() > index) {
-                        booleans_list[key][index] = tombstone_booleans_list;
-                    }
+                    writer.write(booleans_list[property_id]);
                     break;
                 }
                 case integer_list_type: {
-                    if (integers_list[key].size() > index) {
-                        integers_list[key][index] = tombstone_integers_list;
-                    }
+                    writer.write(integers_list[property_id]);
                     break;
                 }
                 case double_list_type: {
-                    if (doubles_list[key].size() > index) {
-                        doubles_list[key][index] = tombstone_doubles_list;
-                    }
+                    writer.write(doubles_list[property_id]);
                     break;
                 }
                 case string_list_type: {
-                    if (strings_list[key].size() > index) {
-                        strings_list[key][index] = tombstone_strings_list;
-                    }
+                    writer.write(strings_list[property_id]);
+                    break;
+                }
+                default: {
+                }
+            }
+            writer.write(validity[property_id]);
+        }
+        // Only the indexed keys are written, the indexes are rebuilt from the columns
+        std::set<std::string> indexes = getIndexes();
+        writer(static_cast<uint64_t>(indexes.size()));
+        for (const auto &key : indexes) {
+            writer.write(key);
+        }
+    }
+
+    bool Properties::readSnapshot(SnapshotReader &reader) {
+        clear();
+        auto count = reader.read<uint64_t>();
+        for (uint64_t i = 0; i < count && reader.ok(); i++) {
+            auto key = reader.read<std::string>();
+            auto type_id = reader.read<uint8_t>();
+            if (key.empty()) {
+                // The empty key has no column
+                continue;
+            }
+            uint16_t property_id = addPropertyId(key, type_id);
+            // Columns are moved straight into place, no per value insertion
+            switch (type_id) {
+                case boolean_type: {
+                    booleans[property_id] = reader.read<std::vector<bool>>();
+                    break;
+                }
+                case integer_type: {
+                    integers[property_id] = reader.read<std::vector<int64_t>>();
+                    break;
+                }
+                case double_type: {
+                    doubles[property_id] = reader.read<std::vector<double>>();
+                    break;
+                }
+                case string_type: {
+                    strings[property_id] = StringColumn(reader.read<std::vector<std::string>>());
+                    break;
+                }
+                case boolean_list_type: {
+                    booleans_list[property_id] = reader.read<std::vector<std::vector<bool>>>();
+                    break;
+                }
+                case integer_list_type: {
+                    integers_list[property_id] = reader.read<std::vector<std::vector<int64_t>>>();
+                    break;
+                }
+                case double_list_type: {
+                    doubles_list[property_id] = reader.read<std::vector<std::vector<double>>>();
+                    break;
+                }
+                case string_list_type: {
+                    strings_list[property_id] = reader.read<std::vector<std::vector<std::string>>>();
                     break;
                 }
                 default: {
                     return false;
                 }
             }
-            return true;
+            validity[property_id] = reader.read<std::vector<uint64_t>>();
         }
-        return false;
+        auto index_count = reader.read<uint64_t>();
+        for (uint64_t i = 0; i < index_count && reader.ok(); i++) {
+            addIndex(reader.read<std::string>());
+        }
+        return reader.ok();
     }
 
-}
\ No newline at end of file
+}
@@ -20,26 +20,45 @@
 #include <any>
 #include <cstdint>
 #include <map>
+#include <set>
+#include <unordered_map>
+#include <roaring/roaring64map.hh>
 #include <tsl/sparse_map.h>
 #include <seastar/core/rwlock.hh>
+#include "Aggregation.h"
+#include "Operation.h"
+#include "PropertyRecord.h"
+#include "StringColumn.h"
+#include "Snapshot.h"
 
 namespace ragedb {
     class Properties {
 
     private:
-        tsl::sparse_map<std::string, uint8_t> types;
+        // Property keys are interned to small ids, columns and indexes are held by id
+        tsl::sparse_map<std::string, uint16_t> property_ids;
+        std::vector<std::string> property_keys;
+        std::vector<uint8_t> property_types;
         tsl::sparse_map<std::string, uint8_t> type_map;
         std::vector<std::string> allowed_types;
-        tsl::sparse_map<std::string, std::vector<bool>> booleans;
-        tsl::sparse_map<std::string, std::vector<int64_t>> integers;
-        tsl::sparse_map<std::string, std::vector<double>> doubles;
-        tsl::sparse_map<std::string, std::vector<std::string>> strings;
-        tsl::sparse_map<std::string, std::vector<std::vector<bool>>> booleans_list;
-        tsl::sparse_map<std::string, std::vector<std::vector<int64_t>>> integers_list;
-        tsl::sparse_map<std::string, std::vector<std::vector<double>>> doubles_list;
-        tsl::sparse_map<std::string, std::vector<std::vector<std::string>>> strings_list;
+        std::vector<std::vector<bool>> booleans;
+        std::vector<std::vector<int64_t>> integers;
+        std::vector<std::vector<double>> doubles;
+        std::vector<StringColumn> strings;
+        std::vector<std::vector<std::vector<bool>>> booleans_list;
+        std::vector<std::vector<std::vector<int64_t>>> integers_list;
+        std::vector<std::vector<std::vector<double>>> doubles_list;
+        std::vector<std::vector<std::vector<std::string>>> strings_list;
+        // One bit per row of each column, set when the row holds a value. Values of unset rows are meaningless.
+        std::vector<std::vector<uint64_t>> validity;
         // TODO: Supported Nested Objects
 
+        // Secondary indexes, the rows holding each distinct value of an indexed property
+        tsl::sparse_map<uint16_t, std::map<bool, Roaring64Map>> boolean_indexes;
+        tsl::sparse_map<uint16_t, std::map<int64_t, Roaring64Map>> integer_indexes;
+        tsl::sparse_map<uint16_t, std::map<double, Roaring64Map>> double_indexes;
+        tsl::sparse_map<uint16_t, std::unordered_map<std::string, Roaring64Map>> string_indexes;
+
 
         const std::any tombstone_any = std::any();
         const bool tombstone_boolean = false;
@@ -52,8 +71,13 @@ namespace ragedb {
         const std::vector<double> tombstone_doubles_list = std::vector<double>();
         const std::vector<std::string> tombstone_strings_list = std::vector<std::string>();
 
-        void addPropertyTypeVectors(const std::string &key, uint8_t type_id);
-        void removePropertyTypeVectors(const std::string &key, uint8_t type_id);
+        uint16_t addPropertyId(const std::string &key, uint8_t type_id);
+        void removePropertyTypeVectors(uint16_t property_id);
+        bool isPropertyType(uint16_t property_id, uint8_t type_id) const;
+        std::vector<uint64_t> presentRows(uint16_t property_id, size_t rows) const;
+        Roaring64Map findIds(uint16_t property_id, Operation operation, const std::any& value, const Roaring64Map *candidates);
+        std::string groupOf(uint16_t property_id, uint64_t row);
+        void aggregateRow(uint16_t property_id, uint64_t row, Aggregation& aggregation);
 
     public:
         Properties();
@@ -61,12 +85,14 @@ namespace ragedb {
         seastar::rwlock property_type_lock;
 
         std::map<std::string, std::string> getPropertyTypes();
+        uint16_t getPropertyId(const std::string& key) const;
+        const std::string& getPropertyKey(uint16_t property_id) const;
         uint8_t getPropertyTypeId(const std::string& key);
+        uint8_t getPropertyTypeId(uint16_t property_id) const;
         uint8_t setPropertyTypeId(const std::string& key, uint8_t property_type_id);
         uint8_t setPropertyType(const std::string& key, const std::string& type);
         bool removePropertyType(const std::string& key);
 
-        tsl::sparse_map<std::string, std::vector<bool>> & getAllBooleanProperties();
         bool getBooleanProperty(const std::string&, uint64_t);
         int64_t getIntegerProperty(const std::string&, uint64_t);
         double getDoubleProperty(const std::string&, uint64_t);
@@ -77,6 +103,16 @@ namespace ragedb {
         std::vector<double> getListOfDoubleProperty(const std::string&, uint64_t);
         std::vector<std::string> getListOfStringProperty(const std::string&, uint64_t);
 
+        bool getBooleanProperty(uint16_t, uint64_t);
+        int64_t getIntegerProperty(uint16_t, uint64_t);
+        double getDoubleProperty(uint16_t, uint64_t);
+        std::string getStringProperty(uint16_t, uint64_t);
+
+        std::vector<bool> getListOfBooleanProperty(uint16_t, uint64_t);
+        std::vector<int64_t> getListOfIntegerProperty(uint16_t, uint64_t);
+        std::vector<double> getListOfDoubleProperty(uint16_t, uint64_t);
+        std::vector<std::string> getListOfStringProperty(uint16_t, uint64_t);
+
         bool setBooleanProperty(const std::string&, uint64_t, bool);
         bool setIntegerProperty(const std::string&, uint64_t, int64_t);
         bool setDoubleProperty(const std::string&, uint64_t, double);
@@ -87,15 +123,44 @@ namespace ragedb {
         bool setListOfDoubleProperty(const std::string&, uint64_t, const std::vector<double>&);
         bool setListOfStringProperty(const std::string&, uint64_t, const std::vector<std::string>&);
 
+        bool setBooleanProperty(uint16_t, uint64_t, bool);
+        bool setIntegerProperty(uint16_t, uint64_t, int64_t);
+        bool setDoubleProperty(uint16_t, uint64_t, double);
+        bool setStringProperty(uint16_t, uint64_t, const std::string&);
+
+        bool setListOfBooleanProperty(uint16_t, uint64_t, const std::vector<bool>&);
+        bool setListOfIntegerProperty(uint16_t, uint64_t, const std::vector<int64_t>&);
+        bool setListOfDoubleProperty(uint16_t, uint64_t, const std::vector<double>&);
+        bool setListOfStringProperty(uint16_t, uint64_t, const std::vector<std::string>&);
+
         std::map<std::string, std::any> getProperties(uint64_t);
+        PropertyRecord getPropertyRecord(uint64_t);
         std::any getProperty(const std::string&, uint64_t);
+        std::any getProperty(uint16_t, uint64_t);
+        bool getNumericProperty(const std::string& key, uint64_t index, double& value);
+        bool getNumericProperty(uint16_t property_id, uint64_t index, double& value);
         bool setProperty(const std::string&, uint64_t, bool);
         bool setProperty(const std::string&, uint64_t, int64_t);
         bool setProperty(const std::string&, uint64_t, double);
         bool setProperty(const std::string&, uint64_t, const std::string&);
 
         bool deleteProperty(const std::string&, uint64_t);
+        bool deleteProperty(uint16_t, uint64_t);
         bool deleteProperties(uint64_t);
+        void truncate(uint64_t rows);
+        bool compact(uint16_t property_id);
+
+        bool addIndex(const std::string& key);
+        bool removeIndex(const std::string& key);
+        bool hasIndex(const std::string& key) const;
+        bool hasIndex(uint16_t property_id) const;
+        std::set<std::string> getIndexes() const;
+        Roaring64Map findIds(const std::string& key, Operation operation, const std::any& value);
+        Roaring64Map findIds(const std::vector<Condition>& conditions);
+        Aggregations aggregate(const std::string& key, const std::string& group_by, const Roaring64Map& rows);
+
+        void writeSnapshot(SnapshotWriter &writer) const;
+        bool readSnapshot(SnapshotReader &reader);
 
         constexpr static uint16_t getBooleanPropertyType() {
             return 1;
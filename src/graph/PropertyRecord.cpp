@@ -0,0 +1,153 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PropertyRecord.h"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace ragedb {
+
+    PropertyRecord::PropertyRecord() = default;
+
+    PropertyRecord::PropertyRecord(const std::map<std::string, std::any>& properties) {
+        entries.reserve(properties.size());
+        for (const auto& [key, value] : properties) {
+            entries.emplace_back(key, FromAny(value));
+        }
+    }
+
+    void PropertyRecord::reserve(size_t size) {
+        entries.reserve(size);
+    }
+
+    void PropertyRecord::add(const std::string& key, PropertyValue value) {
+        entries.emplace_back(key, std::move(value));
+    }
+
+    void PropertyRecord::sort() {
+        std::sort(entries.begin(), entries.end(), [] (const auto& a, const auto& b) {
+            return a.first < b.first;
+        });
+    }
+
+    const PropertyValue* PropertyRecord::find(const std::string& key) const {
+        auto it = std::lower_bound(entries.begin(), entries.end(), key, [] (const auto& entry, const std::string& k) {
+            return entry.first < k;
+        });
+        if (it != entries.end() && it->first == key) {
+            return &it->second;
+        }
+        return nullptr;
+    }
+
+    bool PropertyRecord::empty() const {
+        return entries.empty();
+    }
+
+    size_t PropertyRecord::size() const {
+        return entries.size();
+    }
+
+    std::map<std::string, std::any> PropertyRecord::toMap() const {
+        std::map<std::string, std::any> properties;
+        for (const auto& [key, value] : entries) {
+            properties.emplace_hint(properties.end(), key, ToAny(value));
+        }
+        return properties;
+    }
+
+    std::any PropertyRecord::ToAny(const PropertyValue& value) {
+        return std::visit([] (const auto& item) -> std::any {
+            using T = std::decay_t<decltype(item)>;
+            if constexpr (std::is_same_v<T, std::monostate>) {
+                return std::any();
+            } else {
+                return item;
+            }
+        }, value);
+    }
+
+    PropertyValue PropertyRecord::FromAny(const std::any& value) {
+        const auto& value_type = value.type();
+        if (value_type == typeid(std::string)) {
+            return std::any_cast<std::string>(value);
+        }
+        if (value_type == typeid(int64_t)) {
+            return std::any_cast<int64_t>(value);
+        }
+        if (value_type == typeid(double)) {
+            return std::any_cast<double>(value);
+        }
+        if (value_type == typeid(bool)) {
+            return std::any_cast<bool>(value);
+        }
+        // Booleans read out of a std::vector<bool> column end up in std::any as a bit reference
+        if (value_type == typeid(std::_Bit_reference)) {
+            return static_cast<bool>(std::any_cast<std::_Bit_reference>(value));
+        }
+        if (value_type == typeid(std::vector<std::string>)) {
+            return std::any_cast<std::vector<std::string>>(value);
+        }
+        if (value_type == typeid(std::vector<int64_t>)) {
+            return std::any_cast<std::vector<int64_t>>(value);
+        }
+        if (value_type == typeid(std::vector<double>)) {
+            return std::any_cast<std::vector<double>>(value);
+        }
+        if (value_type == typeid(std::vector<bool>)) {
+            return std::any_cast<std::vector<bool>>(value);
+        }
+        return std::monostate();
+    }
+
+    std::ostream& operator<<(std::ostream& os, const PropertyRecord& record) {
+        bool initial = true;
+        for (const auto& [key, value] : record.entries) {
+            if (std::holds_alternative<std::monostate>(value)) {
+                continue;
+            }
+            if (!initial) {
+                os << ", ";
+            }
+            initial = false;
+            os << "\"" << key << "\": ";
+            std::visit([&os] (const auto& item) {
+                using T = std::decay_t<decltype(item)>;
+                if constexpr (std::is_same_v<T, std::string>) {
+                    os << "\"" << item << "\"";
+                } else if constexpr (std::is_same_v<T, bool>) {
+                    os << (item ? "true" : "false");
+                } else if constexpr (std::is_same_v<T, int64_t> || std::is_same_v<T, double>) {
+                    os << item;
+                } else if constexpr (!std::is_same_v<T, std::monostate>) {
+                    os << '[';
+                    bool nested_initial = true;
+                    for (const auto& nested : item) {
+                        if (!nested_initial) {
+                            os << ", ";
+                        }
+                        os << nested;
+                        nested_initial = false;
+                    }
+                    os << ']';
+                }
+            }, value);
+        }
+        return os;
+    }
+
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RAGEDB_PROPERTYRECORD_H
+#define RAGEDB_PROPERTYRECORD_H
+
+#include <any>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace ragedb {
+
+    // The value of a single property, std::monostate when it is not set
+    using PropertyValue = std::variant<std::monostate, bool, int64_t, double, std::string,
+                                       std::vector<bool>, std::vector<int64_t>, std::vector<double>, std::vector<std::string>>;
+
+    /**
+     * The properties of a single node or relationship, stored as one flat vector of key and value pairs
+     * sorted by key. It is built straight from the property columns, so reading a node costs a single
+     * allocation instead of a tree node and a std::any per property, and it moves as a pointer swap.
+     */
+    class PropertyRecord {
+    private:
+        std::vector<std::pair<std::string, PropertyValue>> entries;
+
+    public:
+        PropertyRecord();
+
+        explicit PropertyRecord(const std::map<std::string, std::any>& properties);
+
+        void reserve(size_t size);
+
+        void add(const std::string& key, PropertyValue value);
+
+        // Call once after adding entries out of key order, lookups rely on the order
+        void sort();
+
+        [[nodiscard]] const PropertyValue* find(const std::string& key) const;
+
+        [[nodiscard]] bool empty() const;
+
+        [[nodiscard]] size_t size() const;
+
+        [[nodiscard]] auto begin() const { return entries.begin(); }
+
+        [[nodiscard]] auto end() const { return entries.end(); }
+
+        [[nodiscard]] std::map<std::string, std::any> toMap() const;
+
+        static std::any ToAny(const PropertyValue& value);
+
+        static PropertyValue FromAny(const std::any& value);
+
+        friend std::ostream& operator<<(std::ostream& os, const PropertyRecord& record);
+    };
+}
+
+#endif //RAGEDB_PROPERTYRECORD_H
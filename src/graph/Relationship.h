@@ -22,6 +22,7 @@
 #include <string>
 #include <map>
 #include <sol/sol.hpp>
+#include "PropertyRecord.h"
 
 namespace ragedb {
 
@@ -31,7 +32,7 @@ namespace ragedb {
         std::string type{};
         uint64_t starting_node_id{};
         uint64_t ending_node_id{};
-        std::map<std::string, std::any> properties{};
+        PropertyRecord properties{};
 
     public:
         Relationship();
@@ -39,6 +40,8 @@ namespace ragedb {
         Relationship(uint64_t id, std::string type, uint64_t startingNodeId, uint64_t endingNodeId);
         Relationship(uint64_t id, std::string type, uint64_t startingNodeId, uint64_t endingNodeId, std::map<std::string, std::any> properties);
 
+        Relationship(uint64_t id, std::string type, uint64_t startingNodeId, uint64_t endingNodeId, PropertyRecord properties);
+
         [[nodiscard]] uint64_t getId() const;
 
         [[nodiscard]] uint16_t getTypeId() const;
@@ -51,6 +54,8 @@ namespace ragedb {
 
         [[nodiscard]] std::map<std::string, std::any> getProperties() const;
 
+        [[nodiscard]] const PropertyRecord& getPropertyRecord() const;
+
         [[nodiscard]] sol::table getPropertiesLua(sol::this_state ts) const;
 
         [[nodiscard]] std::any getProperty(const std::string& property);
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <simdjson.h>
 #include "RelationshipTypes.h"
 #include "Properties.h"
@@ -42,9 +43,14 @@ namespace ragedb {
         type_to_id.clear();
         id_to_type.clear();
         id_to_type.shrink_to_fit();
+        starting_node_ids.clear();
+        starting_node_ids.shrink_to_fit();
+        ending_node_ids.clear();
+        ending_node_ids.shrink_to_fit();
         properties.clear();
         properties.shrink_to_fit();
         deleted_ids.clear();
+        deleted_ids.shrink_to_fit();
 
         // start with empty blank type
         type_to_id.emplace("", 0);
@@ -55,6 +61,48 @@ namespace ragedb {
         deleted_ids.emplace_back(Roaring64Map());
     }
 
+    void RelationshipTypes::writeSnapshot(SnapshotWriter &writer) const {
+        writer(static_cast<uint64_t>(type_to_id.size()));
+        for (const auto &[type, type_id] : type_to_id) {
+            writer.write(type);
+            writer(type_id);
+        }
+        writer.write(id_to_type);
+        for (size_t type_id = 0; type_id < id_to_type.size(); type_id++) {
+            writer.write(starting_node_ids[type_id]);
+            writer.write(ending_node_ids[type_id]);
+            properties[type_id].writeSnapshot(writer);
+            writer.write(deleted_ids[type_id]);
+        }
+    }
+
+    bool RelationshipTypes::readSnapshot(SnapshotReader &reader) {
+        type_to_id.clear();
+        auto type_count = reader.read<uint64_t>();
+        for (uint64_t i = 0; i < type_count && reader.ok(); i++) {
+            auto type = reader.read<std::string>();
+            type_to_id.emplace(type, reader.read<uint16_t>());
+        }
+        id_to_type = reader.read<std::vector<std::string>>();
+        if (!reader.ok() || id_to_type.empty()) {
+            return false;
+        }
+
+        // Load each type directly into its final layout
+        starting_node_ids.clear();
+        ending_node_ids.clear();
+        properties.clear();
+        deleted_ids.clear();
+        properties.resize(id_to_type.size());
+        for (size_t type_id = 0; type_id < id_to_type.size() && reader.ok(); type_id++) {
+            starting_node_ids.emplace_back(reader.read<std::vector<uint64_t>>());
+            ending_node_ids.emplace_back(reader.read<std::vector<uint64_t>>());
+            properties[type_id].readSnapshot(reader);
+            deleted_ids.emplace_back(reader.readBitmap());
+        }
+        return reader.ok();
+    }
+
     uint64_t RelationshipTypes::internalToExternal(uint16_t type_id, uint64_t internal_id) const {
         return (((internal_id << TYPE_BITS) + type_id) << SHARD_BITS) + shard_id;
     }
@@ -207,132 +255,84 @@ namespace ragedb {
         return false;
     }
 
+    /**
+     * Internal ids of live relationships of a type from an internal id on
+     *
+     * @param type_id relationship type id
+     * @param from first internal id to look at
+     * @param limit most ids to return
+     * @return internal ids in order, deleted ones left out
+     */
+    std::vector<uint64_t> RelationshipTypes::getInternalIds(uint16_t type_id, uint64_t from, uint64_t limit) const {
+        if (!ValidTypeId(type_id)) {
+            return std::vector<uint64_t>();
+        }
+        return LiveIds(deleted_ids[type_id], starting_node_ids[type_id].size(), from, limit);
+    }
+
+    /**
+     * Internal ids of live relationships of a type after skipping some of them.
+     * Where the skipped ones end is found by the rank of the deleted ids, not by walking past them.
+     *
+     * @param type_id relationship type id
+     * @param skip live relationships to skip
+     * @param limit most ids to return
+     * @return internal ids in order, deleted ones left out
+     */
+    std::vector<uint64_t> RelationshipTypes::skipInternalIds(uint16_t type_id, uint64_t skip, uint64_t limit) const {
+        if (!ValidTypeId(type_id)) {
+            return std::vector<uint64_t>();
+        }
+        uint64_t slots = starting_node_ids[type_id].size();
+        return LiveIds(deleted_ids[type_id], slots, LiveIdAt(deleted_ids[type_id], slots, skip), limit);
+    }
+
     std::vector<uint64_t> RelationshipTypes::getIds(uint64_t skip, uint64_t limit) const {
         std::vector<uint64_t> allIds;
-        int current = 1;
-        // links are internal links, we need to switch to external links
-        for (size_t type_id=1; type_id < id_to_type.size(); type_id++) {
-            uint64_t max_id = starting_node_ids[type_id].size();
-            if (deleted_ids[type_id].isEmpty()) {
-                for (uint64_t internal_id=0; internal_id < max_id; ++internal_id) {
-                    if (current > (skip + limit)) {
-                        return allIds;
-                    }
-                    if (current > skip) {
-                        allIds.emplace_back(internalToExternal(type_id, internal_id));
-                    }
-                    current++;
-                }
-            } else {
-                for (uint64_t internal_id=0; internal_id < max_id; ++internal_id) {
-                    if (current > (skip + limit)) {
-                        return allIds;
-                    }
-                    if (current > skip) {
-                        if (!deleted_ids[type_id].contains(internal_id)) {
-                            allIds.emplace_back(internalToExternal(type_id, internal_id));
-                        }
-                    }
-                    current++;
-                }
+        // Whole types are skipped by their count
+        for (size_t type_id=1; type_id < id_to_type.size() && allIds.size() < limit; type_id++) {
+            uint64_t count = starting_node_ids[type_id].size() - deleted_ids[type_id].cardinality();
+            if (skip >= count) {
+                skip -= count;
+                continue;
+            }
+            for (uint64_t internal_id : skipInternalIds(type_id, skip, limit - allIds.size())) {
+                allIds.emplace_back(internalToExternal(type_id, internal_id));
             }
+            skip = 0;
         }
         return allIds;
     }
 
     std::vector<uint64_t>  RelationshipTypes::getIds(uint16_t type_id, uint64_t skip, uint64_t limit) {
         std::vector<uint64_t>  allIds;
-        int current = 1;
-        if (ValidTypeId(type_id)) {
-            uint64_t max_id = starting_node_ids[type_id].size();
-            if (deleted_ids[type_id].isEmpty()) {
-                for (uint64_t internal_id=0; internal_id < max_id; ++internal_id) {
-                    if (current > (skip + limit)) {
-                        return allIds;
-                    }
-                    if (current > skip) {
-                        allIds.emplace_back(internalToExternal(type_id, internal_id));
-                    }
-                    current++;
-                }
-            } else {
-                for (uint64_t internal_id=0; internal_id < max_id; ++internal_id) {
-                    if (current > (skip + limit)) {
-                        return allIds;
-                    }
-                    if (current > skip) {
-                        if (!deleted_ids[type_id].contains(internal_id)) {
-                            allIds.emplace_back(internalToExternal(type_id, internal_id));
-                        }
-                    }
-                    current++;
-                }
-            }
+        for (uint64_t internal_id : skipInternalIds(type_id, skip, limit)) {
+            allIds.emplace_back(internalToExternal(type_id, internal_id));
         }
         return allIds;
     }
 
     std::vector<Relationship> RelationshipTypes::getRelationships(uint64_t skip, uint64_t limit) {
         std::vector<Relationship> allRelationships;
-        int current = 1;
-        // links are internal links, we need to switch to external links
-        for (size_t type_id=1; type_id < id_to_type.size(); type_id++) {
-            uint64_t max_id = starting_node_ids[type_id].size();
-            if (deleted_ids[type_id].isEmpty()) {
-                for (uint64_t internal_id=0; internal_id < max_id; ++internal_id) {
-                    if (current > (skip + limit)) {
-                        return allRelationships;
-                    }
-                    if (current > skip) {
-                        allRelationships.emplace_back(getRelationship(type_id, internal_id));
-                    }
-                    current++;
-                }
-            } else {
-                for (uint64_t internal_id=0; internal_id < max_id; ++internal_id) {
-                    if (current > (skip + limit)) {
-                        return allRelationships;
-                    }
-                    if (current > skip) {
-                        if (!deleted_ids[type_id].contains(internal_id)) {
-                            allRelationships.emplace_back(getRelationship(type_id, internal_id));
-                        }
-                    }
-                    current++;
-                }
+        // Whole types are skipped by their count
+        for (size_t type_id=1; type_id < id_to_type.size() && allRelationships.size() < limit; type_id++) {
+            uint64_t count = getCount(type_id);
+            if (skip >= count) {
+                skip -= count;
+                continue;
+            }
+            for (uint64_t internal_id : skipInternalIds(type_id, skip, limit - allRelationships.size())) {
+                allRelationships.emplace_back(getRelationship(type_id, internal_id));
             }
+            skip = 0;
         }
         return allRelationships;
     }
 
     std::vector<Relationship> RelationshipTypes::getRelationships(uint16_t type_id, uint64_t skip, uint64_t limit) {
-        std::vector<Relationship>  allRelationships;
-        int current = 1;
-        if (ValidTypeId(type_id)) {
-            uint64_t max_id = starting_node_ids[type_id].size();
-            if (deleted_ids[type_id].isEmpty()) {
-                for (uint64_t internal_id=0; internal_id < max_id; ++internal_id) {
-                    if (current > (skip + limit)) {
-                        return allRelationships;
-                    }
-                    if (current > skip) {
-                        allRelationships.emplace_back(getRelationship(type_id, internal_id));
-                    }
-                    current++;
-                }
-            } else {
-                for (uint64_t internal_id=0; internal_id < max_id; ++internal_id) {
-                    if (current > (skip + limit)) {
-                        return allRelationships;
-                    }
-                    if (current > skip) {
-                        if (!deleted_ids[type_id].contains(internal_id)) {
-                            allRelationships.emplace_back(getRelationship(type_id, internal_id));
-                        }
-                    }
-                    current++;
-                }
-            }
+        std::vector<Relationship> allRelationships;
+        for (uint64_t internal_id : skipInternalIds(type_id, skip, limit)) {
+            allRelationships.emplace_back(getRelationship(type_id, internal_id));
         }
         return allRelationships;
     }
@@ -434,16 +434,23 @@ namespace ragedb {
         return std::map<std::string, std::any>();
     }
 
+    PropertyRecord RelationshipTypes::getRelationshipPropertyRecord(uint16_t type_id, uint64_t internal_id) {
+        if(ValidTypeId(type_id)) {
+            return properties[type_id].getPropertyRecord(internal_id);
+        }
+        return PropertyRecord();
+    }
+
     Relationship RelationshipTypes::getRelationship(uint64_t external_id) {
         return getRelationship(externalToTypeId(external_id), externalToInternal(external_id), external_id);
     }
 
     Relationship RelationshipTypes::getRelationship(uint16_t type_id, uint64_t internal_id) {
-        return Relationship(internalToExternal(type_id, internal_id), getType(type_id), getStartingNodeId(type_id,internal_id), getEndingNodeId(type_id,internal_id), getRelationshipProperties(type_id, internal_id));
+        return Relationship(internalToExternal(type_id, internal_id), getType(type_id), getStartingNodeId(type_id,internal_id), getEndingNodeId(type_id,internal_id), getRelationshipPropertyRecord(type_id, internal_id));
     }
 
     Relationship RelationshipTypes::getRelationship(uint16_t type_id, uint64_t internal_id, uint64_t external_id) {
-        return Relationship(external_id, getType(type_id), getStartingNodeId(type_id,internal_id), getEndingNodeId(type_id,internal_id), getRelationshipProperties(type_id, internal_id));
+        return Relationship(external_id, getType(type_id), getStartingNodeId(type_id,internal_id), getEndingNodeId(type_id,internal_id), getRelationshipPropertyRecord(type_id, internal_id));
     }
 
     std::any RelationshipTypes::getRelationshipProperty(uint16_t type_id, uint64_t internal_id, const std::string &property) {
@@ -467,6 +474,60 @@ namespace ragedb {
         return ending_node_ids[type_id];
     }
 
+    /**
+     * Make room for count more relationships of a type before adding them in a batch
+     *
+     * @param type_id relationship type id
+     * @param count number of relationships about to be added
+     */
+    void RelationshipTypes::reserve(uint16_t type_id, uint64_t count) {
+        // Grow at least geometrically, so a long run of batches stays amortized linear
+        uint64_t needed = starting_node_ids[type_id].size() + count;
+        if (starting_node_ids[type_id].capacity() < needed) {
+            uint64_t capacity = std::max(needed, 2 * static_cast<uint64_t>(starting_node_ids[type_id].capacity()));
+            starting_node_ids[type_id].reserve(capacity);
+            ending_node_ids[type_id].reserve(capacity);
+        }
+    }
+
+    /**
+     * Drop the deleted ids past the last live relationship of a type and give back their memory.
+     * The next relationship added would take the lowest of them anyway, so no id changes.
+     *
+     * @param type_id relationship type id
+     * @param pause called after each property so a long compaction can give way to other work
+     * @return number of deleted ids dropped
+     */
+    uint64_t RelationshipTypes::compact(uint16_t type_id, const std::function<void()> &pause) {
+        if (!ValidTypeId(type_id)) {
+            return 0;
+        }
+        uint64_t slots = starting_node_ids[type_id].size();
+        uint64_t end = slots;
+        while (end > 0 && deleted_ids[type_id].contains(end - 1)) {
+            end--;
+        }
+        // Cut the end off everything before the first pause, a relationship added during one takes internal id end
+        if (end < slots) {
+            for (uint64_t internal_id = end; internal_id < slots; internal_id++) {
+                deleted_ids[type_id].remove(internal_id);
+            }
+            deleted_ids[type_id].runOptimize();
+            deleted_ids[type_id].shrinkToFit();
+            starting_node_ids[type_id].resize(end);
+            ending_node_ids[type_id].resize(end);
+            if (end * 2 < starting_node_ids[type_id].capacity()) {
+                starting_node_ids[type_id].shrink_to_fit();
+                ending_node_ids[type_id].shrink_to_fit();
+            }
+            properties[type_id].truncate(end);
+        }
+        for (uint16_t property_id = 1; ValidTypeId(type_id) && properties[type_id].compact(property_id); property_id++) {
+            pause();
+        }
+        return slots - end;
+    }
+
     bool RelationshipTypes::setRelationshipPropertyFromJson(uint16_t type_id, uint64_t internal_id, const std::string &property,
                                                             const std::string &json) {
         if (!json.empty()) {
@@ -474,48 +535,49 @@ namespace ragedb {
             simdjson::dom::element value;
             simdjson::error_code error = parser.parse(json).get(value);
             if (error == 0U) {
-                uint16_t data_type_id = properties[type_id].getPropertyTypeId(property);
+                uint16_t property_id = properties[type_id].getPropertyId(property);
+                uint16_t data_type_id = properties[type_id].getPropertyTypeId(property_id);
                 switch (data_type_id) {
                     case Properties::getBooleanPropertyType(): {
-                        return properties[type_id].setBooleanProperty(property, internal_id, bool(value));
+                        return properties[type_id].setBooleanProperty(property_id, internal_id, bool(value));
                     }
                     case Properties::getIntegerPropertyType(): {
-                        return properties[type_id].setIntegerProperty(property, internal_id,
+                        return properties[type_id].setIntegerProperty(property_id, internal_id,
                                                                       static_cast<std::make_signed_t<uint64_t>>(value));
                     }
                     case Properties::getDoublePropertyType(): {
-                        return properties[type_id].setDoubleProperty(property, internal_id, double(value));
+                        return properties[type_id].setDoubleProperty(property_id, internal_id, double(value));
                     }
                     case Properties::getStringPropertyType(): {
-                        return properties[type_id].setStringProperty(property, internal_id, std::string(value));
+                        return properties[type_id].setStringProperty(property_id, internal_id, std::string(value));
                     }
                     case Properties::getBooleanListPropertyType(): {
                         std::vector<bool> bool_vector;
                         for (simdjson::dom::element child : simdjson::dom::array(value)) {
                             bool_vector.emplace_back(bool(child));
                         }
-                        return properties[type_id].setListOfBooleanProperty(property, internal_id, bool_vector);
+                        return properties[type_id].setListOfBooleanProperty(property_id, internal_id, bool_vector);
                     }
                     case Properties::getIntegerListPropertyType(): {
                         std::vector<int64_t> int_vector;
                         for (simdjson::dom::element child : simdjson::dom::array(value)) {
                             int_vector.emplace_back(int64_t(child));
                         }
-                        return properties[type_id].setListOfIntegerProperty(property, internal_id, int_vector);
+                        return properties[type_id].setListOfIntegerProperty(property_id, internal_id, int_vector);
                     }
                     case Properties::getDoubleListPropertyType(): {
                         std::vector<double> double_vector;
                         for (simdjson::dom::element child : simdjson::dom::array(value)) {
                             double_vector.emplace_back(double(child));
                         }
-                        return properties[type_id].setListOfDoubleProperty(property, internal_id, double_vector);
+                        return properties[type_id].setListOfDoubleProperty(property_id, internal_id, double_vector);
                     }
                     case Properties::getStringListPropertyType(): {
                         std::vector<std::string> string_vector;
                         for (simdjson::dom::element child : simdjson::dom::array(value)) {
                             string_vector.emplace_back(child);
                         }
-                        return properties[type_id].setListOfStringProperty(property, internal_id, string_vector);
+                        return properties[type_id].setListOfStringProperty(property_id, internal_id, string_vector);
                     }
                     default: {
                         return false;
@@ -542,36 +604,77 @@ namespace ragedb {
         return properties[type_id];
     }
 
+    /**
+     * Find the relationships of a type by the value of a property
+     *
+     * @param type_id relationship type id
+     * @param property property to look at
+     * @param operation comparison
+     * @param value value to compare to
+     * @return internal ids of the relationships that match
+     */
+    Roaring64Map RelationshipTypes::findIds(uint16_t type_id, const std::string &property, Operation operation, const std::any &value) {
+        if (!ValidTypeId(type_id)) {
+            return Roaring64Map();
+        }
+        Roaring64Map ids = properties[type_id].findIds(property, operation, value);
+        // Deleted relationships keep tombstones in their rows until they are reused
+        ids -= deleted_ids[type_id];
+        return ids;
+    }
+
+    Roaring64Map RelationshipTypes::findIds(uint16_t type_id, const std::vector<Condition> &conditions) {
+        if (!ValidTypeId(type_id)) {
+            return Roaring64Map();
+        }
+        Roaring64Map ids;
+        if (conditions.empty()) {
+            ids.addRange(0, starting_node_ids[type_id].size());
+        } else {
+            ids = properties[type_id].findIds(conditions);
+        }
+        ids -= deleted_ids[type_id];
+        return ids;
+    }
+
+    Aggregations RelationshipTypes::aggregate(uint16_t type_id, const std::string &property, const std::string &group_by, const std::vector<Condition> &conditions) {
+        if (!ValidTypeId(type_id)) {
+            return Aggregations();
+        }
+        return properties[type_id].aggregate(property, group_by, findIds(type_id, conditions));
+    }
+
     bool RelationshipTypes::setRelationshipProperty(uint16_t type_id, uint64_t internal_id, const std::string &property, const std::any& value) {
         // find out what data_type property is supposed to be, cast value to that.
 
-        switch (properties[type_id].getPropertyTypeId(property)) {
+        uint16_t property_id = properties[type_id].getPropertyId(property);
+        switch (properties[type_id].getPropertyTypeId(property_id)) {
             case Properties::getBooleanPropertyType(): {
-                return properties[type_id].setBooleanProperty(property, internal_id, std::any_cast<bool>(value));
+                return properties[type_id].setBooleanProperty(property_id, internal_id, std::any_cast<bool>(value));
             }
             case Properties::getIntegerPropertyType(): {
-                return properties[type_id].setIntegerProperty(property, internal_id, std::any_cast<int64_t>(value));
+                return properties[type_id].setIntegerProperty(property_id, internal_id, std::any_cast<int64_t>(value));
             }
             case Properties::getDoublePropertyType(): {
-                return properties[type_id].setDoubleProperty(property, internal_id, std::any_cast<double>(value));
+                return properties[type_id].setDoubleProperty(property_id, internal_id, std::any_cast<double>(value));
             }
             case Properties::getStringPropertyType(): {
                 if (value.type() != typeid(std::string)) {
-                    return properties[type_id].setStringProperty(property, internal_id, std::string(std::any_cast<const char*>(value)));
+                    return properties[type_id].setStringProperty(property_id, internal_id, std::string(std::any_cast<const char*>(value)));
                 }
-                return properties[type_id].setStringProperty(property, internal_id, std::any_cast<std::string>(value));
+                return properties[type_id].setStringProperty(property_id, internal_id, std::any_cast<std::string>(value));
             }
             case Properties::getBooleanListPropertyType(): {
-                return properties[type_id].setListOfBooleanProperty(property, internal_id, std::any_cast<std::vector<bool>>(value));
+                return properties[type_id].setListOfBooleanProperty(property_id, internal_id, std::any_cast<std::vector<bool>>(value));
             }
             case Properties::getIntegerListPropertyType(): {
-                return properties[type_id].setListOfIntegerProperty(property, internal_id, std::any_cast<std::vector<int64_t>>(value));
+                return properties[type_id].setListOfIntegerProperty(property_id, internal_id, std::any_cast<std::vector<int64_t>>(value));
             }
             case Properties::getDoubleListPropertyType(): {
-                return properties[type_id].setListOfDoubleProperty(property, internal_id, std::any_cast<std::vector<double>>(value));
+                return properties[type_id].setListOfDoubleProperty(property_id, internal_id, std::any_cast<std::vector<double>>(value));
             }
             case Properties::getStringListPropertyType(): {
-                return properties[type_id].setListOfStringProperty(property, internal_id, std::any_cast<std::vector<std::string>>(value));
+                return properties[type_id].setListOfStringProperty(property_id, internal_id, std::any_cast<std::vector<std::string>>(value));
             }
         }
         return false;
@@ -590,23 +693,24 @@ namespace ragedb {
             if (!error) {
                 // Add the node properties
                 for (auto[key, value] : object) {
-                    auto property = static_cast<std::string>(key);
+                    // Look the key up once, the setters below work on its id
+                    uint16_t property_id = properties[type_id].getPropertyId(static_cast<std::string>(key));
                     switch (value.type()) {
                         case simdjson::dom::element_type::INT64:
-                            properties[type_id].setIntegerProperty(property, internal_id, int64_t(value));
+                            properties[type_id].setIntegerProperty(property_id, internal_id, int64_t(value));
                             break;
                         case simdjson::dom::element_type::UINT64:
                             // Unsigned Integer Values are not allowed, convert to signed
-                            properties[type_id].setIntegerProperty(property, internal_id, static_cast<std::make_signed_t<uint64_t>>(value));
+                            properties[type_id].setIntegerProperty(property_id, internal_id, static_cast<std::make_signed_t<uint64_t>>(value));
                             break;
                         case simdjson::dom::element_type::DOUBLE:
-                            properties[type_id].setDoubleProperty(property, internal_id, double(value));
+                            properties[type_id].setDoubleProperty(property_id, internal_id, double(value));
                             break;
                         case simdjson::dom::element_type::STRING:
-                            properties[type_id].setStringProperty(property, internal_id, std::string(value));
+                            properties[type_id].setStringProperty(property_id, internal_id, std::string(value));
                             break;
                         case simdjson::dom::element_type::BOOL:
-                            properties[type_id].setBooleanProperty(property, internal_id, bool(value));
+                            properties[type_id].setBooleanProperty(property_id, internal_id, bool(value));
                             break;
                         case simdjson::dom::element_type::NULL_VALUE:
                             // Null Values are not allowed, just ignore them
@@ -632,31 +736,31 @@ namespace ragedb {
                                         for (simdjson::dom::element child : simdjson::dom::array(value)) {
                                             int_vector.emplace_back(int64_t(child));
                                         }
-                                        properties[type_id].setListOfIntegerProperty(property, internal_id, int_vector);
+                                        properties[type_id].setListOfIntegerProperty(property_id, internal_id, int_vector);
                                         break;
                                     case simdjson::dom::element_type::UINT64:
                                         for (simdjson::dom::element child : simdjson::dom::array(value)) {
                                             int_vector.emplace_back(static_cast<std::make_signed_t<uint64_t>>(child));
                                         }
-                                        properties[type_id].setListOfIntegerProperty(property, internal_id, int_vector);
+                                        properties[type_id].setListOfIntegerProperty(property_id, internal_id, int_vector);
                                         break;
                                     case simdjson::dom::element_type::DOUBLE:
                                         for (simdjson::dom::element child : simdjson::dom::array(value)) {
                                             double_vector.emplace_back(double(child));
                                         }
-                                        properties[type_id].setListOfDoubleProperty(property, internal_id, double_vector);
+                                        properties[type_id].setListOfDoubleProperty(property_id, internal_id, double_vector);
                                         break;
                                     case simdjson::dom::element_type::STRING:
                                         for (simdjson::dom::element child : simdjson::dom::array(value)) {
                                             string_vector.emplace_back(child);
                                         }
-                                        properties[type_id].setListOfStringProperty(property, internal_id, string_vector);
+                                        properties[type_id].setListOfStringProperty(property_id, internal_id, string_vector);
                                         break;
                                     case simdjson::dom::element_type::BOOL:
                                         for (simdjson::dom::element child : simdjson::dom::array(value)) {
                                             bool_vector.emplace_back(bool(child));
                                         }
-                                        properties[type_id].setListOfBooleanProperty(property, internal_id, bool_vector);
+                                        properties[type_id].setListOfBooleanProperty(property_id, internal_id, bool_vector);
                                         break;
                                     case simdjson::dom::element_type::NULL_VALUE:
                                         // Null Values are not allowed, just ignore them
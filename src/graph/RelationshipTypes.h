@@ -18,8 +18,10 @@
 #define RAGEDB_RELATIONSHIPTYPES_H
 
 #include <cstdint>
+#include <functional>
 #include <roaring/roaring64map.hh>
 #include <set>
+#include "Cursor.h"
 #include "Relationship.h"
 #include "Properties.h"
 
@@ -44,6 +46,8 @@ namespace ragedb {
     public:
         RelationshipTypes();
         void Clear();
+        void writeSnapshot(SnapshotWriter &writer) const;
+        bool readSnapshot(SnapshotReader &reader);
 
         bool addTypeId(const std::string &type, uint16_t relationship_type_id);
         uint16_t getTypeId(const std::string &type);
@@ -56,6 +60,8 @@ namespace ragedb {
         bool removeId(uint16_t type_id, uint64_t internal_id);
         bool containsId(uint16_t, uint64_t);
 
+        std::vector<uint64_t> getInternalIds(uint16_t type_id, uint64_t from, uint64_t limit) const;
+        std::vector<uint64_t> skipInternalIds(uint16_t type_id, uint64_t skip, uint64_t limit) const;
         std::vector<uint64_t> getIds(uint64_t skip, uint64_t limit) const;
         std::vector<uint64_t> getIds(uint16_t type_id, uint64_t skip, uint64_t limit);
         std::vector<Relationship> getRelationships(uint64_t skip, uint64_t limit);
@@ -81,6 +87,7 @@ namespace ragedb {
         bool setEndingNodeId(uint16_t type_id, uint64_t internal_id, uint64_t external_id);
 
         std::map<std::string, std::any> getRelationshipProperties(uint16_t type_id, uint64_t internal_id);
+        PropertyRecord getRelationshipPropertyRecord(uint16_t type_id, uint64_t internal_id);
         Relationship getRelationship(uint64_t external_id);
         Relationship getRelationship(uint16_t type_id, uint64_t internal_id);
         Relationship getRelationship(uint16_t type_id, uint64_t internal_id, uint64_t external_id);
@@ -88,6 +95,8 @@ namespace ragedb {
         std::any getRelationshipProperty(uint64_t external_id, const std::string &property);
         std::vector<uint64_t> &getStartingNodeIds(uint16_t type_id);
         std::vector<uint64_t> &getEndingNodeIds(uint16_t type_id);
+        void reserve(uint16_t type_id, uint64_t count);
+        uint64_t compact(uint16_t type_id, const std::function<void()> &pause = [] {});
         bool setRelationshipProperty(uint16_t type_id, uint64_t internal_id, const std::string &property, const std::any& value);
         bool setRelationshipProperty(uint64_t external_id, const std::string &property, const std::any& value);
         bool setRelationshipPropertyFromJson(uint16_t type_id, uint64_t internal_id, const std::string &property, const std::string& json);
@@ -96,6 +105,9 @@ namespace ragedb {
         bool deleteRelationshipProperty(uint64_t external_id, const std::string &property);
 
         Properties &getProperties(uint16_t type_id);
+        Roaring64Map findIds(uint16_t type_id, const std::string &property, Operation operation, const std::any &value);
+        Roaring64Map findIds(uint16_t type_id, const std::vector<Condition> &conditions);
+        Aggregations aggregate(uint16_t type_id, const std::string &property, const std::string &group_by, const std::vector<Condition> &conditions);
         bool setPropertiesFromJSON(uint16_t type_id, uint64_t internal_id, const std::string &json);
         bool deleteProperties(uint16_t type_id, uint64_t internal_id);
 
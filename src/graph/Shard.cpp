@@ -137,7 +137,19 @@ namespace ragedb {
             return json
 		)";
 
-    Shard::Shard(uint _cpus) : cpus(_cpus), shard_id(seastar::this_shard_id()) {
+    Shard::Shard(uint _cpus) : cpus(_cpus), shard_id(seastar::this_shard_id()),
+        node_gets(shard_id, cpus, [this] (uint16_t their_shard, std::vector<uint64_t> ids) {
+            return NodeGetBatch(their_shard, std::move(ids));
+        }),
+        node_property_gets(shard_id, cpus, [this] (uint16_t their_shard, std::vector<std::pair<uint64_t, std::string>> requests) {
+            return NodePropertyGetBatch(their_shard, std::move(requests));
+        }),
+        relationship_gets(shard_id, cpus, [this] (uint16_t their_shard, std::vector<uint64_t> ids) {
+            return RelationshipGetBatch(their_shard, std::move(ids));
+        }),
+        relationship_property_gets(shard_id, cpus, [this] (uint16_t their_shard, std::vector<std::pair<uint64_t, std::string>> requests) {
+            return RelationshipPropertyGetBatch(their_shard, std::move(requests));
+        }) {
         lua.open_libraries(sol::lib::base, sol::lib::package, sol::lib::math, sol::lib::string, sol::lib::table);
         lua.require_script("json", script);
 
@@ -196,15 +208,24 @@ namespace ragedb {
         lua.set_function("NodeTypeGetTypeId", &Shard::NodeTypeGetTypeIdViaLua, this);
         lua.set_function("NodeTypeInsert", &Shard::NodeTypeInsertViaLua, this);
 
+        // Adjacency
+        lua.set_function("NodeTypeFreeze", &Shard::NodeTypeFreezeViaLua, this);
+
+        // Compaction
+        lua.set_function("Compact", &Shard::CompactViaLua, this);
+
         //Nodes
         lua.set_function("NodeAddEmpty", &Shard::NodeAddEmptyViaLua, this);
         lua.set_function("NodeAdd", &Shard::NodeAddViaLua, this);
+        lua.set_function("NodesAdd", &Shard::NodesAddViaLua, this);
         lua.set_function("NodeGetId", &Shard::NodeGetIdViaLua, this);
         lua.set_function("NodesGet", &Shard::NodesGetViaLua, this);
         lua.set_function("NodeGet", &Shard::NodeGetViaLua, this);
         lua.set_function("NodeGetById", &Shard::NodeGetByIdViaLua, this);
         lua.set_function("NodeRemove", &Shard::NodeRemoveViaLua, this);
         lua.set_function("NodeRemoveById", &Shard::NodeRemoveByIdViaLua, this);
+        lua.set_function("NodesRemove", &Shard::NodesRemoveViaLua, this);
+        lua.set_function("NodesRemoveById", &Shard::NodesRemoveByIdViaLua, this);
         lua.set_function("NodeGetTypeId", &Shard::NodeGetTypeIdViaLua, this);
         lua.set_function("NodeGetType", &Shard::NodeGetTypeViaLua, this);
         lua.set_function("NodeGetKey", &Shard::NodeGetKeyViaLua, this);
@@ -230,6 +251,7 @@ namespace ragedb {
         lua.set_function("RelationshipAdd", &Shard::RelationshipAddViaLua, this);
         lua.set_function("RelationshipAddByTypeIdByIds", &Shard::RelationshipAddByTypeIdByIdsViaLua, this);
         lua.set_function("RelationshipAddByIds", &Shard::RelationshipAddByIdsViaLua, this);
+        lua.set_function("RelationshipsAddByIds", &Shard::RelationshipsAddByIdsViaLua, this);
         lua.set_function("RelationshipGet", &Shard::RelationshipGetViaLua, this);
         lua.set_function("RelationshipGet", &Shard::RelationshipGetViaLua, this);
         lua.set_function("RelationshipRemove", &Shard::RelationshipRemoveViaLua, this);
@@ -237,6 +259,7 @@ namespace ragedb {
         lua.set_function("RelationshipGetTypeId", &Shard::RelationshipGetTypeIdViaLua, this);
         lua.set_function("RelationshipGetStartingNodeId", &Shard::RelationshipGetStartingNodeIdViaLua, this);
         lua.set_function("RelationshipGetEndingNodeId", &Shard::RelationshipGetEndingNodeIdViaLua, this);
+        lua.set_function("RelationshipExists", &Shard::RelationshipExistsViaLua, this);
 
         // Relationship Properties
         lua.set_function("RelationshipPropertyGet", &Shard::RelationshipPropertyGetViaLua, this);
@@ -321,6 +344,43 @@ namespace ragedb {
         lua.set_function("AllNodesForType", &Shard::AllNodesForTypeViaLua, this);
         lua.set_function("AllRelationships", &Shard::AllRelationshipsViaLua, this);
         lua.set_function("AllRelationshipsForType", &Shard::AllRelationshipsForTypeViaLua, this);
+        lua.set_function("AllNodesPage", &Shard::AllNodesPageViaLua, this);
+        lua.set_function("AllNodesForTypePage", &Shard::AllNodesForTypePageViaLua, this);
+        lua.set_function("AllRelationshipsPage", &Shard::AllRelationshipsPageViaLua, this);
+        lua.set_function("AllRelationshipsForTypePage", &Shard::AllRelationshipsForTypePageViaLua, this);
+
+        // Find
+        lua.set_function("NodePropertyIndexAdd", &Shard::NodePropertyIndexAddViaLua, this);
+        lua.set_function("NodePropertyIndexDelete", &Shard::NodePropertyIndexDeleteViaLua, this);
+        lua.set_function("RelationshipPropertyIndexAdd", &Shard::RelationshipPropertyIndexAddViaLua, this);
+        lua.set_function("RelationshipPropertyIndexDelete", &Shard::RelationshipPropertyIndexDeleteViaLua, this);
+        lua.set_function("FindNodeIds", &Shard::FindNodeIdsViaLua, this);
+        lua.set_function("FindNodes", &Shard::FindNodesViaLua, this);
+        lua.set_function("FindRelationshipIds", &Shard::FindRelationshipIdsViaLua, this);
+        lua.set_function("FindRelationships", &Shard::FindRelationshipsViaLua, this);
+        lua.set_function("FilterNodeIds", &Shard::FilterNodeIdsViaLua, this);
+        lua.set_function("FilterNodes", &Shard::FilterNodesViaLua, this);
+        lua.set_function("FilterRelationshipIds", &Shard::FilterRelationshipIdsViaLua, this);
+        lua.set_function("FilterRelationships", &Shard::FilterRelationshipsViaLua, this);
+
+        // Aggregate
+        lua.set_function("AggregateNodes", &Shard::AggregateNodesViaLua, this);
+        lua.set_function("AggregateRelationships", &Shard::AggregateRelationshipsViaLua, this);
+
+        // Hops
+        lua.set_function("Traverse", &Shard::TraverseViaLua, this);
+        lua.set_function("KHop", &Shard::KHopViaLua, this);
+
+        // Paths
+        lua.set_function("ShortestPath", &Shard::ShortestPathViaLua, this);
+        lua.set_function("WeightedShortestPath", &Shard::WeightedShortestPathViaLua, this);
+
+        // Analytics
+        lua.set_function("PageRank", &Shard::PageRankViaLua, this);
+        lua.set_function("ConnectedComponents", &Shard::ConnectedComponentsViaLua, this);
+        lua.set_function("LabelPropagation", &Shard::LabelPropagationViaLua, this);
+        lua.set_function("TriangleCount", &Shard::TriangleCountViaLua, this);
+        lua.set_function("ClusteringCoefficient", &Shard::ClusteringCoefficientViaLua, this);
     }
 
 
@@ -357,6 +417,7 @@ namespace ragedb {
      * Empty the Shard of all data
      */
     void Shard::Clear() {
+        wal.Append(LogOperation::Clear);
         node_types.Clear();
         relationship_types.Clear();
     }
@@ -418,6 +479,7 @@ namespace ragedb {
 
     // Helpers
     std::pair <uint16_t, uint64_t> Shard::RelationshipRemoveGetIncoming(uint64_t external_id) {
+        wal.Append(LogOperation::RelationshipRemoveGetIncoming, external_id);
 
         uint16_t rel_type_id = externalToTypeId(external_id);
         uint64_t internal_id = externalToInternal(external_id);
@@ -432,18 +494,9 @@ namespace ragedb {
         uint64_t internal_id1 = externalToInternal(id1);
 
         // Remove relationship from Node 1
-        auto group = find_if(std::begin(node_types.getOutgoingRelationships(id1_type_id).at(internal_id1)),
-                             std::end(node_types.getOutgoingRelationships(id1_type_id).at(internal_id1)),
-                             [rel_type_id] (const Group& g) { return g.rel_type_id == rel_type_id; } );
-
-        if (group != std::end(node_types.getOutgoingRelationships(id1_type_id).at(internal_id1))) {
-            auto rel_to_delete = find_if(std::begin(group->links), std::end(group->links), [external_id](Link entry) {
-                return entry.rel_id == external_id;
-            });
-            if (rel_to_delete != std::end(group->links)) {
-                group->links.erase(rel_to_delete);
-            }
-        }
+        node_types.removeOutgoingLinks(id1_type_id, internal_id1, rel_type_id, id2, [external_id] (const Link& entry) {
+            return entry.rel_id == external_id;
+        });
 
         // Clear the relationship
         relationship_types.setStartingNodeId(rel_type_id, internal_id, 0);
@@ -455,20 +508,27 @@ namespace ragedb {
     }
 
     bool Shard::RelationshipRemoveIncoming(uint16_t rel_type_id, uint64_t external_id, uint64_t node_id) {
+        wal.Append(LogOperation::RelationshipRemoveIncoming, rel_type_id, external_id, node_id);
         // Remove relationship from Node 2
         uint64_t internal_id2 = externalToInternal(node_id);
         uint16_t id2_type_id = externalToTypeId(node_id);
 
-        auto group = find_if(std::begin(node_types.getIncomingRelationships(id2_type_id).at(internal_id2)),
-                             std::end(node_types.getIncomingRelationships(id2_type_id).at(internal_id2)),
-                             [rel_type_id] (const Group& g) { return g.rel_type_id == rel_type_id; } );
+        node_types.removeIncomingLinks(id2_type_id, internal_id2, rel_type_id, [external_id] (const Link& entry) {
+            return entry.rel_id == external_id;
+        });
 
-        auto rel_to_delete = find_if(std::begin(group->links), std::end(group->links), [external_id](Link entry) {
+        return true;
+    }
+
+    bool Shard::RelationshipRemoveIncoming(uint16_t rel_type_id, uint64_t external_id, uint64_t node_id, uint64_t other_node_id) {
+        wal.Append(LogOperation::RelationshipRemoveIncomingFrom, rel_type_id, external_id, node_id, other_node_id);
+        // Knowing the starting node, only the links of Node 2 to it are looked at
+        uint64_t internal_id2 = externalToInternal(node_id);
+        uint16_t id2_type_id = externalToTypeId(node_id);
+
+        node_types.removeIncomingLinks(id2_type_id, internal_id2, rel_type_id, other_node_id, [external_id] (const Link& entry) {
             return entry.rel_id == external_id;
         });
-        if (rel_to_delete != std::end(group->links)) {
-            group->links.erase(rel_to_delete);
-        }
 
         return true;
     }
@@ -18,18 +18,31 @@
 #define RAGEDB_SHARD_H
 
 #include <any>
+#include <iterator>
 #include <seastar/core/sharded.hh>
 #include <seastar/core/rwlock.hh>
+#include <seastar/core/scheduling.hh>
 #include <seastar/core/when_all.hh>
 #include <seastar/core/thread.hh>
+#include <seastar/core/timer.hh>
 #include <simdjson.h>
 #include <sol/sol.hpp>
 #include <tsl/sparse_map.h>
 #include "Direction.h"
+#include "Analytics.h"
+#include "Batcher.h"
+#include "Cursor.h"
+#include "Aggregation.h"
+#include "Hop.h"
+#include "Path.h"
+#include "Operation.h"
 #include "Node.h"
+#include "NodeRemoval.h"
 #include "Relationship.h"
 #include "NodeTypes.h"
 #include "RelationshipTypes.h"
+#include "Snapshot.h"
+#include "WriteAheadLog.h"
 
 namespace ragedb {
 
@@ -48,11 +61,80 @@ namespace ragedb {
 
         NodeTypes node_types;                           // Store string and id of node types
         RelationshipTypes relationship_types;           // Store string and id of relationship types
+        WriteAheadLog wal;                              // Log of the mutations made on this Shard
+        std::set<uint16_t> freezing_node_types;         // Node types with a freeze in progress
+        seastar::timer<> merge_timer;                   // Periodically merges new links into frozen node types
+        seastar::future<> merging = seastar::make_ready_future<>();  // Merge in progress
+        seastar::timer<> compaction_timer;              // Periodically gives back the memory of deleted nodes and relationships
+        seastar::future<> compacting = seastar::make_ready_future<>();  // Compaction in progress
+        seastar::scheduling_group compaction_group;     // Compactions run here so they do not starve requests
+        std::map<uint64_t, Roaring64Map> traversals;   // Nodes of this Shard each running traversal has visited
+        uint64_t traversal_count = 0;                   // Traversals started from this Shard
+        std::map<uint64_t, AnalyticsJob> analytics;     // State of each running analytics job on this Shard
+        uint64_t analytics_count = 0;                   // Analytics jobs started from this Shard
+        seastar::scheduling_group analytics_group;      // Analytics run here so they do not starve requests
+        Batcher<uint64_t, Node> node_gets;              // Point reads for other Shards, coalesced per Shard
+        Batcher<std::pair<uint64_t, std::string>, std::any> node_property_gets;
+        Batcher<uint64_t, Relationship> relationship_gets;
+        Batcher<std::pair<uint64_t, std::string>, std::any> relationship_property_gets;
 
         inline static const uint64_t SKIP = 0;
         inline static const uint64_t LIMIT = 100;
+        inline static const uint64_t REMOVE_BATCH_SIZE = 4096;  // Counterpart node ids sent to a Shard per message when removing nodes
         inline static const std::string EXCEPTION = "An exception has occurred: ";
 
+        static std::any AnyFromLua(const sol::object& value);
+        static std::vector<Condition> ConditionsFromLua(const sol::table& conditions);
+        sol::table AggregationsToLua(const Aggregations& aggregations);
+        sol::table PathToLua(const Path& path);
+        seastar::thread_attributes AnalyticsAttributes();
+        seastar::thread_attributes CompactionAttributes();
+        seastar::future<std::vector<Node>> NodesGetSharded(std::map<uint16_t, std::vector<uint64_t>> sharded_nodes_ids);
+        seastar::future<std::vector<Relationship>> RelationshipsGetSharded(std::map<uint16_t, std::vector<uint64_t>> sharded_relationship_ids);
+
+        // Concatenate the results of each Shard, moving every element once
+        template <typename T>
+        static std::vector<T> MoveMerge(std::vector<std::vector<T>> results) {
+            size_t size = 0;
+            for (const auto& sharded : results) {
+                size += sharded.size();
+            }
+            std::vector<T> combined;
+            combined.reserve(size);
+            for (auto& sharded : results) {
+                std::move(sharded.begin(), sharded.end(), std::back_inserter(combined));
+            }
+            return combined;
+        }
+        // Where a page goes on once this Shard has nothing more to give
+        Cursor NextShardCursor(uint16_t type_id) const;
+
+        // Fill a page from one Shard after another, starting at the cursor, until it is full or every Shard is done
+        template <typename T, typename LocalPage>
+        seastar::future<Page<T>> PagePeered(Cursor cursor, uint64_t limit, LocalPage local_page) {
+            // An empty page would hand back the same cursor forever, finish the paging instead
+            if (limit == 0) {
+                return seastar::make_ready_future<Page<T>>(Page<T>{ {}, Cursor{ 0, 0, 0, true } });
+            }
+            return seastar::async([cursor, limit, local_page = std::move(local_page), this] {
+                Page<T> page;
+                page.next = cursor;
+                while (!page.next.done && page.results.size() < limit) {
+                    Page<T> part = container().invoke_on(page.next.shard_id, [local_page, next = page.next, remaining = limit - page.results.size()] (Shard &local_shard) {
+                        return local_page(local_shard, next, remaining);
+                    }).get0();
+                    std::move(part.results.begin(), part.results.end(), std::back_inserter(page.results));
+                    page.next = part.next;
+                }
+                return page;
+            });
+        }
+
+        seastar::future<std::vector<Node>> NodeGetBatch(uint16_t their_shard, std::vector<uint64_t> ids);
+        seastar::future<std::vector<std::any>> NodePropertyGetBatch(uint16_t their_shard, std::vector<std::pair<uint64_t, std::string>> requests);
+        seastar::future<std::vector<Relationship>> RelationshipGetBatch(uint16_t their_shard, std::vector<uint64_t> ids);
+        seastar::future<std::vector<std::any>> RelationshipPropertyGetBatch(uint16_t their_shard, std::vector<std::pair<uint64_t, std::string>> requests);
+
     public:
         explicit Shard(uint _cpus);
 
@@ -68,6 +150,7 @@ namespace ragedb {
         static uint16_t CalculateShardId(uint64_t id);
         uint16_t CalculateShardId(const std::string &type, const std::string &key) const;
         bool ValidNodeId(uint64_t id);
+        std::vector<bool> ValidNodeIds(const std::vector<uint64_t>& ids);
         bool ValidRelationshipId(uint64_t id);
 
         // *****************************************************************************************************************************
@@ -76,6 +159,30 @@ namespace ragedb {
 
         static seastar::future<std::string> HealthCheck();
 
+        // Snapshots
+        void SnapshotWrite(SnapshotWriter& writer);
+        bool SnapshotRead(SnapshotReader& reader);
+        seastar::future<bool> Snapshot(const std::string& directory);
+        seastar::future<bool> Restore(const std::string& directory);
+
+        // Write Ahead Log
+        seastar::future<bool> Recover(const std::string& directory, std::chrono::microseconds commit_window);
+        seastar::future<> CloseLog();
+        void ApplyLogRecord(SnapshotReader& record);
+
+        /**
+         * Hold on to the result of a mutation until the log records of this Shard are durable
+         *
+         * @param value result of the mutation
+         * @return future value once it is safe to acknowledge
+         */
+        template<typename T>
+        seastar::future<T> Durable(T value) {
+            return wal.Commit().then([value = std::move(value)] () mutable {
+                return std::move(value);
+            });
+        }
+
         // Node Types
         uint16_t NodeTypesGetCount();
         uint64_t NodeTypesGetCount(uint16_t type_id);
@@ -96,6 +203,25 @@ namespace ragedb {
         bool NodeTypeInsert(const std::string& type, uint16_t type_id);
         bool DeleteNodeType(const std::string& type);
 
+        // Adjacency
+        uint64_t NodeTypeFreeze(uint16_t type_id, const std::function<void()>& pause = [] {});
+        uint64_t NodeTypeFreeze(const std::string& type, const std::function<void()>& pause = [] {});
+        void AdjacencyMergeEvery(std::chrono::seconds interval);
+        seastar::future<> StopAdjacencyMerge();
+
+        // Compaction
+        void SetCompactionGroup(seastar::scheduling_group group);
+        uint64_t NodeTypeCompact(uint16_t type_id, const std::function<void()>& pause = [] {});
+        uint64_t NodeTypeCompact(const std::string& type, const std::function<void()>& pause = [] {});
+        uint64_t RelationshipTypeCompact(uint16_t type_id, const std::function<void()>& pause = [] {});
+        uint64_t Compact(const std::function<void()>& pause = [] {});
+        void CompactEvery(std::chrono::seconds interval);
+        seastar::future<> StopCompaction();
+
+        // Batching
+        void RegisterBatchingMetrics();
+        seastar::future<> StopBatching();
+
         // Relationship Type
         std::string RelationshipTypeGetType(uint16_t type_id);
         uint16_t RelationshipTypeGetTypeId(const std::string& type);
@@ -115,13 +241,18 @@ namespace ragedb {
         bool NodeRemoveDeleteIncoming(uint64_t id, const std::map<uint16_t, std::vector<uint64_t>>&grouped_relationships);
         std::map<uint16_t, std::map<uint16_t, std::vector<uint64_t>>> NodeRemoveGetOutgoing(uint64_t external_id);
         bool NodeRemoveDeleteOutgoing(uint64_t id, const std::map<uint16_t, std::vector<uint64_t>>&grouped_relationships);
+        std::map<uint16_t, std::vector<NodeRemoval>> NodesRemoveGetLinks(const std::vector<uint64_t>& ids, const std::function<void()>& pause = [] {});
+        bool NodesRemoveDeleteLinks(const std::vector<NodeRemoval>& removals);
         std::pair <uint16_t ,uint64_t> RelationshipRemoveGetIncoming(uint64_t internal_id);
         bool RelationshipRemoveIncoming(uint16_t rel_type_id, uint64_t external_id, uint64_t node_id);
+        bool RelationshipRemoveIncoming(uint16_t rel_type_id, uint64_t external_id, uint64_t node_id, uint64_t other_node_id);
 
         // Nodes
         uint64_t NodeAddEmpty(uint16_t type_id, const std::string& key);
         uint64_t NodeAdd(uint16_t type_id, const std::string& key, const std::string& properties);
         uint64_t NodeGetID(const std::string& type, const std::string& key);
+        std::vector<uint64_t> NodesAdd(uint16_t type_id, const std::vector<std::string>& keys, const std::vector<std::string>& properties);
+        std::vector<uint64_t> NodeGetIDs(const std::vector<std::string>& types, const std::vector<std::string>& keys);
         std::vector<Node> NodesGet(const std::vector<uint64_t>&);
         Node NodeGet(uint64_t id);
         Node NodeGet(const std::string& type, const std::string& key);
@@ -130,6 +261,7 @@ namespace ragedb {
         std::string NodeGetKey(uint64_t id);
         bool NodeRemove(uint64_t id);
         bool NodeRemove(const std::string& type, const std::string& key);
+        uint64_t NodesRemove(const std::vector<uint64_t>& ids, const std::function<void()>& pause = [] {});
 
         // Node Property
         std::any NodePropertyGet(uint64_t id, const std::string& property);
@@ -162,12 +294,17 @@ namespace ragedb {
         uint64_t RelationshipAddSameShard(uint16_t rel_type, const std::string& type1, const std::string& key1,
                                           const std::string& type2, const std::string& key2, const std::string& properties);
         uint64_t RelationshipAddToOutgoing(uint16_t rel_type, uint64_t id1, uint64_t id2, const std::string& properties);
+        std::vector<uint64_t> RelationshipsAddToOutgoing(uint16_t rel_type_id, const std::vector<uint64_t>& ids1, const std::vector<uint64_t>& ids2,
+                                                         const std::vector<std::string>& properties);
+        uint64_t RelationshipsAddToIncoming(uint16_t rel_type_id, const std::vector<uint64_t>& rel_ids, const std::vector<uint64_t>& ids1,
+                                            const std::vector<uint64_t>& ids2);
         std::vector<Relationship> RelationshipsGet(const std::vector<uint64_t>&);
         Relationship RelationshipGet(uint64_t rel_id);
         std::string RelationshipGetType(uint64_t id);
         uint16_t RelationshipGetTypeId(uint64_t id);
         uint64_t RelationshipGetStartingNodeId(uint64_t id);
         uint64_t RelationshipGetEndingNodeId(uint64_t id);
+        bool RelationshipExists(uint64_t id1, uint64_t id2, const std::string& rel_type);
 
         // Relationship Property
         std::any RelationshipPropertyGet(uint64_t id, const std::string& property);
@@ -190,7 +327,9 @@ namespace ragedb {
         uint64_t NodeGetDegree(uint64_t id);
         uint64_t NodeGetDegree(uint64_t id, Direction direction);
         uint64_t NodeGetDegree(uint64_t id, Direction direction, const std::string& rel_type);
+        uint64_t NodeGetDegree(uint64_t id, Direction direction, uint16_t rel_type_id);
         uint64_t NodeGetDegree(uint64_t id, Direction direction, const std::vector<std::string> &rel_types);
+        uint64_t NodeGetDegree(uint64_t id, Direction direction, const std::vector<uint16_t> &rel_type_ids);
 
         // Traversing
         std::vector<Link> NodeGetRelationshipsIDs(const std::string& type, const std::string& key);
@@ -276,6 +415,8 @@ namespace ragedb {
         std::vector<Node> AllNodes(uint64_t skip = SKIP, uint64_t limit = LIMIT);
         std::vector<Node> AllNodes(const std::string& type, uint64_t skip = SKIP, uint64_t limit = LIMIT);
         std::vector<Node> AllNodes(uint16_t type_id, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+        Page<Node> AllNodes(const Cursor& cursor, uint64_t limit);
+        Page<Node> AllNodes(uint16_t type_id, const Cursor& cursor, uint64_t limit);
 
         std::vector<uint64_t> AllRelationshipIds(uint64_t skip = SKIP, uint64_t limit = LIMIT);
         std::vector<uint64_t> AllRelationshipIds(const std::string& rel_type, uint64_t skip = SKIP, uint64_t limit = LIMIT);
@@ -284,11 +425,60 @@ namespace ragedb {
         std::vector<Relationship> AllRelationships(uint64_t skip = SKIP, uint64_t limit = LIMIT);
         std::vector<Relationship> AllRelationships(const std::string& type, uint64_t skip = SKIP, uint64_t limit = LIMIT);
         std::vector<Relationship> AllRelationships(uint16_t type_id, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+        Page<Relationship> AllRelationships(const Cursor& cursor, uint64_t limit);
+        Page<Relationship> AllRelationships(uint16_t type_id, const Cursor& cursor, uint64_t limit);
 
         std::map<uint16_t, uint64_t> AllRelationshipIdCounts();
         uint64_t AllRelationshipIdCounts(const std::string& type);
         uint64_t AllRelationshipIdCounts(uint16_t type_id);
 
+        // Find
+        bool NodePropertyIndexAdd(uint16_t type_id, const std::string& key);
+        bool NodePropertyIndexDelete(uint16_t type_id, const std::string& key);
+        bool RelationshipPropertyIndexAdd(uint16_t type_id, const std::string& key);
+        bool RelationshipPropertyIndexDelete(uint16_t type_id, const std::string& key);
+
+        std::vector<uint64_t> FindNodeIds(const std::string& type, const std::string& property, Operation operation, const std::any& value, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+        std::vector<uint64_t> FindNodeIds(uint16_t type_id, const std::string& property, Operation operation, const std::any& value, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+        std::vector<Node> FindNodes(const std::string& type, const std::string& property, Operation operation, const std::any& value, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+        std::vector<Node> FindNodes(uint16_t type_id, const std::string& property, Operation operation, const std::any& value, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+        std::vector<uint64_t> FindRelationshipIds(const std::string& rel_type, const std::string& property, Operation operation, const std::any& value, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+        std::vector<uint64_t> FindRelationshipIds(uint16_t type_id, const std::string& property, Operation operation, const std::any& value, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+        std::vector<Relationship> FindRelationships(const std::string& rel_type, const std::string& property, Operation operation, const std::any& value, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+        std::vector<Relationship> FindRelationships(uint16_t type_id, const std::string& property, Operation operation, const std::any& value, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+
+        std::vector<uint64_t> FilterNodeIds(const std::string& type, const std::vector<Condition>& conditions, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+        std::vector<uint64_t> FilterNodeIds(uint16_t type_id, const std::vector<Condition>& conditions, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+        std::vector<Node> FilterNodes(const std::string& type, const std::vector<Condition>& conditions, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+        std::vector<Node> FilterNodes(uint16_t type_id, const std::vector<Condition>& conditions, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+        std::vector<uint64_t> FilterRelationshipIds(const std::string& rel_type, const std::vector<Condition>& conditions, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+        std::vector<uint64_t> FilterRelationshipIds(uint16_t type_id, const std::vector<Condition>& conditions, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+        std::vector<Relationship> FilterRelationships(const std::string& rel_type, const std::vector<Condition>& conditions, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+        std::vector<Relationship> FilterRelationships(uint16_t type_id, const std::vector<Condition>& conditions, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+
+        // Aggregate
+        Aggregations AggregateNodes(const std::string& type, const std::string& property, const std::string& group_by, const std::vector<Condition>& conditions);
+        Aggregations AggregateNodes(uint16_t type_id, const std::string& property, const std::string& group_by, const std::vector<Condition>& conditions);
+        Aggregations AggregateRelationships(const std::string& rel_type, const std::string& property, const std::string& group_by, const std::vector<Condition>& conditions);
+        Aggregations AggregateRelationships(uint16_t type_id, const std::string& property, const std::string& group_by, const std::vector<Condition>& conditions);
+
+        // Hops
+        std::map<uint16_t, std::vector<uint64_t>> TraversalExpand(uint64_t traversal_id, const std::vector<uint64_t>& ids, const Hop& hop);
+        std::vector<uint64_t> TraversalFinish(uint64_t traversal_id, const std::vector<uint64_t>& ids);
+
+        // Paths
+        std::vector<std::vector<PathStep>> PathExpand(const std::vector<uint64_t>& ids, const Hop& hop, const std::string& weight);
+        std::vector<double> RelationshipWeights(const std::vector<uint64_t>& rel_ids, const std::string& weight);
+
+        // Analytics
+        void SetAnalyticsGroup(seastar::scheduling_group group);
+        void SetAnalyticsShares(float shares);
+        uint64_t AnalyticsStart(uint64_t job_id, Algorithm algorithm, const Hop& hop, double damping);
+        AnalyticsStep AnalyticsInitialize(uint64_t job_id, uint64_t nodes);
+        std::map<uint16_t, AnalyticsMessages> AnalyticsSend(uint64_t job_id);
+        AnalyticsStep AnalyticsReceive(uint64_t job_id, const std::vector<AnalyticsMessages>& messages, double dangling);
+        uint64_t AnalyticsWrite(uint64_t job_id, const std::string& property);
+
         // *****************************************************************************************************************************
         //                                               Peered
         // *****************************************************************************************************************************
@@ -313,6 +503,12 @@ namespace ragedb {
         seastar::future<uint16_t> NodeTypeInsertPeered(const std::string& type);
         seastar::future<bool> DeleteNodeTypePeered(const std::string& type);
 
+        // Adjacency
+        seastar::future<uint64_t> NodeTypeFreezePeered(const std::string& type);
+
+        // Compaction
+        seastar::future<uint64_t> CompactPeered();
+
         // Relationship Type
         std::string RelationshipTypeGetTypePeered(uint16_t type_id);
         uint16_t RelationshipTypeGetTypeIdPeered(const std::string& type);
@@ -322,6 +518,7 @@ namespace ragedb {
         // Nodes
         seastar::future<uint64_t> NodeAddEmptyPeered(const std::string& type, const std::string& key);
         seastar::future<uint64_t> NodeAddPeered(const std::string& type, const std::string& key, const std::string& properties);
+        seastar::future<std::vector<uint64_t>> NodesAddPeered(const std::string& type, const std::vector<std::string>& keys, const std::vector<std::string>& properties);
         seastar::future<uint64_t> NodeGetIDPeered(const std::string& type, const std::string& key);
 
         seastar::future<Node> NodeGetPeered(const std::string& type, const std::string& key);
@@ -329,6 +526,8 @@ namespace ragedb {
         seastar::future<std::vector<Node>> NodesGetPeered(const std::vector<uint64_t> &ids);
         seastar::future<bool> NodeRemovePeered(const std::string& type, const std::string& key);
         seastar::future<bool> NodeRemovePeered(uint64_t id);
+        seastar::future<uint64_t> NodesRemovePeered(const std::vector<uint64_t>& ids);
+        seastar::future<uint64_t> NodesRemovePeered(const std::string& type, const std::vector<std::string>& keys);
         seastar::future<uint16_t> NodeGetTypeIdPeered(uint64_t id);
         seastar::future<std::string> NodeGetTypePeered(uint64_t id);
         seastar::future<std::string> NodeGetKeyPeered(uint64_t id);
@@ -369,6 +568,10 @@ namespace ragedb {
                                                         const std::string& type2, const std::string& key2, const std::string& properties);
         seastar::future<uint64_t> RelationshipAddPeered(const std::string& rel_type, uint64_t id1, uint64_t id2, const std::string& properties);
         seastar::future<uint64_t> RelationshipAddPeered(uint16_t rel_type_id, uint64_t id1, uint64_t id2, const std::string& properties);
+        seastar::future<std::vector<uint64_t>> RelationshipsAddPeered(const std::string& rel_type, const std::vector<uint64_t>& ids1, const std::vector<uint64_t>& ids2,
+                                                                      const std::vector<std::string>& properties);
+        seastar::future<std::vector<uint64_t>> RelationshipsAddPeered(uint16_t rel_type_id, const std::vector<uint64_t>& ids1, const std::vector<uint64_t>& ids2,
+                                                                      const std::vector<std::string>& properties);
         seastar::future<Relationship> RelationshipGetPeered(uint64_t id);
         seastar::future<std::vector<Relationship>> RelationshipsGetPeered(const std::vector<uint64_t> &ids);
         seastar::future<bool> RelationshipRemovePeered(uint64_t id);
@@ -376,6 +579,13 @@ namespace ragedb {
         seastar::future<uint16_t> RelationshipGetTypeIdPeered(uint64_t id);
         seastar::future<uint64_t> RelationshipGetStartingNodeIdPeered(uint64_t id);
         seastar::future<uint64_t> RelationshipGetEndingNodeIdPeered(uint64_t id);
+        seastar::future<bool> RelationshipExistsPeered(uint64_t id1, uint64_t id2, const std::string& rel_type);
+
+        // Bulk
+        seastar::future<uint64_t> NodesImportPeered(const std::string& type, const std::vector<std::string>& keys, const std::vector<std::string>& properties);
+        seastar::future<uint64_t> RelationshipsImportPeered(const std::string& rel_type, const std::vector<std::string>& types1, const std::vector<std::string>& keys1,
+                                                            const std::vector<std::string>& types2, const std::vector<std::string>& keys2,
+                                                            const std::vector<std::string>& properties);
 
         // Relationship Properties
         seastar::future<std::any> RelationshipPropertyGetPeered(uint64_t id, const std::string& property);
@@ -476,6 +686,47 @@ namespace ragedb {
         seastar::future<std::vector<Relationship>> AllRelationshipsPeered(uint64_t skip = SKIP, uint64_t limit = LIMIT);
         seastar::future<std::vector<Relationship>> AllRelationshipsPeered(const std::string& rel_type, uint64_t skip = SKIP, uint64_t limit = LIMIT);
 
+        seastar::future<Page<Node>> AllNodesPeered(const Cursor& cursor, uint64_t limit = LIMIT);
+        seastar::future<Page<Node>> AllNodesPeered(const std::string& type, const Cursor& cursor, uint64_t limit = LIMIT);
+        seastar::future<Page<Relationship>> AllRelationshipsPeered(const Cursor& cursor, uint64_t limit = LIMIT);
+        seastar::future<Page<Relationship>> AllRelationshipsPeered(const std::string& rel_type, const Cursor& cursor, uint64_t limit = LIMIT);
+
+        // Find
+        seastar::future<bool> NodePropertyIndexAddPeered(const std::string& type, const std::string& key);
+        seastar::future<bool> NodePropertyIndexDeletePeered(const std::string& type, const std::string& key);
+        seastar::future<bool> RelationshipPropertyIndexAddPeered(const std::string& rel_type, const std::string& key);
+        seastar::future<bool> RelationshipPropertyIndexDeletePeered(const std::string& rel_type, const std::string& key);
+
+        seastar::future<std::vector<uint64_t>> FindNodeIdsPeered(const std::string& type, const std::string& property, Operation operation, const std::any& value, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+        seastar::future<std::vector<Node>> FindNodesPeered(const std::string& type, const std::string& property, Operation operation, const std::any& value, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+        seastar::future<std::vector<uint64_t>> FindRelationshipIdsPeered(const std::string& rel_type, const std::string& property, Operation operation, const std::any& value, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+        seastar::future<std::vector<Relationship>> FindRelationshipsPeered(const std::string& rel_type, const std::string& property, Operation operation, const std::any& value, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+        seastar::future<std::vector<uint64_t>> FilterNodeIdsPeered(const std::string& type, const std::vector<Condition>& conditions, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+        seastar::future<std::vector<Node>> FilterNodesPeered(const std::string& type, const std::vector<Condition>& conditions, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+        seastar::future<std::vector<uint64_t>> FilterRelationshipIdsPeered(const std::string& rel_type, const std::vector<Condition>& conditions, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+        seastar::future<std::vector<Relationship>> FilterRelationshipsPeered(const std::string& rel_type, const std::vector<Condition>& conditions, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+
+        // Aggregate
+        seastar::future<Aggregations> AggregateNodesPeered(const std::string& type, const std::string& property, const std::string& group_by, const std::vector<Condition>& conditions);
+        seastar::future<Aggregations> AggregateRelationshipsPeered(const std::string& rel_type, const std::string& property, const std::string& group_by, const std::vector<Condition>& conditions);
+
+        // Hops
+        seastar::future<std::vector<uint64_t>> TraversePeered(const std::vector<uint64_t>& ids, const std::vector<Hop>& hops);
+        seastar::future<std::vector<uint64_t>> TraversePeered(const std::vector<uint64_t>& ids, Direction direction, const std::vector<std::string>& rel_types, uint64_t depth);
+
+        // Paths
+        seastar::future<Path> ShortestPathPeered(uint64_t id1, uint64_t id2, Direction direction, const std::vector<std::string>& rel_types, uint64_t max_depth);
+        seastar::future<Path> WeightedShortestPathPeered(uint64_t id1, uint64_t id2, Direction direction, const std::vector<std::string>& rel_types, const std::string& weight,
+                                                         uint64_t max_depth, double delta);
+
+        // Analytics
+        seastar::future<uint64_t> AnalyticsPeered(Algorithm algorithm, const Hop& hop, const std::string& property, uint64_t max_steps, double damping);
+        seastar::future<uint64_t> PageRankPeered(const std::vector<std::string>& rel_types, const std::string& property, uint64_t iterations, double damping);
+        seastar::future<uint64_t> ConnectedComponentsPeered(const std::vector<std::string>& rel_types, const std::string& property, uint64_t iterations);
+        seastar::future<uint64_t> LabelPropagationPeered(const std::vector<std::string>& rel_types, const std::string& property, uint64_t iterations);
+        seastar::future<uint64_t> TriangleCountPeered(const std::vector<std::string>& rel_types, const std::string& property);
+        seastar::future<uint64_t> ClusteringCoefficientPeered(const std::vector<std::string>& rel_types, const std::string& property);
+
         // *****************************************************************************************************************************
         //                                                              Via Lua
         // *****************************************************************************************************************************
@@ -502,15 +753,24 @@ namespace ragedb {
         uint16_t NodeTypeGetTypeIdViaLua(const std::string& type);
         uint16_t NodeTypeInsertViaLua(const std::string& type);
 
+        // Adjacency
+        uint64_t NodeTypeFreezeViaLua(const std::string& type);
+
+        // Compaction
+        uint64_t CompactViaLua();
+
         //Nodes
         uint64_t NodeAddEmptyViaLua(const std::string& type, const std::string& key);
         uint64_t NodeAddViaLua(const std::string& type, const std::string& key, const std::string& properties);
+        sol::as_table_t<std::vector<uint64_t>> NodesAddViaLua(const std::string& type, const std::vector<std::string>& keys, const std::vector<std::string>& properties);
         uint64_t NodeGetIdViaLua(const std::string& type, const std::string& key);
         sol::as_table_t<std::vector<Node>> NodesGetViaLua(const std::vector<uint64_t>&);
         Node NodeGetViaLua(const std::string& type, const std::string& key);
         Node NodeGetByIdViaLua(uint64_t id);
         bool NodeRemoveViaLua(const std::string& type, const std::string& key);
         bool NodeRemoveByIdViaLua(uint64_t id);
+        uint64_t NodesRemoveViaLua(const std::string& type, const std::vector<std::string>& keys);
+        uint64_t NodesRemoveByIdViaLua(const std::vector<uint64_t>& ids);
         uint16_t NodeGetTypeIdViaLua(uint64_t id);
         std::string NodeGetTypeViaLua(uint64_t id);
         std::string NodeGetKeyViaLua(uint64_t id);
@@ -538,6 +798,8 @@ namespace ragedb {
                                        const std::string& type2, const std::string& key2, const std::string& properties);
         uint64_t RelationshipAddByTypeIdByIdsViaLua(uint16_t rel_type_id, uint64_t id1, uint64_t id2, const std::string& properties);
         uint64_t RelationshipAddByIdsViaLua(const std::string& rel_type, uint64_t id1, uint64_t id2, const std::string& properties);
+        sol::as_table_t<std::vector<uint64_t>> RelationshipsAddByIdsViaLua(const std::string& rel_type, const std::vector<uint64_t>& ids1, const std::vector<uint64_t>& ids2,
+                                                                         const std::vector<std::string>& properties);
         sol::as_table_t<std::vector<Relationship>> RelationshipsGetViaLua(const std::vector<uint64_t> &ids);
         Relationship RelationshipGetViaLua(uint64_t id);
         bool RelationshipRemoveViaLua(uint64_t id);
@@ -545,6 +807,7 @@ namespace ragedb {
         uint16_t RelationshipGetTypeIdViaLua(uint64_t id);
         uint64_t RelationshipGetStartingNodeIdViaLua(uint64_t id);
         uint64_t RelationshipGetEndingNodeIdViaLua(uint64_t id);
+        bool RelationshipExistsViaLua(uint64_t id1, uint64_t id2, const std::string& rel_type);
 
         // Relationship Properties
         sol::object RelationshipPropertyGetViaLua(uint64_t id, const std::string& property);
@@ -643,6 +906,45 @@ namespace ragedb {
         sol::as_table_t<std::vector<Relationship>> AllRelationshipsViaLua(uint64_t skip = SKIP, uint64_t limit = LIMIT);
         sol::as_table_t<std::vector<Relationship>> AllRelationshipsForTypeViaLua(const std::string& rel_type, uint64_t skip = SKIP, uint64_t limit = LIMIT);
 
+        std::tuple<sol::as_table_t<std::vector<Node>>, std::string> AllNodesPageViaLua(const std::string& cursor, uint64_t limit = LIMIT);
+        std::tuple<sol::as_table_t<std::vector<Node>>, std::string> AllNodesForTypePageViaLua(const std::string& type, const std::string& cursor, uint64_t limit = LIMIT);
+        std::tuple<sol::as_table_t<std::vector<Relationship>>, std::string> AllRelationshipsPageViaLua(const std::string& cursor, uint64_t limit = LIMIT);
+        std::tuple<sol::as_table_t<std::vector<Relationship>>, std::string> AllRelationshipsForTypePageViaLua(const std::string& rel_type, const std::string& cursor, uint64_t limit = LIMIT);
+
+        // Find
+        bool NodePropertyIndexAddViaLua(const std::string& type, const std::string& key);
+        bool NodePropertyIndexDeleteViaLua(const std::string& type, const std::string& key);
+        bool RelationshipPropertyIndexAddViaLua(const std::string& rel_type, const std::string& key);
+        bool RelationshipPropertyIndexDeleteViaLua(const std::string& rel_type, const std::string& key);
+        sol::as_table_t<std::vector<uint64_t>> FindNodeIdsViaLua(const std::string& type, const std::string& property, const std::string& operation, const sol::object& value, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+        sol::as_table_t<std::vector<Node>> FindNodesViaLua(const std::string& type, const std::string& property, const std::string& operation, const sol::object& value, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+        sol::as_table_t<std::vector<uint64_t>> FindRelationshipIdsViaLua(const std::string& rel_type, const std::string& property, const std::string& operation, const sol::object& value, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+        sol::as_table_t<std::vector<Relationship>> FindRelationshipsViaLua(const std::string& rel_type, const std::string& property, const std::string& operation, const sol::object& value, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+        sol::as_table_t<std::vector<uint64_t>> FilterNodeIdsViaLua(const std::string& type, const sol::table& conditions, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+        sol::as_table_t<std::vector<Node>> FilterNodesViaLua(const std::string& type, const sol::table& conditions, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+        sol::as_table_t<std::vector<uint64_t>> FilterRelationshipIdsViaLua(const std::string& rel_type, const sol::table& conditions, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+        sol::as_table_t<std::vector<Relationship>> FilterRelationshipsViaLua(const std::string& rel_type, const sol::table& conditions, uint64_t skip = SKIP, uint64_t limit = LIMIT);
+
+        // Aggregate
+        sol::table AggregateNodesViaLua(const std::string& type, const std::string& property, const std::string& group_by, const sol::object& conditions);
+        sol::table AggregateRelationshipsViaLua(const std::string& rel_type, const std::string& property, const std::string& group_by, const sol::object& conditions);
+
+        // Hops
+        sol::as_table_t<std::vector<uint64_t>> TraverseViaLua(const std::vector<uint64_t>& ids, const sol::table& hops);
+        sol::as_table_t<std::vector<uint64_t>> KHopViaLua(const std::vector<uint64_t>& ids, Direction direction, const std::vector<std::string>& rel_types, uint64_t depth);
+
+        // Paths
+        sol::table ShortestPathViaLua(uint64_t id1, uint64_t id2, Direction direction, const std::vector<std::string>& rel_types, uint64_t max_depth);
+        sol::table WeightedShortestPathViaLua(uint64_t id1, uint64_t id2, Direction direction, const std::vector<std::string>& rel_types, const std::string& weight,
+                                              uint64_t max_depth, double delta);
+
+        // Analytics
+        uint64_t PageRankViaLua(const std::vector<std::string>& rel_types, const std::string& property, uint64_t iterations, double damping);
+        uint64_t ConnectedComponentsViaLua(const std::vector<std::string>& rel_types, const std::string& property, uint64_t iterations);
+        uint64_t LabelPropagationViaLua(const std::vector<std::string>& rel_types, const std::string& property, uint64_t iterations);
+        uint64_t TriangleCountViaLua(const std::vector<std::string>& rel_types, const std::string& property);
+        uint64_t ClusteringCoefficientViaLua(const std::vector<std::string>& rel_types, const std::string& property);
+
     };
 }
 
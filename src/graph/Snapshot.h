@@ -0,0 +1,228 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RAGEDB_SNAPSHOT_H
+#define RAGEDB_SNAPSHOT_H
+
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <roaring/roaring64map.hh>
+
+namespace ragedb {
+
+    // Snapshots are a flat little-endian binary image of the columnar vectors of a Shard.
+    // They are only meant to be read back by the same build on the same number of cores.
+    static const uint64_t SNAPSHOT_MAGIC = 0x3630544F48534752U; // "RGSHOT06"
+
+    class SnapshotWriter {
+    private:
+        std::string buffer;
+
+    public:
+        SnapshotWriter() = default;
+
+        // Serializer interface used by tsl::sparse_map::serialize
+        template<typename T>
+        void operator()(const T& value) {
+            static_assert(std::is_arithmetic_v<T>, "Only arithmetic values can be written directly");
+            buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        void operator()(const std::pair<std::string, uint64_t>& value) {
+            write(value.first);
+            operator()(value.second);
+        }
+
+        void operator()(const std::pair<uint64_t, uint64_t>& value) {
+            operator()(value.first);
+            operator()(value.second);
+        }
+
+        void write(const std::string& value) {
+            operator()(value.size());
+            buffer.append(value);
+        }
+
+        template<typename T>
+        void write(const std::vector<T>& values) {
+            static_assert(std::is_arithmetic_v<T>, "Only vectors of arithmetic values can be written directly");
+            operator()(static_cast<uint64_t>(values.size()));
+            buffer.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+        }
+
+        void write(const std::vector<bool>& values) {
+            operator()(values.size());
+            for (bool value : values) {
+                operator()(static_cast<uint8_t>(value));
+            }
+        }
+
+        void write(const std::vector<std::string>& values) {
+            operator()(values.size());
+            for (const auto& value : values) {
+                write(value);
+            }
+        }
+
+        template<typename T>
+        void write(const std::vector<std::vector<T>>& values) {
+            operator()(static_cast<uint64_t>(values.size()));
+            for (const auto& value : values) {
+                write(value);
+            }
+        }
+
+        void write(const Roaring64Map& bitmap) {
+            uint64_t size = bitmap.getSizeInBytes();
+            operator()(size);
+            size_t position = buffer.size();
+            buffer.resize(position + size);
+            bitmap.write(buffer.data() + position);
+        }
+
+        [[nodiscard]] const std::string& data() const {
+            return buffer;
+        }
+    };
+
+    class SnapshotReader {
+    private:
+        const char* buffer;
+        size_t size;
+        size_t position{0};
+        bool failed{false};
+
+        bool available(size_t bytes) {
+            if (failed || size - position < bytes) {
+                failed = true;
+                return false;
+            }
+            return true;
+        }
+
+    public:
+        SnapshotReader(const char* _buffer, size_t _size) : buffer(_buffer), size(_size) {}
+
+        // Deserializer interface used by tsl::sparse_map::deserialize
+        template<typename T>
+        T operator()() {
+            if constexpr (std::is_arithmetic_v<T>) {
+                T value{};
+                if (available(sizeof(T))) {
+                    std::memcpy(&value, buffer + position, sizeof(T));
+                    position += sizeof(T);
+                }
+                return value;
+            } else {
+                using Key = std::remove_const_t<typename T::first_type>;
+                using Value = typename T::second_type;
+                Key key = read<Key>();
+                Value value = operator()<Value>();
+                return T(std::move(key), value);
+            }
+        }
+
+        template<typename T>
+        T read() {
+            if constexpr (std::is_arithmetic_v<T>) {
+                return operator()<T>();
+            } else if constexpr (std::is_same_v<T, std::string>) {
+                auto length = operator()<uint64_t>();
+                if (!available(length)) {
+                    return std::string();
+                }
+                std::string value(buffer + position, length);
+                position += length;
+                return value;
+            } else if constexpr (std::is_same_v<T, std::vector<bool>>) {
+                auto count = operator()<uint64_t>();
+                std::vector<bool> values;
+                if (!available(count)) {
+                    return values;
+                }
+                values.reserve(count);
+                for (uint64_t i = 0; i < count; i++) {
+                    values.push_back(buffer[position + i] != 0);
+                }
+                position += count;
+                return values;
+            } else if constexpr (std::is_arithmetic_v<typename T::value_type>) {
+                using Value = typename T::value_type;
+                auto count = operator()<uint64_t>();
+                T values;
+                if (count > (size - position) / sizeof(Value) || !available(count * sizeof(Value))) {
+                    failed = true;
+                    return values;
+                }
+                values.resize(count);
+                std::memcpy(values.data(), buffer + position, count * sizeof(Value));
+                position += count * sizeof(Value);
+                return values;
+            } else {
+                auto count = operator()<uint64_t>();
+                T values;
+                if (!available(count)) {
+                    return values;
+                }
+                values.reserve(count);
+                for (uint64_t i = 0; i < count && !failed; i++) {
+                    values.emplace_back(read<typename T::value_type>());
+                }
+                return values;
+            }
+        }
+
+        Roaring64Map readBitmap() {
+            auto length = operator()<uint64_t>();
+            if (!available(length)) {
+                return Roaring64Map();
+            }
+            // readSafe never reads past length bytes, a corrupt bitmap throws or comes back a different size
+            Roaring64Map bitmap;
+            if (length < sizeof(uint64_t)) {
+                failed = true;
+                return bitmap;
+            }
+            try {
+                bitmap = Roaring64Map::readSafe(buffer + position, length);
+            } catch (const std::exception&) {
+                failed = true;
+                return Roaring64Map();
+            }
+            if (bitmap.getSizeInBytes() != length) {
+                failed = true;
+                return Roaring64Map();
+            }
+            position += length;
+            return bitmap;
+        }
+
+        [[nodiscard]] bool ok() const {
+            return !failed;
+        }
+
+        [[nodiscard]] bool done() const {
+            return !failed && position == size;
+        }
+    };
+}
+
+#endif //RAGEDB_SNAPSHOT_H
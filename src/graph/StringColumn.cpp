@@ -0,0 +1,192 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <algorithm>
+#include "StringColumn.h"
+
+namespace ragedb {
+
+    StringColumn::StringColumn() = default;
+
+    StringColumn::StringColumn(std::vector<std::string> column) {
+        codes.reserve(column.size());
+        for (const auto& value : column) {
+            codes.emplace_back(encode(value));
+            hold(codes.back());
+            if (dictionary.size() > DICTIONARY_MIN_VALUES && dictionary.size() * 2 > column.size()) {
+                // Too many distinct values, keep the column as it is
+                std::vector<uint32_t>().swap(codes);
+                clearDictionary();
+                values = std::move(column);
+                encoded = false;
+                return;
+            }
+        }
+    }
+
+    uint32_t StringColumn::encode(const std::string& value) {
+        auto search = dictionary_codes.find(value);
+        if (search != dictionary_codes.end()) {
+            return search->second;
+        }
+        uint32_t code;
+        if (free_codes.empty()) {
+            code = static_cast<uint32_t>(dictionary.size());
+            dictionary.emplace_back(value);
+            holders.emplace_back(0);
+        } else {
+            code = free_codes.back();
+            free_codes.pop_back();
+            dictionary[code] = value;
+        }
+        dictionary_codes.emplace(value, code);
+        // No row holds it until the caller stores it
+        stale++;
+        return code;
+    }
+
+    void StringColumn::hold(uint32_t code) {
+        if (code != 0 && holders[code]++ == 0) {
+            stale--;
+        }
+    }
+
+    void StringColumn::release(uint32_t code) {
+        if (code != 0 && --holders[code] == 0) {
+            stale++;
+        }
+    }
+
+    void StringColumn::decode() {
+        values.reserve(codes.size());
+        for (uint32_t code : codes) {
+            values.emplace_back(dictionary[code]);
+        }
+        std::vector<uint32_t>().swap(codes);
+        clearDictionary();
+        encoded = false;
+    }
+
+    void StringColumn::clearDictionary() {
+        dictionary.assign(1, "");
+        dictionary_codes.clear();
+        dictionary_codes.emplace("", 0);
+        holders.assign(1, 0);
+        std::vector<uint32_t>().swap(free_codes);
+        stale = 0;
+    }
+
+    size_t StringColumn::size() const {
+        return encoded ? codes.size() : values.size();
+    }
+
+    void StringColumn::resize(size_t size) {
+        if (encoded) {
+            for (size_t row = size; row < codes.size(); row++) {
+                release(codes[row]);
+            }
+            codes.resize(size, 0);
+        } else {
+            values.resize(size);
+        }
+    }
+
+    size_t StringColumn::capacity() const {
+        return encoded ? codes.capacity() : values.capacity();
+    }
+
+    void StringColumn::shrink_to_fit() {
+        if (encoded) {
+            codes.shrink_to_fit();
+        } else {
+            values.shrink_to_fit();
+        }
+    }
+
+    void StringColumn::compact() {
+        // Only the dictionary is looked at, rows keep their codes and freed codes are handed out again by encode
+        if (!encoded || stale * 4 <= dictionary.size()) {
+            return;
+        }
+        for (uint32_t code = 1; code < dictionary.size(); code++) {
+            if (holders[code] > 0) {
+                continue;
+            }
+            auto search = dictionary_codes.find(dictionary[code]);
+            // Codes freed by an earlier compaction hold the empty string, which belongs to code 0
+            if (search != dictionary_codes.end() && search->second == code) {
+                dictionary_codes.erase(search);
+                std::string().swap(dictionary[code]);
+                free_codes.emplace_back(code);
+            }
+        }
+        stale = 0;
+    }
+
+    const std::string& StringColumn::operator[](size_t row) const {
+        return encoded ? dictionary[codes[row]] : values[row];
+    }
+
+    void StringColumn::set(size_t row, const std::string& value) {
+        if (!encoded) {
+            if (value.empty()) {
+                // Swap rather than assign so the memory of the string is given back
+                std::string().swap(values[row]);
+            } else {
+                values[row] = value;
+            }
+            return;
+        }
+        uint32_t code = encode(value);
+        hold(code);
+        release(codes[row]);
+        codes[row] = code;
+        // Codes of values no longer held by any row stay in the dictionary until it is compacted, so count against it
+        if (dictionary.size() > DICTIONARY_MIN_VALUES && dictionary.size() * 2 > codes.size()) {
+            decode();
+        }
+    }
+
+    bool StringColumn::isEncoded() const {
+        return encoded;
+    }
+
+    const std::vector<uint32_t>& StringColumn::getCodes() const {
+        return codes;
+    }
+
+    const std::vector<std::string>& StringColumn::getDictionary() const {
+        return dictionary;
+    }
+
+    bool StringColumn::findCode(const std::string& value, uint32_t& code) const {
+        auto search = dictionary_codes.find(value);
+        if (search == dictionary_codes.end()) {
+            return false;
+        }
+        code = search->second;
+        return true;
+    }
+
+    void StringColumn::write(SnapshotWriter& writer) const {
+        writer(size());
+        for (size_t row = 0; row < size(); row++) {
+            writer.write(operator[](row));
+        }
+    }
+
+}
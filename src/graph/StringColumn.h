@@ -0,0 +1,91 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef RAGEDB_STRINGCOLUMN_H
+#define RAGEDB_STRINGCOLUMN_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <tsl/sparse_map.h>
+#include "Snapshot.h"
+
+namespace ragedb {
+
+    /**
+     * A column of string property values. Low cardinality columns (status, country, category) are
+     * dictionary encoded: each distinct value is stored once and every row holds a 32 bit code into
+     * the dictionary. Once the dictionary grows past half the rows the column falls back to plain strings.
+     * Rows are read with operator[] like a std::vector, and written with set.
+     */
+    class StringColumn {
+    private:
+        // Columns with fewer distinct values than this always stay encoded
+        static const size_t DICTIONARY_MIN_VALUES = 1024;
+
+        bool encoded = true;
+        // Code 0 is always the empty string, rows added by resize hold it
+        std::vector<std::string> dictionary = { "" };
+        tsl::sparse_map<std::string, uint32_t> dictionary_codes = { { "", 0 } };
+        std::vector<uint64_t> holders = { 0 };  // Rows holding each code, not counted for code 0
+        std::vector<uint32_t> free_codes;       // Codes given back by compact, handed out again first
+        size_t stale = 0;                       // Codes in the dictionary no row holds
+        std::vector<uint32_t> codes;
+        std::vector<std::string> values;
+
+        uint32_t encode(const std::string& value);
+        void hold(uint32_t code);
+        void release(uint32_t code);
+        void decode();
+        void clearDictionary();
+
+    public:
+        StringColumn();
+
+        explicit StringColumn(std::vector<std::string> column);
+
+        [[nodiscard]] size_t size() const;
+
+        void resize(size_t size);
+
+        [[nodiscard]] size_t capacity() const;
+
+        void shrink_to_fit();
+
+        // Give back the dictionary entries of values no row holds anymore, once they are a quarter of the dictionary
+        void compact();
+
+        const std::string& operator[](size_t row) const;
+
+        void set(size_t row, const std::string& value);
+
+        // True when rows are stored as codes into the dictionary
+        [[nodiscard]] bool isEncoded() const;
+
+        [[nodiscard]] const std::vector<uint32_t>& getCodes() const;
+
+        [[nodiscard]] const std::vector<std::string>& getDictionary() const;
+
+        // Find the code of a value, false when the value is not in the dictionary
+        bool findCode(const std::string& value, uint32_t& code) const;
+
+        // Written as a plain list of strings, the encoding is chosen again when read
+        void write(SnapshotWriter& writer) const;
+    };
+}
+
+#endif //RAGEDB_STRINGCOLUMN_H
@@ -0,0 +1,398 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <seastar/core/align.hh>
+#include <seastar/core/future-util.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/core/thread.hh>
+#include "Properties.h"
+#include "WriteAheadLog.h"
+
+namespace ragedb {
+
+    // Each record is its length, a checksum of its payload and the payload itself.
+    // A zero length marks the end of the log, it is what the padding of the last block reads as.
+    static const size_t RECORD_HEADER_SIZE = 2 * sizeof(uint32_t);
+
+    static uint32_t Checksum(const char* data, size_t length) {
+        // FNV-1a, enough to tell a torn write from a complete record
+        uint32_t hash = 2166136261U;
+        for (size_t i = 0; i < length; i++) {
+            hash ^= static_cast<uint8_t>(data[i]);
+            hash *= 16777619U;
+        }
+        return hash;
+    }
+
+    WriteAheadLog::WriteAheadLog() : timer([this] { Flush(); }) {}
+
+    bool WriteAheadLog::IsEnabled() const {
+        return enabled;
+    }
+
+    uint64_t WriteAheadLog::Generation() const {
+        return generation;
+    }
+
+    void WriteAheadLog::SetGeneration(uint64_t log_generation) {
+        if (!enabled) {
+            generation = log_generation;
+        }
+    }
+
+    std::string WriteAheadLog::Path(uint64_t log_generation) const {
+        return directory + "/shard-" + std::to_string(shard_id) + "-" + std::to_string(log_generation) + ".wal";
+    }
+
+    void WriteAheadLog::Encode(SnapshotWriter &record, const std::string &value) {
+        record.write(value);
+    }
+
+    void WriteAheadLog::Encode(SnapshotWriter &record, const std::any &value) {
+        if (value.type() == typeid(bool)) {
+            record(Properties::getBooleanPropertyType());
+            record(static_cast<uint8_t>(std::any_cast<bool>(value)));
+        } else if (value.type() == typeid(int64_t)) {
+            record(Properties::getIntegerPropertyType());
+            record(std::any_cast<int64_t>(value));
+        } else if (value.type() == typeid(double)) {
+            record(Properties::getDoublePropertyType());
+            record(std::any_cast<double>(value));
+        } else if (value.type() == typeid(std::string)) {
+            record(Properties::getStringPropertyType());
+            record.write(std::any_cast<std::string>(value));
+        } else if (value.type() == typeid(const char*)) {
+            record(Properties::getStringPropertyType());
+            record.write(std::string(std::any_cast<const char*>(value)));
+        } else if (value.type() == typeid(std::vector<bool>)) {
+            record(Properties::getBooleanListPropertyType());
+            record.write(std::any_cast<std::vector<bool>>(value));
+        } else if (value.type() == typeid(std::vector<int64_t>)) {
+            record(Properties::getIntegerListPropertyType());
+            record.write(std::any_cast<std::vector<int64_t>>(value));
+        } else if (value.type() == typeid(std::vector<double>)) {
+            record(Properties::getDoubleListPropertyType());
+            record.write(std::any_cast<std::vector<double>>(value));
+        } else if (value.type() == typeid(std::vector<std::string>)) {
+            record(Properties::getStringListPropertyType());
+            record.write(std::any_cast<std::vector<std::string>>(value));
+        } else {
+            // Shards reject values they can not store, replaying an empty one is rejected the same way
+            record(static_cast<uint16_t>(0));
+        }
+    }
+
+    void WriteAheadLog::Encode(SnapshotWriter &record, const std::map<uint16_t, std::vector<uint64_t>> &value) {
+        record(static_cast<uint64_t>(value.size()));
+        for (const auto& [key, ids] : value) {
+            record(key);
+            record.write(ids);
+        }
+    }
+
+    std::any WriteAheadLog::DecodeAny(SnapshotReader &record) {
+        switch (record.read<uint16_t>()) {
+            case Properties::getBooleanPropertyType():
+                return std::any(record.read<uint8_t>() != 0);
+            case Properties::getIntegerPropertyType():
+                return std::any(record.read<int64_t>());
+            case Properties::getDoublePropertyType():
+                return std::any(record.read<double>());
+            case Properties::getStringPropertyType():
+                return std::any(record.read<std::string>());
+            case Properties::getBooleanListPropertyType():
+                return std::any(record.read<std::vector<bool>>());
+            case Properties::getIntegerListPropertyType():
+                return std::any(record.read<std::vector<int64_t>>());
+            case Properties::getDoubleListPropertyType():
+                return std::any(record.read<std::vector<double>>());
+            case Properties::getStringListPropertyType():
+                return std::any(record.read<std::vector<std::string>>());
+            default:
+                return std::any();
+        }
+    }
+
+    std::map<uint16_t, std::vector<uint64_t>> WriteAheadLog::DecodeGroupedIds(SnapshotReader &record) {
+        std::map<uint16_t, std::vector<uint64_t>> grouped;
+        auto count = record.read<uint64_t>();
+        for (uint64_t i = 0; i < count && record.ok(); i++) {
+            auto key = record.read<uint16_t>();
+            grouped.insert({key, record.read<std::vector<uint64_t>>()});
+        }
+        return grouped;
+    }
+
+    void WriteAheadLog::Push(const std::string &record) {
+        auto length = static_cast<uint32_t>(record.size());
+        uint32_t checksum = Checksum(record.data(), record.size());
+        pending.append(reinterpret_cast<const char*>(&length), sizeof(length));
+        pending.append(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+        pending.append(record);
+        appended++;
+
+        // Everything appended until the timer fires goes out in the same write
+        if (!timer.armed()) {
+            timer.arm(window);
+        }
+    }
+
+    void WriteAheadLog::Acknowledge(uint64_t count) {
+        durable = std::max(durable, count);
+        while (!waiters.empty() && waiters.front().first <= durable) {
+            waiters.front().second.set_value();
+            waiters.pop_front();
+        }
+    }
+
+    void WriteAheadLog::Fail(uint64_t count, const std::exception_ptr& exception) {
+        durable = std::max(durable, count);
+        while (!waiters.empty() && waiters.front().first <= durable) {
+            waiters.front().second.set_exception(exception);
+            waiters.pop_front();
+        }
+    }
+
+    /**
+     * Write a batch of records after the tail of the current log file and flush it
+     *
+     * @param batch encoded records
+     * @return future once the batch is on disk
+     */
+    seastar::future<> WriteAheadLog::Write(std::string batch) {
+        if (batch.empty()) {
+            return seastar::make_ready_future<>();
+        }
+
+        // DMA writes are whole aligned blocks, so the last partial block is written again with the new records after it
+        size_t alignment = file.disk_write_dma_alignment();
+        size_t size = tail.size() + batch.size();
+        size_t length = seastar::align_up(size, alignment);
+        auto buffer = seastar::temporary_buffer<char>::aligned(alignment, length);
+        std::memcpy(buffer.get_write(), tail.data(), tail.size());
+        std::memcpy(buffer.get_write() + tail.size(), batch.data(), batch.size());
+        std::memset(buffer.get_write() + size, 0, length - size);
+
+        return seastar::do_with(std::move(buffer), [size, length, alignment, this] (seastar::temporary_buffer<char>& buffer) {
+            return file.dma_write(offset, buffer.get(), length).then([length, this] (size_t written) {
+                if (written < length) {
+                    throw std::runtime_error("short write to the write ahead log");
+                }
+                return file.flush();
+            }).then([size, alignment, &buffer, this] {
+                size_t kept = size % alignment;
+                tail.assign(buffer.get() + size - kept, kept);
+                offset += size - kept;
+            });
+        });
+    }
+
+    /**
+     * Group commit, write out every record appended since the last one
+     */
+    void WriteAheadLog::Flush() {
+        if (pending.empty()) {
+            return;
+        }
+        uint64_t count = appended;
+        static_cast<void>(seastar::with_semaphore(io, 1, [batch = std::move(pending), this] () mutable {
+            return Write(std::move(batch));
+        }).then_wrapped([count, this] (seastar::future<> written) {
+            if (written.failed()) {
+                Fail(count, written.get_exception());
+            } else {
+                Acknowledge(count);
+            }
+        }));
+        pending.clear();
+    }
+
+    seastar::future<> WriteAheadLog::OpenFile(uint64_t log_generation) {
+        std::string path = Path(log_generation);
+        return seastar::recursive_touch_directory(directory).then([path] {
+            return seastar::open_file_dma(path, seastar::open_flags::wo | seastar::open_flags::create | seastar::open_flags::truncate);
+        }).then([this] (seastar::file log) {
+            file = std::move(log);
+            offset = 0;
+            tail.clear();
+            // Make sure the new file itself survives a crash
+            return seastar::sync_directory(directory);
+        });
+    }
+
+    /**
+     * Start logging to a new file for the current generation
+     *
+     * @param log_directory where the log files are kept
+     * @param log_shard_id shard the log belongs to
+     * @param commit_window how long records wait to be grouped into a single write
+     * @return future once the log is accepting records
+     */
+    seastar::future<> WriteAheadLog::Open(const std::string &log_directory, uint log_shard_id, std::chrono::microseconds commit_window) {
+        directory = log_directory;
+        shard_id = log_shard_id;
+        window = commit_window;
+        return seastar::with_semaphore(io, 1, [this] {
+            return OpenFile(generation);
+        }).then([this] {
+            enabled = true;
+        });
+    }
+
+    /**
+     * Read the log files from the current generation onward and apply every complete record
+     *
+     * @param log_directory where the log files are kept
+     * @param log_shard_id shard the log belongs to
+     * @param apply called with each record
+     * @return future number of records replayed, the generation is left after the last log file
+     */
+    seastar::future<uint64_t> WriteAheadLog::Replay(const std::string &log_directory, uint log_shard_id, const std::function<void(SnapshotReader&)>& apply) {
+        directory = log_directory;
+        shard_id = log_shard_id;
+        oldest_generation = generation;
+
+        return seastar::async([apply, this] () {
+            uint64_t replayed = 0;
+            while (seastar::file_exists(Path(generation)).get0()) {
+                seastar::file log = seastar::open_file_dma(Path(generation), seastar::open_flags::ro).get0();
+                uint64_t size = log.size().get0();
+                seastar::temporary_buffer<char> data;
+                if (size > 0) {
+                    data = log.dma_read_exactly<char>(0, size).get0();
+                }
+                log.close().get();
+
+                // Stop at the padding or at a record torn by a crash, nothing after it was acknowledged
+                size_t position = 0;
+                while (data.size() - position >= RECORD_HEADER_SIZE) {
+                    uint32_t length;
+                    uint32_t checksum;
+                    std::memcpy(&length, data.get() + position, sizeof(length));
+                    std::memcpy(&checksum, data.get() + position + sizeof(length), sizeof(checksum));
+                    const char* payload = data.get() + position + RECORD_HEADER_SIZE;
+                    if (length == 0 || length > data.size() - position - RECORD_HEADER_SIZE || Checksum(payload, length) != checksum) {
+                        break;
+                    }
+                    SnapshotReader record(payload, length);
+                    apply(record);
+                    replayed++;
+                    position += RECORD_HEADER_SIZE + length;
+                }
+                generation++;
+            }
+            return replayed;
+        });
+    }
+
+    /**
+     * Wait for every record appended so far to be on disk
+     *
+     * @return future once they are durable
+     */
+    seastar::future<> WriteAheadLog::Commit() {
+        if (durable >= appended) {
+            return seastar::make_ready_future<>();
+        }
+        waiters.emplace_back(appended, seastar::promise<>());
+        return waiters.back().second.get_future();
+    }
+
+    /**
+     * Start a new generation, records appended from now on go to a new file
+     *
+     * @return future once the previous generation is durable and closed
+     */
+    seastar::future<> WriteAheadLog::Rotate() {
+        if (!enabled) {
+            return seastar::make_ready_future<>();
+        }
+        timer.cancel();
+        uint64_t count = appended;
+        uint64_t next = ++generation;
+        std::string batch = std::move(pending);
+        pending.clear();
+
+        return seastar::with_semaphore(io, 1, [batch = std::move(batch), next, this] () mutable {
+            return Write(std::move(batch)).then([this] {
+                return file.close();
+            }).then([next, this] {
+                return OpenFile(next);
+            });
+        }).then_wrapped([count, this] (seastar::future<> rotated) {
+            if (rotated.failed()) {
+                auto exception = rotated.get_exception();
+                Fail(count, exception);
+                return seastar::make_exception_future<>(exception);
+            }
+            Acknowledge(count);
+            return seastar::make_ready_future<>();
+        });
+    }
+
+    /**
+     * Delete the log files of generations a snapshot has made redundant
+     *
+     * @param before_generation first generation still needed
+     * @return future once they are deleted
+     */
+    seastar::future<> WriteAheadLog::Remove(uint64_t before_generation) {
+        if (directory.empty()) {
+            return seastar::make_ready_future<>();
+        }
+        return seastar::with_semaphore(io, 1, [before_generation, this] {
+            return seastar::do_until([before_generation, this] { return oldest_generation >= before_generation; }, [this] {
+                std::string path = Path(oldest_generation++);
+                return seastar::file_exists(path).then([path] (bool exists) {
+                    return exists ? seastar::remove_file(path) : seastar::make_ready_future<>();
+                });
+            }).then([this] {
+                return seastar::sync_directory(directory);
+            });
+        });
+    }
+
+    /**
+     * Write out any pending records and stop logging
+     *
+     * @return future once the log file is closed
+     */
+    seastar::future<> WriteAheadLog::Close() {
+        if (!enabled) {
+            return seastar::make_ready_future<>();
+        }
+        enabled = false;
+        timer.cancel();
+        uint64_t count = appended;
+        std::string batch = std::move(pending);
+        pending.clear();
+
+        return seastar::with_semaphore(io, 1, [batch = std::move(batch), this] () mutable {
+            return Write(std::move(batch)).then([this] {
+                return file.close();
+            });
+        }).then_wrapped([count, this] (seastar::future<> closed) {
+            if (closed.failed()) {
+                auto exception = closed.get_exception();
+                Fail(count, exception);
+                return seastar::make_exception_future<>(exception);
+            }
+            Acknowledge(count);
+            return seastar::make_ready_future<>();
+        });
+    }
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RAGEDB_WRITEAHEADLOG_H
+#define RAGEDB_WRITEAHEADLOG_H
+
+#include <any>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <seastar/core/file.hh>
+#include <seastar/core/future.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/timer.hh>
+#include "Snapshot.h"
+
+namespace ragedb {
+
+    // Every Shard method that changes data appends one of these before applying the change.
+    // Never renumber them, logs written by older builds must still replay.
+    enum class LogOperation : uint8_t {
+        NodeTypeInsert = 1,
+        DeleteNodeType = 2,
+        RelationshipTypeInsert = 3,
+        DeleteRelationshipType = 4,
+        NodePropertyTypeAdd = 5,
+        RelationshipPropertyTypeAdd = 6,
+        NodePropertyTypeDelete = 7,
+        RelationshipPropertyTypeDelete = 8,
+        NodeAddEmpty = 9,
+        NodeAdd = 10,
+        NodeRemove = 11,
+        NodeRemoveDeleteIncoming = 12,
+        NodeRemoveDeleteOutgoing = 13,
+        NodePropertySet = 14,
+        NodePropertySetFromJson = 15,
+        NodePropertyDelete = 16,
+        NodePropertiesSetFromJson = 17,
+        NodePropertiesResetFromJson = 18,
+        NodePropertiesDelete = 19,
+        RelationshipAddEmptySameShard = 20,
+        RelationshipAddSameShard = 21,
+        RelationshipAddEmptyToOutgoing = 22,
+        RelationshipAddToOutgoing = 23,
+        RelationshipAddToIncoming = 24,
+        RelationshipRemoveGetIncoming = 25,
+        RelationshipRemoveIncoming = 26,
+        RelationshipPropertySet = 27,
+        RelationshipPropertySetFromJson = 28,
+        RelationshipPropertyDelete = 29,
+        RelationshipPropertiesSetFromJson = 30,
+        RelationshipPropertiesResetFromJson = 31,
+        RelationshipPropertiesDelete = 32,
+        Clear = 33,
+        NodePropertyIndexAdd = 34,
+        NodePropertyIndexDelete = 35,
+        RelationshipPropertyIndexAdd = 36,
+        RelationshipPropertyIndexDelete = 37,
+        RelationshipRemoveIncomingFrom = 38
+    };
+
+    /**
+     * Append only log of the mutations of a single Shard.
+     *
+     * Records are buffered in memory and written by a group commit: every record appended within
+     * the commit window goes out in a single aligned DMA write followed by one flush. A log is split
+     * into generations, a snapshot starts a new generation so older ones can be removed once the
+     * snapshot is on disk. Recovery loads the snapshot and replays every generation after it.
+     */
+    class WriteAheadLog {
+    private:
+        std::string directory;
+        uint shard_id{0};
+        uint64_t generation{0};                         // Generation records are currently appended to
+        uint64_t oldest_generation{0};                  // Oldest generation still needed on disk
+        bool enabled{false};
+
+        seastar::file file;
+        uint64_t offset{0};                             // Aligned file offset of the tail
+        std::string tail;                               // Bytes of the last partial block already written
+
+        std::string pending;                            // Records waiting for the next group commit
+        uint64_t appended{0};                           // Number of records appended
+        uint64_t durable{0};                            // Number of records flushed to disk
+        std::deque<std::pair<uint64_t, seastar::promise<>>> waiters;
+
+        std::chrono::microseconds window{1000};
+        seastar::timer<> timer;
+        seastar::semaphore io{1};                       // Keep writes, rotations and closes in order
+
+        std::string Path(uint64_t log_generation) const;
+        void Push(const std::string& record);
+        void Flush();
+        seastar::future<> Write(std::string batch);
+        seastar::future<> OpenFile(uint64_t log_generation);
+        void Acknowledge(uint64_t count);
+        void Fail(uint64_t count, const std::exception_ptr& exception);
+
+        template<typename T, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+        static void Encode(SnapshotWriter& record, T value) {
+            record(value);
+        }
+
+        static void Encode(SnapshotWriter& record, const std::string& value);
+        static void Encode(SnapshotWriter& record, const std::any& value);
+        static void Encode(SnapshotWriter& record, const std::map<uint16_t, std::vector<uint64_t>>& value);
+
+    public:
+        WriteAheadLog();
+
+        [[nodiscard]] bool IsEnabled() const;
+        [[nodiscard]] uint64_t Generation() const;
+        void SetGeneration(uint64_t log_generation);
+
+        /**
+         * Append a mutation to the log, it is not durable until the next Commit resolves
+         *
+         * @param operation the Shard method being logged
+         * @param args the arguments of the method
+         */
+        template<typename... Args>
+        void Append(LogOperation operation, const Args&... args) {
+            if (!enabled) {
+                return;
+            }
+            SnapshotWriter record;
+            record(static_cast<uint8_t>(operation));
+            (Encode(record, args), ...);
+            Push(record.data());
+        }
+
+        static std::any DecodeAny(SnapshotReader& record);
+        static std::map<uint16_t, std::vector<uint64_t>> DecodeGroupedIds(SnapshotReader& record);
+
+        seastar::future<> Open(const std::string& log_directory, uint log_shard_id, std::chrono::microseconds commit_window);
+        seastar::future<uint64_t> Replay(const std::string& log_directory, uint log_shard_id, const std::function<void(SnapshotReader&)>& apply);
+        seastar::future<> Commit();
+        seastar::future<> Rotate();
+        seastar::future<> Remove(uint64_t before_generation);
+        seastar::future<> Close();
+    };
+}
+
+#endif //RAGEDB_WRITEAHEADLOG_H
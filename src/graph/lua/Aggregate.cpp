@@ -0,0 +1,54 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../Shard.h"
+
+namespace ragedb {
+
+    // Each group becomes a table of count, and sum, min, max and avg for numeric properties
+    sol::table Shard::AggregationsToLua(const Aggregations& aggregations) {
+        sol::table groups = lua.create_table();
+        for (const auto& [group, aggregation] : aggregations) {
+            sol::table values = lua.create_table();
+            values["count"] = aggregation.count;
+            if (aggregation.numeric) {
+                values["sum"] = aggregation.sum;
+                values["min"] = aggregation.min;
+                values["max"] = aggregation.max;
+                values["avg"] = aggregation.average();
+            }
+            groups[group] = values;
+        }
+        return groups;
+    }
+
+    sol::table Shard::AggregateNodesViaLua(const std::string& type, const std::string& property, const std::string& group_by, const sol::object& conditions) {
+        std::vector<Condition> parsed;
+        if (conditions.get_type() == sol::type::table) {
+            parsed = ConditionsFromLua(conditions.as<sol::table>());
+        }
+        return AggregationsToLua(AggregateNodesPeered(type, property, group_by, parsed).get0());
+    }
+
+    sol::table Shard::AggregateRelationshipsViaLua(const std::string& rel_type, const std::string& property, const std::string& group_by, const sol::object& conditions) {
+        std::vector<Condition> parsed;
+        if (conditions.get_type() == sol::type::table) {
+            parsed = ConditionsFromLua(conditions.as<sol::table>());
+        }
+        return AggregationsToLua(AggregateRelationshipsPeered(rel_type, property, group_by, parsed).get0());
+    }
+
+}
@@ -51,4 +51,41 @@ namespace ragedb {
         return sol::as_table(AllRelationshipsPeered(rel_type, skip, limit).get0());
     }
 
+    // Pages resume at the cursor returned with the last one, an empty cursor starts at the beginning and comes back at the end
+    std::tuple<sol::as_table_t<std::vector<Node>>, std::string> Shard::AllNodesPageViaLua(const std::string& cursor, uint64_t limit) {
+        Cursor start;
+        if (limit == 0 || !Cursor::decode(cursor, start)) {
+            return { sol::as_table(std::vector<Node>()), "" };
+        }
+        Page<Node> page = AllNodesPeered(start, limit).get0();
+        return { sol::as_table(std::move(page.results)), page.next.encode() };
+    }
+
+    std::tuple<sol::as_table_t<std::vector<Node>>, std::string> Shard::AllNodesForTypePageViaLua(const std::string& type, const std::string& cursor, uint64_t limit) {
+        Cursor start;
+        if (limit == 0 || !Cursor::decode(cursor, start)) {
+            return { sol::as_table(std::vector<Node>()), "" };
+        }
+        Page<Node> page = AllNodesPeered(type, start, limit).get0();
+        return { sol::as_table(std::move(page.results)), page.next.encode() };
+    }
+
+    std::tuple<sol::as_table_t<std::vector<Relationship>>, std::string> Shard::AllRelationshipsPageViaLua(const std::string& cursor, uint64_t limit) {
+        Cursor start;
+        if (limit == 0 || !Cursor::decode(cursor, start)) {
+            return { sol::as_table(std::vector<Relationship>()), "" };
+        }
+        Page<Relationship> page = AllRelationshipsPeered(start, limit).get0();
+        return { sol::as_table(std::move(page.results)), page.next.encode() };
+    }
+
+    std::tuple<sol::as_table_t<std::vector<Relationship>>, std::string> Shard::AllRelationshipsForTypePageViaLua(const std::string& rel_type, const std::string& cursor, uint64_t limit) {
+        Cursor start;
+        if (limit == 0 || !Cursor::decode(cursor, start)) {
+            return { sol::as_table(std::vector<Relationship>()), "" };
+        }
+        Page<Relationship> page = AllRelationshipsPeered(rel_type, start, limit).get0();
+        return { sol::as_table(std::move(page.results)), page.next.encode() };
+    }
+
 }
\ No newline at end of file
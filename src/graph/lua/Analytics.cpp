@@ -0,0 +1,42 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "../Shard.h"
+
+namespace ragedb {
+
+    uint64_t Shard::PageRankViaLua(const std::vector<std::string>& rel_types, const std::string& property, uint64_t iterations, double damping) {
+        return PageRankPeered(rel_types, property, iterations, damping).get0();
+    }
+
+    uint64_t Shard::ConnectedComponentsViaLua(const std::vector<std::string>& rel_types, const std::string& property, uint64_t iterations) {
+        return ConnectedComponentsPeered(rel_types, property, iterations).get0();
+    }
+
+    uint64_t Shard::LabelPropagationViaLua(const std::vector<std::string>& rel_types, const std::string& property, uint64_t iterations) {
+        return LabelPropagationPeered(rel_types, property, iterations).get0();
+    }
+
+    uint64_t Shard::TriangleCountViaLua(const std::vector<std::string>& rel_types, const std::string& property) {
+        return TriangleCountPeered(rel_types, property).get0();
+    }
+
+    uint64_t Shard::ClusteringCoefficientViaLua(const std::vector<std::string>& rel_types, const std::string& property) {
+        return ClusteringCoefficientPeered(rel_types, property).get0();
+    }
+
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../Shard.h"
+
+namespace ragedb {
+
+    std::any Shard::AnyFromLua(const sol::object& value) {
+        if (value.is<std::string>()) {
+            return value.as<std::string>();
+        }
+        if (value.is<int64_t>()) {
+            return value.as<int64_t>();
+        }
+        if (value.is<double>()) {
+            return value.as<double>();
+        }
+        if (value.is<bool>()) {
+            return value.as<bool>();
+        }
+        return std::any();
+    }
+
+    // Each condition is a table of property, operation and value, as in { "age", ">", 30 }
+    std::vector<Condition> Shard::ConditionsFromLua(const sol::table& conditions) {
+        std::vector<Condition> parsed;
+        for (const auto& entry : conditions) {
+            if (entry.second.get_type() != sol::type::table) {
+                continue;
+            }
+            auto condition = entry.second.as<sol::table>();
+            parsed.push_back(Condition { condition.get_or<std::string>(1, ""),
+                                         ParseOperation(condition.get_or<std::string>(2, "")),
+                                         AnyFromLua(condition.get<sol::object>(3)) });
+        }
+        return parsed;
+    }
+
+    bool Shard::NodePropertyIndexAddViaLua(const std::string& type, const std::string& key) {
+        return NodePropertyIndexAddPeered(type, key).get0();
+    }
+
+    bool Shard::NodePropertyIndexDeleteViaLua(const std::string& type, const std::string& key) {
+        return NodePropertyIndexDeletePeered(type, key).get0();
+    }
+
+    bool Shard::RelationshipPropertyIndexAddViaLua(const std::string& rel_type, const std::string& key) {
+        return RelationshipPropertyIndexAddPeered(rel_type, key).get0();
+    }
+
+    bool Shard::RelationshipPropertyIndexDeleteViaLua(const std::string& rel_type, const std::string& key) {
+        return RelationshipPropertyIndexDeletePeered(rel_type, key).get0();
+    }
+
+    sol::as_table_t<std::vector<uint64_t>> Shard::FindNodeIdsViaLua(const std::string& type, const std::string& property, const std::string& operation, const sol::object& value, uint64_t skip, uint64_t limit) {
+        return sol::as_table(FindNodeIdsPeered(type, property, ParseOperation(operation), AnyFromLua(value), skip, limit).get0());
+    }
+
+    sol::as_table_t<std::vector<Node>> Shard::FindNodesViaLua(const std::string& type, const std::string& property, const std::string& operation, const sol::object& value, uint64_t skip, uint64_t limit) {
+        return sol::as_table(FindNodesPeered(type, property, ParseOperation(operation), AnyFromLua(value), skip, limit).get0());
+    }
+
+    sol::as_table_t<std::vector<uint64_t>> Shard::FindRelationshipIdsViaLua(const std::string& rel_type, const std::string& property, const std::string& operation, const sol::object& value, uint64_t skip, uint64_t limit) {
+        return sol::as_table(FindRelationshipIdsPeered(rel_type, property, ParseOperation(operation), AnyFromLua(value), skip, limit).get0());
+    }
+
+    sol::as_table_t<std::vector<Relationship>> Shard::FindRelationshipsViaLua(const std::string& rel_type, const std::string& property, const std::string& operation, const sol::object& value, uint64_t skip, uint64_t limit) {
+        return sol::as_table(FindRelationshipsPeered(rel_type, property, ParseOperation(operation), AnyFromLua(value), skip, limit).get0());
+    }
+
+    sol::as_table_t<std::vector<uint64_t>> Shard::FilterNodeIdsViaLua(const std::string& type, const sol::table& conditions, uint64_t skip, uint64_t limit) {
+        return sol::as_table(FilterNodeIdsPeered(type, ConditionsFromLua(conditions), skip, limit).get0());
+    }
+
+    sol::as_table_t<std::vector<Node>> Shard::FilterNodesViaLua(const std::string& type, const sol::table& conditions, uint64_t skip, uint64_t limit) {
+        return sol::as_table(FilterNodesPeered(type, ConditionsFromLua(conditions), skip, limit).get0());
+    }
+
+    sol::as_table_t<std::vector<uint64_t>> Shard::FilterRelationshipIdsViaLua(const std::string& rel_type, const sol::table& conditions, uint64_t skip, uint64_t limit) {
+        return sol::as_table(FilterRelationshipIdsPeered(rel_type, ConditionsFromLua(conditions), skip, limit).get0());
+    }
+
+    sol::as_table_t<std::vector<Relationship>> Shard::FilterRelationshipsViaLua(const std::string& rel_type, const sol::table& conditions, uint64_t skip, uint64_t limit) {
+        return sol::as_table(FilterRelationshipsPeered(rel_type, ConditionsFromLua(conditions), skip, limit).get0());
+    }
+
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../Shard.h"
+
+namespace ragedb {
+
+    static Direction DirectionFromLua(const sol::object& direction) {
+        if (direction.is<std::string>()) {
+            std::string name = direction.as<std::string>();
+            if (name == "IN" || name == "in") {
+                return IN;
+            }
+            if (name == "OUT" || name == "out") {
+                return OUT;
+            }
+            return BOTH;
+        }
+        if (direction.is<int>()) {
+            int value = direction.as<int>();
+            return value == IN ? IN : value == OUT ? OUT : BOTH;
+        }
+        return BOTH;
+    }
+
+    // Each hop is a table of direction and relationship types, as in { "OUT", { "FRIENDS" } }
+    sol::as_table_t<std::vector<uint64_t>> Shard::TraverseViaLua(const std::vector<uint64_t>& ids, const sol::table& hops) {
+        std::vector<Hop> parsed;
+        for (const auto& entry : hops) {
+            if (entry.second.get_type() != sol::type::table) {
+                continue;
+            }
+            auto hop_table = entry.second.as<sol::table>();
+            Hop hop;
+            hop.direction = DirectionFromLua(hop_table.get<sol::object>(1));
+            sol::object rel_types = hop_table.get<sol::object>(2);
+            if (rel_types.get_type() == sol::type::table) {
+                for (const auto& rel_type : rel_types.as<sol::table>()) {
+                    hop.rel_type_ids.emplace_back(relationship_types.getTypeId(rel_type.second.as<std::string>()));
+                }
+            }
+            parsed.emplace_back(hop);
+        }
+        return sol::as_table(TraversePeered(ids, parsed).get0());
+    }
+
+    sol::as_table_t<std::vector<uint64_t>> Shard::KHopViaLua(const std::vector<uint64_t>& ids, Direction direction, const std::vector<std::string>& rel_types, uint64_t depth) {
+        return sol::as_table(TraversePeered(ids, direction, rel_types, depth).get0());
+    }
+
+}
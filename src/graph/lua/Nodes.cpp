@@ -26,6 +26,10 @@ namespace ragedb {
         return NodeAddPeered(type, key, properties).get0();
     }
 
+    sol::as_table_t<std::vector<uint64_t>> Shard::NodesAddViaLua(const std::string& type, const std::vector<std::string>& keys, const std::vector<std::string>& properties) {
+        return sol::as_table(NodesAddPeered(type, keys, properties).get0());
+    }
+
     uint64_t Shard::NodeGetIdViaLua(const std::string& type, const std::string& key) {
         return NodeGetIDPeered(type, key).get0();
     }
@@ -50,6 +54,14 @@ namespace ragedb {
         return NodeRemovePeered(id).get0();
     }
 
+    uint64_t Shard::NodesRemoveViaLua(const std::string& type, const std::vector<std::string>& keys) {
+        return NodesRemovePeered(type, keys).get0();
+    }
+
+    uint64_t Shard::NodesRemoveByIdViaLua(const std::vector<uint64_t>& ids) {
+        return NodesRemovePeered(ids).get0();
+    }
+
     uint16_t Shard::NodeGetTypeIdViaLua(uint64_t id) {
         return NodeGetTypeIdPeered(id).get0();
     }
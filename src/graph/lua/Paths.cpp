@@ -0,0 +1,40 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "../Shard.h"
+
+namespace ragedb {
+
+    // A path becomes a table of nodes, relationships and weight
+    sol::table Shard::PathToLua(const Path& path) {
+        sol::table values = lua.create_table();
+        values["nodes"] = sol::as_table(path.node_ids);
+        values["relationships"] = sol::as_table(path.rel_ids);
+        values["weight"] = path.weight;
+        return values;
+    }
+
+    sol::table Shard::ShortestPathViaLua(uint64_t id1, uint64_t id2, Direction direction, const std::vector<std::string>& rel_types, uint64_t max_depth) {
+        return PathToLua(ShortestPathPeered(id1, id2, direction, rel_types, max_depth).get0());
+    }
+
+    sol::table Shard::WeightedShortestPathViaLua(uint64_t id1, uint64_t id2, Direction direction, const std::vector<std::string>& rel_types, const std::string& weight,
+                                                 uint64_t max_depth, double delta) {
+        return PathToLua(WeightedShortestPathPeered(id1, id2, direction, rel_types, weight, max_depth, delta).get0());
+    }
+
+}
@@ -44,6 +44,11 @@ namespace ragedb {
         return RelationshipAddPeered(rel_type, id1, id2, properties).get0();
     }
 
+    sol::as_table_t<std::vector<uint64_t>> Shard::RelationshipsAddByIdsViaLua(const std::string& rel_type, const std::vector<uint64_t>& ids1, const std::vector<uint64_t>& ids2,
+                                                                            const std::vector<std::string>& properties) {
+        return sol::as_table(RelationshipsAddPeered(rel_type, ids1, ids2, properties).get0());
+    }
+
     Relationship Shard::RelationshipGetViaLua(uint64_t id) {
         return RelationshipGetPeered(id).get0();
     }
@@ -72,6 +77,10 @@ namespace ragedb {
         return RelationshipGetEndingNodeIdPeered(id).get0();
     }
 
+    bool Shard::RelationshipExistsViaLua(uint64_t id1, uint64_t id2, const std::string& rel_type) {
+        return RelationshipExistsPeered(id1, id2, rel_type).get0();
+    }
+
     sol::object Shard::RelationshipPropertyGetViaLua(uint64_t id, const std::string& property) {
         std::any value = RelationshipPropertyGetPeered(id, property).get0();
         const auto& value_type = value.type();
@@ -78,4 +78,14 @@ namespace ragedb {
         return NodeTypeInsertPeered(type).get0();
     }
 
+    // Adjacency
+    uint64_t Shard::NodeTypeFreezeViaLua(const std::string& type) {
+        return NodeTypeFreezePeered(type).get0();
+    }
+
+    // Compaction
+    uint64_t Shard::CompactViaLua() {
+        return CompactPeered().get0();
+    }
+
 }
\ No newline at end of file
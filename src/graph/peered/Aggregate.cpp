@@ -0,0 +1,59 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../Shard.h"
+
+namespace ragedb {
+
+    /**
+     * Aggregate a property of the nodes of a type. Every Shard aggregates its own nodes
+     * and the partial aggregations are merged here.
+     *
+     * @param type node type
+     * @param property property to aggregate, empty to count the nodes
+     * @param group_by property to group by, empty for a single group
+     * @param conditions conditions the nodes must match, none for every node of the type
+     * @return aggregation of each group
+     */
+    seastar::future<Aggregations> Shard::AggregateNodesPeered(const std::string& type, const std::string& property, const std::string& group_by, const std::vector<Condition>& conditions) {
+        seastar::future<std::vector<Aggregations>> v = container().map([type, property, group_by, conditions] (Shard &local_shard) {
+            return local_shard.AggregateNodes(type, property, group_by, conditions);
+        });
+
+        return v.then([] (const std::vector<Aggregations>& partials) {
+            Aggregations aggregations;
+            for (const auto& partial : partials) {
+                MergeAggregations(aggregations, partial);
+            }
+            return aggregations;
+        });
+    }
+
+    seastar::future<Aggregations> Shard::AggregateRelationshipsPeered(const std::string& rel_type, const std::string& property, const std::string& group_by, const std::vector<Condition>& conditions) {
+        seastar::future<std::vector<Aggregations>> v = container().map([rel_type, property, group_by, conditions] (Shard &local_shard) {
+            return local_shard.AggregateRelationships(rel_type, property, group_by, conditions);
+        });
+
+        return v.then([] (const std::vector<Aggregations>& partials) {
+            Aggregations aggregations;
+            for (const auto& partial : partials) {
+                MergeAggregations(aggregations, partial);
+            }
+            return aggregations;
+        });
+    }
+
+}
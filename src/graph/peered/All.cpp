@@ -465,4 +465,52 @@ namespace ragedb {
         });
     }
 
+    /**
+     * A page of all nodes resuming at a cursor. Each Shard picks up where the cursor left off on it,
+     * so a page costs the same however deep into the graph it is.
+     *
+     * @param cursor where the last page left off, the default cursor for the first page
+     * @param limit most nodes to return
+     * @return future nodes and the cursor of the next page, done when there are no more
+     */
+    seastar::future<Page<Node>> Shard::AllNodesPeered(const Cursor& cursor, uint64_t limit) {
+        if (cursor.shard_id >= cpus) {
+            return seastar::make_ready_future<Page<Node>>(Page<Node>{ {}, Cursor{ 0, 0, 0, true } });
+        }
+        return PagePeered<Node>(cursor, limit, [] (Shard &local_shard, const Cursor& next, uint64_t remaining) {
+            return local_shard.AllNodes(next, remaining);
+        });
+    }
+
+    seastar::future<Page<Node>> Shard::AllNodesPeered(const std::string& type, const Cursor& cursor, uint64_t limit) {
+        uint16_t node_type_id = node_types.getTypeId(type);
+        // A cursor of another type was not handed out for this one
+        if (node_type_id == 0 || cursor.shard_id >= cpus || (cursor.type_id != 0 && cursor.type_id != node_type_id)) {
+            return seastar::make_ready_future<Page<Node>>(Page<Node>{ {}, Cursor{ 0, 0, 0, true } });
+        }
+        return PagePeered<Node>(cursor, limit, [node_type_id] (Shard &local_shard, const Cursor& next, uint64_t remaining) {
+            return local_shard.AllNodes(node_type_id, next, remaining);
+        });
+    }
+
+    seastar::future<Page<Relationship>> Shard::AllRelationshipsPeered(const Cursor& cursor, uint64_t limit) {
+        if (cursor.shard_id >= cpus) {
+            return seastar::make_ready_future<Page<Relationship>>(Page<Relationship>{ {}, Cursor{ 0, 0, 0, true } });
+        }
+        return PagePeered<Relationship>(cursor, limit, [] (Shard &local_shard, const Cursor& next, uint64_t remaining) {
+            return local_shard.AllRelationships(next, remaining);
+        });
+    }
+
+    seastar::future<Page<Relationship>> Shard::AllRelationshipsPeered(const std::string& rel_type, const Cursor& cursor, uint64_t limit) {
+        uint16_t relationship_type_id = relationship_types.getTypeId(rel_type);
+        // A cursor of another type was not handed out for this one
+        if (relationship_type_id == 0 || cursor.shard_id >= cpus || (cursor.type_id != 0 && cursor.type_id != relationship_type_id)) {
+            return seastar::make_ready_future<Page<Relationship>>(Page<Relationship>{ {}, Cursor{ 0, 0, 0, true } });
+        }
+        return PagePeered<Relationship>(cursor, limit, [relationship_type_id] (Shard &local_shard, const Cursor& next, uint64_t remaining) {
+            return local_shard.AllRelationships(relationship_type_id, next, remaining);
+        });
+    }
+
 }
@@ -0,0 +1,172 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "../Shard.h"
+
+namespace ragedb {
+
+    /**
+     * Run an analytics job in bulk synchronous supersteps. Every Shard works on its own nodes in parallel and sends
+     * the messages for nodes of other Shards back here, to be handed out with the next superstep, so each superstep
+     * is one message exchange. The job and the work it asks of every Shard run on the analytics scheduling group.
+     *
+     * @param algorithm algorithm to run
+     * @param hop relationship types and direction to follow
+     * @param property node property to write the results to, created for every node type that does not have it
+     * @param max_steps most supersteps to run, the job ends earlier when no node changes
+     * @param damping probability of following a relationship, for PageRank
+     * @return the number of nodes written
+     */
+    seastar::future<uint64_t> Shard::AnalyticsPeered(Algorithm algorithm, const Hop& hop, const std::string& property, uint64_t max_steps, double damping) {
+        uint64_t job_id = (static_cast<uint64_t>(shard_id) << 48U) + analytics_count++;
+
+        return seastar::async(AnalyticsAttributes(), [job_id, algorithm, hop, property, max_steps, damping, this] () {
+            std::vector<seastar::future<uint64_t>> starts;
+            for (uint16_t their_shard = 0; their_shard < cpus; their_shard++) {
+                starts.push_back(container().invoke_on(their_shard, [job_id, algorithm, hop, damping] (Shard &local_shard) {
+                    return seastar::async(local_shard.AnalyticsAttributes(), [&local_shard, job_id, algorithm, hop, damping] {
+                        return local_shard.AnalyticsStart(job_id, algorithm, hop, damping);
+                    });
+                }));
+            }
+            std::vector<uint64_t> counts = seastar::when_all_succeed(starts.begin(), starts.end()).get0();
+            uint64_t nodes = 0;
+            for (uint64_t count : counts) {
+                nodes += count;
+            }
+
+            std::vector<seastar::future<AnalyticsStep>> initializations;
+            for (uint16_t their_shard = 0; their_shard < cpus; their_shard++) {
+                initializations.push_back(container().invoke_on(their_shard, [job_id, nodes] (Shard &local_shard) {
+                    return local_shard.AnalyticsInitialize(job_id, nodes);
+                }));
+            }
+            std::vector<AnalyticsStep> steps = seastar::when_all_succeed(initializations.begin(), initializations.end()).get0();
+
+            for (uint64_t step = 0; step < max_steps; step++) {
+                double dangling = 0;
+                for (const AnalyticsStep &shard_step : steps) {
+                    dangling += shard_step.dangling;
+                }
+
+                std::vector<seastar::future<std::map<uint16_t, AnalyticsMessages>>> sends;
+                for (uint16_t their_shard = 0; their_shard < cpus; their_shard++) {
+                    sends.push_back(container().invoke_on(their_shard, [job_id] (Shard &local_shard) {
+                        return seastar::async(local_shard.AnalyticsAttributes(), [&local_shard, job_id] {
+                            return local_shard.AnalyticsSend(job_id);
+                        });
+                    }));
+                }
+                std::vector<std::map<uint16_t, AnalyticsMessages>> sent = seastar::when_all_succeed(sends.begin(), sends.end()).get0();
+
+                std::vector<std::vector<AnalyticsMessages>> inboxes(cpus);
+                for (auto& shard_sent : sent) {
+                    for (auto& [their_shard, messages] : shard_sent) {
+                        inboxes[their_shard].emplace_back(std::move(messages));
+                    }
+                }
+
+                std::vector<seastar::future<AnalyticsStep>> receives;
+                for (uint16_t their_shard = 0; their_shard < cpus; their_shard++) {
+                    receives.push_back(container().invoke_on(their_shard, [job_id, messages = std::move(inboxes[their_shard]), dangling] (Shard &local_shard) mutable {
+                        return seastar::async(local_shard.AnalyticsAttributes(), [&local_shard, job_id, messages = std::move(messages), dangling] {
+                            return local_shard.AnalyticsReceive(job_id, messages, dangling);
+                        });
+                    }));
+                }
+                steps = seastar::when_all_succeed(receives.begin(), receives.end()).get0();
+
+                uint64_t changed = 0;
+                for (const AnalyticsStep &shard_step : steps) {
+                    changed += shard_step.changed;
+                }
+                if (changed == 0) {
+                    break;
+                }
+            }
+
+            // The property is created for every node type through Shard 0 so all Shards agree on its data type
+            std::string data_type = algorithm == Algorithm::PageRank || algorithm == Algorithm::ClusteringCoefficient ? "double" : "integer";
+            for (uint16_t type_id : node_types.getTypeIds()) {
+                container().invoke_on(0, [type_id, property, data_type] (Shard &local_shard) {
+                    return local_shard.NodePropertyTypeInsertPeered(type_id, property, data_type);
+                }).get0();
+            }
+
+            std::vector<seastar::future<uint64_t>> writes;
+            for (uint16_t their_shard = 0; their_shard < cpus; their_shard++) {
+                writes.push_back(container().invoke_on(their_shard, [job_id, property] (Shard &local_shard) {
+                    return seastar::async(local_shard.AnalyticsAttributes(), [&local_shard, job_id, property] {
+                        return local_shard.AnalyticsWrite(job_id, property);
+                    });
+                }));
+            }
+            std::vector<uint64_t> written = seastar::when_all_succeed(writes.begin(), writes.end()).get0();
+            uint64_t total = 0;
+            for (uint64_t count : written) {
+                total += count;
+            }
+            return total;
+        });
+    }
+
+    // Ranks follow outgoing relationships
+    seastar::future<uint64_t> Shard::PageRankPeered(const std::vector<std::string>& rel_types, const std::string& property, uint64_t iterations, double damping) {
+        Hop hop;
+        hop.direction = OUT;
+        for (const auto& rel_type : rel_types) {
+            hop.rel_type_ids.emplace_back(relationship_types.getTypeId(rel_type));
+        }
+        return AnalyticsPeered(Algorithm::PageRank, hop, property, iterations, damping);
+    }
+
+    // Components are labeled with the smallest node id in them, relationships are followed both ways
+    seastar::future<uint64_t> Shard::ConnectedComponentsPeered(const std::vector<std::string>& rel_types, const std::string& property, uint64_t iterations) {
+        Hop hop;
+        for (const auto& rel_type : rel_types) {
+            hop.rel_type_ids.emplace_back(relationship_types.getTypeId(rel_type));
+        }
+        return AnalyticsPeered(Algorithm::ConnectedComponents, hop, property, iterations, 0);
+    }
+
+    // Communities are labeled with the id of one of their nodes
+    seastar::future<uint64_t> Shard::LabelPropagationPeered(const std::vector<std::string>& rel_types, const std::string& property, uint64_t iterations) {
+        Hop hop;
+        for (const auto& rel_type : rel_types) {
+            hop.rel_type_ids.emplace_back(relationship_types.getTypeId(rel_type));
+        }
+        return AnalyticsPeered(Algorithm::LabelPropagation, hop, property, iterations, 0);
+    }
+
+    // Triangles take two supersteps, one to find them and one to tell the corners that did not find them
+    seastar::future<uint64_t> Shard::TriangleCountPeered(const std::vector<std::string>& rel_types, const std::string& property) {
+        Hop hop;
+        for (const auto& rel_type : rel_types) {
+            hop.rel_type_ids.emplace_back(relationship_types.getTypeId(rel_type));
+        }
+        return AnalyticsPeered(Algorithm::TriangleCount, hop, property, 2, 0);
+    }
+
+    seastar::future<uint64_t> Shard::ClusteringCoefficientPeered(const std::vector<std::string>& rel_types, const std::string& property) {
+        Hop hop;
+        for (const auto& rel_type : rel_types) {
+            hop.rel_type_ids.emplace_back(relationship_types.getTypeId(rel_type));
+        }
+        return AnalyticsPeered(Algorithm::ClusteringCoefficient, hop, property, 2, 0);
+    }
+
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "../Shard.h"
+
+namespace ragedb {
+
+    void Shard::RegisterBatchingMetrics() {
+        node_gets.RegisterMetrics("node_get");
+        node_property_gets.RegisterMetrics("node_property_get");
+        relationship_gets.RegisterMetrics("relationship_get");
+        relationship_property_gets.RegisterMetrics("relationship_property_get");
+    }
+
+    // Wait for the point reads already sent to other Shards
+    seastar::future<> Shard::StopBatching() {
+        return seastar::when_all_succeed(node_gets.Close(), node_property_gets.Close(), relationship_gets.Close(), relationship_property_gets.Close()).discard_result();
+    }
+
+    seastar::future<std::vector<Node>> Shard::NodeGetBatch(uint16_t their_shard, std::vector<uint64_t> ids) {
+        return container().invoke_on(their_shard, [ids = std::move(ids)] (Shard &local_shard) {
+            std::vector<Node> nodes;
+            nodes.reserve(ids.size());
+            for (uint64_t id : ids) {
+                nodes.emplace_back(local_shard.NodeGet(id));
+            }
+            return nodes;
+        });
+    }
+
+    seastar::future<std::vector<std::any>> Shard::NodePropertyGetBatch(uint16_t their_shard, std::vector<std::pair<uint64_t, std::string>> requests) {
+        return container().invoke_on(their_shard, [requests = std::move(requests)] (Shard &local_shard) {
+            std::vector<std::any> values;
+            values.reserve(requests.size());
+            for (const auto& [id, property] : requests) {
+                values.emplace_back(local_shard.NodePropertyGet(id, property));
+            }
+            return values;
+        });
+    }
+
+    seastar::future<std::vector<Relationship>> Shard::RelationshipGetBatch(uint16_t their_shard, std::vector<uint64_t> ids) {
+        return container().invoke_on(their_shard, [ids = std::move(ids)] (Shard &local_shard) {
+            std::vector<Relationship> relationships;
+            relationships.reserve(ids.size());
+            for (uint64_t id : ids) {
+                relationships.emplace_back(local_shard.RelationshipGet(id));
+            }
+            return relationships;
+        });
+    }
+
+    seastar::future<std::vector<std::any>> Shard::RelationshipPropertyGetBatch(uint16_t their_shard, std::vector<std::pair<uint64_t, std::string>> requests) {
+        return container().invoke_on(their_shard, [requests = std::move(requests)] (Shard &local_shard) {
+            std::vector<std::any> values;
+            values.reserve(requests.size());
+            for (const auto& [id, property] : requests) {
+                values.emplace_back(local_shard.RelationshipPropertyGet(id, property));
+            }
+            return values;
+        });
+    }
+
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include "../Shard.h"
+
+namespace ragedb {
+
+    /**
+     * Add a batch of nodes of one type, sending each Shard its part of the batch in a single message
+     *
+     * @param type node type, created if it does not exist yet
+     * @param keys node keys
+     * @param properties node properties as json, empty or one entry per key
+     * @return the number of nodes created, existing keys are skipped
+     */
+    seastar::future<uint64_t> Shard::NodesImportPeered(const std::string &type, const std::vector<std::string> &keys, const std::vector<std::string> &properties) {
+        return NodesAddPeered(type, keys, properties).then([] (const std::vector<uint64_t>& ids) {
+            return static_cast<uint64_t>(std::count_if(std::begin(ids), std::end(ids), [] (uint64_t id) { return id > 0; }));
+        });
+    }
+
+    /**
+     * Add a batch of relationships of one type between nodes given by type and key.
+     * Node ids are looked up with one message per Shard, then the relationships between the
+     * nodes that were found are added by RelationshipsAddPeered, also with one message per Shard.
+     *
+     * @param rel_type relationship type, created if it does not exist yet
+     * @param types1 starting node types
+     * @param keys1 starting node keys
+     * @param types2 ending node types
+     * @param keys2 ending node keys
+     * @param properties relationship properties as json, empty or one entry per relationship
+     * @return the number of relationships created, the ones with a missing node are skipped
+     */
+    seastar::future<uint64_t> Shard::RelationshipsImportPeered(const std::string &rel_type, const std::vector<std::string> &types1, const std::vector<std::string> &keys1,
+                                                               const std::vector<std::string> &types2, const std::vector<std::string> &keys2,
+                                                               const std::vector<std::string> &properties) {
+        // Both ends of relationship i are looked up at positions 2i and 2i + 1
+        std::map<uint16_t, std::vector<std::string>> sharded_types;
+        std::map<uint16_t, std::vector<std::string>> sharded_keys;
+        std::map<uint16_t, std::vector<size_t>> sharded_positions;
+        for (size_t i = 0; i < keys1.size(); i++) {
+            uint16_t shard_id1 = CalculateShardId(types1[i], keys1[i]);
+            sharded_types[shard_id1].emplace_back(types1[i]);
+            sharded_keys[shard_id1].emplace_back(keys1[i]);
+            sharded_positions[shard_id1].emplace_back(2 * i);
+            uint16_t shard_id2 = CalculateShardId(types2[i], keys2[i]);
+            sharded_types[shard_id2].emplace_back(types2[i]);
+            sharded_keys[shard_id2].emplace_back(keys2[i]);
+            sharded_positions[shard_id2].emplace_back(2 * i + 1);
+        }
+
+        return seastar::async([rel_type, sharded_types = std::move(sharded_types), sharded_keys = std::move(sharded_keys),
+                               sharded_positions = std::move(sharded_positions), properties, count = keys1.size(), this] () mutable {
+            uint16_t rel_type_id = relationship_types.getTypeId(rel_type);
+            // The relationship type needs to be set by Shard 0 and propagated
+            if (rel_type_id == 0) {
+                rel_type_id = container().invoke_on(0, [rel_type] (Shard &local_shard) {
+                    return local_shard.RelationshipTypeInsertPeered(rel_type);
+                }).get0();
+            }
+
+            std::vector<seastar::future<std::vector<uint64_t>>> lookups;
+            for (auto& [their_shard, grouped_keys] : sharded_keys) {
+                lookups.push_back(container().invoke_on(their_shard, [grouped_types = std::move(sharded_types[their_shard]), grouped_keys = std::move(grouped_keys)] (Shard &local_shard) {
+                    return local_shard.NodeGetIDs(grouped_types, grouped_keys);
+                }));
+            }
+            std::vector<std::vector<uint64_t>> found = seastar::when_all_succeed(lookups.begin(), lookups.end()).get0();
+
+            std::vector<uint64_t> node_ids(2 * count, 0);
+            size_t lookup = 0;
+            for (const auto& [their_shard, positions] : sharded_positions) {
+                for (size_t j = 0; j < positions.size(); j++) {
+                    node_ids[positions[j]] = found[lookup][j];
+                }
+                lookup++;
+            }
+
+            std::vector<uint64_t> ids1;
+            std::vector<uint64_t> ids2;
+            std::vector<std::string> found_properties;
+            ids1.reserve(count);
+            ids2.reserve(count);
+            bool with_properties = properties.size() == count;
+            for (size_t i = 0; i < count; i++) {
+                if (node_ids[2 * i] > 0 && node_ids[2 * i + 1] > 0) {
+                    ids1.emplace_back(node_ids[2 * i]);
+                    ids2.emplace_back(node_ids[2 * i + 1]);
+                    if (with_properties) {
+                        found_properties.emplace_back(std::move(properties[i]));
+                    }
+                }
+            }
+
+            std::vector<uint64_t> rel_ids = RelationshipsAddPeered(rel_type_id, ids1, ids2, found_properties).get0();
+            return static_cast<uint64_t>(std::count_if(std::begin(rel_ids), std::end(rel_ids), [] (uint64_t id) { return id > 0; }));
+        });
+    }
+
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include "../Shard.h"
+
+namespace ragedb {
+
+    /**
+     * Index a node property on every Shard, so finding nodes by it does not scan the column
+     *
+     * @param type node type
+     * @param key property to index
+     * @return true if every Shard built the index
+     */
+    seastar::future<bool> Shard::NodePropertyIndexAddPeered(const std::string& type, const std::string& key) {
+        uint16_t type_id = node_types.getTypeId(type);
+        if (type_id == 0) {
+            return seastar::make_ready_future<bool>(false);
+        }
+
+        seastar::future<std::vector<bool>> v = container().map([type_id, key] (Shard &local_shard) {
+            return local_shard.Durable(local_shard.NodePropertyIndexAdd(type_id, key));
+        });
+
+        return v.then([] (const std::vector<bool>& results) {
+            return std::all_of(std::begin(results), std::end(results), [] (bool result) { return result; });
+        });
+    }
+
+    seastar::future<bool> Shard::NodePropertyIndexDeletePeered(const std::string& type, const std::string& key) {
+        uint16_t type_id = node_types.getTypeId(type);
+        if (type_id == 0) {
+            return seastar::make_ready_future<bool>(false);
+        }
+
+        seastar::future<std::vector<bool>> v = container().map([type_id, key] (Shard &local_shard) {
+            return local_shard.Durable(local_shard.NodePropertyIndexDelete(type_id, key));
+        });
+
+        return v.then([] (const std::vector<bool>& results) {
+            return std::all_of(std::begin(results), std::end(results), [] (bool result) { return result; });
+        });
+    }
+
+    seastar::future<bool> Shard::RelationshipPropertyIndexAddPeered(const std::string& rel_type, const std::string& key) {
+        uint16_t type_id = relationship_types.getTypeId(rel_type);
+        if (type_id == 0) {
+            return seastar::make_ready_future<bool>(false);
+        }
+
+        seastar::future<std::vector<bool>> v = container().map([type_id, key] (Shard &local_shard) {
+            return local_shard.Durable(local_shard.RelationshipPropertyIndexAdd(type_id, key));
+        });
+
+        return v.then([] (const std::vector<bool>& results) {
+            return std::all_of(std::begin(results), std::end(results), [] (bool result) { return result; });
+        });
+    }
+
+    seastar::future<bool> Shard::RelationshipPropertyIndexDeletePeered(const std::string& rel_type, const std::string& key) {
+        uint16_t type_id = relationship_types.getTypeId(rel_type);
+        if (type_id == 0) {
+            return seastar::make_ready_future<bool>(false);
+        }
+
+        seastar::future<std::vector<bool>> v = container().map([type_id, key] (Shard &local_shard) {
+            return local_shard.Durable(local_shard.RelationshipPropertyIndexDelete(type_id, key));
+        });
+
+        return v.then([] (const std::vector<bool>& results) {
+            return std::all_of(std::begin(results), std::end(results), [] (bool result) { return result; });
+        });
+    }
+
+    seastar::future<std::vector<uint64_t>> Shard::FindNodeIdsPeered(const std::string& type, const std::string& property, Operation operation, const std::any& value, uint64_t skip, uint64_t limit) {
+        return FilterNodeIdsPeered(type, { Condition { property, operation, value } }, skip, limit);
+    }
+
+    seastar::future<std::vector<Node>> Shard::FindNodesPeered(const std::string& type, const std::string& property, Operation operation, const std::any& value, uint64_t skip, uint64_t limit) {
+        return FilterNodesPeered(type, { Condition { property, operation, value } }, skip, limit);
+    }
+
+    seastar::future<std::vector<uint64_t>> Shard::FindRelationshipIdsPeered(const std::string& rel_type, const std::string& property, Operation operation, const std::any& value, uint64_t skip, uint64_t limit) {
+        return FilterRelationshipIdsPeered(rel_type, { Condition { property, operation, value } }, skip, limit);
+    }
+
+    seastar::future<std::vector<Relationship>> Shard::FindRelationshipsPeered(const std::string& rel_type, const std::string& property, Operation operation, const std::any& value, uint64_t skip, uint64_t limit) {
+        return FilterRelationshipsPeered(rel_type, { Condition { property, operation, value } }, skip, limit);
+    }
+
+    /**
+     * Find the nodes of a type on every Shard that match every condition of a filter.
+     * Each Shard evaluates the filter against its own property columns in parallel and returns
+     * at most skip + limit matches, which are paged in Shard order.
+     *
+     * @param type node type
+     * @param conditions conditions that must all match
+     * @param skip matches to skip
+     * @param limit most matches to return
+     * @return external ids of the matching nodes
+     */
+    seastar::future<std::vector<uint64_t>> Shard::FilterNodeIdsPeered(const std::string& type, const std::vector<Condition>& conditions, uint64_t skip, uint64_t limit) {
+        uint64_t max = skip + limit;
+        seastar::future<std::vector<std::vector<uint64_t>>> v = container().map([type, conditions, max] (Shard &local_shard) {
+            return local_shard.FilterNodeIds(type, conditions, 0, max);
+        });
+
+        return v.then([skip, limit] (const std::vector<std::vector<uint64_t>>& results) {
+            std::vector<uint64_t> ids;
+            uint64_t current = 0;
+            for (const auto& result : results) {
+                for (uint64_t id : result) {
+                    if (current >= skip + limit) {
+                        return ids;
+                    }
+                    if (current++ >= skip) {
+                        ids.emplace_back(id);
+                    }
+                }
+            }
+            return ids;
+        });
+    }
+
+    seastar::future<std::vector<Node>> Shard::FilterNodesPeered(const std::string& type, const std::vector<Condition>& conditions, uint64_t skip, uint64_t limit) {
+        uint64_t max = skip + limit;
+        seastar::future<std::vector<std::vector<Node>>> v = container().map([type, conditions, max] (Shard &local_shard) {
+            return local_shard.FilterNodes(type, conditions, 0, max);
+        });
+
+        return v.then([skip, limit] (const std::vector<std::vector<Node>>& results) {
+            std::vector<Node> nodes;
+            uint64_t current = 0;
+            for (const auto& result : results) {
+                for (const Node& node : result) {
+                    if (current >= skip + limit) {
+                        return nodes;
+                    }
+                    if (current++ >= skip) {
+                        nodes.emplace_back(node);
+                    }
+                }
+            }
+            return nodes;
+        });
+    }
+
+    seastar::future<std::vector<uint64_t>> Shard::FilterRelationshipIdsPeered(const std::string& rel_type, const std::vector<Condition>& conditions, uint64_t skip, uint64_t limit) {
+        uint64_t max = skip + limit;
+        seastar::future<std::vector<std::vector<uint64_t>>> v = container().map([rel_type, conditions, max] (Shard &local_shard) {
+            return local_shard.FilterRelationshipIds(rel_type, conditions, 0, max);
+        });
+
+        return v.then([skip, limit] (const std::vector<std::vector<uint64_t>>& results) {
+            std::vector<uint64_t> ids;
+            uint64_t current = 0;
+            for (const auto& result : results) {
+                for (uint64_t id : result) {
+                    if (current >= skip + limit) {
+                        return ids;
+                    }
+                    if (current++ >= skip) {
+                        ids.emplace_back(id);
+                    }
+                }
+            }
+            return ids;
+        });
+    }
+
+    seastar::future<std::vector<Relationship>> Shard::FilterRelationshipsPeered(const std::string& rel_type, const std::vector<Condition>& conditions, uint64_t skip, uint64_t limit) {
+        uint64_t max = skip + limit;
+        seastar::future<std::vector<std::vector<Relationship>>> v = container().map([rel_type, conditions, max] (Shard &local_shard) {
+            return local_shard.FilterRelationships(rel_type, conditions, 0, max);
+        });
+
+        return v.then([skip, limit] (const std::vector<std::vector<Relationship>>& results) {
+            std::vector<Relationship> relationships;
+            uint64_t current = 0;
+            for (const auto& result : results) {
+                for (const Relationship& relationship : result) {
+                    if (current >= skip + limit) {
+                        return relationships;
+                    }
+                    if (current++ >= skip) {
+                        relationships.emplace_back(relationship);
+                    }
+                }
+            }
+            return relationships;
+        });
+    }
+
+}
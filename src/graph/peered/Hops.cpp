@@ -0,0 +1,87 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include "../Shard.h"
+
+namespace ragedb {
+
+    /**
+     * Traverse from a set of nodes, one hop per level. Each level every Shard expands its part of the frontier
+     * in parallel and only the ids of the next frontier travel between Shards, so a traversal takes one message
+     * round per hop plus one to collect the result.
+     *
+     * @param ids nodes to start from
+     * @param hops relationship types and direction to follow at each level
+     * @return ids of the nodes first reached at the last hop, in id order
+     */
+    seastar::future<std::vector<uint64_t>> Shard::TraversePeered(const std::vector<uint64_t>& ids, const std::vector<Hop>& hops) {
+        std::map<uint16_t, std::vector<uint64_t>> sharded_ids;
+        for (uint64_t id : ids) {
+            sharded_ids[CalculateShardId(id)].emplace_back(id);
+        }
+        uint64_t traversal_id = (static_cast<uint64_t>(shard_id) << 48U) + traversal_count++;
+
+        return seastar::async([traversal_id, sharded_ids = std::move(sharded_ids), hops, this] () mutable {
+            for (const Hop& hop : hops) {
+                std::vector<seastar::future<std::map<uint16_t, std::vector<uint64_t>>>> futures;
+                for (const auto& [their_shard, grouped_ids] : sharded_ids) {
+                    futures.push_back(container().invoke_on(their_shard, [traversal_id, grouped_ids = grouped_ids, hop] (Shard &local_shard) {
+                        return local_shard.TraversalExpand(traversal_id, grouped_ids, hop);
+                    }));
+                }
+                std::vector<std::map<uint16_t, std::vector<uint64_t>>> results = seastar::when_all_succeed(futures.begin(), futures.end()).get0();
+
+                std::map<uint16_t, std::vector<uint64_t>> next;
+                for (auto& result : results) {
+                    for (auto& [their_shard, grouped_ids] : result) {
+                        next[their_shard].insert(next[their_shard].end(), grouped_ids.begin(), grouped_ids.end());
+                    }
+                }
+                sharded_ids = std::move(next);
+                if (sharded_ids.empty()) {
+                    break;
+                }
+            }
+
+            // Every Shard is told, so the ones that visited nodes along the way forget the traversal
+            std::vector<seastar::future<std::vector<uint64_t>>> futures;
+            for (uint16_t their_shard = 0; their_shard < cpus; their_shard++) {
+                futures.push_back(container().invoke_on(their_shard, [traversal_id, grouped_ids = std::move(sharded_ids[their_shard])] (Shard &local_shard) {
+                    return local_shard.TraversalFinish(traversal_id, grouped_ids);
+                }));
+            }
+            std::vector<std::vector<uint64_t>> results = seastar::when_all_succeed(futures.begin(), futures.end()).get0();
+
+            std::vector<uint64_t> found;
+            for (const auto& result : results) {
+                found.insert(found.end(), result.begin(), result.end());
+            }
+            std::sort(found.begin(), found.end());
+            return found;
+        });
+    }
+
+    seastar::future<std::vector<uint64_t>> Shard::TraversePeered(const std::vector<uint64_t>& ids, Direction direction, const std::vector<std::string>& rel_types, uint64_t depth) {
+        Hop hop;
+        hop.direction = direction;
+        for (const auto& rel_type : rel_types) {
+            hop.rel_type_ids.emplace_back(relationship_types.getTypeId(rel_type));
+        }
+        return TraversePeered(ids, std::vector<Hop>(depth, hop));
+    }
+
+}
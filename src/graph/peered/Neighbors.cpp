@@ -23,24 +23,8 @@ namespace ragedb {
 
         return container().invoke_on(node_shard_id, [type, key](Shard &local_shard) {
                     return local_shard.NodeGetShardedNodeIDs(type, key); })
-                .then([this] (const std::map<uint16_t, std::vector<uint64_t>>& sharded_nodes_ids) {
-                    std::vector<seastar::future<std::vector<Node>>> futures;
-                    for (auto const& [their_shard, grouped_node_ids] : sharded_nodes_ids ) {
-                        auto future = container().invoke_on(their_shard, [grouped_node_ids = grouped_node_ids] (Shard &local_shard) {
-                            return local_shard.NodesGet(grouped_node_ids);
-                        });
-                        futures.push_back(std::move(future));
-                    }
-
-                    auto p = make_shared(std::move(futures));
-                    return seastar::when_all_succeed(p->begin(), p->end()).then([] (const std::vector<std::vector<Node>>& results) {
-                        std::vector<Node> combined;
-
-                        for(const std::vector<Node>& sharded : results) {
-                            combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                        }
-                        return combined;
-                    });
+                .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_nodes_ids) {
+                    return NodesGetSharded(std::move(sharded_nodes_ids));
                 });
     }
 
@@ -49,24 +33,8 @@ namespace ragedb {
         if (rel_type_id > 0) {
             uint16_t node_shard_id = CalculateShardId(type, key);
             return container().invoke_on(node_shard_id, [type, key, rel_type_id](Shard &local_shard) { return local_shard.NodeGetShardedNodeIDs(type, key, rel_type_id); })
-                    .then([this](const std::map<uint16_t, std::vector<uint64_t>> &sharded_nodes_ids) {
-                        std::vector<seastar::future<std::vector<Node>>> futures;
-                        for (auto const &[their_shard, grouped_node_ids] : sharded_nodes_ids) {
-                            auto future = container().invoke_on(their_shard, [grouped_node_ids = grouped_node_ids](Shard &local_shard) {
-                                return local_shard.NodesGet(grouped_node_ids);
-                            });
-                            futures.push_back(std::move(future));
-                        }
-
-                        auto p = make_shared(std::move(futures));
-                        return seastar::when_all_succeed(p->begin(), p->end()).then([](const std::vector<std::vector<Node>> &results) {
-                            std::vector<Node> combined;
-
-                            for (const std::vector<Node> &sharded : results) {
-                                combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                            }
-                            return combined;
-                        });
+                    .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_nodes_ids) {
+                        return NodesGetSharded(std::move(sharded_nodes_ids));
                     });
         }
 
@@ -77,24 +45,8 @@ namespace ragedb {
         if (rel_type_id > 0) {
             uint16_t node_shard_id = CalculateShardId(type, key);
             return container().invoke_on(node_shard_id, [type, key, rel_type_id](Shard &local_shard) { return local_shard.NodeGetShardedNodeIDs(type, key, rel_type_id); })
-                    .then([this](const std::map<uint16_t, std::vector<uint64_t>> &sharded_nodes_ids) {
-                        std::vector<seastar::future<std::vector<Node>>> futures;
-                        for (auto const &[their_shard, grouped_node_ids] : sharded_nodes_ids) {
-                            auto future = container().invoke_on(their_shard, [grouped_node_ids = grouped_node_ids](Shard &local_shard) {
-                                return local_shard.NodesGet(grouped_node_ids);
-                            });
-                            futures.push_back(std::move(future));
-                        }
-
-                        auto p = make_shared(std::move(futures));
-                        return seastar::when_all_succeed(p->begin(), p->end()).then([](const std::vector<std::vector<Node>> &results) {
-                            std::vector<Node> combined;
-
-                            for (const std::vector<Node> &sharded : results) {
-                                combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                            }
-                            return combined;
-                        });
+                    .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_nodes_ids) {
+                        return NodesGetSharded(std::move(sharded_nodes_ids));
                     });
         }
 
@@ -104,24 +56,8 @@ namespace ragedb {
     seastar::future<std::vector<Node>> Shard::NodeGetNeighborsPeered(const std::string& type, const std::string& key, const std::vector<std::string> &rel_types) {
         uint16_t node_shard_id = CalculateShardId(type, key);
         return container().invoke_on(node_shard_id, [type, key, rel_types](Shard &local_shard) { return local_shard.NodeGetShardedNodeIDs(type, key, rel_types); })
-                .then([this](const std::map<uint16_t, std::vector<uint64_t>> &sharded_nodes_ids) {
-                    std::vector<seastar::future<std::vector<Node>>> futures;
-                    for (auto const &[their_shard, grouped_node_ids] : sharded_nodes_ids) {
-                        auto future = container().invoke_on(their_shard, [grouped_node_ids = grouped_node_ids](Shard &local_shard) {
-                            return local_shard.NodesGet(grouped_node_ids);
-                        });
-                        futures.push_back(std::move(future));
-                    }
-
-                    auto p = make_shared(std::move(futures));
-                    return seastar::when_all_succeed(p->begin(), p->end()).then([](const std::vector<std::vector<Node>> &results) {
-                        std::vector<Node> combined;
-
-                        for (const std::vector<Node> &sharded : results) {
-                            combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                        }
-                        return combined;
-                    });
+                .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_nodes_ids) {
+                    return NodesGetSharded(std::move(sharded_nodes_ids));
                 });
     }
 
@@ -130,24 +66,8 @@ namespace ragedb {
 
         return container().invoke_on(node_shard_id, [external_id](Shard &local_shard) {
                     return local_shard.NodeGetShardedNodeIDs(external_id); })
-                .then([this] (const std::map<uint16_t, std::vector<uint64_t>>& sharded_nodes_ids) {
-                    std::vector<seastar::future<std::vector<Node>>> futures;
-                    for (auto const& [their_shard, grouped_node_ids] : sharded_nodes_ids ) {
-                        auto future = container().invoke_on(their_shard, [grouped_node_ids = grouped_node_ids] (Shard &local_shard) {
-                            return local_shard.NodesGet(grouped_node_ids);
-                        });
-                        futures.push_back(std::move(future));
-                    }
-
-                    auto p = make_shared(std::move(futures));
-                    return seastar::when_all_succeed(p->begin(), p->end()).then([] (const std::vector<std::vector<Node>>& results) {
-                        std::vector<Node> combined;
-
-                        for(const std::vector<Node>& sharded : results) {
-                            combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                        }
-                        return combined;
-                    });
+                .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_nodes_ids) {
+                    return NodesGetSharded(std::move(sharded_nodes_ids));
                 });
     }
 
@@ -156,24 +76,8 @@ namespace ragedb {
         uint16_t rel_type_id = relationship_types.getTypeId(rel_type);
         if (rel_type_id > 0) {
             return container().invoke_on(node_shard_id, [external_id, rel_type_id](Shard &local_shard) { return local_shard.NodeGetShardedNodeIDs(external_id, rel_type_id); })
-                    .then([this](const std::map<uint16_t, std::vector<uint64_t>> &sharded_nodes_ids) {
-                        std::vector<seastar::future<std::vector<Node>>> futures;
-                        for (auto const &[their_shard, grouped_node_ids] : sharded_nodes_ids) {
-                            auto future = container().invoke_on(their_shard, [grouped_node_ids = grouped_node_ids](Shard &local_shard) {
-                                return local_shard.NodesGet(grouped_node_ids);
-                            });
-                            futures.push_back(std::move(future));
-                        }
-
-                        auto p = make_shared(std::move(futures));
-                        return seastar::when_all_succeed(p->begin(), p->end()).then([](const std::vector<std::vector<Node>> &results) {
-                            std::vector<Node> combined;
-
-                            for (const std::vector<Node> &sharded : results) {
-                                combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                            }
-                            return combined;
-                        });
+                    .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_nodes_ids) {
+                        return NodesGetSharded(std::move(sharded_nodes_ids));
                     });
         }
 
@@ -184,24 +88,8 @@ namespace ragedb {
         if (rel_type_id > 0) {
             uint16_t node_shard_id = CalculateShardId(external_id);
             return container().invoke_on(node_shard_id, [external_id, rel_type_id](Shard &local_shard) { return local_shard.NodeGetShardedNodeIDs(external_id, rel_type_id); })
-                    .then([this](const std::map<uint16_t, std::vector<uint64_t>> &sharded_nodes_ids) {
-                        std::vector<seastar::future<std::vector<Node>>> futures;
-                        for (auto const &[their_shard, grouped_node_ids] : sharded_nodes_ids) {
-                            auto future = container().invoke_on(their_shard, [grouped_node_ids = grouped_node_ids](Shard &local_shard) {
-                                return local_shard.NodesGet(grouped_node_ids);
-                            });
-                            futures.push_back(std::move(future));
-                        }
-
-                        auto p = make_shared(std::move(futures));
-                        return seastar::when_all_succeed(p->begin(), p->end()).then([](const std::vector<std::vector<Node>> &results) {
-                            std::vector<Node> combined;
-
-                            for (const std::vector<Node> &sharded : results) {
-                                combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                            }
-                            return combined;
-                        });
+                    .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_nodes_ids) {
+                        return NodesGetSharded(std::move(sharded_nodes_ids));
                     });
         }
 
@@ -211,24 +99,8 @@ namespace ragedb {
     seastar::future<std::vector<Node>> Shard::NodeGetNeighborsPeered(uint64_t external_id, const std::vector<std::string> &rel_types) {
         uint16_t node_shard_id = CalculateShardId(external_id);
         return container().invoke_on(node_shard_id, [external_id, rel_types](Shard &local_shard) { return local_shard.NodeGetShardedNodeIDs(external_id, rel_types); })
-                .then([this](const std::map<uint16_t, std::vector<uint64_t>> &sharded_nodes_ids) {
-                    std::vector<seastar::future<std::vector<Node>>> futures;
-                    for (auto const &[their_shard, grouped_node_ids] : sharded_nodes_ids) {
-                        auto future = container().invoke_on(their_shard, [grouped_node_ids = grouped_node_ids](Shard &local_shard) {
-                            return local_shard.NodesGet(grouped_node_ids);
-                        });
-                        futures.push_back(std::move(future));
-                    }
-
-                    auto p = make_shared(std::move(futures));
-                    return seastar::when_all_succeed(p->begin(), p->end()).then([](const std::vector<std::vector<Node>> &results) {
-                        std::vector<Node> combined;
-
-                        for (const std::vector<Node> &sharded : results) {
-                            combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                        }
-                        return combined;
-                    });
+                .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_nodes_ids) {
+                    return NodesGetSharded(std::move(sharded_nodes_ids));
                 });
     }
 
@@ -240,47 +112,15 @@ namespace ragedb {
             case OUT: {
                 return container().invoke_on(node_shard_id, [type, key](Shard &local_shard) {
                             return local_shard.NodeGetShardedOutgoingNodeIDs(type, key); })
-                        .then([this] (const std::map<uint16_t, std::vector<uint64_t>>& sharded_nodes_ids) {
-                            std::vector<seastar::future<std::vector<Node>>> futures;
-                            for (auto const& [their_shard, grouped_node_ids] : sharded_nodes_ids ) {
-                                auto future = container().invoke_on(their_shard, [grouped_node_ids = grouped_node_ids] (Shard &local_shard) {
-                                    return local_shard.NodesGet(grouped_node_ids);
-                                });
-                                futures.push_back(std::move(future));
-                            }
-
-                            auto p = make_shared(std::move(futures));
-                            return seastar::when_all_succeed(p->begin(), p->end()).then([] (const std::vector<std::vector<Node>>& results) {
-                                std::vector<Node> combined;
-
-                                for(const std::vector<Node>& sharded : results) {
-                                    combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                                }
-                                return combined;
-                            });
+                        .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_nodes_ids) {
+                            return NodesGetSharded(std::move(sharded_nodes_ids));
                         });
             }
             case IN: {
                 return container().invoke_on(node_shard_id, [type, key](Shard &local_shard) {
                             return local_shard.NodeGetShardedIncomingNodeIDs(type, key); })
-                        .then([this] (const std::map<uint16_t, std::vector<uint64_t>>& sharded_nodes_ids) {
-                            std::vector<seastar::future<std::vector<Node>>> futures;
-                            for (auto const& [their_shard, grouped_node_ids] : sharded_nodes_ids ) {
-                                auto future = container().invoke_on(their_shard, [grouped_node_ids = grouped_node_ids] (Shard &local_shard) {
-                                    return local_shard.NodesGet(grouped_node_ids);
-                                });
-                                futures.push_back(std::move(future));
-                            }
-
-                            auto p = make_shared(std::move(futures));
-                            return seastar::when_all_succeed(p->begin(), p->end()).then([] (const std::vector<std::vector<Node>>& results) {
-                                std::vector<Node> combined;
-
-                                for(const std::vector<Node>& sharded : results) {
-                                    combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                                }
-                                return combined;
-                            });
+                        .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_nodes_ids) {
+                            return NodesGetSharded(std::move(sharded_nodes_ids));
                         });
             }
             default: return NodeGetNeighborsPeered(type, key);
@@ -294,46 +134,14 @@ namespace ragedb {
             switch (direction) {
                 case OUT: {
                     return container().invoke_on(node_shard_id, [type, key, rel_type_id](Shard &local_shard) { return local_shard.NodeGetShardedOutgoingNodeIDs(type, key, rel_type_id); })
-                            .then([this](const std::map<uint16_t, std::vector<uint64_t>>& sharded_nodes_ids) {
-                                std::vector<seastar::future<std::vector<Node>>> futures;
-                                for (auto const &[their_shard, grouped_node_ids] : sharded_nodes_ids) {
-                                    auto future = container().invoke_on(their_shard, [grouped_node_ids = grouped_node_ids](Shard &local_shard) {
-                                        return local_shard.NodesGet(grouped_node_ids);
-                                    });
-                                    futures.push_back(std::move(future));
-                                }
-
-                                auto p = make_shared(std::move(futures));
-                                return seastar::when_all_succeed(p->begin(), p->end()).then([](const std::vector<std::vector<Node>>& results) {
-                                    std::vector<Node> combined;
-
-                                    for (const std::vector<Node>& sharded : results) {
-                                        combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                                    }
-                                    return combined;
-                                });
+                            .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_nodes_ids) {
+                                return NodesGetSharded(std::move(sharded_nodes_ids));
                             });
                 }
                 case IN: {
                     return container().invoke_on(node_shard_id, [type, key, rel_type_id](Shard &local_shard) { return local_shard.NodeGetShardedIncomingNodeIDs(type, key, rel_type_id); })
-                            .then([this](const std::map<uint16_t, std::vector<uint64_t>>& sharded_nodes_ids) {
-                                std::vector<seastar::future<std::vector<Node>>> futures;
-                                for (auto const &[their_shard, grouped_node_ids] : sharded_nodes_ids) {
-                                    auto future = container().invoke_on(their_shard, [grouped_node_ids = grouped_node_ids](Shard &local_shard) {
-                                        return local_shard.NodesGet(grouped_node_ids);
-                                    });
-                                    futures.push_back(std::move(future));
-                                }
-
-                                auto p = make_shared(std::move(futures));
-                                return seastar::when_all_succeed(p->begin(), p->end()).then([](const std::vector<std::vector<Node>>& results) {
-                                    std::vector<Node> combined;
-
-                                    for (const std::vector<Node>& sharded : results) {
-                                        combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                                    }
-                                    return combined;
-                                });
+                            .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_nodes_ids) {
+                                return NodesGetSharded(std::move(sharded_nodes_ids));
                             });
                 }
                 default:
@@ -350,46 +158,14 @@ namespace ragedb {
             switch (direction) {
                 case OUT: {
                     return container().invoke_on(node_shard_id, [type, key, rel_type_id](Shard &local_shard) { return local_shard.NodeGetShardedOutgoingNodeIDs(type, key, rel_type_id); })
-                            .then([this](const std::map<uint16_t, std::vector<uint64_t>>& sharded_nodes_ids) {
-                                std::vector<seastar::future<std::vector<Node>>> futures;
-                                for (auto const &[their_shard, grouped_node_ids] : sharded_nodes_ids) {
-                                    auto future = container().invoke_on(their_shard, [grouped_node_ids = grouped_node_ids](Shard &local_shard) {
-                                        return local_shard.NodesGet(grouped_node_ids);
-                                    });
-                                    futures.push_back(std::move(future));
-                                }
-
-                                auto p = make_shared(std::move(futures));
-                                return seastar::when_all_succeed(p->begin(), p->end()).then([](const std::vector<std::vector<Node>>& results) {
-                                    std::vector<Node> combined;
-
-                                    for (const std::vector<Node>& sharded : results) {
-                                        combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                                    }
-                                    return combined;
-                                });
+                            .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_nodes_ids) {
+                                return NodesGetSharded(std::move(sharded_nodes_ids));
                             });
                 }
                 case IN: {
                     return container().invoke_on(node_shard_id, [type, key, rel_type_id](Shard &local_shard) { return local_shard.NodeGetShardedIncomingNodeIDs(type, key, rel_type_id); })
-                            .then([this](const std::map<uint16_t, std::vector<uint64_t>>& sharded_nodes_ids) {
-                                std::vector<seastar::future<std::vector<Node>>> futures;
-                                for (auto const &[their_shard, grouped_node_ids] : sharded_nodes_ids) {
-                                    auto future = container().invoke_on(their_shard, [grouped_node_ids = grouped_node_ids](Shard &local_shard) {
-                                        return local_shard.NodesGet(grouped_node_ids);
-                                    });
-                                    futures.push_back(std::move(future));
-                                }
-
-                                auto p = make_shared(std::move(futures));
-                                return seastar::when_all_succeed(p->begin(), p->end()).then([](const std::vector<std::vector<Node>>& results) {
-                                    std::vector<Node> combined;
-
-                                    for (const std::vector<Node>& sharded : results) {
-                                        combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                                    }
-                                    return combined;
-                                });
+                            .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_nodes_ids) {
+                                return NodesGetSharded(std::move(sharded_nodes_ids));
                             });
                 }
                 default:
@@ -407,47 +183,15 @@ namespace ragedb {
             case OUT: {
                 return container().invoke_on(node_shard_id, [type, key, rel_types](Shard &local_shard) {
                             return local_shard.NodeGetShardedOutgoingNodeIDs(type, key, rel_types); })
-                        .then([this] (const std::map<uint16_t, std::vector<uint64_t>>& sharded_nodes_ids) {
-                            std::vector<seastar::future<std::vector<Node>>> futures;
-                            for (auto const& [their_shard, grouped_node_ids] : sharded_nodes_ids ) {
-                                auto future = container().invoke_on(their_shard, [grouped_node_ids = grouped_node_ids] (Shard &local_shard) {
-                                    return local_shard.NodesGet(grouped_node_ids);
-                                });
-                                futures.push_back(std::move(future));
-                            }
-
-                            auto p = make_shared(std::move(futures));
-                            return seastar::when_all_succeed(p->begin(), p->end()).then([] (const std::vector<std::vector<Node>>& results) {
-                                std::vector<Node> combined;
-
-                                for(const std::vector<Node>& sharded : results) {
-                                    combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                                }
-                                return combined;
-                            });
+                        .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_nodes_ids) {
+                            return NodesGetSharded(std::move(sharded_nodes_ids));
                         });
             }
             case IN: {
                 return container().invoke_on(node_shard_id, [type, key, rel_types](Shard &local_shard) {
                             return local_shard.NodeGetShardedIncomingNodeIDs(type, key, rel_types); })
-                        .then([this] (const std::map<uint16_t, std::vector<uint64_t>>& sharded_nodes_ids) {
-                            std::vector<seastar::future<std::vector<Node>>> futures;
-                            for (auto const& [their_shard, grouped_node_ids] : sharded_nodes_ids ) {
-                                auto future = container().invoke_on(their_shard, [grouped_node_ids = grouped_node_ids] (Shard &local_shard) {
-                                    return local_shard.NodesGet(grouped_node_ids);
-                                });
-                                futures.push_back(std::move(future));
-                            }
-
-                            auto p = make_shared(std::move(futures));
-                            return seastar::when_all_succeed(p->begin(), p->end()).then([] (const std::vector<std::vector<Node>>& results) {
-                                std::vector<Node> combined;
-
-                                for(const std::vector<Node>& sharded : results) {
-                                    combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                                }
-                                return combined;
-                            });
+                        .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_nodes_ids) {
+                            return NodesGetSharded(std::move(sharded_nodes_ids));
                         });
             }
             default: return NodeGetNeighborsPeered(type, key, rel_types);
@@ -462,47 +206,15 @@ namespace ragedb {
             case OUT: {
                 return container().invoke_on(node_shard_id, [external_id](Shard &local_shard) {
                             return local_shard.NodeGetShardedOutgoingNodeIDs(external_id); })
-                        .then([this] (const std::map<uint16_t, std::vector<uint64_t>>& sharded_nodes_ids) {
-                            std::vector<seastar::future<std::vector<Node>>> futures;
-                            for (auto const& [their_shard, grouped_node_ids] : sharded_nodes_ids ) {
-                                auto future = container().invoke_on(their_shard, [grouped_node_ids = grouped_node_ids] (Shard &local_shard) {
-                                    return local_shard.NodesGet(grouped_node_ids);
-                                });
-                                futures.push_back(std::move(future));
-                            }
-
-                            auto p = make_shared(std::move(futures));
-                            return seastar::when_all_succeed(p->begin(), p->end()).then([] (const std::vector<std::vector<Node>>& results) {
-                                std::vector<Node> combined;
-
-                                for(const std::vector<Node>& sharded : results) {
-                                    combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                                }
-                                return combined;
-                            });
+                        .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_nodes_ids) {
+                            return NodesGetSharded(std::move(sharded_nodes_ids));
                         });
             }
             case IN: {
                 return container().invoke_on(node_shard_id, [external_id](Shard &local_shard) {
                             return local_shard.NodeGetShardedIncomingNodeIDs(external_id); })
-                        .then([this] (const std::map<uint16_t, std::vector<uint64_t>>& sharded_nodes_ids) {
-                            std::vector<seastar::future<std::vector<Node>>> futures;
-                            for (auto const& [their_shard, grouped_node_ids] : sharded_nodes_ids ) {
-                                auto future = container().invoke_on(their_shard, [grouped_node_ids = grouped_node_ids] (Shard &local_shard) {
-                                    return local_shard.NodesGet(grouped_node_ids);
-                                });
-                                futures.push_back(std::move(future));
-                            }
-
-                            auto p = make_shared(std::move(futures));
-                            return seastar::when_all_succeed(p->begin(), p->end()).then([] (const std::vector<std::vector<Node>>& results) {
-                                std::vector<Node> combined;
-
-                                for(const std::vector<Node>& sharded : results) {
-                                    combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                                }
-                                return combined;
-                            });
+                        .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_nodes_ids) {
+                            return NodesGetSharded(std::move(sharded_nodes_ids));
                         });
             }
             default: return NodeGetNeighborsPeered(external_id);
@@ -516,46 +228,14 @@ namespace ragedb {
             switch (direction) {
                 case OUT: {
                     return container().invoke_on(node_shard_id, [external_id, rel_type_id](Shard &local_shard) { return local_shard.NodeGetShardedOutgoingNodeIDs(external_id, rel_type_id); })
-                            .then([this](const std::map<uint16_t, std::vector<uint64_t>>& sharded_nodes_ids) {
-                                std::vector<seastar::future<std::vector<Node>>> futures;
-                                for (auto const &[their_shard, grouped_node_ids] : sharded_nodes_ids) {
-                                    auto future = container().invoke_on(their_shard, [grouped_node_ids = grouped_node_ids](Shard &local_shard) {
-                                        return local_shard.NodesGet(grouped_node_ids);
-                                    });
-                                    futures.push_back(std::move(future));
-                                }
-
-                                auto p = make_shared(std::move(futures));
-                                return seastar::when_all_succeed(p->begin(), p->end()).then([](const std::vector<std::vector<Node>>& results) {
-                                    std::vector<Node> combined;
-
-                                    for (const std::vector<Node>& sharded : results) {
-                                        combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                                    }
-                                    return combined;
-                                });
+                            .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_nodes_ids) {
+                                return NodesGetSharded(std::move(sharded_nodes_ids));
                             });
                 }
                 case IN: {
                     return container().invoke_on(node_shard_id, [external_id, rel_type_id](Shard &local_shard) { return local_shard.NodeGetShardedIncomingNodeIDs(external_id, rel_type_id); })
-                            .then([this](const std::map<uint16_t, std::vector<uint64_t>>& sharded_nodes_ids) {
-                                std::vector<seastar::future<std::vector<Node>>> futures;
-                                for (auto const &[their_shard, grouped_node_ids] : sharded_nodes_ids) {
-                                    auto future = container().invoke_on(their_shard, [grouped_node_ids = grouped_node_ids](Shard &local_shard) {
-                                        return local_shard.NodesGet(grouped_node_ids);
-                                    });
-                                    futures.push_back(std::move(future));
-                                }
-
-                                auto p = make_shared(std::move(futures));
-                                return seastar::when_all_succeed(p->begin(), p->end()).then([](const std::vector<std::vector<Node>>& results) {
-                                    std::vector<Node> combined;
-
-                                    for (const std::vector<Node>& sharded : results) {
-                                        combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                                    }
-                                    return combined;
-                                });
+                            .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_nodes_ids) {
+                                return NodesGetSharded(std::move(sharded_nodes_ids));
                             });
                 }
                 default:
@@ -572,46 +252,14 @@ namespace ragedb {
             switch (direction) {
                 case OUT: {
                     return container().invoke_on(node_shard_id, [external_id, rel_type_id](Shard &local_shard) { return local_shard.NodeGetShardedOutgoingNodeIDs(external_id, rel_type_id); })
-                            .then([this](const std::map<uint16_t, std::vector<uint64_t>>& sharded_nodes_ids) {
-                                std::vector<seastar::future<std::vector<Node>>> futures;
-                                for (auto const &[their_shard, grouped_node_ids] : sharded_nodes_ids) {
-                                    auto future = container().invoke_on(their_shard, [grouped_node_ids = grouped_node_ids](Shard &local_shard) {
-                                        return local_shard.NodesGet(grouped_node_ids);
-                                    });
-                                    futures.push_back(std::move(future));
-                                }
-
-                                auto p = make_shared(std::move(futures));
-                                return seastar::when_all_succeed(p->begin(), p->end()).then([](const std::vector<std::vector<Node>>& results) {
-                                    std::vector<Node> combined;
-
-                                    for (const std::vector<Node>& sharded : results) {
-                                        combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                                    }
-                                    return combined;
-                                });
+                            .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_nodes_ids) {
+                                return NodesGetSharded(std::move(sharded_nodes_ids));
                             });
                 }
                 case IN: {
                     return container().invoke_on(node_shard_id, [external_id, rel_type_id](Shard &local_shard) { return local_shard.NodeGetShardedIncomingNodeIDs(external_id, rel_type_id); })
-                            .then([this](const std::map<uint16_t, std::vector<uint64_t>>& sharded_nodes_ids) {
-                                std::vector<seastar::future<std::vector<Node>>> futures;
-                                for (auto const &[their_shard, grouped_node_ids] : sharded_nodes_ids) {
-                                    auto future = container().invoke_on(their_shard, [grouped_node_ids = grouped_node_ids](Shard &local_shard) {
-                                        return local_shard.NodesGet(grouped_node_ids);
-                                    });
-                                    futures.push_back(std::move(future));
-                                }
-
-                                auto p = make_shared(std::move(futures));
-                                return seastar::when_all_succeed(p->begin(), p->end()).then([](const std::vector<std::vector<Node>>& results) {
-                                    std::vector<Node> combined;
-
-                                    for (const std::vector<Node>& sharded : results) {
-                                        combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                                    }
-                                    return combined;
-                                });
+                            .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_nodes_ids) {
+                                return NodesGetSharded(std::move(sharded_nodes_ids));
                             });
                 }
                 default:
@@ -629,47 +277,15 @@ namespace ragedb {
             case OUT: {
                 return container().invoke_on(node_shard_id, [external_id, rel_types](Shard &local_shard) {
                             return local_shard.NodeGetShardedOutgoingNodeIDs(external_id, rel_types); })
-                        .then([this] (const std::map<uint16_t, std::vector<uint64_t>>& sharded_nodes_ids) {
-                            std::vector<seastar::future<std::vector<Node>>> futures;
-                            for (auto const& [their_shard, grouped_node_ids] : sharded_nodes_ids ) {
-                                auto future = container().invoke_on(their_shard, [grouped_node_ids = grouped_node_ids] (Shard &local_shard) {
-                                    return local_shard.NodesGet(grouped_node_ids);
-                                });
-                                futures.push_back(std::move(future));
-                            }
-
-                            auto p = make_shared(std::move(futures));
-                            return seastar::when_all_succeed(p->begin(), p->end()).then([] (const std::vector<std::vector<Node>>& results) {
-                                std::vector<Node> combined;
-
-                                for(const std::vector<Node>& sharded : results) {
-                                    combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                                }
-                                return combined;
-                            });
+                        .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_nodes_ids) {
+                            return NodesGetSharded(std::move(sharded_nodes_ids));
                         });
             }
             case IN: {
                 return container().invoke_on(node_shard_id, [external_id, rel_types](Shard &local_shard) {
                             return local_shard.NodeGetShardedIncomingNodeIDs(external_id, rel_types); })
-                        .then([this] (const std::map<uint16_t, std::vector<uint64_t>>& sharded_nodes_ids) {
-                            std::vector<seastar::future<std::vector<Node>>> futures;
-                            for (auto const& [their_shard, grouped_node_ids] : sharded_nodes_ids ) {
-                                auto future = container().invoke_on(their_shard, [grouped_node_ids = grouped_node_ids] (Shard &local_shard) {
-                                    return local_shard.NodesGet(grouped_node_ids);
-                                });
-                                futures.push_back(std::move(future));
-                            }
-
-                            auto p = make_shared(std::move(futures));
-                            return seastar::when_all_succeed(p->begin(), p->end()).then([] (const std::vector<std::vector<Node>>& results) {
-                                std::vector<Node> combined;
-
-                                for(const std::vector<Node>& sharded : results) {
-                                    combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                                }
-                                return combined;
-                            });
+                        .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_nodes_ids) {
+                            return NodesGetSharded(std::move(sharded_nodes_ids));
                         });
             }
             default: return NodeGetNeighborsPeered(external_id, rel_types);
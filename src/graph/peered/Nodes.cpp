@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <numeric>
 #include "../Shard.h"
 
 namespace ragedb {
@@ -25,7 +27,7 @@ namespace ragedb {
         // The node type exists, so continue on
         if (type_id > 0) {
             return container().invoke_on(node_shard_id, [type_id, key](Shard &local_shard) {
-                return local_shard.NodeAddEmpty(type_id, key);
+                return local_shard.Durable(local_shard.NodeAddEmpty(type_id, key));
             });
         }
 
@@ -33,7 +35,7 @@ namespace ragedb {
         return container().invoke_on(0, [node_shard_id, type, key, this] (Shard &local_shard) {
             return local_shard.NodeTypeInsertPeered(type).then([node_shard_id, type, key, this] (uint16_t node_type_id) {
                 return container().invoke_on(node_shard_id, [node_type_id, key](Shard &local_shard) {
-                    return local_shard.NodeAddEmpty(node_type_id, key);
+                    return local_shard.Durable(local_shard.NodeAddEmpty(node_type_id, key));
                 });
             });
         });
@@ -46,7 +48,7 @@ namespace ragedb {
         // The node type exists, so continue on
         if (node_type_id > 0) {
             return container().invoke_on(node_shard_id, [node_type_id, key, properties](Shard &local_shard) {
-                return local_shard.NodeAdd(node_type_id, key, properties);
+                return local_shard.Durable(local_shard.NodeAdd(node_type_id, key, properties));
             });
         }
 
@@ -54,12 +56,69 @@ namespace ragedb {
         return container().invoke_on(0, [node_shard_id, type, key, properties, this](Shard &local_shard) {
             return local_shard.NodeTypeInsertPeered(type).then([node_shard_id, key, properties, this](uint16_t node_type_id) {
                 return container().invoke_on(node_shard_id, [node_type_id, key, properties](Shard &local_shard) {
-                    return local_shard.NodeAdd(node_type_id, key, properties);
+                    return local_shard.Durable(local_shard.NodeAdd(node_type_id, key, properties));
                 });
             });
         });
     }
 
+    /**
+     * Add a batch of nodes of one type with a single message per Shard
+     *
+     * @param type node type, created if it does not exist yet
+     * @param keys node keys
+     * @param properties node properties as json, empty or one entry per key
+     * @return the new node ids in the order of the keys, 0 for keys that already exist
+     */
+    seastar::future<std::vector<uint64_t>> Shard::NodesAddPeered(const std::string &type, const std::vector<std::string> &keys, const std::vector<std::string> &properties) {
+        bool with_properties = properties.size() == keys.size();
+        std::map<uint16_t, std::vector<std::string>> sharded_keys;
+        std::map<uint16_t, std::vector<std::string>> sharded_properties;
+        std::map<uint16_t, std::vector<size_t>> sharded_positions;
+        for (size_t i = 0; i < keys.size(); i++) {
+            uint16_t node_shard_id = CalculateShardId(type, keys[i]);
+            sharded_keys[node_shard_id].emplace_back(keys[i]);
+            sharded_positions[node_shard_id].emplace_back(i);
+            if (with_properties) {
+                sharded_properties[node_shard_id].emplace_back(properties[i]);
+            }
+        }
+
+        uint16_t node_type_id = node_types.getTypeId(type);
+        seastar::future<uint16_t> type_id_future = seastar::make_ready_future<uint16_t>(node_type_id);
+        // The node type needs to be set by Shard 0 and propagated
+        if (node_type_id == 0) {
+            type_id_future = container().invoke_on(0, [type] (Shard &local_shard) {
+                return local_shard.NodeTypeInsertPeered(type);
+            });
+        }
+
+        return type_id_future.then([sharded_keys = std::move(sharded_keys), sharded_properties = std::move(sharded_properties),
+                                    sharded_positions = std::move(sharded_positions), count = keys.size(), this] (uint16_t type_id) mutable {
+            std::vector<seastar::future<std::vector<uint64_t>>> futures;
+            for (auto& [their_shard, grouped_keys] : sharded_keys) {
+                auto future = container().invoke_on(their_shard, [type_id, grouped_keys = std::move(grouped_keys), grouped_properties = std::move(sharded_properties[their_shard])] (Shard &local_shard) {
+                    return local_shard.Durable(local_shard.NodesAdd(type_id, grouped_keys, grouped_properties));
+                });
+                futures.push_back(std::move(future));
+            }
+
+            auto p = make_shared(std::move(futures));
+            return seastar::when_all_succeed(p->begin(), p->end()).then([p, sharded_positions = std::move(sharded_positions), count] (const std::vector<std::vector<uint64_t>>& results) {
+                // Put the ids back in the order of the keys
+                std::vector<uint64_t> ids(count, 0);
+                size_t result = 0;
+                for (const auto& [their_shard, positions] : sharded_positions) {
+                    for (size_t j = 0; j < positions.size(); j++) {
+                        ids[positions[j]] = results[result][j];
+                    }
+                    result++;
+                }
+                return ids;
+            });
+        });
+    }
+
     seastar::future<uint64_t> Shard::NodeGetIDPeered(const std::string &type, const std::string &key) {
         uint16_t node_shard_id = CalculateShardId(type, key);
 
@@ -76,39 +135,37 @@ namespace ragedb {
         });
     }
 
+    // Coalesced with the other point reads for the same Shard
     seastar::future<Node> Shard::NodeGetPeered(uint64_t id) {
-        uint16_t node_shard_id = CalculateShardId(id);
-
-        return container().invoke_on(node_shard_id, [id](Shard &local_shard) {
-            return local_shard.NodeGet(id);
-        });
+        return node_gets.Add(CalculateShardId(id), id);
     }
 
     seastar::future<std::vector<Node>> Shard::NodesGetPeered(const std::vector<uint64_t> &ids) {
         std::map<uint16_t, std::vector<uint64_t>> sharded_nodes_ids;
-        for (int i = 0; i < cpus; i++) {
-            sharded_nodes_ids.insert({i, std::vector<uint64_t>() });
-        }
         for (auto id : ids) {
             sharded_nodes_ids[CalculateShardId(id)].emplace_back(id);
         }
+        return NodesGetSharded(std::move(sharded_nodes_ids));
+    }
 
+    /**
+     * Get nodes from the Shards they belong to. The ids are moved into the messages, and the nodes
+     * that come back are moved into the result, so no node is copied on the way.
+     *
+     * @param sharded_nodes_ids node ids grouped by the Shard they belong to
+     * @return the nodes, in Shard order
+     */
+    seastar::future<std::vector<Node>> Shard::NodesGetSharded(std::map<uint16_t, std::vector<uint64_t>> sharded_nodes_ids) {
         std::vector<seastar::future<std::vector<Node>>> futures;
-        for (auto const& [their_shard, grouped_node_ids] : sharded_nodes_ids ) {
-            auto future = container().invoke_on(their_shard, [grouped_node_ids = grouped_node_ids] (Shard &local_shard) {
+        futures.reserve(sharded_nodes_ids.size());
+        for (auto& [their_shard, grouped_node_ids] : sharded_nodes_ids) {
+            futures.push_back(container().invoke_on(their_shard, [grouped_node_ids = std::move(grouped_node_ids)] (Shard &local_shard) {
                 return local_shard.NodesGet(grouped_node_ids);
-            });
-            futures.push_back(std::move(future));
+            }));
         }
 
-        auto p = make_shared(std::move(futures));
-        return seastar::when_all_succeed(p->begin(), p->end()).then([] (const std::vector<std::vector<Node>>& results) {
-            std::vector<Node> combined;
-
-            for(const std::vector<Node>& sharded : results) {
-                combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-            }
-            return combined;
+        return seastar::when_all_succeed(futures.begin(), futures.end()).then([] (std::vector<std::vector<Node>> results) {
+            return MoveMerge(std::move(results));
         });
     }
 
@@ -123,54 +180,143 @@ namespace ragedb {
     }
 
     seastar::future<bool> Shard::NodeRemovePeered(uint64_t external_id) {
-        uint16_t node_shard_id = CalculateShardId(external_id);
-
-        return container().invoke_on(node_shard_id, [external_id](Shard &local_shard) {
-            return local_shard.ValidNodeId(external_id);
-        }).then([node_shard_id, external_id, this] (bool valid) {
-            if(valid) {
-                uint64_t internal_id = externalToInternal(external_id);
-
-                seastar::future<std::vector<bool>> incoming = container().invoke_on(node_shard_id, [external_id] (Shard &local_shard) {
-                    return local_shard.NodeRemoveGetIncoming(external_id);
-                }).then([external_id, this] (auto sharded_grouped_rels) {
-                    std::vector<seastar::future<bool>> futures;
-                    for (auto const& [their_shard, grouped_rels] : sharded_grouped_rels ) {
-                        auto future = container().invoke_on(their_shard, [external_id, grouped_rels = std::move(grouped_rels)] (Shard &local_shard) {
-                            return local_shard.NodeRemoveDeleteIncoming(external_id, grouped_rels);
-                        });
-                        futures.push_back(std::move(future));
-                    }
-
-                    auto p = make_shared(std::move(futures));
-                    return seastar::when_all_succeed(p->begin(), p->end());
-                });
+        return NodesRemovePeered(std::vector<uint64_t>({external_id})).then([] (uint64_t removed) {
+            return removed > 0;
+        });
+    }
 
-                seastar::future<std::vector<bool>> outgoing = container().invoke_on(shard_id, [external_id] (Shard &local_shard) {
-                    return local_shard.NodeRemoveGetOutgoing(external_id);
-                }).then([external_id, this] (auto sharded_grouped_rels) {
-                    std::vector<seastar::future<bool>> futures;
-                    for (auto const& [their_shard, grouped_rels] : sharded_grouped_rels ) {
-                        auto future = container().invoke_on(their_shard, [external_id, grouped_rels = grouped_rels] (Shard &local_shard) {
-                            return local_shard.NodeRemoveDeleteOutgoing(external_id, grouped_rels);
-                        });
-                        futures.push_back(std::move(future));
+    /**
+     * Append the counterparts of a removed node to the batches of a Shard, splitting them across
+     * batches so none holds more than batch_size node ids
+     *
+     * @param batches batches of the Shard holding the counterparts
+     * @param filled node ids in the last batch
+     * @param removal counterparts of the removed node
+     * @param batch_size most node ids per batch
+     */
+    static void AddToBatches(std::vector<std::vector<NodeRemoval>> &batches, uint64_t &filled, const NodeRemoval &removal, uint64_t batch_size) {
+        auto add = [&] (const std::map<uint16_t, std::vector<uint64_t>> &grouped_relationships, bool incoming) {
+            for (const auto &[rel_type_id, node_ids] : grouped_relationships) {
+                size_t start = 0;
+                while (start < node_ids.size()) {
+                    if (batches.empty() || filled == batch_size) {
+                        batches.emplace_back();
+                        filled = 0;
                     }
+                    auto &batch = batches.back();
+                    if (batch.empty() || batch.back().id != removal.id) {
+                        batch.push_back(NodeRemoval{removal.id, {}, {}});
+                    }
+                    size_t count = std::min(node_ids.size() - start, static_cast<size_t>(batch_size - filled));
+                    auto &ids = incoming ? batch.back().incoming[rel_type_id] : batch.back().outgoing[rel_type_id];
+                    ids.insert(ids.end(), node_ids.begin() + start, node_ids.begin() + start + count);
+                    start += count;
+                    filled += count;
+                }
+            }
+        };
+        add(removal.incoming, true);
+        add(removal.outgoing, false);
+    }
 
-                    auto p = make_shared(std::move(futures));
-                    return seastar::when_all_succeed(p->begin(), p->end());
-                });
+    /**
+     * Remove a batch of nodes and all their relationships.
+     * The Shard of each node gathers the counterparts other Shards hold of its links in one pass, those are regrouped
+     * by the Shard holding them and sent in rounds with one message per Shard of at most REMOVE_BATCH_SIZE node ids.
+     * Once every counterpart is gone the nodes are removed, the Shards doing the work yield between nodes.
+     *
+     * @param ids ids of the nodes to remove
+     * @return number of nodes removed
+     */
+    seastar::future<uint64_t> Shard::NodesRemovePeered(const std::vector<uint64_t> &ids) {
+        std::map<uint16_t, std::vector<uint64_t>> sharded_ids;
+        for (uint64_t id : ids) {
+            sharded_ids[CalculateShardId(id)].emplace_back(id);
+        }
 
-                return seastar::when_all(std::move(incoming), std::move(outgoing)).then([node_shard_id, external_id, this] (auto tup) {
-                    if(std::get<0>(tup).failed() || std::get<1>(tup).failed()) {
-                        return seastar::make_ready_future<bool>(false);
+        return seastar::async([sharded_ids = std::move(sharded_ids), this] () mutable {
+            std::vector<seastar::future<std::map<uint16_t, std::vector<NodeRemoval>>>> gathers;
+            for (const auto& [their_shard, grouped_ids] : sharded_ids) {
+                gathers.push_back(container().invoke_on(their_shard, [grouped_ids = grouped_ids] (Shard &local_shard) {
+                    return seastar::async([grouped_ids, &local_shard] {
+                        return local_shard.NodesRemoveGetLinks(grouped_ids, [] { seastar::thread::maybe_yield(); });
+                    });
+                }));
+            }
+            std::vector<std::map<uint16_t, std::vector<NodeRemoval>>> gathered = seastar::when_all_succeed(gathers.begin(), gathers.end()).get0();
+
+            std::map<uint16_t, std::vector<std::vector<NodeRemoval>>> sharded_batches;
+            std::map<uint16_t, uint64_t> filled;
+            for (const auto& sharded_removals : gathered) {
+                for (const auto& [their_shard, removals] : sharded_removals) {
+                    for (const auto& removal : removals) {
+                        AddToBatches(sharded_batches[their_shard], filled[their_shard], removal, REMOVE_BATCH_SIZE);
+                    }
+                }
+            }
+            gathered.clear();
+
+            try {
+                for (size_t round = 0; ; round++) {
+                    std::vector<seastar::future<bool>> deletes;
+                    for (auto& [their_shard, batches] : sharded_batches) {
+                        if (round < batches.size()) {
+                            deletes.push_back(container().invoke_on(their_shard, [batch = std::move(batches[round])] (Shard &local_shard) {
+                                return local_shard.Durable(local_shard.NodesRemoveDeleteLinks(batch));
+                            }));
+                        }
                     }
-                    return container().invoke_on(node_shard_id, [external_id] (Shard &local_shard) {
-                        return local_shard.NodeRemove(external_id);
+                    if (deletes.empty()) {
+                        break;
+                    }
+                    seastar::when_all_succeed(deletes.begin(), deletes.end()).get();
+                }
+            } catch (...) {
+                // Keep the nodes if their relationships could not be deleted everywhere
+                return uint64_t(0);
+            }
+
+            std::vector<seastar::future<uint64_t>> removes;
+            for (auto& [their_shard, grouped_ids] : sharded_ids) {
+                removes.push_back(container().invoke_on(their_shard, [grouped_ids = std::move(grouped_ids)] (Shard &local_shard) {
+                    return seastar::async([grouped_ids, &local_shard] {
+                        return local_shard.NodesRemove(grouped_ids, [] { seastar::thread::maybe_yield(); });
+                    }).then([&local_shard] (uint64_t removed) {
+                        return local_shard.Durable(removed);
                     });
-                });
+                }));
             }
-            return seastar::make_ready_future<bool>(false);
+            std::vector<uint64_t> removed = seastar::when_all_succeed(removes.begin(), removes.end()).get0();
+            return std::accumulate(std::begin(removed), std::end(removed), uint64_t(0));
+        });
+    }
+
+    /**
+     * Remove a batch of nodes of one type by key, looking up their ids with one message per Shard
+     *
+     * @param type node type
+     * @param keys node keys, missing ones are skipped
+     * @return number of nodes removed
+     */
+    seastar::future<uint64_t> Shard::NodesRemovePeered(const std::string &type, const std::vector<std::string> &keys) {
+        std::map<uint16_t, std::vector<std::string>> sharded_keys;
+        for (const auto& key : keys) {
+            sharded_keys[CalculateShardId(type, key)].emplace_back(key);
+        }
+
+        std::vector<seastar::future<std::vector<uint64_t>>> lookups;
+        for (auto& [their_shard, grouped_keys] : sharded_keys) {
+            lookups.push_back(container().invoke_on(their_shard, [type, grouped_keys = std::move(grouped_keys)] (Shard &local_shard) {
+                return local_shard.NodeGetIDs(std::vector<std::string>(grouped_keys.size(), type), grouped_keys);
+            }));
+        }
+
+        return seastar::when_all_succeed(lookups.begin(), lookups.end()).then([this] (std::vector<std::vector<uint64_t>> found) {
+            std::vector<uint64_t> ids;
+            for (const auto& sharded_ids : found) {
+                std::copy_if(std::begin(sharded_ids), std::end(sharded_ids), std::back_inserter(ids), [] (uint64_t id) { return id > 0; });
+            }
+            return NodesRemovePeered(ids);
         });
     }
 
@@ -202,19 +348,16 @@ namespace ragedb {
         });
     }
 
+    // Coalesced with the other point reads for the same Shard
     seastar::future<std::any> Shard::NodePropertyGetPeered(uint64_t id, const std::string &property) {
-        uint16_t node_shard_id = CalculateShardId(id);
-
-        return container().invoke_on(node_shard_id, [id, property](Shard &local_shard) {
-            return local_shard.NodePropertyGet(id, property);
-        });
+        return node_property_gets.Add(CalculateShardId(id), {id, property});
     }
 
     seastar::future<bool> Shard::NodePropertySetPeered(const std::string& type, const std::string& key, const std::string& property, const std::any& value) {
         uint16_t node_shard_id = CalculateShardId(type, key);
 
         return container().invoke_on(node_shard_id, [type, key, property, value](Shard &local_shard) {
-            return local_shard.NodePropertySet(type, key, property, value);
+            return local_shard.Durable(local_shard.NodePropertySet(type, key, property, value));
         });
     }
 
@@ -222,7 +365,7 @@ namespace ragedb {
         uint16_t node_shard_id = CalculateShardId(id);
 
         return container().invoke_on(node_shard_id, [id, property, value](Shard &local_shard) {
-            return local_shard.NodePropertySet(id, property, value);
+            return local_shard.Durable(local_shard.NodePropertySet(id, property, value));
         });
     }
 
@@ -230,7 +373,7 @@ namespace ragedb {
         uint16_t node_shard_id = CalculateShardId(type, key);
 
         return container().invoke_on(node_shard_id, [type, key, property, value](Shard &local_shard) {
-            return local_shard.NodePropertySetFromJson(type, key, property, value);
+            return local_shard.Durable(local_shard.NodePropertySetFromJson(type, key, property, value));
         });
     }
 
@@ -238,7 +381,7 @@ namespace ragedb {
         uint16_t node_shard_id = CalculateShardId(id);
 
         return container().invoke_on(node_shard_id, [id, property, value](Shard &local_shard) {
-            return local_shard.NodePropertySetFromJson(id, property, value);
+            return local_shard.Durable(local_shard.NodePropertySetFromJson(id, property, value));
         });
     }
 
@@ -246,7 +389,7 @@ namespace ragedb {
         uint16_t node_shard_id = CalculateShardId(type, key);
 
         return container().invoke_on(node_shard_id, [type, key, property](Shard &local_shard) {
-            return local_shard.NodePropertyDelete(type, key, property);
+            return local_shard.Durable(local_shard.NodePropertyDelete(type, key, property));
         });
     }
 
@@ -254,7 +397,7 @@ namespace ragedb {
         uint16_t node_shard_id = CalculateShardId(id);
 
         return container().invoke_on(node_shard_id, [id, property](Shard &local_shard) {
-            return local_shard.NodePropertyDelete(id, property);
+            return local_shard.Durable(local_shard.NodePropertyDelete(id, property));
         });
     }
 
@@ -278,7 +421,7 @@ namespace ragedb {
         uint16_t node_shard_id = CalculateShardId(type, key);
 
         return container().invoke_on(node_shard_id, [type, key, value](Shard &local_shard) {
-            return local_shard.NodePropertiesSetFromJson(type, key, value);
+            return local_shard.Durable(local_shard.NodePropertiesSetFromJson(type, key, value));
         });
     }
 
@@ -286,7 +429,7 @@ namespace ragedb {
         uint16_t node_shard_id = CalculateShardId(id);
 
         return container().invoke_on(node_shard_id, [id, value](Shard &local_shard) {
-            return local_shard.NodePropertiesSetFromJson(id, value);
+            return local_shard.Durable(local_shard.NodePropertiesSetFromJson(id, value));
         });
     }
 
@@ -294,7 +437,7 @@ namespace ragedb {
         uint16_t node_shard_id = CalculateShardId(type, key);
 
         return container().invoke_on(node_shard_id, [type, key, value](Shard &local_shard) {
-            return local_shard.NodePropertiesResetFromJson(type, key, value);
+            return local_shard.Durable(local_shard.NodePropertiesResetFromJson(type, key, value));
         });
     }
 
@@ -302,7 +445,7 @@ namespace ragedb {
         uint16_t node_shard_id = CalculateShardId(id);
 
         return container().invoke_on(node_shard_id, [id, value](Shard &local_shard) {
-            return local_shard.NodePropertiesResetFromJson(id, value);
+            return local_shard.Durable(local_shard.NodePropertiesResetFromJson(id, value));
         });
     }
 
@@ -310,7 +453,7 @@ namespace ragedb {
         uint16_t node_shard_id = CalculateShardId(type, key);
 
         return container().invoke_on(node_shard_id, [type, key](Shard &local_shard) {
-            return local_shard.NodePropertiesDelete(type, key);
+            return local_shard.Durable(local_shard.NodePropertiesDelete(type, key));
         });
     }
 
@@ -318,7 +461,7 @@ namespace ragedb {
         uint16_t node_shard_id = CalculateShardId(id);
 
         return container().invoke_on(node_shard_id, [id](Shard &local_shard) {
-            return local_shard.NodePropertiesDelete(id);
+            return local_shard.Durable(local_shard.NodePropertiesDelete(id));
         });
     }
 
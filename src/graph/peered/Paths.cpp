@@ -0,0 +1,288 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include "../Shard.h"
+
+namespace ragedb {
+
+    /**
+     * Find the shortest path between two nodes by number of relationships with a bidirectional breadth first search.
+     * The side with the smaller frontier takes the next step, every Shard expands its part of that frontier in parallel
+     * and this Shard keeps the visited nodes of both sides, so each level costs one message round.
+     *
+     * @param id1 starting node
+     * @param id2 ending node
+     * @param direction direction to follow relationships from the starting node
+     * @param rel_types relationship types to follow, all of them when empty
+     * @param max_depth longest path to look for
+     * @return the path, with no nodes when there is none within max_depth
+     */
+    seastar::future<Path> Shard::ShortestPathPeered(uint64_t id1, uint64_t id2, Direction direction, const std::vector<std::string>& rel_types, uint64_t max_depth) {
+        Hop forward;
+        forward.direction = direction;
+        for (const auto& rel_type : rel_types) {
+            forward.rel_type_ids.emplace_back(relationship_types.getTypeId(rel_type));
+        }
+        Hop backward = forward;
+        backward.direction = direction == IN ? OUT : direction == OUT ? IN : BOTH;
+
+        return seastar::async([id1, id2, forward = std::move(forward), backward = std::move(backward), max_depth, this] () {
+            struct Visit {
+                uint64_t parent;
+                uint64_t rel_id;
+                uint64_t depth;
+            };
+
+            Path path;
+            bool valid = container().invoke_on(CalculateShardId(id1), [id1] (Shard &local_shard) { return local_shard.ValidNodeId(id1); }).get0() &&
+                         container().invoke_on(CalculateShardId(id2), [id2] (Shard &local_shard) { return local_shard.ValidNodeId(id2); }).get0();
+            if (!valid) {
+                return path;
+            }
+            if (id1 == id2) {
+                path.node_ids.emplace_back(id1);
+                return path;
+            }
+
+            std::map<uint64_t, Visit> visited_forward {{id1, {0, 0, 0}}};
+            std::map<uint64_t, Visit> visited_backward {{id2, {0, 0, 0}}};
+            std::vector<uint64_t> frontier_forward {id1};
+            std::vector<uint64_t> frontier_backward {id2};
+            uint64_t best = max_depth + 1;
+            uint64_t meet_from = 0;
+            uint64_t meet_rel = 0;
+            uint64_t meet_to = 0;
+
+            for (uint64_t depth = 0; depth < max_depth && !frontier_forward.empty() && !frontier_backward.empty(); depth++) {
+                bool going_forward = frontier_forward.size() <= frontier_backward.size();
+                std::vector<uint64_t> &frontier = going_forward ? frontier_forward : frontier_backward;
+                std::map<uint64_t, Visit> &visited = going_forward ? visited_forward : visited_backward;
+                std::map<uint64_t, Visit> &other = going_forward ? visited_backward : visited_forward;
+                const Hop &hop = going_forward ? forward : backward;
+
+                std::map<uint16_t, std::vector<uint64_t>> sharded_ids;
+                for (uint64_t id : frontier) {
+                    sharded_ids[CalculateShardId(id)].emplace_back(id);
+                }
+                std::vector<seastar::future<std::vector<std::vector<PathStep>>>> futures;
+                for (const auto& [their_shard, grouped_ids] : sharded_ids) {
+                    futures.push_back(container().invoke_on(their_shard, [grouped_ids = grouped_ids, hop] (Shard &local_shard) {
+                        return local_shard.PathExpand(grouped_ids, hop, "");
+                    }));
+                }
+                std::vector<std::vector<std::vector<PathStep>>> results = seastar::when_all_succeed(futures.begin(), futures.end()).get0();
+
+                std::vector<uint64_t> next;
+                size_t result = 0;
+                for (const auto& [their_shard, grouped_ids] : sharded_ids) {
+                    for (size_t i = 0; i < grouped_ids.size(); i++) {
+                        uint64_t from = grouped_ids[i];
+                        uint64_t from_depth = visited[from].depth;
+                        for (const PathStep &step : results[result][i]) {
+                            auto found = other.find(step.node_id);
+                            if (found != other.end() && from_depth + 1 + found->second.depth < best) {
+                                best = from_depth + 1 + found->second.depth;
+                                // Always remember the meeting point in the direction of the path
+                                meet_from = going_forward ? from : step.node_id;
+                                meet_to = going_forward ? step.node_id : from;
+                                meet_rel = step.rel_id;
+                            }
+                            if (visited.find(step.node_id) == visited.end()) {
+                                visited.emplace(step.node_id, Visit {from, step.rel_id, from_depth + 1});
+                                next.emplace_back(step.node_id);
+                            }
+                        }
+                    }
+                    result++;
+                }
+                frontier = std::move(next);
+
+                // Every path found later would be at least one relationship longer
+                if (best <= max_depth) {
+                    break;
+                }
+            }
+
+            if (best > max_depth) {
+                return path;
+            }
+            for (uint64_t id = meet_from; id != id1; id = visited_forward[id].parent) {
+                path.node_ids.emplace_back(id);
+                path.rel_ids.emplace_back(visited_forward[id].rel_id);
+            }
+            path.node_ids.emplace_back(id1);
+            std::reverse(path.node_ids.begin(), path.node_ids.end());
+            std::reverse(path.rel_ids.begin(), path.rel_ids.end());
+            path.rel_ids.emplace_back(meet_rel);
+            for (uint64_t id = meet_to; id != id2; id = visited_backward[id].parent) {
+                path.node_ids.emplace_back(id);
+                path.rel_ids.emplace_back(visited_backward[id].rel_id);
+            }
+            path.node_ids.emplace_back(id2);
+            path.weight = static_cast<double>(path.rel_ids.size());
+            return path;
+        });
+    }
+
+    /**
+     * Find the lightest path between two nodes with delta stepping. Nodes are kept in buckets of width delta by distance
+     * and every node of the lightest bucket is expanded in parallel by the Shard it belongs to. Weights of relationships
+     * stored on another Shard than the node they were reached from are then read with one message per Shard.
+     * Relationships without a numeric weight weigh 1, relationships with a negative weight are not followed.
+     *
+     * @param id1 starting node
+     * @param id2 ending node
+     * @param direction direction to follow relationships from the starting node
+     * @param rel_types relationship types to follow, all of them when empty
+     * @param weight relationship property holding the weight
+     * @param max_depth paths are only extended from nodes reached with fewer relationships than this
+     * @param delta bucket width, a large delta expands more nodes per round, a small one wastes fewer expansions
+     * @return the path, with no nodes when there is none
+     */
+    seastar::future<Path> Shard::WeightedShortestPathPeered(uint64_t id1, uint64_t id2, Direction direction, const std::vector<std::string>& rel_types, const std::string& weight,
+                                                            uint64_t max_depth, double delta) {
+        Hop hop;
+        hop.direction = direction;
+        for (const auto& rel_type : rel_types) {
+            hop.rel_type_ids.emplace_back(relationship_types.getTypeId(rel_type));
+        }
+        if (!(delta > 0)) {
+            delta = 1.0;
+        }
+
+        return seastar::async([id1, id2, hop = std::move(hop), weight, max_depth, delta, this] () {
+            struct Visit {
+                double distance;
+                uint64_t parent;
+                uint64_t rel_id;
+                uint64_t depth;
+            };
+
+            Path path;
+            bool valid = container().invoke_on(CalculateShardId(id1), [id1] (Shard &local_shard) { return local_shard.ValidNodeId(id1); }).get0() &&
+                         container().invoke_on(CalculateShardId(id2), [id2] (Shard &local_shard) { return local_shard.ValidNodeId(id2); }).get0();
+            if (!valid) {
+                return path;
+            }
+
+            std::map<uint64_t, Visit> visited {{id1, {0, 0, 0, 0}}};
+            // Distance each node had when it was last expanded, it only needs expanding again if it got lighter
+            std::map<uint64_t, double> expanded;
+            std::map<uint64_t, std::set<uint64_t>> buckets {{0, {id1}}};
+
+            while (!buckets.empty()) {
+                auto [bucket, bucket_ids] = *buckets.begin();
+                buckets.erase(buckets.begin());
+                auto end = visited.find(id2);
+                if (end != visited.end() && static_cast<double>(bucket) * delta > end->second.distance) {
+                    break;
+                }
+
+                std::map<uint16_t, std::vector<uint64_t>> sharded_ids;
+                for (uint64_t id : bucket_ids) {
+                    const Visit &visit = visited[id];
+                    auto previous = expanded.find(id);
+                    if (visit.depth >= max_depth || (previous != expanded.end() && previous->second <= visit.distance)) {
+                        continue;
+                    }
+                    expanded[id] = visit.distance;
+                    sharded_ids[CalculateShardId(id)].emplace_back(id);
+                }
+                if (sharded_ids.empty()) {
+                    continue;
+                }
+
+                std::vector<seastar::future<std::vector<std::vector<PathStep>>>> futures;
+                for (const auto& [their_shard, grouped_ids] : sharded_ids) {
+                    futures.push_back(container().invoke_on(their_shard, [grouped_ids = grouped_ids, hop, weight] (Shard &local_shard) {
+                        return local_shard.PathExpand(grouped_ids, hop, weight);
+                    }));
+                }
+                std::vector<std::vector<std::vector<PathStep>>> results = seastar::when_all_succeed(futures.begin(), futures.end()).get0();
+
+                // Fill in the weights the expanding Shards could not read
+                std::map<uint16_t, std::vector<uint64_t>> sharded_rel_ids;
+                for (const auto& result : results) {
+                    for (const auto& steps : result) {
+                        for (const PathStep &step : steps) {
+                            if (std::isnan(step.weight)) {
+                                sharded_rel_ids[CalculateShardId(step.rel_id)].emplace_back(step.rel_id);
+                            }
+                        }
+                    }
+                }
+                std::map<uint64_t, double> remote_weights;
+                if (!sharded_rel_ids.empty()) {
+                    std::vector<seastar::future<std::vector<double>>> weight_futures;
+                    for (const auto& [their_shard, grouped_rel_ids] : sharded_rel_ids) {
+                        weight_futures.push_back(container().invoke_on(their_shard, [grouped_rel_ids = grouped_rel_ids, weight] (Shard &local_shard) {
+                            return local_shard.RelationshipWeights(grouped_rel_ids, weight);
+                        }));
+                    }
+                    std::vector<std::vector<double>> weights = seastar::when_all_succeed(weight_futures.begin(), weight_futures.end()).get0();
+                    size_t result = 0;
+                    for (const auto& [their_shard, grouped_rel_ids] : sharded_rel_ids) {
+                        for (size_t i = 0; i < grouped_rel_ids.size(); i++) {
+                            remote_weights[grouped_rel_ids[i]] = weights[result][i];
+                        }
+                        result++;
+                    }
+                }
+
+                size_t result = 0;
+                for (const auto& [their_shard, grouped_ids] : sharded_ids) {
+                    for (size_t i = 0; i < grouped_ids.size(); i++) {
+                        uint64_t from = grouped_ids[i];
+                        Visit from_visit = visited[from];
+                        for (const PathStep &step : results[result][i]) {
+                            double step_weight = std::isnan(step.weight) ? remote_weights[step.rel_id] : step.weight;
+                            if (step_weight < 0) {
+                                continue;
+                            }
+                            double distance = from_visit.distance + step_weight;
+                            auto found = visited.find(step.node_id);
+                            if (found == visited.end() || distance < found->second.distance) {
+                                visited[step.node_id] = Visit {distance, from, step.rel_id, from_visit.depth + 1};
+                                // Light relationships land back in the current bucket and get expanded next round
+                                buckets[static_cast<uint64_t>(distance / delta)].insert(step.node_id);
+                            }
+                        }
+                    }
+                    result++;
+                }
+            }
+
+            auto end = visited.find(id2);
+            if (end == visited.end()) {
+                return path;
+            }
+            for (uint64_t id = id2; id != id1; id = visited[id].parent) {
+                path.node_ids.emplace_back(id);
+                path.rel_ids.emplace_back(visited[id].rel_id);
+            }
+            path.node_ids.emplace_back(id1);
+            std::reverse(path.node_ids.begin(), path.node_ids.end());
+            std::reverse(path.rel_ids.begin(), path.rel_ids.end());
+            path.weight = end->second.distance;
+            return path;
+        });
+    }
+
+}
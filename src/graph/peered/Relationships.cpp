@@ -28,7 +28,7 @@ namespace ragedb {
             // if the shards are the same, then handle this special case
             if(shard_id1 == shard_id2) {
                 return container().invoke_on(shard_id1, [rel_type_id, type1, key1, type2, key2](Shard &local_shard) {
-                    return local_shard.RelationshipAddEmptySameShard(rel_type_id, type1, key1, type2, key2);
+                    return local_shard.Durable(local_shard.RelationshipAddEmptySameShard(rel_type_id, type1, key1, type2, key2));
                 });
             }
             // we need to get id2 on its shard
@@ -51,14 +51,14 @@ namespace ragedb {
                             }
                         }
                         // We return a vector because we need both the node id and the relationship id
-                        return ids;
+                        return local_shard.Durable(ids);
                     }).then([rel_type_id, shard_id2, id2, this](std::vector<uint64_t> ids) {
                         // if the relationship is valid (and by extension both nodes) then add the second part
                         if (!ids.empty()) {
                             return container()
                             .invoke_on(shard_id2, [rel_type_id, id1 = ids[0], id2, rel_id = ids[1]](
                                     Shard &local_shard) {
-                                return local_shard.RelationshipAddToIncoming(rel_type_id, rel_id, id1, id2);
+                                return local_shard.Durable(local_shard.RelationshipAddToIncoming(rel_type_id, rel_id, id1, id2));
                             });
                         }
                         return seastar::make_ready_future<uint64_t>(uint64_t(0));
@@ -76,7 +76,7 @@ namespace ragedb {
                         // if the shards are the same, then handle this special case
                         if(shard_id1 == shard_id2) {
                             return container().invoke_on(shard_id1, [rel_type_id, type1, key1, type2, key2](Shard &local_shard) {
-                                return local_shard.RelationshipAddEmptySameShard(rel_type_id, type1, key1, type2, key2);
+                                return local_shard.Durable(local_shard.RelationshipAddEmptySameShard(rel_type_id, type1, key1, type2, key2));
                             });
                         }
                         // we need to get id2 on its shard
@@ -99,14 +99,14 @@ namespace ragedb {
                                                 }
                                             }
                                             // We return a vector because we need both the node id and the relationship id
-                                            return ids;
+                                            return local_shard.Durable(ids);
                                         }).then([rel_type_id, shard_id2, id2, this](std::vector<uint64_t> ids) {
                                     // if the relationship is valid (and by extension both nodes) then add the second part
                                     if (!ids.empty()) {
                                         return container()
                                                 .invoke_on(shard_id2, [rel_type_id, id1 = ids[0], id2, rel_id = ids[1]](
                                                         Shard &local_shard) {
-                                                    return local_shard.RelationshipAddToIncoming(rel_type_id, rel_id, id1, id2);
+                                                    return local_shard.Durable(local_shard.RelationshipAddToIncoming(rel_type_id, rel_id, id1, id2));
                                                 });
                                     }
                                     return seastar::make_ready_future<uint64_t>(uint64_t(0));
@@ -130,7 +130,7 @@ namespace ragedb {
             // if the shards are the same, then handle this special case
             if(shard_id1 == shard_id2) {
                 return container().invoke_on(shard_id1, [rel_type_id, type1, key1, type2, key2, properties](Shard &local_shard) {
-                    return local_shard.RelationshipAddSameShard(rel_type_id, type1, key1, type2, key2, properties);
+                    return local_shard.Durable(local_shard.RelationshipAddSameShard(rel_type_id, type1, key1, type2, key2, properties));
                 });
             }
             // we need to get id2 on its shard
@@ -153,14 +153,14 @@ namespace ragedb {
                                     }
                                 }
                                 // We return a vector because we need both the node id and the relationship id
-                                return ids;
+                                return local_shard.Durable(ids);
                             }).then([rel_type_id, shard_id2, id2, this](std::vector<uint64_t> ids) {
                         // if the relationship is valid (and by extension both nodes) then add the second part
                         if (!ids.empty()) {
                             return container()
                                     .invoke_on(shard_id2, [rel_type_id, id1 = ids[0], id2, rel_id = ids[1]](
                                             Shard &local_shard) {
-                                        return local_shard.RelationshipAddToIncoming(rel_type_id, rel_id, id1, id2);
+                                        return local_shard.Durable(local_shard.RelationshipAddToIncoming(rel_type_id, rel_id, id1, id2));
                                     });
                         }
                         return seastar::make_ready_future<uint64_t>(uint64_t(0));
@@ -179,8 +179,8 @@ namespace ragedb {
                         if (shard_id1 == shard_id2) {
                             return container().invoke_on(shard_id1, [rel_type_id, type1, key1, type2, key2, properties](
                                     Shard &local_shard) {
-                                return local_shard.RelationshipAddSameShard(rel_type_id, type1, key1, type2, key2,
-                                                                            properties);
+                                return local_shard.Durable(local_shard.RelationshipAddSameShard(rel_type_id, type1, key1, type2, key2,
+                                                                            properties));
                             });
                         }
                         // we need to get id2 on its shard
@@ -204,7 +204,7 @@ namespace ragedb {
                                                            }
                                                        }
                                                        // We return a vector because we need both the node id and the relationship id
-                                                       return ids;
+                                                       return local_shard.Durable(ids);
                                                    }).then(
                                         [rel_type_id, shard_id2, id2, this](std::vector<uint64_t> ids) {
                                             // if the relationship is valid (and by extension both nodes) then add the second part
@@ -213,8 +213,8 @@ namespace ragedb {
                                                         .invoke_on(shard_id2,
                                                                    [rel_type_id, id1 = ids[0], id2, rel_id = ids[1]](
                                                                            Shard &local_shard) {
-                                                                       return local_shard.RelationshipAddToIncoming(
-                                                                               rel_type_id, rel_id, id1, id2);
+                                                                       return local_shard.Durable(local_shard.RelationshipAddToIncoming(
+                                                                               rel_type_id, rel_id, id1, id2));
                                                                    });
                                             }
                                             return seastar::make_ready_future<uint64_t>(uint64_t(0));
@@ -237,7 +237,7 @@ namespace ragedb {
             // if the shards are the same, then handle this special case
             if (shard_id1 == shard_id2) {
                 return container().invoke_on(shard_id1, [rel_type_id, id1, id2](Shard &local_shard) {
-                    return local_shard.RelationshipAddEmptySameShard(rel_type_id, id1, id2);
+                    return local_shard.Durable(local_shard.RelationshipAddEmptySameShard(rel_type_id, id1, id2));
                 });
             }
             // we need to validate id2 on its shard
@@ -249,15 +249,15 @@ namespace ragedb {
                     return container().invoke_on(shard_id1,[rel_type_id, id1, id2](Shard &local_shard) {
                         if (local_shard.ValidNodeId(id1)) {
                             // if both nodes are valid, then go ahead and try to create the relationship
-                            return local_shard.RelationshipAddEmptyToOutgoing(rel_type_id, id1, id2);
+                            return local_shard.Durable(local_shard.RelationshipAddEmptyToOutgoing(rel_type_id, id1, id2));
                         }
                         // Invalid id1
-                        return uint64_t(0);
+                        return seastar::make_ready_future<uint64_t>(uint64_t(0));
                             }).then([rel_type_id, shard_id2, id1, id2, this](uint64_t rel_id) {
                                 // if the relationship is valid (and by extension both nodes) then add the second part
                                 if (rel_id > 0) {
                                  return container().invoke_on(shard_id2, [rel_type_id, id1, id2, rel_id](Shard &local_shard) {
-                                        return local_shard.RelationshipAddToIncoming(rel_type_id, rel_id, id1, id2);
+                                        return local_shard.Durable(local_shard.RelationshipAddToIncoming(rel_type_id, rel_id, id1, id2));
                                  });
                                 }
                                 return seastar::make_ready_future<uint64_t>(uint64_t(0));
@@ -273,7 +273,7 @@ namespace ragedb {
                     .then([shard_id1, shard_id2, rel_type, id1, id2, this](uint16_t rel_type_id) {
                         if (shard_id1 == shard_id2) {
                             return container().invoke_on(shard_id1, [rel_type_id, id1, id2](Shard &local_shard) {
-                                return local_shard.RelationshipAddEmptySameShard(rel_type_id, id1, id2);
+                                return local_shard.Durable(local_shard.RelationshipAddEmptySameShard(rel_type_id, id1, id2));
                             });
                         }
 
@@ -286,15 +286,15 @@ namespace ragedb {
                                 return container().invoke_on(shard_id1,[rel_type_id, id1, id2](Shard &local_shard) {
                                     if (local_shard.ValidNodeId(id1)) {
                                         // if both nodes are valid, then go ahead and try to create the relationship
-                                        return local_shard.RelationshipAddEmptyToOutgoing(rel_type_id, id1, id2);
+                                        return local_shard.Durable(local_shard.RelationshipAddEmptyToOutgoing(rel_type_id, id1, id2));
                                     }
                                     // Invalid id1
-                                    return uint64_t(0);
+                                    return seastar::make_ready_future<uint64_t>(uint64_t(0));
                                 }).then([rel_type_id, shard_id2, id1, id2, this](uint64_t rel_id) {
                                     // if the relationship is valid (and by extension both nodes) then add the second part
                                     if (rel_id > 0) {
                                         return container().invoke_on(shard_id2, [rel_type_id, id1, id2, rel_id](Shard &local_shard) {
-                                            return local_shard.RelationshipAddToIncoming(rel_type_id, rel_id, id1, id2);
+                                            return local_shard.Durable(local_shard.RelationshipAddToIncoming(rel_type_id, rel_id, id1, id2));
                                         });
                                     }
                                     return seastar::make_ready_future<uint64_t>(uint64_t(0));
@@ -317,7 +317,7 @@ namespace ragedb {
             // if the shards are the same, then handle this special case
             if (shard_id1 == shard_id2) {
                 return container().invoke_on(shard_id1, [rel_type_id, id1, id2](Shard &local_shard) {
-                    return local_shard.RelationshipAddEmptySameShard(rel_type_id, id1, id2);
+                    return local_shard.Durable(local_shard.RelationshipAddEmptySameShard(rel_type_id, id1, id2));
                 });
             }
             // we need to validate id2 on its shard
@@ -329,15 +329,15 @@ namespace ragedb {
                     return container().invoke_on(shard_id1,[rel_type_id, id1, id2](Shard &local_shard) {
                         if (local_shard.ValidNodeId(id1)) {
                             // if both nodes are valid, then go ahead and try to create the relationship
-                            return local_shard.RelationshipAddEmptyToOutgoing(rel_type_id, id1, id2);
+                            return local_shard.Durable(local_shard.RelationshipAddEmptyToOutgoing(rel_type_id, id1, id2));
                         }
                         // Invalid id1
-                        return uint64_t(0);
+                        return seastar::make_ready_future<uint64_t>(uint64_t(0));
                     }).then([rel_type_id, shard_id2, id1, id2, this](uint64_t rel_id) {
                         // if the relationship is valid (and by extension both nodes) then add the second part
                         if (rel_id > 0) {
                             return container().invoke_on(shard_id2, [rel_type_id, id1, id2, rel_id](Shard &local_shard) {
-                                return local_shard.RelationshipAddToIncoming(rel_type_id, rel_id, id1, id2);
+                                return local_shard.Durable(local_shard.RelationshipAddToIncoming(rel_type_id, rel_id, id1, id2));
                             });
                         }
                         return seastar::make_ready_future<uint64_t>(uint64_t(0));
@@ -360,7 +360,7 @@ namespace ragedb {
         if (rel_type_id > 0) {
             if (shard_id1 == shard_id2) {
                 return container().invoke_on(shard_id1, [rel_type_id, id1, id2, properties](Shard &local_shard) {
-                    return local_shard.RelationshipAddSameShard(rel_type_id, id1, id2, properties);
+                    return local_shard.Durable(local_shard.RelationshipAddSameShard(rel_type_id, id1, id2, properties));
                 });
             }
 
@@ -373,15 +373,15 @@ namespace ragedb {
                     return container().invoke_on(shard_id1,[rel_type_id, id1, id2, properties](Shard &local_shard) {
                         if (local_shard.ValidNodeId(id1)) {
                             // if both nodes are valid, then go ahead and try to create the relationship
-                            return local_shard.RelationshipAddToOutgoing(rel_type_id, id1, id2, properties);
+                            return local_shard.Durable(local_shard.RelationshipAddToOutgoing(rel_type_id, id1, id2, properties));
                         }
                         // Invalid id1
-                        return uint64_t(0);
+                        return seastar::make_ready_future<uint64_t>(uint64_t(0));
                     }).then([rel_type_id, shard_id2, id1, id2, this](uint64_t rel_id) {
                         // if the relationship is valid (and by extension both nodes) then add the second part
                         if (rel_id > 0) {
                             return container().invoke_on(shard_id2, [rel_type_id, id1, id2, rel_id](Shard &local_shard) {
-                                return local_shard.RelationshipAddToIncoming(rel_type_id, rel_id, id1, id2);
+                                return local_shard.Durable(local_shard.RelationshipAddToIncoming(rel_type_id, rel_id, id1, id2));
                             });
                         }
                         return seastar::make_ready_future<uint64_t>(uint64_t(0));
@@ -398,7 +398,7 @@ namespace ragedb {
                     .then([shard_id1, shard_id2, rel_type, id1, id2, properties, this](uint16_t rel_type_id) {
                         if (shard_id1 == shard_id2) {
                             return container().invoke_on(shard_id1, [rel_type_id, id1, id2, properties](Shard &local_shard) {
-                                return local_shard.RelationshipAddSameShard(rel_type_id, id1, id2, properties);
+                                return local_shard.Durable(local_shard.RelationshipAddSameShard(rel_type_id, id1, id2, properties));
                             });
                         }
 
@@ -411,15 +411,15 @@ namespace ragedb {
                                 return container().invoke_on(shard_id1,[rel_type_id, id1, id2, properties](Shard &local_shard) {
                                     if (local_shard.ValidNodeId(id1)) {
                                         // if both nodes are valid, then go ahead and try to create the relationship
-                                        return local_shard.RelationshipAddToOutgoing(rel_type_id, id1, id2, properties);
+                                        return local_shard.Durable(local_shard.RelationshipAddToOutgoing(rel_type_id, id1, id2, properties));
                                     }
                                     // Invalid id1
-                                    return uint64_t(0);
+                                    return seastar::make_ready_future<uint64_t>(uint64_t(0));
                                 }).then([rel_type_id, shard_id2, id1, id2, this](uint64_t rel_id) {
                                     // if the relationship is valid (and by extension both nodes) then add the second part
                                     if (rel_id > 0) {
                                         return container().invoke_on(shard_id2, [rel_type_id, id1, id2, rel_id](Shard &local_shard) {
-                                            return local_shard.RelationshipAddToIncoming(rel_type_id, rel_id, id1, id2);
+                                            return local_shard.Durable(local_shard.RelationshipAddToIncoming(rel_type_id, rel_id, id1, id2));
                                         });
                                     }
                                     return seastar::make_ready_future<uint64_t>(uint64_t(0));
@@ -440,7 +440,7 @@ namespace ragedb {
         if (relationship_types.ValidTypeId(rel_type_id)) {
             if (shard_id1 == shard_id2) {
                 return container().invoke_on(shard_id1, [rel_type_id, id1, id2, properties](Shard &local_shard) {
-                    return local_shard.RelationshipAddSameShard(rel_type_id, id1, id2, properties);
+                    return local_shard.Durable(local_shard.RelationshipAddSameShard(rel_type_id, id1, id2, properties));
                 });
             }
 
@@ -453,15 +453,15 @@ namespace ragedb {
                     return container().invoke_on(shard_id1,[rel_type_id, id1, id2, properties](Shard &local_shard) {
                         if (local_shard.ValidNodeId(id1)) {
                             // if both nodes are valid, then go ahead and try to create the relationship
-                            return local_shard.RelationshipAddToOutgoing(rel_type_id, id1, id2, properties);
+                            return local_shard.Durable(local_shard.RelationshipAddToOutgoing(rel_type_id, id1, id2, properties));
                         }
                         // Invalid id1
-                        return uint64_t(0);
+                        return seastar::make_ready_future<uint64_t>(uint64_t(0));
                     }).then([rel_type_id, shard_id2, id1, id2, this](uint64_t rel_id) {
                         // if the relationship is valid (and by extension both nodes) then add the second part
                         if (rel_id > 0) {
                             return container().invoke_on(shard_id2, [rel_type_id, id1, id2, rel_id](Shard &local_shard) {
-                                return local_shard.RelationshipAddToIncoming(rel_type_id, rel_id, id1, id2);
+                                return local_shard.Durable(local_shard.RelationshipAddToIncoming(rel_type_id, rel_id, id1, id2));
                             });
                         }
                         return seastar::make_ready_future<uint64_t>(uint64_t(0));
@@ -476,56 +476,187 @@ namespace ragedb {
         return seastar::make_ready_future<uint64_t>(uint64_t(0));
     }
 
-    seastar::future<Relationship> Shard::RelationshipGetPeered(uint64_t id) {
-        uint16_t rel_shard_id = CalculateShardId(id);
+    seastar::future<std::vector<uint64_t>> Shard::RelationshipsAddPeered(const std::string &rel_type, const std::vector<uint64_t> &ids1, const std::vector<uint64_t> &ids2,
+                                                                         const std::vector<std::string> &properties) {
+        // Every starting node needs an ending node, don't create the type for a batch that can't be added
+        if (ids1.size() != ids2.size()) {
+            return seastar::make_ready_future<std::vector<uint64_t>>(std::vector<uint64_t>());
+        }
 
-        return container().invoke_on(rel_shard_id, [id] (Shard &local_shard) {
-            return local_shard.RelationshipGet(id);
+        uint16_t rel_type_id = relationship_types.getTypeId(rel_type);
+
+        // The rel type exists, continue on
+        if (rel_type_id > 0) {
+            return RelationshipsAddPeered(rel_type_id, ids1, ids2, properties);
+        }
+
+        // The relationship type needs to be set by Shard 0 and propagated
+        return container().invoke_on(0, [rel_type] (Shard &local_shard) {
+            return local_shard.RelationshipTypeInsertPeered(rel_type);
+        }).then([ids1, ids2, properties, this] (uint16_t rel_type_id) {
+            return RelationshipsAddPeered(rel_type_id, ids1, ids2, properties);
         });
     }
 
+    /**
+     * Add a batch of relationships of one type with a single message per Shard for each step:
+     * validate the ending nodes, add the outgoing sides, then add the incoming sides.
+     *
+     * @param rel_type_id relationship type id
+     * @param ids1 starting node ids
+     * @param ids2 ending node ids
+     * @param properties relationship properties as json, empty or one entry per relationship
+     * @return the new relationship ids in the order of the input, 0 where a node is invalid, empty when ids1 and ids2 differ in length
+     */
+    seastar::future<std::vector<uint64_t>> Shard::RelationshipsAddPeered(uint16_t rel_type_id, const std::vector<uint64_t> &ids1, const std::vector<uint64_t> &ids2,
+                                                                         const std::vector<std::string> &properties) {
+        // Every starting node needs an ending node
+        if (ids1.size() != ids2.size()) {
+            return seastar::make_ready_future<std::vector<uint64_t>>(std::vector<uint64_t>());
+        }
+
+        // Invalid Relationship type id
+        if (!relationship_types.ValidTypeId(rel_type_id)) {
+            return seastar::make_ready_future<std::vector<uint64_t>>(std::vector<uint64_t>(ids1.size(), 0));
+        }
+
+        std::map<uint16_t, std::vector<uint64_t>> sharded_ids2;
+        std::map<uint16_t, std::vector<size_t>> sharded_positions;
+        for (size_t i = 0; i < ids2.size(); i++) {
+            uint16_t shard_id2 = CalculateShardId(ids2[i]);
+            sharded_ids2[shard_id2].emplace_back(ids2[i]);
+            sharded_positions[shard_id2].emplace_back(i);
+        }
+
+        return seastar::async([rel_type_id, ids1, ids2, properties, sharded_ids2 = std::move(sharded_ids2), sharded_positions = std::move(sharded_positions), this] () mutable {
+            // we need to validate the ending nodes on their shards
+            std::vector<seastar::future<std::vector<bool>>> validations;
+            for (auto& [their_shard, grouped_ids2] : sharded_ids2) {
+                validations.push_back(container().invoke_on(their_shard, [grouped_ids2 = std::move(grouped_ids2)] (Shard &local_shard) {
+                    return local_shard.ValidNodeIds(grouped_ids2);
+                }));
+            }
+            std::vector<std::vector<bool>> validated = seastar::when_all_succeed(validations.begin(), validations.end()).get0();
+
+            std::vector<bool> valid(ids2.size(), false);
+            size_t validation = 0;
+            for (const auto& [their_shard, positions] : sharded_positions) {
+                for (size_t j = 0; j < positions.size(); j++) {
+                    valid[positions[j]] = validated[validation][j];
+                }
+                validation++;
+            }
+
+            // then add the outgoing side on the shard of each valid starting node
+            bool with_properties = properties.size() == ids1.size();
+            std::map<uint16_t, std::vector<size_t>> outgoing_positions;
+            std::map<uint16_t, std::vector<uint64_t>> outgoing_ids1;
+            std::map<uint16_t, std::vector<uint64_t>> outgoing_ids2;
+            std::map<uint16_t, std::vector<std::string>> outgoing_properties;
+            for (size_t i = 0; i < ids1.size(); i++) {
+                if (valid[i]) {
+                    uint16_t shard_id1 = CalculateShardId(ids1[i]);
+                    outgoing_positions[shard_id1].emplace_back(i);
+                    outgoing_ids1[shard_id1].emplace_back(ids1[i]);
+                    outgoing_ids2[shard_id1].emplace_back(ids2[i]);
+                    if (with_properties) {
+                        outgoing_properties[shard_id1].emplace_back(std::move(properties[i]));
+                    }
+                }
+            }
+
+            std::vector<seastar::future<std::vector<uint64_t>>> outgoing;
+            for (auto& [their_shard, grouped_ids1] : outgoing_ids1) {
+                outgoing.push_back(container().invoke_on(their_shard, [rel_type_id, grouped_ids1 = std::move(grouped_ids1), grouped_ids2 = std::move(outgoing_ids2[their_shard]),
+                                                                       grouped_properties = std::move(outgoing_properties[their_shard])] (Shard &local_shard) {
+                    return local_shard.Durable(local_shard.RelationshipsAddToOutgoing(rel_type_id, grouped_ids1, grouped_ids2, grouped_properties));
+                }));
+            }
+            std::vector<std::vector<uint64_t>> added = seastar::when_all_succeed(outgoing.begin(), outgoing.end()).get0();
+
+            std::vector<uint64_t> rel_ids(ids1.size(), 0);
+            size_t batch = 0;
+            for (const auto& [their_shard, positions] : outgoing_positions) {
+                for (size_t j = 0; j < positions.size(); j++) {
+                    rel_ids[positions[j]] = added[batch][j];
+                }
+                batch++;
+            }
+
+            // finally add the incoming side of the relationships that were created
+            std::map<uint16_t, std::vector<uint64_t>> incoming_rel_ids;
+            std::map<uint16_t, std::vector<uint64_t>> incoming_ids1;
+            std::map<uint16_t, std::vector<uint64_t>> incoming_ids2;
+            for (size_t i = 0; i < rel_ids.size(); i++) {
+                if (rel_ids[i] > 0) {
+                    uint16_t shard_id2 = CalculateShardId(ids2[i]);
+                    incoming_rel_ids[shard_id2].emplace_back(rel_ids[i]);
+                    incoming_ids1[shard_id2].emplace_back(ids1[i]);
+                    incoming_ids2[shard_id2].emplace_back(ids2[i]);
+                }
+            }
+
+            std::vector<seastar::future<uint64_t>> incoming;
+            for (auto& [their_shard, grouped_rel_ids] : incoming_rel_ids) {
+                incoming.push_back(container().invoke_on(their_shard, [rel_type_id, grouped_rel_ids = std::move(grouped_rel_ids), grouped_ids1 = std::move(incoming_ids1[their_shard]),
+                                                                       grouped_ids2 = std::move(incoming_ids2[their_shard])] (Shard &local_shard) {
+                    return local_shard.Durable(local_shard.RelationshipsAddToIncoming(rel_type_id, grouped_rel_ids, grouped_ids1, grouped_ids2));
+                }));
+            }
+            seastar::when_all_succeed(incoming.begin(), incoming.end()).get();
+
+            return rel_ids;
+        });
+    }
+
+    // Coalesced with the other point reads for the same Shard
+    seastar::future<Relationship> Shard::RelationshipGetPeered(uint64_t id) {
+        return relationship_gets.Add(CalculateShardId(id), id);
+    }
+
     seastar::future<std::vector<Relationship>> Shard::RelationshipsGetPeered(const std::vector<uint64_t> &ids) {
         std::map<uint16_t, std::vector<uint64_t>> sharded_relationship_ids;
-        for (int i = 0; i < cpus; i++) {
-            sharded_relationship_ids.insert({i, std::vector<uint64_t>() });
-        }
         for (auto id : ids) {
             sharded_relationship_ids[CalculateShardId(id)].emplace_back(id);
         }
+        return RelationshipsGetSharded(std::move(sharded_relationship_ids));
+    }
 
+    /**
+     * Get relationships from the Shards they belong to, moving the ids there and the relationships back
+     *
+     * @param sharded_relationship_ids relationship ids grouped by the Shard they belong to
+     * @return the relationships, in Shard order
+     */
+    seastar::future<std::vector<Relationship>> Shard::RelationshipsGetSharded(std::map<uint16_t, std::vector<uint64_t>> sharded_relationship_ids) {
         std::vector<seastar::future<std::vector<Relationship>>> futures;
-        for (auto const& [their_shard, grouped_relationship_ids] : sharded_relationship_ids ) {
-            auto future = container().invoke_on(their_shard, [grouped_node_ids = grouped_relationship_ids] (Shard &local_shard) {
-                return local_shard.RelationshipsGet(grouped_node_ids);
-            });
-            futures.push_back(std::move(future));
+        futures.reserve(sharded_relationship_ids.size());
+        for (auto& [their_shard, grouped_relationship_ids] : sharded_relationship_ids) {
+            futures.push_back(container().invoke_on(their_shard, [grouped_relationship_ids = std::move(grouped_relationship_ids)] (Shard &local_shard) {
+                return local_shard.RelationshipsGet(grouped_relationship_ids);
+            }));
         }
 
-        auto p = make_shared(std::move(futures));
-        return seastar::when_all_succeed(p->begin(), p->end()).then([] (const std::vector<std::vector<Relationship>>& results) {
-            std::vector<Relationship> combined;
-
-            for(const std::vector<Relationship>& sharded : results) {
-                combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-            }
-            return combined;
+        return seastar::when_all_succeed(futures.begin(), futures.end()).then([] (std::vector<std::vector<Relationship>> results) {
+            return MoveMerge(std::move(results));
         });
     }
 
     seastar::future<bool> Shard::RelationshipRemovePeered(uint64_t external_id) {
         uint16_t rel_shard_id = CalculateShardId(external_id);
 
+        // The starting node comes back with the check, so the ending node only looks at its links to it
         return container().invoke_on(rel_shard_id, [external_id] (Shard &local_shard) {
-            return local_shard.ValidRelationshipId(external_id);
-        }).then([rel_shard_id, external_id, this] (bool valid) {
-            if(valid) {
+            return local_shard.ValidRelationshipId(external_id) ? local_shard.RelationshipGetStartingNodeId(external_id) : 0;
+        }).then([rel_shard_id, external_id, this] (uint64_t id1) {
+            if(id1 > 0) {
                 return container().invoke_on(rel_shard_id, [external_id] (Shard &local_shard) {
-                    return local_shard.RelationshipRemoveGetIncoming(external_id);
-                }).then([external_id, this] (std::pair <uint16_t, uint64_t> rel_type_incoming_node_id) {
+                    return local_shard.Durable(local_shard.RelationshipRemoveGetIncoming(external_id));
+                }).then([external_id, id1, this] (std::pair <uint16_t, uint64_t> rel_type_incoming_node_id) {
 
                     uint16_t shard_id2 = CalculateShardId(rel_type_incoming_node_id.second);
-                    return container().invoke_on(shard_id2, [rel_type_incoming_node_id, external_id] (Shard &local_shard) {
-                        return local_shard.RelationshipRemoveIncoming(rel_type_incoming_node_id.first, external_id, rel_type_incoming_node_id.second);
+                    return container().invoke_on(shard_id2, [rel_type_incoming_node_id, external_id, id1] (Shard &local_shard) {
+                        return local_shard.Durable(local_shard.RelationshipRemoveIncoming(rel_type_incoming_node_id.first, external_id, rel_type_incoming_node_id.second, id1));
                     });
                 });
             }
@@ -557,19 +688,25 @@ namespace ragedb {
         });
     }
 
-    seastar::future<std::any> Shard::RelationshipPropertyGetPeered(uint64_t id, const std::string &property) {
-        uint16_t rel_shard_id = CalculateShardId(id);
+    // Relationships are stored with their starting node, so only that Shard is asked
+    seastar::future<bool> Shard::RelationshipExistsPeered(uint64_t id1, uint64_t id2, const std::string &rel_type) {
+        uint16_t node_shard_id = CalculateShardId(id1);
 
-        return container().invoke_on(rel_shard_id, [id, property](Shard &local_shard) {
-            return local_shard.RelationshipPropertyGet(id, property);
+        return container().invoke_on(node_shard_id, [id1, id2, rel_type] (Shard &local_shard) {
+            return local_shard.RelationshipExists(id1, id2, rel_type);
         });
     }
 
+    // Coalesced with the other point reads for the same Shard
+    seastar::future<std::any> Shard::RelationshipPropertyGetPeered(uint64_t id, const std::string &property) {
+        return relationship_property_gets.Add(CalculateShardId(id), {id, property});
+    }
+
     seastar::future<bool> Shard::RelationshipPropertySetPeered(uint64_t id, const std::string& property, const std::any& value) {
         uint16_t rel_shard_id = CalculateShardId(id);
 
         return container().invoke_on(rel_shard_id, [id, property, value](Shard &local_shard) {
-            return local_shard.RelationshipPropertySet(id, property, value);
+            return local_shard.Durable(local_shard.RelationshipPropertySet(id, property, value));
         });
     }
 
@@ -577,7 +714,7 @@ namespace ragedb {
         uint16_t rel_shard_id = CalculateShardId(id);
 
         return container().invoke_on(rel_shard_id, [id, property, value](Shard &local_shard) {
-            return local_shard.RelationshipPropertySetFromJson(id, property, value);
+            return local_shard.Durable(local_shard.RelationshipPropertySetFromJson(id, property, value));
         });
     }
 
@@ -585,7 +722,7 @@ namespace ragedb {
         uint16_t rel_shard_id = CalculateShardId(id);
 
         return container().invoke_on(rel_shard_id, [id, property](Shard &local_shard) {
-            return local_shard.RelationshipPropertyDelete(id, property);
+            return local_shard.Durable(local_shard.RelationshipPropertyDelete(id, property));
         });
     }
 
@@ -601,7 +738,7 @@ namespace ragedb {
         uint16_t rel_shard_id = CalculateShardId(id);
 
         return container().invoke_on(rel_shard_id, [id, value](Shard &local_shard) {
-            return local_shard.RelationshipPropertiesSetFromJson(id, value);
+            return local_shard.Durable(local_shard.RelationshipPropertiesSetFromJson(id, value));
         });
     }
 
@@ -609,7 +746,7 @@ namespace ragedb {
         uint16_t rel_shard_id = CalculateShardId(id);
 
         return container().invoke_on(rel_shard_id, [id, value](Shard &local_shard) {
-            return local_shard.RelationshipPropertiesResetFromJson(id, value);
+            return local_shard.Durable(local_shard.RelationshipPropertiesResetFromJson(id, value));
         });
     }
 
@@ -617,7 +754,7 @@ namespace ragedb {
         uint16_t rel_shard_id = CalculateShardId(id);
 
         return container().invoke_on(rel_shard_id, [id](Shard &local_shard) {
-            return local_shard.RelationshipPropertiesDelete(id);
+            return local_shard.Durable(local_shard.RelationshipPropertiesDelete(id));
         });
     }
 
@@ -151,24 +151,8 @@ namespace ragedb {
 
         return container().invoke_on(node_shard_id, [type, key](Shard &local_shard) {
                     return local_shard.NodeGetShardedRelationshipIDs(type, key); })
-                .then([this] (const std::map<uint16_t, std::vector<uint64_t>>& sharded_relationships_ids) {
-                    std::vector<seastar::future<std::vector<Relationship>>> futures;
-                    for (auto const& [their_shard, grouped_rel_ids] : sharded_relationships_ids ) {
-                        auto future = container().invoke_on(their_shard, [grouped_rel_ids = grouped_rel_ids] (Shard &local_shard) {
-                            return local_shard.RelationshipsGet(grouped_rel_ids);
-                        });
-                        futures.push_back(std::move(future));
-                    }
-
-                    auto p = make_shared(std::move(futures));
-                    return seastar::when_all_succeed(p->begin(), p->end()).then([] (const std::vector<std::vector<Relationship>>& results) {
-                        std::vector<Relationship> combined;
-
-                        for(const std::vector<Relationship>& sharded : results) {
-                            combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                        }
-                        return combined;
-                    });
+                .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_relationships_ids) {
+                    return RelationshipsGetSharded(std::move(sharded_relationships_ids));
                 });
     }
 
@@ -178,24 +162,8 @@ namespace ragedb {
         if (rel_type_id > 0) {
             uint16_t node_shard_id = CalculateShardId(type, key);
             return container().invoke_on(node_shard_id, [type, key, rel_type_id](Shard &local_shard) { return local_shard.NodeGetShardedRelationshipIDs(type, key, rel_type_id); })
-                    .then([this](const std::map<uint16_t, std::vector<uint64_t>> &sharded_relationships_ids) {
-                        std::vector<seastar::future<std::vector<Relationship>>> futures;
-                        for (auto const &[their_shard, grouped_rel_ids] : sharded_relationships_ids) {
-                            auto future = container().invoke_on(their_shard, [grouped_rel_ids = grouped_rel_ids](Shard &local_shard) {
-                                return local_shard.RelationshipsGet(grouped_rel_ids);
-                            });
-                            futures.push_back(std::move(future));
-                        }
-
-                        auto p = make_shared(std::move(futures));
-                        return seastar::when_all_succeed(p->begin(), p->end()).then([](const std::vector<std::vector<Relationship>> &results) {
-                            std::vector<Relationship> combined;
-
-                            for (const std::vector<Relationship> &sharded : results) {
-                                combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                            }
-                            return combined;
-                        });
+                    .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_relationships_ids) {
+                        return RelationshipsGetSharded(std::move(sharded_relationships_ids));
                     });
         }
 
@@ -206,24 +174,8 @@ namespace ragedb {
         if (rel_type_id > 0) {
             uint16_t node_shard_id = CalculateShardId(type, key);
             return container().invoke_on(node_shard_id, [type, key, rel_type_id](Shard &local_shard) { return local_shard.NodeGetShardedRelationshipIDs(type, key, rel_type_id); })
-                    .then([this](const std::map<uint16_t, std::vector<uint64_t>> &sharded_relationships_ids) {
-                        std::vector<seastar::future<std::vector<Relationship>>> futures;
-                        for (auto const &[their_shard, grouped_rel_ids] : sharded_relationships_ids) {
-                            auto future = container().invoke_on(their_shard, [grouped_rel_ids = grouped_rel_ids](Shard &local_shard) {
-                                return local_shard.RelationshipsGet(grouped_rel_ids);
-                            });
-                            futures.push_back(std::move(future));
-                        }
-
-                        auto p = make_shared(std::move(futures));
-                        return seastar::when_all_succeed(p->begin(), p->end()).then([](const std::vector<std::vector<Relationship>> &results) {
-                            std::vector<Relationship> combined;
-
-                            for (const std::vector<Relationship> &sharded : results) {
-                                combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                            }
-                            return combined;
-                        });
+                    .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_relationships_ids) {
+                        return RelationshipsGetSharded(std::move(sharded_relationships_ids));
                     });
         }
 
@@ -234,24 +186,8 @@ namespace ragedb {
         uint16_t node_shard_id = CalculateShardId(type, key);
 
         return container().invoke_on(node_shard_id, [type, key, rel_types](Shard &local_shard) { return local_shard.NodeGetShardedRelationshipIDs(type, key, rel_types); })
-                .then([this](const std::map<uint16_t, std::vector<uint64_t>> &sharded_relationships_ids) {
-                    std::vector<seastar::future<std::vector<Relationship>>> futures;
-                    for (auto const &[their_shard, grouped_rel_ids] : sharded_relationships_ids) {
-                        auto future = container().invoke_on(their_shard, [grouped_rel_ids = grouped_rel_ids](Shard &local_shard) {
-                            return local_shard.RelationshipsGet(grouped_rel_ids);
-                        });
-                        futures.push_back(std::move(future));
-                    }
-
-                    auto p = make_shared(std::move(futures));
-                    return seastar::when_all_succeed(p->begin(), p->end()).then([](const std::vector<std::vector<Relationship>> &results) {
-                        std::vector<Relationship> combined;
-
-                        for (const std::vector<Relationship> &sharded : results) {
-                            combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                        }
-                        return combined;
-                    });
+                .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_relationships_ids) {
+                    return RelationshipsGetSharded(std::move(sharded_relationships_ids));
                 });
     }
 
@@ -260,24 +196,8 @@ namespace ragedb {
 
         return container().invoke_on(node_shard_id, [external_id](Shard &local_shard) {
                     return local_shard.NodeGetShardedRelationshipIDs(external_id); })
-                .then([this] (const std::map<uint16_t, std::vector<uint64_t>>& sharded_relationships_ids) {
-                    std::vector<seastar::future<std::vector<Relationship>>> futures;
-                    for (auto const& [their_shard, grouped_rel_ids] : sharded_relationships_ids ) {
-                        auto future = container().invoke_on(their_shard, [grouped_rel_ids = grouped_rel_ids] (Shard &local_shard) {
-                            return local_shard.RelationshipsGet(grouped_rel_ids);
-                        });
-                        futures.push_back(std::move(future));
-                    }
-
-                    auto p = make_shared(std::move(futures));
-                    return seastar::when_all_succeed(p->begin(), p->end()).then([] (const std::vector<std::vector<Relationship>>& results) {
-                        std::vector<Relationship> combined;
-
-                        for(const std::vector<Relationship>& sharded : results) {
-                            combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                        }
-                        return combined;
-                    });
+                .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_relationships_ids) {
+                    return RelationshipsGetSharded(std::move(sharded_relationships_ids));
                 });
     }
 
@@ -287,24 +207,8 @@ namespace ragedb {
         if (rel_type_id > 0) {
             uint16_t node_shard_id = CalculateShardId(external_id);
             return container().invoke_on(node_shard_id, [external_id, rel_type_id](Shard &local_shard) { return local_shard.NodeGetShardedRelationshipIDs(external_id, rel_type_id); })
-                    .then([this](const std::map<uint16_t, std::vector<uint64_t>> &sharded_relationships_ids) {
-                        std::vector<seastar::future<std::vector<Relationship>>> futures;
-                        for (auto const &[their_shard, grouped_rel_ids] : sharded_relationships_ids) {
-                            auto future = container().invoke_on(their_shard, [grouped_rel_ids = grouped_rel_ids](Shard &local_shard) {
-                                return local_shard.RelationshipsGet(grouped_rel_ids);
-                            });
-                            futures.push_back(std::move(future));
-                        }
-
-                        auto p = make_shared(std::move(futures));
-                        return seastar::when_all_succeed(p->begin(), p->end()).then([](const std::vector<std::vector<Relationship>> &results) {
-                            std::vector<Relationship> combined;
-
-                            for (const std::vector<Relationship> &sharded : results) {
-                                combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                            }
-                            return combined;
-                        });
+                    .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_relationships_ids) {
+                        return RelationshipsGetSharded(std::move(sharded_relationships_ids));
                     });
         }
 
@@ -316,24 +220,8 @@ namespace ragedb {
         if (rel_type_id > 0) {
             uint16_t node_shard_id = CalculateShardId(external_id);
             return container().invoke_on(node_shard_id, [external_id, rel_type_id](Shard &local_shard) { return local_shard.NodeGetShardedRelationshipIDs(external_id, rel_type_id); })
-                    .then([this](const std::map<uint16_t, std::vector<uint64_t>> &sharded_relationships_ids) {
-                        std::vector<seastar::future<std::vector<Relationship>>> futures;
-                        for (auto const &[their_shard, grouped_rel_ids] : sharded_relationships_ids) {
-                            auto future = container().invoke_on(their_shard, [grouped_rel_ids = grouped_rel_ids](Shard &local_shard) {
-                                return local_shard.RelationshipsGet(grouped_rel_ids);
-                            });
-                            futures.push_back(std::move(future));
-                        }
-
-                        auto p = make_shared(std::move(futures));
-                        return seastar::when_all_succeed(p->begin(), p->end()).then([](const std::vector<std::vector<Relationship>> &results) {
-                            std::vector<Relationship> combined;
-
-                            for (const std::vector<Relationship> &sharded : results) {
-                                combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                            }
-                            return combined;
-                        });
+                    .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_relationships_ids) {
+                        return RelationshipsGetSharded(std::move(sharded_relationships_ids));
                     });
         }
 
@@ -344,24 +232,8 @@ namespace ragedb {
         uint16_t node_shard_id = CalculateShardId(external_id);
 
         return container().invoke_on(node_shard_id, [external_id, rel_types](Shard &local_shard) { return local_shard.NodeGetShardedRelationshipIDs(external_id, rel_types); })
-                .then([this](const std::map<uint16_t, std::vector<uint64_t>> &sharded_relationships_ids) {
-                    std::vector<seastar::future<std::vector<Relationship>>> futures;
-                    for (auto const &[their_shard, grouped_rel_ids] : sharded_relationships_ids) {
-                        auto future = container().invoke_on(their_shard, [grouped_rel_ids = grouped_rel_ids](Shard &local_shard) {
-                            return local_shard.RelationshipsGet(grouped_rel_ids);
-                        });
-                        futures.push_back(std::move(future));
-                    }
-
-                    auto p = make_shared(std::move(futures));
-                    return seastar::when_all_succeed(p->begin(), p->end()).then([](const std::vector<std::vector<Relationship>> &results) {
-                        std::vector<Relationship> combined;
-
-                        for (const std::vector<Relationship> &sharded : results) {
-                            combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                        }
-                        return combined;
-                    });
+                .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_relationships_ids) {
+                    return RelationshipsGetSharded(std::move(sharded_relationships_ids));
                 });
     }
 
@@ -376,24 +248,8 @@ namespace ragedb {
             case IN: {
                 return container().invoke_on(node_shard_id, [type, key](Shard &local_shard) {
                             return local_shard.NodeGetShardedIncomingRelationshipIDs(type, key); })
-                        .then([this] (const std::map<uint16_t, std::vector<uint64_t>>& sharded_relationships_ids) {
-                            std::vector<seastar::future<std::vector<Relationship>>> futures;
-                            for (auto const& [their_shard, grouped_rel_ids] : sharded_relationships_ids ) {
-                                auto future = container().invoke_on(their_shard, [grouped_rel_ids = grouped_rel_ids] (Shard &local_shard) {
-                                    return local_shard.RelationshipsGet(grouped_rel_ids);
-                                });
-                                futures.push_back(std::move(future));
-                            }
-
-                            auto p = make_shared(std::move(futures));
-                            return seastar::when_all_succeed(p->begin(), p->end()).then([] (const std::vector<std::vector<Relationship>>& results) {
-                                std::vector<Relationship> combined;
-
-                                for(const std::vector<Relationship>& sharded : results) {
-                                    combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                                }
-                                return combined;
-                            });
+                        .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_relationships_ids) {
+                            return RelationshipsGetSharded(std::move(sharded_relationships_ids));
                         });
             }
             default: return NodeGetRelationshipsPeered(type, key);
@@ -411,24 +267,8 @@ namespace ragedb {
                 }
                 case IN: {
                     return container().invoke_on(node_shard_id, [type, key, rel_type_id](Shard &local_shard) { return local_shard.NodeGetShardedIncomingRelationshipIDs(type, key, rel_type_id); })
-                            .then([this](const std::map<uint16_t, std::vector<uint64_t>>& sharded_relationships_ids) {
-                                std::vector<seastar::future<std::vector<Relationship>>> futures;
-                                for (auto const &[their_shard, grouped_rel_ids] : sharded_relationships_ids) {
-                                    auto future = container().invoke_on(their_shard, [grouped_rel_ids = grouped_rel_ids](Shard &local_shard) {
-                                        return local_shard.RelationshipsGet(grouped_rel_ids);
-                                    });
-                                    futures.push_back(std::move(future));
-                                }
-
-                                auto p = make_shared(std::move(futures));
-                                return seastar::when_all_succeed(p->begin(), p->end()).then([](const std::vector<std::vector<Relationship>>& results) {
-                                    std::vector<Relationship> combined;
-
-                                    for (const std::vector<Relationship>& sharded : results) {
-                                        combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                                    }
-                                    return combined;
-                                });
+                            .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_relationships_ids) {
+                                return RelationshipsGetSharded(std::move(sharded_relationships_ids));
                             });
                 }
                 default:
@@ -448,24 +288,8 @@ namespace ragedb {
                 }
                 case IN: {
                     return container().invoke_on(node_shard_id, [type, key, rel_type_id](Shard &local_shard) { return local_shard.NodeGetShardedIncomingRelationshipIDs(type, key, rel_type_id); })
-                            .then([this](const std::map<uint16_t, std::vector<uint64_t>>& sharded_relationships_ids) {
-                                std::vector<seastar::future<std::vector<Relationship>>> futures;
-                                for (auto const &[their_shard, grouped_rel_ids] : sharded_relationships_ids) {
-                                    auto future = container().invoke_on(their_shard, [grouped_rel_ids = grouped_rel_ids](Shard &local_shard) {
-                                        return local_shard.RelationshipsGet(grouped_rel_ids);
-                                    });
-                                    futures.push_back(std::move(future));
-                                }
-
-                                auto p = make_shared(std::move(futures));
-                                return seastar::when_all_succeed(p->begin(), p->end()).then([](const std::vector<std::vector<Relationship>>& results) {
-                                    std::vector<Relationship> combined;
-
-                                    for (const std::vector<Relationship>& sharded : results) {
-                                        combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                                    }
-                                    return combined;
-                                });
+                            .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_relationships_ids) {
+                                return RelationshipsGetSharded(std::move(sharded_relationships_ids));
                             });
                 }
                 default:
@@ -487,24 +311,8 @@ namespace ragedb {
             case IN: {
                 return container().invoke_on(node_shard_id, [type, key, rel_types](Shard &local_shard) {
                             return local_shard.NodeGetShardedIncomingRelationshipIDs(type, key, rel_types); })
-                        .then([this] (const std::map<uint16_t, std::vector<uint64_t>>& sharded_relationships_ids) {
-                            std::vector<seastar::future<std::vector<Relationship>>> futures;
-                            for (auto const& [their_shard, grouped_rel_ids] : sharded_relationships_ids ) {
-                                auto future = container().invoke_on(their_shard, [grouped_rel_ids = grouped_rel_ids] (Shard &local_shard) {
-                                    return local_shard.RelationshipsGet(grouped_rel_ids);
-                                });
-                                futures.push_back(std::move(future));
-                            }
-
-                            auto p = make_shared(std::move(futures));
-                            return seastar::when_all_succeed(p->begin(), p->end()).then([] (const std::vector<std::vector<Relationship>>& results) {
-                                std::vector<Relationship> combined;
-
-                                for(const std::vector<Relationship>& sharded : results) {
-                                    combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                                }
-                                return combined;
-                            });
+                        .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_relationships_ids) {
+                            return RelationshipsGetSharded(std::move(sharded_relationships_ids));
                         });
             }
             default: return NodeGetRelationshipsPeered(type, key, rel_types);
@@ -523,24 +331,8 @@ namespace ragedb {
             case IN: {
                 return container().invoke_on(node_shard_id, [external_id](Shard &local_shard) {
                             return local_shard.NodeGetShardedIncomingRelationshipIDs(external_id); })
-                        .then([this] (const std::map<uint16_t, std::vector<uint64_t>>& sharded_relationships_ids) {
-                            std::vector<seastar::future<std::vector<Relationship>>> futures;
-                            for (auto const& [their_shard, grouped_rel_ids] : sharded_relationships_ids ) {
-                                auto future = container().invoke_on(their_shard, [grouped_rel_ids = grouped_rel_ids] (Shard &local_shard) {
-                                    return local_shard.RelationshipsGet(grouped_rel_ids);
-                                });
-                                futures.push_back(std::move(future));
-                            }
-
-                            auto p = make_shared(std::move(futures));
-                            return seastar::when_all_succeed(p->begin(), p->end()).then([] (const std::vector<std::vector<Relationship>>& results) {
-                                std::vector<Relationship> combined;
-
-                                for(const std::vector<Relationship>& sharded : results) {
-                                    combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                                }
-                                return combined;
-                            });
+                        .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_relationships_ids) {
+                            return RelationshipsGetSharded(std::move(sharded_relationships_ids));
                         });
             }
             default: return NodeGetRelationshipsPeered(external_id);
@@ -557,24 +349,8 @@ namespace ragedb {
                 }
                 case IN: {
                     return container().invoke_on(node_shard_id, [external_id, rel_type_id](Shard &local_shard) { return local_shard.NodeGetShardedIncomingRelationshipIDs(external_id, rel_type_id); })
-                            .then([this](const std::map<uint16_t, std::vector<uint64_t>>& sharded_relationships_ids) {
-                                std::vector<seastar::future<std::vector<Relationship>>> futures;
-                                for (auto const &[their_shard, grouped_rel_ids] : sharded_relationships_ids) {
-                                    auto future = container().invoke_on(their_shard, [grouped_rel_ids = grouped_rel_ids](Shard &local_shard) {
-                                        return local_shard.RelationshipsGet(grouped_rel_ids);
-                                    });
-                                    futures.push_back(std::move(future));
-                                }
-
-                                auto p = make_shared(std::move(futures));
-                                return seastar::when_all_succeed(p->begin(), p->end()).then([](const std::vector<std::vector<Relationship>>& results) {
-                                    std::vector<Relationship> combined;
-
-                                    for (const std::vector<Relationship>& sharded : results) {
-                                        combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                                    }
-                                    return combined;
-                                });
+                            .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_relationships_ids) {
+                                return RelationshipsGetSharded(std::move(sharded_relationships_ids));
                             });
                 }
                 default:
@@ -594,24 +370,8 @@ namespace ragedb {
                 }
                 case IN: {
                     return container().invoke_on(node_shard_id, [external_id, rel_type_id](Shard &local_shard) { return local_shard.NodeGetShardedIncomingRelationshipIDs(external_id, rel_type_id); })
-                            .then([this](const std::map<uint16_t, std::vector<uint64_t>>& sharded_relationships_ids) {
-                                std::vector<seastar::future<std::vector<Relationship>>> futures;
-                                for (auto const &[their_shard, grouped_rel_ids] : sharded_relationships_ids) {
-                                    auto future = container().invoke_on(their_shard, [grouped_rel_ids = grouped_rel_ids](Shard &local_shard) {
-                                        return local_shard.RelationshipsGet(grouped_rel_ids);
-                                    });
-                                    futures.push_back(std::move(future));
-                                }
-
-                                auto p = make_shared(std::move(futures));
-                                return seastar::when_all_succeed(p->begin(), p->end()).then([](const std::vector<std::vector<Relationship>>& results) {
-                                    std::vector<Relationship> combined;
-
-                                    for (const std::vector<Relationship>& sharded : results) {
-                                        combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                                    }
-                                    return combined;
-                                });
+                            .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_relationships_ids) {
+                                return RelationshipsGetSharded(std::move(sharded_relationships_ids));
                             });
                 }
                 default:
@@ -633,24 +393,8 @@ namespace ragedb {
             case IN: {
                 return container().invoke_on(node_shard_id, [external_id, rel_types](Shard &local_shard) {
                             return local_shard.NodeGetShardedIncomingRelationshipIDs(external_id, rel_types); })
-                        .then([this] (const std::map<uint16_t, std::vector<uint64_t>>& sharded_relationships_ids) {
-                            std::vector<seastar::future<std::vector<Relationship>>> futures;
-                            for (auto const& [their_shard, grouped_rel_ids] : sharded_relationships_ids ) {
-                                auto future = container().invoke_on(their_shard, [grouped_rel_ids = grouped_rel_ids] (Shard &local_shard) {
-                                    return local_shard.RelationshipsGet(grouped_rel_ids);
-                                });
-                                futures.push_back(std::move(future));
-                            }
-
-                            auto p = make_shared(std::move(futures));
-                            return seastar::when_all_succeed(p->begin(), p->end()).then([] (const std::vector<std::vector<Relationship>>& results) {
-                                std::vector<Relationship> combined;
-
-                                for(const std::vector<Relationship>& sharded : results) {
-                                    combined.insert(std::end(combined), std::begin(sharded), std::end(sharded));
-                                }
-                                return combined;
-                            });
+                        .then([this] (std::map<uint16_t, std::vector<uint64_t>> sharded_relationships_ids) {
+                            return RelationshipsGetSharded(std::move(sharded_relationships_ids));
                         });
             }
             default: return NodeGetRelationshipsPeered(external_id, rel_types);
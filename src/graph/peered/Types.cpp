@@ -90,7 +90,7 @@ namespace ragedb {
             // The node type was not found and must therefore be new, add it to all shards.
             type_id = node_types.insertOrGetTypeId(type);
             return container().invoke_on_all([type, type_id](Shard &local_shard) {
-                        local_shard.NodeTypeInsert(type, type_id);
+                        return local_shard.Durable(local_shard.NodeTypeInsert(type, type_id)).discard_result();
                     })
                     .then([type_id, this] {
                         this->node_type_lock.for_write().unlock();
@@ -108,7 +108,7 @@ namespace ragedb {
             this->node_type_lock.for_write().lock().get();
             // The type was found and must therefore be deleted on all shards.
             return container().invoke_on_all([type](Shard &local_shard) {
-                        local_shard.DeleteNodeType(type);
+                        return local_shard.Durable(local_shard.DeleteNodeType(type)).discard_result();
                     })
                     .then([type_id, this] {
                         this->node_type_lock.for_write().unlock();
@@ -119,6 +119,41 @@ namespace ragedb {
         return seastar::make_ready_future<bool>(false);
     }
 
+    /**
+     * Freeze the adjacency of a node type on every Shard, yielding between nodes
+     *
+     * @param type node type
+     * @return future number of links packed across all shards
+     */
+    seastar::future<uint64_t> Shard::NodeTypeFreezePeered(const std::string &type) {
+        seastar::future<std::vector<uint64_t>> v = container().map([type] (Shard &local_shard) {
+            return seastar::async([type, &local_shard] {
+                return local_shard.NodeTypeFreeze(type, [] { seastar::thread::maybe_yield(); });
+            });
+        });
+
+        return v.then([] (const std::vector<uint64_t>& counts) {
+            return std::accumulate(std::begin(counts), std::end(counts), uint64_t(0));
+        });
+    }
+
+    /**
+     * Give back the memory of deleted nodes and relationships on every Shard, in their compaction scheduling group
+     *
+     * @return future number of deleted ids dropped across all shards
+     */
+    seastar::future<uint64_t> Shard::CompactPeered() {
+        seastar::future<std::vector<uint64_t>> v = container().map([] (Shard &local_shard) {
+            return seastar::async(local_shard.CompactionAttributes(), [&local_shard] {
+                return local_shard.Compact([] { seastar::thread::maybe_yield(); });
+            });
+        });
+
+        return v.then([] (const std::vector<uint64_t>& counts) {
+            return std::accumulate(std::begin(counts), std::end(counts), uint64_t(0));
+        });
+    }
+
     std::string Shard::RelationshipTypeGetTypePeered(uint16_t type_id) {
         return relationship_types.getType(type_id);
     }
@@ -138,7 +173,7 @@ namespace ragedb {
             rel_type_id = relationship_types.insertOrGetTypeId(rel_type);
             this->rel_type_lock.for_write().unlock();
             return container().invoke_on_all([rel_type, rel_type_id](Shard &local_shard) {
-                        local_shard.RelationshipTypeInsert(rel_type, rel_type_id);
+                        return local_shard.Durable(local_shard.RelationshipTypeInsert(rel_type, rel_type_id)).discard_result();
                     })
                     .then([rel_type_id] {
                         return seastar::make_ready_future<uint16_t>(rel_type_id);
@@ -155,7 +190,7 @@ namespace ragedb {
             this->rel_type_lock.for_write().lock().get();
             // The type was found and must therefore be deleted on all shards.
             return container().invoke_on_all([type](Shard &local_shard) {
-                        local_shard.DeleteRelationshipType(type);
+                        return local_shard.Durable(local_shard.DeleteRelationshipType(type)).discard_result();
                     })
                     .then([type_id, this] {
                         this->rel_type_lock.for_write().unlock();
@@ -172,7 +207,7 @@ namespace ragedb {
         uint8_t property_type_id = node_types.getNodeTypeProperties(type_id).setPropertyType(key, type);
 
         return container().invoke_on_all([type_id, key, property_type_id](Shard &all_shards) {
-            all_shards.NodePropertyTypeAdd(type_id, key, property_type_id);
+            return all_shards.Durable(all_shards.NodePropertyTypeAdd(type_id, key, property_type_id)).discard_result();
         }).then([type_id, property_type_id, this] {
             this->node_types.getNodeTypeProperties(type_id).property_type_lock.for_write().unlock();
             return seastar::make_ready_future<uint8_t>(property_type_id);
@@ -185,7 +220,7 @@ namespace ragedb {
         uint8_t property_type_id = relationship_types.getProperties(type_id).setPropertyType(key, type);
 
         return container().invoke_on_all([type_id, key, property_type_id](Shard &all_shards) {
-            all_shards.RelationshipPropertyTypeAdd(type_id, key, property_type_id);
+            return all_shards.Durable(all_shards.RelationshipPropertyTypeAdd(type_id, key, property_type_id)).discard_result();
         }).then([type_id, property_type_id, this] {
             this->relationship_types.getProperties(type_id).property_type_lock.for_write().unlock();
             return seastar::make_ready_future<uint8_t>(property_type_id);
@@ -233,7 +268,7 @@ namespace ragedb {
         }
 
         return container().map([type_id, key] (Shard &local_shard) {
-            return local_shard.NodePropertyTypeDelete(type_id, key);
+            return local_shard.Durable(local_shard.NodePropertyTypeDelete(type_id, key));
         }).then([](const std::vector<bool>& deletes) {
             bool successful = true;
             for (auto && i : deletes) {
@@ -250,7 +285,7 @@ namespace ragedb {
         }
 
         return container().map([type_id, key] (Shard &local_shard) {
-            return local_shard.RelationshipPropertyTypeDelete(type_id, key);
+            return local_shard.Durable(local_shard.RelationshipPropertyTypeDelete(type_id, key));
         }).then([](const std::vector<bool>& deletes) {
             bool successful = true;
             for (auto && i : deletes) {
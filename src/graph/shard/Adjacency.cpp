@@ -0,0 +1,95 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <iostream>
+#include "../Shard.h"
+
+namespace ragedb {
+
+    /**
+     * Pack the links of every node of a type into contiguous blocks sorted by relationship type.
+     * Links added or removed afterwards thaw only the group they touch, and freezing the type
+     * again merges those groups back into fresh blocks.
+     *
+     * @param type_id node type id
+     * @param pause called between nodes so a long freeze can give way to other work
+     * @return number of links packed, 0 if the type is not valid, already being frozen or cleared during the freeze
+     */
+    uint64_t Shard::NodeTypeFreeze(uint16_t type_id, const std::function<void()>& pause) {
+        // A second freeze of the same type would release the blocks the first one is packing into
+        if (!node_types.ValidTypeId(type_id) || !freezing_node_types.insert(type_id).second) {
+            return 0;
+        }
+
+        FrozenLinks outgoing;
+        FrozenLinks incoming;
+        uint64_t count = 0;
+        // The type and its size are checked again after every pause, the shard may have changed in between
+        for (uint64_t internal_id = 0; node_types.ValidTypeId(type_id) && internal_id < node_types.getOutgoingRelationships(type_id).size(); internal_id++) {
+            count += node_types.freezeNode(type_id, internal_id, outgoing, incoming);
+            pause();
+        }
+
+        if (!node_types.setFrozenLinks(type_id, std::move(outgoing), std::move(incoming))) {
+            count = 0;
+        }
+        freezing_node_types.erase(type_id);
+        return count;
+    }
+
+    uint64_t Shard::NodeTypeFreeze(const std::string &type, const std::function<void()>& pause) {
+        return NodeTypeFreeze(node_types.getTypeId(type), pause);
+    }
+
+    /**
+     * Merge the links written since the last freeze into every frozen node type on an interval
+     *
+     * @param interval time between merges, 0 to stop merging
+     */
+    void Shard::AdjacencyMergeEvery(std::chrono::seconds interval) {
+        merge_timer.cancel();
+        if (interval.count() == 0) {
+            return;
+        }
+        merge_timer.set_callback([this] {
+            // Skip this round if the last merge is still going
+            if (!merging.available()) {
+                return;
+            }
+            merging = seastar::async([this] {
+                for (uint16_t type_id : node_types.getTypeIds()) {
+                    if (node_types.isFrozen(type_id)) {
+                        NodeTypeFreeze(type_id, [] { seastar::thread::maybe_yield(); });
+                    }
+                }
+            }).handle_exception([this] (const std::exception_ptr& e) {
+                std::cerr << "Exception merging adjacency on Shard " << shard_id << ": " << e << '\n';
+            });
+        });
+        merge_timer.arm_periodic(interval);
+    }
+
+    /**
+     * Stop merging frozen node types
+     *
+     * @return future once the merge in progress, if any, is done
+     */
+    seastar::future<> Shard::StopAdjacencyMerge() {
+        merge_timer.cancel();
+        return std::exchange(merging, seastar::make_ready_future<>());
+    }
+
+}
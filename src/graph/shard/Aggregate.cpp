@@ -0,0 +1,46 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../Shard.h"
+
+namespace ragedb {
+
+    Aggregations Shard::AggregateNodes(const std::string& type, const std::string& property, const std::string& group_by, const std::vector<Condition>& conditions) {
+        return AggregateNodes(node_types.getTypeId(type), property, group_by, conditions);
+    }
+
+    /**
+     * Aggregate a property of the nodes of a type on this Shard, straight from its column
+     *
+     * @param type_id node type id
+     * @param property property to aggregate, empty to count the nodes
+     * @param group_by property to group by, empty for a single group
+     * @param conditions conditions the nodes must match, none for every node of the type
+     * @return partial aggregation of each group on this Shard
+     */
+    Aggregations Shard::AggregateNodes(uint16_t type_id, const std::string& property, const std::string& group_by, const std::vector<Condition>& conditions) {
+        return node_types.aggregate(type_id, property, group_by, conditions);
+    }
+
+    Aggregations Shard::AggregateRelationships(const std::string& rel_type, const std::string& property, const std::string& group_by, const std::vector<Condition>& conditions) {
+        return AggregateRelationships(relationship_types.getTypeId(rel_type), property, group_by, conditions);
+    }
+
+    Aggregations Shard::AggregateRelationships(uint16_t type_id, const std::string& property, const std::string& group_by, const std::vector<Condition>& conditions) {
+        return relationship_types.aggregate(type_id, property, group_by, conditions);
+    }
+
+}
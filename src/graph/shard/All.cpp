@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include "../Shard.h"
 
 namespace ragedb {
@@ -56,6 +57,61 @@ namespace ragedb {
         return node_types.getNodes(type_id, skip, limit);
     }
 
+    Cursor Shard::NextShardCursor(uint16_t type_id) const {
+        Cursor next;
+        next.shard_id = static_cast<uint16_t>(shard_id + 1);
+        next.type_id = type_id;
+        next.done = next.shard_id >= cpus;
+        return next;
+    }
+
+    /**
+     * A page of the nodes of this Shard resuming at a cursor, going through the node types in order.
+     * Only the nodes returned and the deleted ids among them are looked at, however deep the page.
+     *
+     * @param cursor where the last page left off on this Shard, type 0 to start at the first type
+     * @param limit most nodes to return, 0 finishes the paging since an empty page would hand back the same cursor forever
+     * @return the nodes and where the next page starts, on the next Shard once this one has no more
+     */
+    Page<Node> Shard::AllNodes(const Cursor& cursor, uint64_t limit) {
+        if (limit == 0) {
+            return { {}, Cursor{ 0, 0, 0, true } };
+        }
+        Page<Node> page;
+        uint64_t from = cursor.internal_id;
+        for (uint16_t type_id = std::max<uint16_t>(cursor.type_id, 1); type_id <= node_types.getSize(); type_id++) {
+            for (uint64_t internal_id : node_types.getInternalIds(type_id, from, limit - page.results.size())) {
+                page.results.emplace_back(node_types.getNode(type_id, internal_id));
+                from = internal_id + 1;
+            }
+            if (page.results.size() == limit) {
+                page.next = { static_cast<uint16_t>(shard_id), type_id, from, false };
+                return page;
+            }
+            from = 0;
+        }
+        page.next = NextShardCursor(0);
+        return page;
+    }
+
+    Page<Node> Shard::AllNodes(uint16_t type_id, const Cursor& cursor, uint64_t limit) {
+        if (limit == 0) {
+            return { {}, Cursor{ 0, 0, 0, true } };
+        }
+        Page<Node> page;
+        uint64_t from = cursor.internal_id;
+        for (uint64_t internal_id : node_types.getInternalIds(type_id, from, limit)) {
+            page.results.emplace_back(node_types.getNode(type_id, internal_id));
+            from = internal_id + 1;
+        }
+        if (page.results.size() == limit) {
+            page.next = { static_cast<uint16_t>(shard_id), type_id, from, false };
+        } else {
+            page.next = NextShardCursor(type_id);
+        }
+        return page;
+    }
+
     std::vector<uint64_t> Shard::AllRelationshipIds(uint64_t skip, uint64_t limit) {
         return relationship_types.getIds(skip, limit);
     }
@@ -82,6 +138,52 @@ namespace ragedb {
         return relationship_types.getRelationships(type_id, skip, limit);
     }
 
+    /**
+     * A page of the relationships of this Shard resuming at a cursor, going through the relationship types in order
+     *
+     * @param cursor where the last page left off on this Shard, type 0 to start at the first type
+     * @param limit most relationships to return, 0 finishes the paging
+     * @return the relationships and where the next page starts, on the next Shard once this one has no more
+     */
+    Page<Relationship> Shard::AllRelationships(const Cursor& cursor, uint64_t limit) {
+        if (limit == 0) {
+            return { {}, Cursor{ 0, 0, 0, true } };
+        }
+        Page<Relationship> page;
+        uint64_t from = cursor.internal_id;
+        for (uint16_t type_id = std::max<uint16_t>(cursor.type_id, 1); type_id <= relationship_types.getSize(); type_id++) {
+            for (uint64_t internal_id : relationship_types.getInternalIds(type_id, from, limit - page.results.size())) {
+                page.results.emplace_back(relationship_types.getRelationship(type_id, internal_id));
+                from = internal_id + 1;
+            }
+            if (page.results.size() == limit) {
+                page.next = { static_cast<uint16_t>(shard_id), type_id, from, false };
+                return page;
+            }
+            from = 0;
+        }
+        page.next = NextShardCursor(0);
+        return page;
+    }
+
+    Page<Relationship> Shard::AllRelationships(uint16_t type_id, const Cursor& cursor, uint64_t limit) {
+        if (limit == 0) {
+            return { {}, Cursor{ 0, 0, 0, true } };
+        }
+        Page<Relationship> page;
+        uint64_t from = cursor.internal_id;
+        for (uint64_t internal_id : relationship_types.getInternalIds(type_id, from, limit)) {
+            page.results.emplace_back(relationship_types.getRelationship(type_id, internal_id));
+            from = internal_id + 1;
+        }
+        if (page.results.size() == limit) {
+            page.next = { static_cast<uint16_t>(shard_id), type_id, from, false };
+        } else {
+            page.next = NextShardCursor(type_id);
+        }
+        return page;
+    }
+
     std::map<uint16_t, uint64_t> Shard::AllRelationshipIdCounts() {
         return relationship_types.getCounts();
     }
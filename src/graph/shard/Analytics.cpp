@@ -0,0 +1,411 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "../Shard.h"
+
+namespace ragedb {
+
+    // Ranks that move less than this between supersteps count as unchanged
+    static const double RANK_TOLERANCE = 1e-10;
+
+    // Give requests waiting on this core a chance to run every so many nodes, when running in a seastar thread
+    static void AnalyticsYield(size_t done) {
+        if ((done & 1023U) == 0 && seastar::thread::running_in_thread()) {
+            seastar::thread::maybe_yield();
+        }
+    }
+
+    void Shard::SetAnalyticsGroup(seastar::scheduling_group group) {
+        analytics_group = group;
+    }
+
+    // Shares are kept per core, so every Shard sets its own
+    void Shard::SetAnalyticsShares(float shares) {
+        analytics_group.set_shares(shares);
+    }
+
+    seastar::thread_attributes Shard::AnalyticsAttributes() {
+        seastar::thread_attributes attributes;
+        attributes.sched_group = analytics_group;
+        return attributes;
+    }
+
+    /**
+     * Start an analytics job on this Shard by taking a copy of the neighbors of its nodes
+     *
+     * @param job_id job to start
+     * @param algorithm algorithm the job runs
+     * @param hop relationship types and direction to follow
+     * @param damping probability of following a relationship, for PageRank
+     * @return the number of nodes of this Shard in the job
+     */
+    uint64_t Shard::AnalyticsStart(uint64_t job_id, Algorithm algorithm, const Hop &hop, double damping) {
+        AnalyticsJob &job = analytics[job_id];
+        job.algorithm = algorithm;
+        job.damping = damping;
+        job.ids = node_types.getIds(SKIP, std::numeric_limits<uint64_t>::max() - 1);
+        job.neighbors.resize(job.ids.size());
+
+        auto follow = [&hop] (const std::vector<Group> &groups, std::vector<uint64_t> &found) {
+            for (const Group &group : groups) {
+                if (hop.rel_type_ids.empty() || std::find(hop.rel_type_ids.begin(), hop.rel_type_ids.end(), group.rel_type_id) != hop.rel_type_ids.end()) {
+                    for (const Link &link : group.links) {
+                        found.emplace_back(link.node_id);
+                    }
+                }
+            }
+        };
+
+        for (size_t i = 0; i < job.ids.size(); i++) {
+            uint64_t id = job.ids[i];
+            job.positions.emplace(id, i);
+            uint16_t type_id = externalToTypeId(id);
+            uint64_t internal_id = externalToInternal(id);
+            std::vector<uint64_t> &neighbors = job.neighbors[i];
+            if (hop.direction != IN) {
+                follow(node_types.getOutgoingRelationships(type_id).at(internal_id), neighbors);
+            }
+            if (hop.direction != OUT) {
+                follow(node_types.getIncomingRelationships(type_id).at(internal_id), neighbors);
+            }
+            std::sort(neighbors.begin(), neighbors.end());
+            // PageRank splits rank over every relationship, the rest only care about which nodes are neighbors
+            if (algorithm != Algorithm::PageRank) {
+                neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+                neighbors.erase(std::remove(neighbors.begin(), neighbors.end(), id), neighbors.end());
+            }
+            AnalyticsYield(i);
+        }
+
+        switch (algorithm) {
+            case Algorithm::ConnectedComponents:
+            case Algorithm::LabelPropagation: {
+                job.labels = job.ids;
+                break;
+            }
+            default: {
+                job.labels.assign(job.ids.size(), 0);
+            }
+        }
+        job.active.assign(job.ids.size(), true);
+        return job.ids.size();
+    }
+
+    /**
+     * Set the starting values of an analytics job once the number of nodes on every Shard is known
+     *
+     * @param job_id job to initialize
+     * @param nodes number of nodes across all Shards
+     * @return rank held by nodes without relationships to follow
+     */
+    AnalyticsStep Shard::AnalyticsInitialize(uint64_t job_id, uint64_t nodes) {
+        AnalyticsStep result;
+        auto found = analytics.find(job_id);
+        if (found == analytics.end()) {
+            return result;
+        }
+        AnalyticsJob &job = found->second;
+        job.nodes = nodes;
+        if (job.algorithm == Algorithm::PageRank && nodes > 0) {
+            job.values.assign(job.ids.size(), 1.0 / static_cast<double>(nodes));
+            for (size_t i = 0; i < job.ids.size(); i++) {
+                if (job.neighbors[i].empty()) {
+                    result.dangling += job.values[i];
+                }
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Send the messages of the next superstep of an analytics job. Messages for the same node are combined
+     * when the algorithm allows it, so a node gets at most one message from each Shard.
+     *
+     * @param job_id job to run
+     * @return messages grouped by the Shard they are for
+     */
+    std::map<uint16_t, AnalyticsMessages> Shard::AnalyticsSend(uint64_t job_id) {
+        std::map<uint16_t, AnalyticsMessages> messages;
+        auto found = analytics.find(job_id);
+        if (found == analytics.end()) {
+            return messages;
+        }
+        AnalyticsJob &job = found->second;
+
+        switch (job.algorithm) {
+            case Algorithm::PageRank: {
+                std::unordered_map<uint64_t, double> sums;
+                for (size_t i = 0; i < job.ids.size(); i++) {
+                    if (!job.neighbors[i].empty()) {
+                        double share = job.values[i] / static_cast<double>(job.neighbors[i].size());
+                        for (uint64_t neighbor : job.neighbors[i]) {
+                            sums[neighbor] += share;
+                        }
+                    }
+                    AnalyticsYield(i);
+                }
+                for (const auto& [neighbor, sum] : sums) {
+                    AnalyticsMessages &shard_messages = messages[CalculateShardId(neighbor)];
+                    shard_messages.ids.emplace_back(neighbor);
+                    shard_messages.values.emplace_back(sum);
+                }
+                break;
+            }
+            case Algorithm::ConnectedComponents: {
+                std::unordered_map<uint64_t, uint64_t> smallest;
+                for (size_t i = 0; i < job.ids.size(); i++) {
+                    if (job.active[i]) {
+                        job.active[i] = false;
+                        for (uint64_t neighbor : job.neighbors[i]) {
+                            auto [entry, inserted] = smallest.emplace(neighbor, job.labels[i]);
+                            if (!inserted && job.labels[i] < entry->second) {
+                                entry->second = job.labels[i];
+                            }
+                        }
+                    }
+                    AnalyticsYield(i);
+                }
+                for (const auto& [neighbor, label] : smallest) {
+                    AnalyticsMessages &shard_messages = messages[CalculateShardId(neighbor)];
+                    shard_messages.ids.emplace_back(neighbor);
+                    shard_messages.labels.emplace_back(label);
+                }
+                break;
+            }
+            case Algorithm::LabelPropagation: {
+                // Every label counts, so these are not combined
+                for (size_t i = 0; i < job.ids.size(); i++) {
+                    for (uint64_t neighbor : job.neighbors[i]) {
+                        AnalyticsMessages &shard_messages = messages[CalculateShardId(neighbor)];
+                        shard_messages.ids.emplace_back(neighbor);
+                        shard_messages.labels.emplace_back(job.labels[i]);
+                    }
+                    AnalyticsYield(i);
+                }
+                break;
+            }
+            case Algorithm::TriangleCount:
+            case Algorithm::ClusteringCoefficient: {
+                if (job.step > 0) {
+                    messages = std::move(job.outbox);
+                    job.outbox.clear();
+                    break;
+                }
+                // Each triangle u < v < w is found once, by v checking the neighbors of u larger than itself
+                for (size_t i = 0; i < job.ids.size(); i++) {
+                    uint64_t id = job.ids[i];
+                    const std::vector<uint64_t> &neighbors = job.neighbors[i];
+                    for (auto neighbor = std::upper_bound(neighbors.begin(), neighbors.end(), id); neighbor != neighbors.end(); ++neighbor) {
+                        if (neighbor + 1 == neighbors.end()) {
+                            break;
+                        }
+                        AnalyticsMessages &shard_messages = messages[CalculateShardId(*neighbor)];
+                        shard_messages.ids.emplace_back(*neighbor);
+                        shard_messages.labels.emplace_back(id);
+                        shard_messages.neighbors.emplace_back(neighbor + 1, neighbors.end());
+                    }
+                    AnalyticsYield(i);
+                }
+                break;
+            }
+        }
+        return messages;
+    }
+
+    /**
+     * Apply the messages of a superstep of an analytics job to the nodes of this Shard
+     *
+     * @param job_id job to run
+     * @param messages messages for this Shard from every Shard
+     * @param dangling rank held by nodes without relationships to follow across all Shards, for PageRank
+     * @return how many nodes changed and the rank now held by nodes without relationships to follow
+     */
+    AnalyticsStep Shard::AnalyticsReceive(uint64_t job_id, const std::vector<AnalyticsMessages> &messages, double dangling) {
+        AnalyticsStep result;
+        auto found = analytics.find(job_id);
+        if (found == analytics.end()) {
+            return result;
+        }
+        AnalyticsJob &job = found->second;
+        size_t done = 0;
+
+        switch (job.algorithm) {
+            case Algorithm::PageRank: {
+                std::vector<double> sums(job.ids.size(), 0.0);
+                for (const AnalyticsMessages &shard_messages : messages) {
+                    for (size_t i = 0; i < shard_messages.ids.size(); i++) {
+                        auto position = job.positions.find(shard_messages.ids[i]);
+                        if (position != job.positions.end()) {
+                            sums[position->second] += shard_messages.values[i];
+                        }
+                    }
+                }
+                double nodes = static_cast<double>(job.nodes);
+                for (size_t i = 0; i < job.ids.size(); i++) {
+                    double value = (1.0 - job.damping) / nodes + job.damping * (sums[i] + dangling / nodes);
+                    if (std::abs(value - job.values[i]) > RANK_TOLERANCE) {
+                        result.changed++;
+                    }
+                    job.values[i] = value;
+                    if (job.neighbors[i].empty()) {
+                        result.dangling += value;
+                    }
+                    AnalyticsYield(i);
+                }
+                break;
+            }
+            case Algorithm::ConnectedComponents: {
+                for (const AnalyticsMessages &shard_messages : messages) {
+                    for (size_t i = 0; i < shard_messages.ids.size(); i++) {
+                        auto position = job.positions.find(shard_messages.ids[i]);
+                        if (position != job.positions.end() && shard_messages.labels[i] < job.labels[position->second]) {
+                            job.labels[position->second] = shard_messages.labels[i];
+                            if (!job.active[position->second]) {
+                                job.active[position->second] = true;
+                                result.changed++;
+                            }
+                        }
+                        AnalyticsYield(++done);
+                    }
+                }
+                break;
+            }
+            case Algorithm::LabelPropagation: {
+                std::unordered_map<size_t, std::map<uint64_t, uint64_t>> counts;
+                for (const AnalyticsMessages &shard_messages : messages) {
+                    for (size_t i = 0; i < shard_messages.ids.size(); i++) {
+                        auto position = job.positions.find(shard_messages.ids[i]);
+                        if (position != job.positions.end()) {
+                            counts[position->second][shard_messages.labels[i]]++;
+                        }
+                        AnalyticsYield(++done);
+                    }
+                }
+                for (const auto& [position, label_counts] : counts) {
+                    // The most common label wins, ties go to the smallest label so every Shard agrees
+                    uint64_t label = label_counts.begin()->first;
+                    uint64_t count = label_counts.begin()->second;
+                    for (const auto& [candidate, candidate_count] : label_counts) {
+                        if (candidate_count > count) {
+                            label = candidate;
+                            count = candidate_count;
+                        }
+                    }
+                    if (label != job.labels[position]) {
+                        job.labels[position] = label;
+                        result.changed++;
+                    }
+                }
+                break;
+            }
+            case Algorithm::TriangleCount:
+            case Algorithm::ClusteringCoefficient: {
+                if (job.step > 0) {
+                    for (const AnalyticsMessages &shard_messages : messages) {
+                        for (size_t i = 0; i < shard_messages.ids.size(); i++) {
+                            auto position = job.positions.find(shard_messages.ids[i]);
+                            if (position != job.positions.end()) {
+                                job.labels[position->second] += shard_messages.labels[i];
+                            }
+                        }
+                    }
+                    break;
+                }
+                // Credit the two other corners of every triangle found here in the next superstep
+                std::unordered_map<uint64_t, uint64_t> credits;
+                for (const AnalyticsMessages &shard_messages : messages) {
+                    for (size_t i = 0; i < shard_messages.ids.size(); i++) {
+                        auto position = job.positions.find(shard_messages.ids[i]);
+                        if (position == job.positions.end()) {
+                            continue;
+                        }
+                        const std::vector<uint64_t> &neighbors = job.neighbors[position->second];
+                        for (uint64_t other : shard_messages.neighbors[i]) {
+                            if (std::binary_search(neighbors.begin(), neighbors.end(), other)) {
+                                job.labels[position->second]++;
+                                credits[shard_messages.labels[i]]++;
+                                credits[other]++;
+                            }
+                        }
+                        AnalyticsYield(++done);
+                    }
+                }
+                for (const auto& [id, count] : credits) {
+                    AnalyticsMessages &shard_messages = job.outbox[CalculateShardId(id)];
+                    shard_messages.ids.emplace_back(id);
+                    shard_messages.labels.emplace_back(count);
+                }
+                result.changed = credits.size();
+                break;
+            }
+        }
+        job.step++;
+        return result;
+    }
+
+    /**
+     * Write the results of an analytics job to a property of the nodes of this Shard and end the job.
+     * PageRank and clustering coefficients are written as doubles, the rest as integers. Nodes whose
+     * type already has the property with a different data type are skipped.
+     *
+     * @param job_id job to finish
+     * @param property node property to write the results to
+     * @return the number of nodes written
+     */
+    uint64_t Shard::AnalyticsWrite(uint64_t job_id, const std::string &property) {
+        auto found = analytics.find(job_id);
+        if (found == analytics.end()) {
+            return 0;
+        }
+        AnalyticsJob &job = found->second;
+        bool doubles = job.algorithm == Algorithm::PageRank || job.algorithm == Algorithm::ClusteringCoefficient;
+        uint8_t data_type_id = doubles ? Properties::getDoublePropertyType() : Properties::getIntegerPropertyType();
+
+        uint64_t written = 0;
+        for (size_t i = 0; i < job.ids.size(); i++) {
+            uint64_t id = job.ids[i];
+            if (!ValidNodeId(id) || node_types.getNodeTypeProperties(externalToTypeId(id)).getPropertyTypeId(property) != data_type_id) {
+                continue;
+            }
+            std::any value;
+            switch (job.algorithm) {
+                case Algorithm::PageRank: {
+                    value = job.values[i];
+                    break;
+                }
+                case Algorithm::ClusteringCoefficient: {
+                    double degree = static_cast<double>(job.neighbors[i].size());
+                    value = degree < 2 ? 0.0 : 2.0 * static_cast<double>(job.labels[i]) / (degree * (degree - 1));
+                    break;
+                }
+                default: {
+                    value = static_cast<int64_t>(job.labels[i]);
+                }
+            }
+            if (NodePropertySet(id, property, value)) {
+                written++;
+            }
+            AnalyticsYield(i);
+        }
+        analytics.erase(found);
+        return written;
+    }
+
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <iostream>
+#include "../Shard.h"
+
+namespace ragedb {
+
+    void Shard::SetCompactionGroup(seastar::scheduling_group group) {
+        compaction_group = group;
+    }
+
+    seastar::thread_attributes Shard::CompactionAttributes() {
+        seastar::thread_attributes attributes;
+        attributes.sched_group = compaction_group;
+        return attributes;
+    }
+
+    /**
+     * Give back the memory held by the deleted nodes of a type. Nothing is logged, only deleted ids
+     * past the last live node go away and the next node added would have taken the lowest of them,
+     * so replaying the log without the compaction hands out the same ids.
+     *
+     * @param type_id node type id
+     * @param pause called every so many keys, properties and deleted ids so a long compaction can give way to other work
+     * @return number of deleted ids dropped from the end of the type
+     */
+    uint64_t Shard::NodeTypeCompact(uint16_t type_id, const std::function<void()>& pause) {
+        return node_types.compact(type_id, pause);
+    }
+
+    uint64_t Shard::NodeTypeCompact(const std::string &type, const std::function<void()>& pause) {
+        return NodeTypeCompact(node_types.getTypeId(type), pause);
+    }
+
+    uint64_t Shard::RelationshipTypeCompact(uint16_t type_id, const std::function<void()>& pause) {
+        return relationship_types.compact(type_id, pause);
+    }
+
+    /**
+     * Compact every node and relationship type of this Shard
+     *
+     * @param pause called between types and every so many keys, properties and deleted ids
+     * @return number of deleted ids dropped
+     */
+    uint64_t Shard::Compact(const std::function<void()>& pause) {
+        uint64_t count = 0;
+        for (uint16_t type_id : node_types.getTypeIds()) {
+            count += NodeTypeCompact(type_id, pause);
+            pause();
+        }
+        for (uint16_t type_id : relationship_types.getTypeIds()) {
+            count += RelationshipTypeCompact(type_id, pause);
+            pause();
+        }
+        return count;
+    }
+
+    /**
+     * Compact this Shard on an interval, in the compaction scheduling group
+     *
+     * @param interval time between compactions, 0 to stop compacting
+     */
+    void Shard::CompactEvery(std::chrono::seconds interval) {
+        compaction_timer.cancel();
+        if (interval.count() == 0) {
+            return;
+        }
+        compaction_timer.set_callback([this] {
+            // Skip this round if the last compaction is still going
+            if (!compacting.available()) {
+                return;
+            }
+            compacting = seastar::async(CompactionAttributes(), [this] {
+                Compact([] { seastar::thread::maybe_yield(); });
+            }).handle_exception([this] (const std::exception_ptr& e) {
+                std::cerr << "Exception compacting Shard " << shard_id << ": " << e << '\n';
+            });
+        });
+        compaction_timer.arm_periodic(interval);
+    }
+
+    /**
+     * Stop compacting
+     *
+     * @return future once the compaction in progress, if any, is done
+     */
+    seastar::future<> Shard::StopCompaction() {
+        compaction_timer.cancel();
+        return std::exchange(compacting, seastar::make_ready_future<>());
+    }
+
+}
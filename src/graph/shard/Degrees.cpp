@@ -39,102 +39,49 @@ namespace ragedb {
     }
 
     uint64_t Shard::NodeGetDegree(uint64_t id) {
-        if (ValidNodeId(id)) {
-            uint64_t internal_id = externalToInternal(id);
-            uint16_t node_type_id = externalToTypeId(id);
-            return node_types.getOutgoingRelationships(node_type_id).at(internal_id).size() + node_types.getIncomingRelationships(node_type_id).at(internal_id).size();
-        }
-        return 0;
+        return NodeGetDegree(id, BOTH);
     }
 
     uint64_t Shard::NodeGetDegree(uint64_t id, Direction direction) {
         if (ValidNodeId(id)) {
-            uint64_t internal_id = externalToInternal(id);
-            uint16_t node_type_id = externalToTypeId(id);
-            uint64_t count = 0;
-            // Use the two ifs to handle ALL for a direction
-            if (direction != IN) {
-                // For each type sum up the values
-                for (const auto &[key, value] : node_types.getOutgoingRelationships(node_type_id).at(internal_id)) {
-                    count += value.size();
-                }
-            }
-            if (direction != OUT) {
-                // For each type sum up the values
-                for (const auto &[key, value] : node_types.getIncomingRelationships(node_type_id).at(internal_id)) {
-                    count += value.size();
-                }
-            }
-            return count;
+            return node_types.getDegree(externalToTypeId(id), externalToInternal(id), direction);
         }
 
         return 0;
     }
 
     uint64_t Shard::NodeGetDegree(uint64_t id, Direction direction, const std::string &rel_type) {
-        if (ValidNodeId(id)) {
-            uint64_t internal_id = externalToInternal(id);
-            uint16_t node_type_id = externalToTypeId(id);
-            uint16_t type_id = relationship_types.getTypeId(rel_type);
-            if (type_id > 0) {
-                uint64_t count = 0;
-                // Use the two ifs to handle ALL for a direction
-                if (direction != IN) {
-                    auto group = find_if(std::begin(node_types.getOutgoingRelationships(node_type_id).at(internal_id)), std::end(node_types.getOutgoingRelationships(node_type_id).at(internal_id)),
-                                         [type_id] (const Group& g) { return g.rel_type_id == type_id; } );
-
-                    if (group != std::end(node_types.getOutgoingRelationships(node_type_id).at(internal_id))) {
-                        count += group->links.size();
-                    }
-                }
-                if (direction != OUT) {
-                    auto group = find_if(std::begin(node_types.getIncomingRelationships(node_type_id).at(internal_id)), std::end(node_types.getIncomingRelationships(node_type_id).at(internal_id)),
-                                         [type_id] (const Group& g) { return g.rel_type_id == type_id; } );
-
-                    if (group != std::end(node_types.getIncomingRelationships(node_type_id).at(internal_id))) {
-                        count += group->links.size();
-                    }
-                }
-                return count;
-            }
+        return NodeGetDegree(id, direction, relationship_types.getTypeId(rel_type));
+    }
+
+    uint64_t Shard::NodeGetDegree(uint64_t id, Direction direction, uint16_t rel_type_id) {
+        if (rel_type_id > 0 && ValidNodeId(id)) {
+            return node_types.getDegree(externalToTypeId(id), externalToInternal(id), direction, rel_type_id);
         }
 
         return 0;
     }
 
     uint64_t Shard::NodeGetDegree(uint64_t id, Direction direction, const std::vector<std::string> &rel_types) {
+        // Resolve the relationship types once, not once per direction
+        std::vector<uint16_t> rel_type_ids;
+        rel_type_ids.reserve(rel_types.size());
+        for (const auto &rel_type : rel_types) {
+            uint16_t type_id = relationship_types.getTypeId(rel_type);
+            if (type_id > 0) {
+                rel_type_ids.emplace_back(type_id);
+            }
+        }
+        return NodeGetDegree(id, direction, rel_type_ids);
+    }
+
+    uint64_t Shard::NodeGetDegree(uint64_t id, Direction direction, const std::vector<uint16_t> &rel_type_ids) {
         if (ValidNodeId(id)) {
             uint64_t internal_id = externalToInternal(id);
             uint16_t node_type_id = externalToTypeId(id);
             uint64_t count = 0;
-            // Use the two ifs to handle ALL for a direction
-            if (direction != IN) {
-                // For each requested type sum up the values
-                for (const auto &rel_type : rel_types) {
-                    uint16_t type_id = relationship_types.getTypeId(rel_type);
-                    if (type_id > 0) {
-                        auto group = find_if(std::begin(node_types.getOutgoingRelationships(node_type_id).at(internal_id)), std::end(node_types.getOutgoingRelationships(node_type_id).at(internal_id)),
-                                             [type_id] (const Group& g) { return g.rel_type_id == type_id; } );
-
-                        if (group != std::end(node_types.getOutgoingRelationships(node_type_id).at(internal_id))) {
-                            count += group->links.size();
-                        }
-                    }
-                }
-            }
-            if (direction != OUT) {
-                // For each requested type sum up the values
-                for (const auto &rel_type : rel_types) {
-                    uint16_t type_id = relationship_types.getTypeId(rel_type);
-                    if (type_id > 0) {
-                        auto group = find_if(std::begin(node_types.getIncomingRelationships(node_type_id).at(internal_id)), std::end(node_types.getIncomingRelationships(node_type_id).at(internal_id)),
-                                             [type_id] (const Group& g) { return g.rel_type_id == type_id; } );
-
-                        if (group != std::end(node_types.getIncomingRelationships(node_type_id).at(internal_id))) {
-                            count += group->links.size();
-                        }
-                    }
-                }
+            for (uint16_t rel_type_id : rel_type_ids) {
+                count += node_types.getDegree(node_type_id, internal_id, direction, rel_type_id);
             }
             return count;
         }
@@ -142,4 +89,4 @@ namespace ragedb {
         return 0;
     }
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "../Shard.h"
+
+namespace ragedb {
+
+    bool Shard::NodePropertyIndexAdd(uint16_t type_id, const std::string& key) {
+        wal.Append(LogOperation::NodePropertyIndexAdd, type_id, key);
+        if (node_types.ValidTypeId(type_id)) {
+            return node_types.getNodeTypeProperties(type_id).addIndex(key);
+        }
+        return false;
+    }
+
+    bool Shard::NodePropertyIndexDelete(uint16_t type_id, const std::string& key) {
+        wal.Append(LogOperation::NodePropertyIndexDelete, type_id, key);
+        if (node_types.ValidTypeId(type_id)) {
+            return node_types.getNodeTypeProperties(type_id).removeIndex(key);
+        }
+        return false;
+    }
+
+    bool Shard::RelationshipPropertyIndexAdd(uint16_t type_id, const std::string& key) {
+        wal.Append(LogOperation::RelationshipPropertyIndexAdd, type_id, key);
+        if (relationship_types.ValidTypeId(type_id)) {
+            return relationship_types.getProperties(type_id).addIndex(key);
+        }
+        return false;
+    }
+
+    bool Shard::RelationshipPropertyIndexDelete(uint16_t type_id, const std::string& key) {
+        wal.Append(LogOperation::RelationshipPropertyIndexDelete, type_id, key);
+        if (relationship_types.ValidTypeId(type_id)) {
+            return relationship_types.getProperties(type_id).removeIndex(key);
+        }
+        return false;
+    }
+
+    std::vector<uint64_t> Shard::FindNodeIds(const std::string& type, const std::string& property, Operation operation, const std::any& value, uint64_t skip, uint64_t limit) {
+        return FilterNodeIds(node_types.getTypeId(type), { Condition { property, operation, value } }, skip, limit);
+    }
+
+    std::vector<uint64_t> Shard::FindNodeIds(uint16_t type_id, const std::string& property, Operation operation, const std::any& value, uint64_t skip, uint64_t limit) {
+        return FilterNodeIds(type_id, { Condition { property, operation, value } }, skip, limit);
+    }
+
+    std::vector<Node> Shard::FindNodes(const std::string& type, const std::string& property, Operation operation, const std::any& value, uint64_t skip, uint64_t limit) {
+        return FilterNodes(node_types.getTypeId(type), { Condition { property, operation, value } }, skip, limit);
+    }
+
+    std::vector<Node> Shard::FindNodes(uint16_t type_id, const std::string& property, Operation operation, const std::any& value, uint64_t skip, uint64_t limit) {
+        return FilterNodes(type_id, { Condition { property, operation, value } }, skip, limit);
+    }
+
+    std::vector<uint64_t> Shard::FindRelationshipIds(const std::string& rel_type, const std::string& property, Operation operation, const std::any& value, uint64_t skip, uint64_t limit) {
+        return FilterRelationshipIds(relationship_types.getTypeId(rel_type), { Condition { property, operation, value } }, skip, limit);
+    }
+
+    std::vector<uint64_t> Shard::FindRelationshipIds(uint16_t type_id, const std::string& property, Operation operation, const std::any& value, uint64_t skip, uint64_t limit) {
+        return FilterRelationshipIds(type_id, { Condition { property, operation, value } }, skip, limit);
+    }
+
+    std::vector<Relationship> Shard::FindRelationships(const std::string& rel_type, const std::string& property, Operation operation, const std::any& value, uint64_t skip, uint64_t limit) {
+        return FilterRelationships(relationship_types.getTypeId(rel_type), { Condition { property, operation, value } }, skip, limit);
+    }
+
+    std::vector<Relationship> Shard::FindRelationships(uint16_t type_id, const std::string& property, Operation operation, const std::any& value, uint64_t skip, uint64_t limit) {
+        return FilterRelationships(type_id, { Condition { property, operation, value } }, skip, limit);
+    }
+
+    std::vector<uint64_t> Shard::FilterNodeIds(const std::string& type, const std::vector<Condition>& conditions, uint64_t skip, uint64_t limit) {
+        return FilterNodeIds(node_types.getTypeId(type), conditions, skip, limit);
+    }
+
+    /**
+     * Find the nodes of a type on this Shard that match every condition of a filter.
+     * The conditions are compared against the property columns, only the matches are turned into ids.
+     *
+     * @param type_id node type id
+     * @param conditions conditions that must all match, none matches every node of the type
+     * @param skip matches to skip
+     * @param limit most matches to return
+     * @return external ids of the matching nodes in internal id order
+     */
+    std::vector<uint64_t> Shard::FilterNodeIds(uint16_t type_id, const std::vector<Condition>& conditions, uint64_t skip, uint64_t limit) {
+        std::vector<uint64_t> ids;
+        uint64_t current = 0;
+        for (uint64_t internal_id : node_types.findIds(type_id, conditions)) {
+            if (current >= skip + limit) {
+                break;
+            }
+            if (current++ >= skip) {
+                ids.emplace_back(internalToExternal(type_id, internal_id));
+            }
+        }
+        return ids;
+    }
+
+    std::vector<Node> Shard::FilterNodes(const std::string& type, const std::vector<Condition>& conditions, uint64_t skip, uint64_t limit) {
+        return FilterNodes(node_types.getTypeId(type), conditions, skip, limit);
+    }
+
+    std::vector<Node> Shard::FilterNodes(uint16_t type_id, const std::vector<Condition>& conditions, uint64_t skip, uint64_t limit) {
+        std::vector<Node> nodes;
+        for (uint64_t id : FilterNodeIds(type_id, conditions, skip, limit)) {
+            nodes.emplace_back(node_types.getNode(id));
+        }
+        return nodes;
+    }
+
+    std::vector<uint64_t> Shard::FilterRelationshipIds(const std::string& rel_type, const std::vector<Condition>& conditions, uint64_t skip, uint64_t limit) {
+        return FilterRelationshipIds(relationship_types.getTypeId(rel_type), conditions, skip, limit);
+    }
+
+    std::vector<uint64_t> Shard::FilterRelationshipIds(uint16_t type_id, const std::vector<Condition>& conditions, uint64_t skip, uint64_t limit) {
+        std::vector<uint64_t> ids;
+        uint64_t current = 0;
+        for (uint64_t internal_id : relationship_types.findIds(type_id, conditions)) {
+            if (current >= skip + limit) {
+                break;
+            }
+            if (current++ >= skip) {
+                ids.emplace_back(internalToExternal(type_id, internal_id));
+            }
+        }
+        return ids;
+    }
+
+    std::vector<Relationship> Shard::FilterRelationships(const std::string& rel_type, const std::vector<Condition>& conditions, uint64_t skip, uint64_t limit) {
+        return FilterRelationships(relationship_types.getTypeId(rel_type), conditions, skip, limit);
+    }
+
+    std::vector<Relationship> Shard::FilterRelationships(uint16_t type_id, const std::vector<Condition>& conditions, uint64_t skip, uint64_t limit) {
+        std::vector<Relationship> relationships;
+        for (uint64_t id : FilterRelationshipIds(type_id, conditions, skip, limit)) {
+            relationships.emplace_back(relationship_types.getRelationship(id));
+        }
+        return relationships;
+    }
+
+}
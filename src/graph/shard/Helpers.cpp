@@ -19,26 +19,28 @@
 namespace ragedb {
 
     bool Shard::NodeRemoveDeleteIncoming(uint64_t id, const std::map<uint16_t, std::vector<uint64_t>>&grouped_relationships) {
+        wal.Append(LogOperation::NodeRemoveDeleteIncoming, id, grouped_relationships);
         for (const auto& rel_type_node_ids : grouped_relationships) {
             uint16_t rel_type_id = rel_type_node_ids.first;
             for (auto node_id : rel_type_node_ids.second) {
                 uint64_t internal_id = externalToInternal(node_id);
                 uint16_t node_type_id = externalToTypeId(node_id);
 
-                auto group = find_if(std::begin(node_types.getIncomingRelationships(node_type_id).at(internal_id)), std::end(node_types.getIncomingRelationships(node_type_id).at(internal_id)),
-                                     [rel_type_id] (const Group& g) { return g.rel_type_id == rel_type_id; } );
-
-                if (group != std::end(node_types.getIncomingRelationships(node_type_id).at(internal_id))) {
-                    group->links.erase(std::remove_if(std::begin(group->links), std::end(group->links), [id](Link entry) {
-                        return entry.node_id == id;
-                    }), std::end(group->links));
-                }
+                node_types.removeIncomingLinks(node_type_id, internal_id, rel_type_id, id, [] (const Link&) {
+                    return true;
+                });
             }
         }
 
         return true;
     }
 
+    /**
+     * Group the counterparts of the outgoing links of a node that other Shards hold, in a single pass over the links
+     *
+     * @param external_id id of the node being removed
+     * @return ids of the nodes at the other end by Shard and relationship type id
+     */
     std::map<uint16_t, std::map<uint16_t, std::vector<uint64_t>>> Shard::NodeRemoveGetIncoming(uint64_t external_id) {
         uint64_t internal_id = externalToInternal(external_id);
         uint16_t node_type_id = externalToTypeId(external_id);
@@ -50,30 +52,22 @@ namespace ragedb {
             uint16_t rel_type = types.rel_type_id;
 
             for (Link link : types.links) {
-                std::map<uint16_t, std::vector<uint64_t>> node_ids;
-                for (int i = 0; i < cpus; i++) {
-                    node_ids.insert({ i, std::vector<uint64_t>() });
-                }
-
-                // Remove relationship from other node that I own
                 uint16_t node_shard_id = CalculateShardId(link.node_id);
-                if ( node_shard_id != shard_id) {
-                    node_ids.at(node_shard_id).push_back(link.node_id);
+                if (node_shard_id != shard_id) {
+                    relationships_to_delete[node_shard_id][rel_type].push_back(link.node_id);
                 }
-
-                for (int i = 0; i < cpus; i++) {
-                    if(node_ids.at(i).empty()) {
-                        node_ids.erase(i);
-                    }
-                }
-
-                relationships_to_delete.insert({ rel_type, node_ids });
             }
         }
 
         return relationships_to_delete;
     }
 
+    /**
+     * Group the counterparts of the incoming links of a node that other Shards hold, in a single pass over the links
+     *
+     * @param external_id id of the node being removed
+     * @return ids of the nodes at the other end by Shard and relationship type id
+     */
     std::map<uint16_t, std::map<uint16_t, std::vector<uint64_t>>> Shard::NodeRemoveGetOutgoing(uint64_t external_id) {
         uint64_t internal_id = externalToInternal(external_id);
         uint16_t node_type_id = externalToTypeId(external_id);
@@ -85,57 +79,78 @@ namespace ragedb {
             uint16_t rel_type = types.rel_type_id;
 
             for (Link link : types.links) {
-                std::map<uint16_t, std::vector<uint64_t>> node_ids;
-                for (int i = 0; i < cpus; i++) {
-                    node_ids.insert({ i, std::vector<uint64_t>() });
-                }
-
-                // Remove relationship from other node that I own
                 uint16_t node_shard_id = CalculateShardId(link.node_id);
-                if ( node_shard_id != shard_id) {
-                    node_ids.at(node_shard_id).push_back(link.node_id);
+                if (node_shard_id != shard_id) {
+                    relationships_to_delete[node_shard_id][rel_type].push_back(link.node_id);
                 }
+            }
+        }
 
-                for (int i = 0; i < cpus; i++) {
-                    if(node_ids.at(i).empty()) {
-                        node_ids.erase(i);
-                    }
-                }
+        return relationships_to_delete;
+    }
 
-                relationships_to_delete.insert({ rel_type, node_ids });
+    /**
+     * Gather the counterparts other Shards hold of the links of a batch of nodes about to be removed
+     *
+     * @param ids ids of the nodes being removed, invalid ones are skipped
+     * @param pause called after each node, to yield when running in a seastar thread
+     * @return the counterparts to delete by Shard, one entry per node
+     */
+    std::map<uint16_t, std::vector<NodeRemoval>> Shard::NodesRemoveGetLinks(const std::vector<uint64_t> &ids, const std::function<void()> &pause) {
+        std::map<uint16_t, std::vector<NodeRemoval>> removals;
+        for (uint64_t id : ids) {
+            if (!ValidNodeId(id)) {
+                continue;
+            }
+            auto removal = [&removals, id] (uint16_t their_shard) -> NodeRemoval& {
+                auto &shard_removals = removals[their_shard];
+                if (shard_removals.empty() || shard_removals.back().id != id) {
+                    shard_removals.push_back(NodeRemoval{id, {}, {}});
+                }
+                return shard_removals.back();
+            };
+            for (auto &[their_shard, grouped_relationships] : NodeRemoveGetIncoming(id)) {
+                removal(their_shard).incoming = std::move(grouped_relationships);
             }
+            for (auto &[their_shard, grouped_relationships] : NodeRemoveGetOutgoing(id)) {
+                removal(their_shard).outgoing = std::move(grouped_relationships);
+            }
+            pause();
         }
+        return removals;
+    }
 
-        return relationships_to_delete;
+    // Delete a batch of counterparts sent by the Shards of the removed nodes
+    bool Shard::NodesRemoveDeleteLinks(const std::vector<NodeRemoval> &removals) {
+        for (const auto &removal : removals) {
+            if (!removal.incoming.empty()) {
+                NodeRemoveDeleteIncoming(removal.id, removal.incoming);
+            }
+            if (!removal.outgoing.empty()) {
+                NodeRemoveDeleteOutgoing(removal.id, removal.outgoing);
+            }
+        }
+        return true;
     }
 
     bool Shard::NodeRemoveDeleteOutgoing(uint64_t id, const std::map<uint16_t, std::vector<uint64_t>> &grouped_relationships) {
+        wal.Append(LogOperation::NodeRemoveDeleteOutgoing, id, grouped_relationships);
         for (const auto& rel_type_node_ids : grouped_relationships) {
             uint16_t rel_type_id = rel_type_node_ids.first;
             for (auto node_id : rel_type_node_ids.second) {
                 uint64_t internal_id = externalToInternal(node_id);
                 uint16_t node_type_id = externalToTypeId(node_id);
 
-                auto group = find_if(std::begin(node_types.getOutgoingRelationships(node_type_id).at(internal_id)), std::end(node_types.getOutgoingRelationships(node_type_id).at(internal_id)),
-                                     [rel_type_id] (const Group& g) { return g.rel_type_id == rel_type_id; } );
-
-                if (group != std::end(node_types.getOutgoingRelationships(node_type_id).at(internal_id))) {
-                    // Look in the relationship chain for any relationships of the node to be removed and delete them.
-                    group->links.erase(std::remove_if(std::begin(group->links), std::end(group->links), [id, rel_type_id, this](Link entry) {
-                        if (entry.node_id == id) {
-                            uint64_t internal_id = externalToInternal(entry.rel_id);
-                            // Update the relationship type counts
-                            relationship_types.removeId(rel_type_id, internal_id);
-                            relationship_types.setStartingNodeId(rel_type_id, internal_id, 0);
-                            relationship_types.setEndingNodeId(rel_type_id, internal_id, 0);
-                            relationship_types.deleteProperties(rel_type_id, internal_id);
-                            return true;
-                        }
-
-                        return false;
-                    }), std::end(group->links));
-                }
-
+                // Look in the relationship chain for any relationships of the node to be removed and delete them.
+                node_types.removeOutgoingLinks(node_type_id, internal_id, rel_type_id, id, [rel_type_id, this] (const Link& entry) {
+                    uint64_t internal_id = externalToInternal(entry.rel_id);
+                    // Update the relationship type counts
+                    relationship_types.removeId(rel_type_id, internal_id);
+                    relationship_types.setStartingNodeId(rel_type_id, internal_id, 0);
+                    relationship_types.setEndingNodeId(rel_type_id, internal_id, 0);
+                    relationship_types.deleteProperties(rel_type_id, internal_id);
+                    return true;
+                });
             }
         }
 
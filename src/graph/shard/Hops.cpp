@@ -0,0 +1,93 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include "../Shard.h"
+
+namespace ragedb {
+
+    /**
+     * Take one hop of a traversal from the nodes of this Shard in its frontier.
+     * Nodes the traversal already visited here are skipped, the rest are marked visited and expanded.
+     *
+     * @param traversal_id traversal the frontier belongs to
+     * @param ids frontier nodes that belong to this Shard
+     * @param hop relationship types and direction to follow
+     * @return the next frontier grouped by the Shard each node belongs to
+     */
+    std::map<uint16_t, std::vector<uint64_t>> Shard::TraversalExpand(uint64_t traversal_id, const std::vector<uint64_t>& ids, const Hop& hop) {
+        Roaring64Map &visited = traversals[traversal_id];
+        std::map<uint16_t, std::vector<uint64_t>> sharded_ids;
+
+        auto follow = [&hop, &sharded_ids] (const std::vector<Group> &groups) {
+            for (const Group &group : groups) {
+                if (hop.rel_type_ids.empty() || std::find(hop.rel_type_ids.begin(), hop.rel_type_ids.end(), group.rel_type_id) != hop.rel_type_ids.end()) {
+                    for (const Link &link : group.links) {
+                        sharded_ids[CalculateShardId(link.node_id)].emplace_back(link.node_id);
+                    }
+                }
+            }
+        };
+
+        for (uint64_t id : ids) {
+            if (visited.contains(id) || !ValidNodeId(id)) {
+                continue;
+            }
+            visited.add(id);
+            uint16_t type_id = externalToTypeId(id);
+            uint64_t internal_id = externalToInternal(id);
+            if (hop.direction != IN) {
+                follow(node_types.getOutgoingRelationships(type_id).at(internal_id));
+            }
+            if (hop.direction != OUT) {
+                follow(node_types.getIncomingRelationships(type_id).at(internal_id));
+            }
+        }
+
+        // Only send each node once per hop
+        for (auto &[their_shard, node_ids] : sharded_ids) {
+            std::sort(node_ids.begin(), node_ids.end());
+            node_ids.erase(std::unique(node_ids.begin(), node_ids.end()), node_ids.end());
+        }
+        return sharded_ids;
+    }
+
+    /**
+     * End a traversal on this Shard
+     *
+     * @param traversal_id traversal to end
+     * @param ids last frontier nodes that belong to this Shard
+     * @return the ones the traversal had not visited before
+     */
+    std::vector<uint64_t> Shard::TraversalFinish(uint64_t traversal_id, const std::vector<uint64_t>& ids) {
+        std::vector<uint64_t> found;
+        auto traversal = traversals.find(traversal_id);
+        // The frontier may hold a node once for every Shard that reached it
+        std::vector<uint64_t> unique_ids(ids);
+        std::sort(unique_ids.begin(), unique_ids.end());
+        unique_ids.erase(std::unique(unique_ids.begin(), unique_ids.end()), unique_ids.end());
+        for (uint64_t id : unique_ids) {
+            if ((traversal == traversals.end() || !traversal->second.contains(id)) && ValidNodeId(id)) {
+                found.emplace_back(id);
+            }
+        }
+        if (traversal != traversals.end()) {
+            traversals.erase(traversal);
+        }
+        return found;
+    }
+
+}
@@ -60,6 +60,15 @@ namespace ragedb {
                && node_types.ValidNodeId(externalToTypeId(id), externalToInternal(id));
     }
 
+    std::vector<bool> Shard::ValidNodeIds(const std::vector<uint64_t> &ids) {
+        std::vector<bool> valid;
+        valid.reserve(ids.size());
+        for (auto id : ids) {
+            valid.push_back(ValidNodeId(id));
+        }
+        return valid;
+    }
+
     bool Shard::ValidRelationshipId(uint64_t id) {
         // Relationship must be greater than zero,
         // less than maximum relationship id,
@@ -0,0 +1,281 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <iostream>
+#include "../Shard.h"
+
+namespace ragedb {
+
+    /**
+     * Apply a log record by calling the Shard method that wrote it with the same arguments.
+     * Ids are handed out deterministically, so replaying the records in order rebuilds the same Shard.
+     *
+     * @param record log record to apply
+     */
+    void Shard::ApplyLogRecord(SnapshotReader &record) {
+        // Arguments are read into locals first, the order function arguments are evaluated in is unspecified
+        auto operation = static_cast<LogOperation>(record.read<uint8_t>());
+        try {
+            switch (operation) {
+                case LogOperation::NodeTypeInsert: {
+                    auto type = record.read<std::string>();
+                    auto type_id = record.read<uint16_t>();
+                    NodeTypeInsert(type, type_id);
+                    break;
+                }
+                case LogOperation::DeleteNodeType: {
+                    auto type = record.read<std::string>();
+                    DeleteNodeType(type);
+                    break;
+                }
+                case LogOperation::RelationshipTypeInsert: {
+                    auto type = record.read<std::string>();
+                    auto type_id = record.read<uint16_t>();
+                    RelationshipTypeInsert(type, type_id);
+                    break;
+                }
+                case LogOperation::DeleteRelationshipType: {
+                    auto type = record.read<std::string>();
+                    DeleteRelationshipType(type);
+                    break;
+                }
+                case LogOperation::NodePropertyTypeAdd: {
+                    auto type_id = record.read<uint16_t>();
+                    auto key = record.read<std::string>();
+                    auto property_type_id = record.read<uint8_t>();
+                    NodePropertyTypeAdd(type_id, key, property_type_id);
+                    break;
+                }
+                case LogOperation::RelationshipPropertyTypeAdd: {
+                    auto type_id = record.read<uint16_t>();
+                    auto key = record.read<std::string>();
+                    auto property_type_id = record.read<uint8_t>();
+                    RelationshipPropertyTypeAdd(type_id, key, property_type_id);
+                    break;
+                }
+                case LogOperation::NodePropertyTypeDelete: {
+                    auto type_id = record.read<uint16_t>();
+                    auto key = record.read<std::string>();
+                    NodePropertyTypeDelete(type_id, key);
+                    break;
+                }
+                case LogOperation::RelationshipPropertyTypeDelete: {
+                    auto type_id = record.read<uint16_t>();
+                    auto key = record.read<std::string>();
+                    RelationshipPropertyTypeDelete(type_id, key);
+                    break;
+                }
+                case LogOperation::NodeAddEmpty: {
+                    auto type_id = record.read<uint16_t>();
+                    auto key = record.read<std::string>();
+                    NodeAddEmpty(type_id, key);
+                    break;
+                }
+                case LogOperation::NodeAdd: {
+                    auto type_id = record.read<uint16_t>();
+                    auto key = record.read<std::string>();
+                    auto properties = record.read<std::string>();
+                    NodeAdd(type_id, key, properties);
+                    break;
+                }
+                case LogOperation::NodeRemove: {
+                    auto id = record.read<uint64_t>();
+                    NodeRemove(id);
+                    break;
+                }
+                case LogOperation::NodeRemoveDeleteIncoming: {
+                    auto id = record.read<uint64_t>();
+                    auto grouped_relationships = WriteAheadLog::DecodeGroupedIds(record);
+                    NodeRemoveDeleteIncoming(id, grouped_relationships);
+                    break;
+                }
+                case LogOperation::NodeRemoveDeleteOutgoing: {
+                    auto id = record.read<uint64_t>();
+                    auto grouped_relationships = WriteAheadLog::DecodeGroupedIds(record);
+                    NodeRemoveDeleteOutgoing(id, grouped_relationships);
+                    break;
+                }
+                case LogOperation::NodePropertySet: {
+                    auto id = record.read<uint64_t>();
+                    auto property = record.read<std::string>();
+                    auto value = WriteAheadLog::DecodeAny(record);
+                    NodePropertySet(id, property, value);
+                    break;
+                }
+                case LogOperation::NodePropertySetFromJson: {
+                    auto id = record.read<uint64_t>();
+                    auto property = record.read<std::string>();
+                    auto value = record.read<std::string>();
+                    NodePropertySetFromJson(id, property, value);
+                    break;
+                }
+                case LogOperation::NodePropertyDelete: {
+                    auto id = record.read<uint64_t>();
+                    auto property = record.read<std::string>();
+                    NodePropertyDelete(id, property);
+                    break;
+                }
+                case LogOperation::NodePropertiesSetFromJson: {
+                    auto id = record.read<uint64_t>();
+                    auto value = record.read<std::string>();
+                    NodePropertiesSetFromJson(id, value);
+                    break;
+                }
+                case LogOperation::NodePropertiesResetFromJson: {
+                    auto id = record.read<uint64_t>();
+                    auto value = record.read<std::string>();
+                    NodePropertiesResetFromJson(id, value);
+                    break;
+                }
+                case LogOperation::NodePropertiesDelete: {
+                    auto id = record.read<uint64_t>();
+                    NodePropertiesDelete(id);
+                    break;
+                }
+                case LogOperation::RelationshipAddEmptySameShard: {
+                    auto rel_type_id = record.read<uint16_t>();
+                    auto id1 = record.read<uint64_t>();
+                    auto id2 = record.read<uint64_t>();
+                    RelationshipAddEmptySameShard(rel_type_id, id1, id2);
+                    break;
+                }
+                case LogOperation::RelationshipAddSameShard: {
+                    auto rel_type_id = record.read<uint16_t>();
+                    auto id1 = record.read<uint64_t>();
+                    auto id2 = record.read<uint64_t>();
+                    auto properties = record.read<std::string>();
+                    RelationshipAddSameShard(rel_type_id, id1, id2, properties);
+                    break;
+                }
+                case LogOperation::RelationshipAddEmptyToOutgoing: {
+                    auto rel_type_id = record.read<uint16_t>();
+                    auto id1 = record.read<uint64_t>();
+                    auto id2 = record.read<uint64_t>();
+                    RelationshipAddEmptyToOutgoing(rel_type_id, id1, id2);
+                    break;
+                }
+                case LogOperation::RelationshipAddToOutgoing: {
+                    auto rel_type_id = record.read<uint16_t>();
+                    auto id1 = record.read<uint64_t>();
+                    auto id2 = record.read<uint64_t>();
+                    auto properties = record.read<std::string>();
+                    RelationshipAddToOutgoing(rel_type_id, id1, id2, properties);
+                    break;
+                }
+                case LogOperation::RelationshipAddToIncoming: {
+                    auto rel_type_id = record.read<uint16_t>();
+                    auto rel_id = record.read<uint64_t>();
+                    auto id1 = record.read<uint64_t>();
+                    auto id2 = record.read<uint64_t>();
+                    RelationshipAddToIncoming(rel_type_id, rel_id, id1, id2);
+                    break;
+                }
+                case LogOperation::RelationshipRemoveGetIncoming: {
+                    auto id = record.read<uint64_t>();
+                    RelationshipRemoveGetIncoming(id);
+                    break;
+                }
+                case LogOperation::RelationshipRemoveIncoming: {
+                    auto rel_type_id = record.read<uint16_t>();
+                    auto id = record.read<uint64_t>();
+                    auto node_id = record.read<uint64_t>();
+                    RelationshipRemoveIncoming(rel_type_id, id, node_id);
+                    break;
+                }
+                case LogOperation::RelationshipRemoveIncomingFrom: {
+                    auto rel_type_id = record.read<uint16_t>();
+                    auto id = record.read<uint64_t>();
+                    auto node_id = record.read<uint64_t>();
+                    auto other_node_id = record.read<uint64_t>();
+                    RelationshipRemoveIncoming(rel_type_id, id, node_id, other_node_id);
+                    break;
+                }
+                case LogOperation::RelationshipPropertySet: {
+                    auto id = record.read<uint64_t>();
+                    auto property = record.read<std::string>();
+                    auto value = WriteAheadLog::DecodeAny(record);
+                    RelationshipPropertySet(id, property, value);
+                    break;
+                }
+                case LogOperation::RelationshipPropertySetFromJson: {
+                    auto id = record.read<uint64_t>();
+                    auto property = record.read<std::string>();
+                    auto value = record.read<std::string>();
+                    RelationshipPropertySetFromJson(id, property, value);
+                    break;
+                }
+                case LogOperation::RelationshipPropertyDelete: {
+                    auto id = record.read<uint64_t>();
+                    auto property = record.read<std::string>();
+                    RelationshipPropertyDelete(id, property);
+                    break;
+                }
+                case LogOperation::RelationshipPropertiesSetFromJson: {
+                    auto id = record.read<uint64_t>();
+                    auto value = record.read<std::string>();
+                    RelationshipPropertiesSetFromJson(id, value);
+                    break;
+                }
+                case LogOperation::RelationshipPropertiesResetFromJson: {
+                    auto id = record.read<uint64_t>();
+                    auto value = record.read<std::string>();
+                    RelationshipPropertiesResetFromJson(id, value);
+                    break;
+                }
+                case LogOperation::RelationshipPropertiesDelete: {
+                    auto id = record.read<uint64_t>();
+                    RelationshipPropertiesDelete(id);
+                    break;
+                }
+                case LogOperation::NodePropertyIndexAdd: {
+                    auto type_id = record.read<uint16_t>();
+                    auto key = record.read<std::string>();
+                    NodePropertyIndexAdd(type_id, key);
+                    break;
+                }
+                case LogOperation::NodePropertyIndexDelete: {
+                    auto type_id = record.read<uint16_t>();
+                    auto key = record.read<std::string>();
+                    NodePropertyIndexDelete(type_id, key);
+                    break;
+                }
+                case LogOperation::RelationshipPropertyIndexAdd: {
+                    auto type_id = record.read<uint16_t>();
+                    auto key = record.read<std::string>();
+                    RelationshipPropertyIndexAdd(type_id, key);
+                    break;
+                }
+                case LogOperation::RelationshipPropertyIndexDelete: {
+                    auto type_id = record.read<uint16_t>();
+                    auto key = record.read<std::string>();
+                    RelationshipPropertyIndexDelete(type_id, key);
+                    break;
+                }
+                case LogOperation::Clear: {
+                    Clear();
+                    break;
+                }
+                default: {
+                    std::cerr << "Unknown log record " << static_cast<int>(operation) << " on Shard " << shard_id << '\n';
+                }
+            }
+        } catch (...) {
+            // The original call threw as well and changed nothing, keep going
+            std::cerr << "Exception replaying log record on Shard " << shard_id << ": " << std::current_exception() << '\n';
+        }
+    }
+
+}
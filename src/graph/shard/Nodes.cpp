@@ -21,60 +21,62 @@
 namespace ragedb {
 
     uint64_t Shard::NodeAddEmpty(uint16_t type_id, const std::string &key) {
+        wal.Append(LogOperation::NodeAddEmpty, type_id, key);
         uint64_t internal_id = node_types.getCount(type_id);
         uint64_t external_id = 0;
 
         // Check if the key exists
-        auto key_search = node_types.getKeysToNodeId(type_id).find(key);
-        if (key_search == std::end(node_types.getKeysToNodeId(type_id))) {
+        if (node_types.getNodeId(type_id, key) == 0) {
             // If we have deleted nodes, fill in the space by adding the new node here
             if (node_types.hasDeleted(type_id)) {
                 internal_id = node_types.getDeletedIdsMinimum(type_id);
                 external_id = internalToExternal(type_id, internal_id);
                 // Replace the deleted node and remove it from the list
-                node_types.getKeys(type_id).at(internal_id) = key;
+                node_types.getKeys(type_id).set(internal_id, key);
                 node_types.addId(type_id, internal_id);
             } else {
                 external_id = internalToExternal(type_id, internal_id);
                 // Set Metadata properties
                 // Add the node to the end and prepare a place for its relationships
-                node_types.getKeys(type_id).emplace_back(key);
+                node_types.getKeys(type_id).set(internal_id, key);
                 node_types.getOutgoingRelationships(type_id).emplace_back();
                 node_types.getIncomingRelationships(type_id).emplace_back();
+                node_types.getOutgoingDegrees(type_id).emplace_back(0);
+                node_types.getIncomingDegrees(type_id).emplace_back(0);
                 node_types.addId(type_id, internal_id);
             }
-            node_types.getKeysToNodeId(type_id).insert({key, external_id });
         }
 
         return external_id;
     }
 
     uint64_t Shard::NodeAdd(uint16_t type_id, const std::string &key, const std::string &properties) {
+        wal.Append(LogOperation::NodeAdd, type_id, key, properties);
         uint64_t internal_id = node_types.getCount(type_id);
         uint64_t external_id = 0;
 
         // Check if the key exists
-        auto key_search = node_types.getKeysToNodeId(type_id).find(key);
-        if (key_search == std::end(node_types.getKeysToNodeId(type_id))) {
+        if (node_types.getNodeId(type_id, key) == 0) {
             // If we have deleted nodes, fill in the space by adding the new node here
             if (node_types.hasDeleted(type_id)) {
                 internal_id = node_types.getDeletedIdsMinimum(type_id);
                 external_id = internalToExternal(type_id, internal_id);
 
                 // Replace the deleted node and remove it from the list
-                node_types.getKeys(type_id).at(internal_id) = key;
+                node_types.getKeys(type_id).set(internal_id, key);
                 node_types.addId(type_id, internal_id);
                 node_types.setPropertiesFromJSON(type_id, internal_id, properties);
             } else {
                 external_id = internalToExternal(type_id, internal_id);
                 // Add the node to the end and prepare a place for its relationships
-                node_types.getKeys(type_id).emplace_back(key);
+                node_types.getKeys(type_id).set(internal_id, key);
                 node_types.getOutgoingRelationships(type_id).emplace_back();
                 node_types.getIncomingRelationships(type_id).emplace_back();
+                node_types.getOutgoingDegrees(type_id).emplace_back(0);
+                node_types.getIncomingDegrees(type_id).emplace_back(0);
                 node_types.addId(type_id, internal_id);
                 node_types.setPropertiesFromJSON(type_id, internal_id, properties);
             }
-            node_types.getKeysToNodeId(type_id).insert({key, external_id });
         }
 
         return external_id;
@@ -90,6 +92,34 @@ namespace ragedb {
         return 0;
     }
 
+    std::vector<uint64_t> Shard::NodesAdd(uint16_t type_id, const std::vector<std::string> &keys, const std::vector<std::string> &properties) {
+        if (!node_types.ValidTypeId(type_id)) {
+            return std::vector<uint64_t>(keys.size(), 0);
+        }
+        std::vector<uint64_t> ids;
+        ids.reserve(keys.size());
+        node_types.reserve(type_id, keys.size());
+        // Properties are optional, but when given there must be one entry per key
+        bool with_properties = properties.size() == keys.size();
+        for (size_t i = 0; i < keys.size(); i++) {
+            if (with_properties && !properties[i].empty()) {
+                ids.emplace_back(NodeAdd(type_id, keys[i], properties[i]));
+            } else {
+                ids.emplace_back(NodeAddEmpty(type_id, keys[i]));
+            }
+        }
+        return ids;
+    }
+
+    std::vector<uint64_t> Shard::NodeGetIDs(const std::vector<std::string> &types, const std::vector<std::string> &keys) {
+        std::vector<uint64_t> ids;
+        ids.reserve(keys.size());
+        for (size_t i = 0; i < keys.size(); i++) {
+            ids.emplace_back(NodeGetID(types[i], keys[i]));
+        }
+        return ids;
+    }
+
     std::vector<Node> Shard::NodesGet(const std::vector<uint64_t>& node_ids) {
         std::vector<Node> sharded_nodes;
 
@@ -124,20 +154,18 @@ namespace ragedb {
 
     std::string Shard::NodeGetKey(uint64_t id) {
         if (ValidNodeId(id)) {
-            return node_types.getKeys(externalToTypeId(id))[externalToInternal(id)];
+            return node_types.getNodeKey(externalToTypeId(id), externalToInternal(id));
         }
         return node_types.getType(0);
     }
 
     bool Shard::NodeRemove(uint64_t id) {
+        wal.Append(LogOperation::NodeRemove, id);
         if (ValidNodeId(id)) {
             uint16_t node_type_id = externalToTypeId(id);
             uint64_t internal_id = externalToInternal(id);
-            std::string key = node_types.getNodeKey(node_type_id, internal_id);
-
             // remove the key
-            node_types.getKeysToNodeId(node_type_id).erase(key);
-            node_types.getKeys(node_type_id).at(internal_id).clear();
+            node_types.getKeys(node_type_id).remove(internal_id);
 
             // remove the id and properties of the node
             node_types.removeId(node_type_id, internal_id);
@@ -162,58 +190,42 @@ namespace ragedb {
                         uint64_t other_internal_id = externalToInternal(link.node_id);
                         uint16_t other_node_type_id = externalToTypeId(link.node_id);
 
-                        for (auto &other_types : node_types.getIncomingRelationships(other_node_type_id).at(
-                                other_internal_id)) {
-                            if (other_types.rel_type_id == rel_type_id) {
-                                other_types.links.erase(
-                                        std::remove_if(std::begin(other_types.links), std::end(other_types.links),
-                                                       [link](Link entry) {
-                                                           return entry.rel_id == link.rel_id;
-                                                       }), std::end(other_types.links));
-                            }
-                        }
+                        node_types.removeIncomingLinks(other_node_type_id, other_internal_id, rel_type_id, id, [link] (const Link& entry) {
+                            return entry.rel_id == link.rel_id;
+                        });
                     }
                 }
             }
 
-            // Empty outgoing relationships
-            node_types.getOutgoingRelationships(node_type_id).at(internal_id).clear();
-
             // Go through all the incoming relationships and delete them and their counterpart
             for (auto &types : node_types.getIncomingRelationships(node_type_id).at(internal_id)) {
                 // Get the Relationship Type of the list
                 uint16_t rel_type_id = types.rel_type_id;
 
                 for (Link link : types.links) {
-                    uint64_t internal_relationship_id = externalToInternal(link.rel_id);
-                    // Clear the relationship properties and meta properties
-                    relationship_types.deleteProperties(rel_type_id, internal_relationship_id);
-                    relationship_types.setStartingNodeId(rel_type_id, internal_relationship_id, 0);
-                    relationship_types.setEndingNodeId(rel_type_id, internal_relationship_id, 0);
-                    // Add the relationship to be recycled
-                    relationship_types.removeId(rel_type_id, internal_relationship_id);
-
-                    // Remove relationship from other node that I own
+                    // Relationships live with their starting node, the Shard of that node deletes the ones I do not own
                     if (CalculateShardId(link.node_id) == shard_id) {
+                        uint64_t internal_relationship_id = externalToInternal(link.rel_id);
+                        // Clear the relationship properties and meta properties
+                        relationship_types.deleteProperties(rel_type_id, internal_relationship_id);
+                        relationship_types.setStartingNodeId(rel_type_id, internal_relationship_id, 0);
+                        relationship_types.setEndingNodeId(rel_type_id, internal_relationship_id, 0);
+                        // Add the relationship to be recycled
+                        relationship_types.removeId(rel_type_id, internal_relationship_id);
+
+                        // Remove relationship from other node that I own
                         uint64_t other_internal_id = externalToInternal(link.node_id);
                         uint16_t other_node_type_id = externalToTypeId(link.node_id);
 
-                        for (auto &other_types : node_types.getOutgoingRelationships(other_node_type_id).at(
-                                other_internal_id)) {
-                            if (other_types.rel_type_id == rel_type_id) {
-                                other_types.links.erase(
-                                        std::remove_if(std::begin(other_types.links), std::end(other_types.links),
-                                                       [link](Link entry) {
-                                                           return entry.rel_id == link.rel_id;
-                                                       }), std::end(other_types.links));
-                            }
-                        }
+                        node_types.removeOutgoingLinks(other_node_type_id, other_internal_id, rel_type_id, id, [link] (const Link& entry) {
+                            return entry.rel_id == link.rel_id;
+                        });
                     }
                 }
             }
 
-            // Empty outgoing relationships
-            node_types.getIncomingRelationships(node_type_id).at(internal_id).clear();
+            // Empty the relationships of the node
+            node_types.clearLinks(node_type_id, internal_id);
             return true;
         }
         return false;
@@ -224,6 +236,25 @@ namespace ragedb {
         return NodeRemove(id);
     }
 
+    /**
+     * Remove a batch of nodes and the links this Shard holds for them
+     *
+     * @param ids ids of the nodes to remove
+     * @param pause called after each node, to yield when running in a seastar thread
+     * @return number of nodes removed
+     */
+    uint64_t Shard::NodesRemove(const std::vector<uint64_t>& ids, const std::function<void()>& pause) {
+        uint64_t removed = 0;
+        for (uint64_t id : ids) {
+            // Only valid ids are logged, a missing node has nothing to replay
+            if (ValidNodeId(id) && NodeRemove(id)) {
+                removed++;
+            }
+            pause();
+        }
+        return removed;
+    }
+
 
     std::any Shard::NodePropertyGet(uint64_t id, const std::string& property) {
         if (ValidNodeId(id)) {
@@ -233,6 +264,7 @@ namespace ragedb {
     }
 
     bool Shard::NodePropertySet(uint64_t id, const std::string& property, std::any value) {
+        wal.Append(LogOperation::NodePropertySet, id, property, value);
         if (ValidNodeId(id)) {
             return node_types.setNodeProperty(id, property, std::move(value));
         }
@@ -240,6 +272,7 @@ namespace ragedb {
     }
 
     bool Shard::NodePropertySetFromJson(uint64_t id, const std::string& property, const std::string& value) {
+        wal.Append(LogOperation::NodePropertySetFromJson, id, property, value);
         if (ValidNodeId(id)) {
             return node_types.setNodePropertyFromJson(id, property, value);
         }
@@ -267,6 +300,7 @@ namespace ragedb {
     }
 
     bool Shard::NodePropertyDelete(uint64_t id, const std::string& property) {
+        wal.Append(LogOperation::NodePropertyDelete, id, property);
         if (ValidNodeId(id)) {
             return node_types.deleteNodeProperty(id, property);
         }
@@ -292,6 +326,7 @@ namespace ragedb {
     }
 
     bool Shard::NodePropertiesSetFromJson(uint64_t id, const std::string& value) {
+        wal.Append(LogOperation::NodePropertiesSetFromJson, id, value);
         // If the node is valid
         if (ValidNodeId(id)) {
             return node_types.setPropertiesFromJSON(externalToTypeId(id), externalToInternal(id), value);
@@ -305,6 +340,7 @@ namespace ragedb {
     }
 
     bool Shard::NodePropertiesResetFromJson(uint64_t id, const std::string& value) {
+        wal.Append(LogOperation::NodePropertiesResetFromJson, id, value);
         // If the node is valid
         if (ValidNodeId(id)) {
             node_types.deleteProperties(externalToTypeId(id), externalToInternal(id));
@@ -319,6 +355,7 @@ namespace ragedb {
     }
 
     bool Shard::NodePropertiesDelete(uint64_t id) {
+        wal.Append(LogOperation::NodePropertiesDelete, id);
         // If the node is valid
         if (ValidNodeId(id)) {
             return node_types.deleteProperties(externalToTypeId(id), externalToInternal(id));
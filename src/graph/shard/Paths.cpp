@@ -0,0 +1,95 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <algorithm>
+#include <cmath>
+#include "../Shard.h"
+
+namespace ragedb {
+
+    /**
+     * Follow the relationships of the nodes of this Shard for one step of a path search
+     *
+     * @param ids nodes that belong to this Shard
+     * @param hop relationship types and direction to follow
+     * @param weight relationship property holding the weight, every relationship weighs 1 when empty
+     * @return for each id the neighbors it reaches, with NaN weights for relationships stored on other Shards
+     */
+    std::vector<std::vector<PathStep>> Shard::PathExpand(const std::vector<uint64_t>& ids, const Hop& hop, const std::string& weight) {
+        std::vector<std::vector<PathStep>> steps(ids.size());
+
+        auto follow = [&hop, &weight, this] (const std::vector<Group> &groups, std::vector<PathStep> &found) {
+            for (const Group &group : groups) {
+                if (hop.rel_type_ids.empty() || std::find(hop.rel_type_ids.begin(), hop.rel_type_ids.end(), group.rel_type_id) != hop.rel_type_ids.end()) {
+                    Properties &rel_properties = relationship_types.getProperties(group.rel_type_id);
+                    uint16_t weight_id = weight.empty() ? 0 : rel_properties.getPropertyId(weight);
+                    for (const Link &link : group.links) {
+                        double value = 1.0;
+                        if (!weight.empty()) {
+                            if (CalculateShardId(link.rel_id) == shard_id) {
+                                if (!rel_properties.getNumericProperty(weight_id, externalToInternal(link.rel_id), value)) {
+                                    value = 1.0;
+                                }
+                            } else {
+                                value = std::nan("");
+                            }
+                        }
+                        found.push_back({link.node_id, link.rel_id, value});
+                    }
+                }
+            }
+        };
+
+        for (size_t i = 0; i < ids.size(); i++) {
+            uint64_t id = ids[i];
+            if (!ValidNodeId(id)) {
+                continue;
+            }
+            uint16_t type_id = externalToTypeId(id);
+            uint64_t internal_id = externalToInternal(id);
+            if (hop.direction != IN) {
+                follow(node_types.getOutgoingRelationships(type_id).at(internal_id), steps[i]);
+            }
+            if (hop.direction != OUT) {
+                follow(node_types.getIncomingRelationships(type_id).at(internal_id), steps[i]);
+            }
+        }
+        return steps;
+    }
+
+    /**
+     * Read the weights of relationships that belong to this Shard
+     *
+     * @param rel_ids relationships that belong to this Shard
+     * @param weight relationship property holding the weight
+     * @return the weight of each relationship, 1 when it has no numeric value for the property
+     */
+    std::vector<double> Shard::RelationshipWeights(const std::vector<uint64_t>& rel_ids, const std::string& weight) {
+        std::vector<double> weights;
+        weights.reserve(rel_ids.size());
+        for (uint64_t rel_id : rel_ids) {
+            double value = 1.0;
+            if (!ValidRelationshipId(rel_id) ||
+                !relationship_types.getProperties(externalToTypeId(rel_id)).getNumericProperty(weight, externalToInternal(rel_id), value)) {
+                value = 1.0;
+            }
+            weights.emplace_back(value);
+        }
+        return weights;
+    }
+
+}
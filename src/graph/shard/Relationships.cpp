@@ -19,6 +19,7 @@
 namespace ragedb {
 
     uint64_t Shard::RelationshipAddEmptySameShard(uint16_t rel_type_id, uint64_t id1, uint64_t id2) {
+        wal.Append(LogOperation::RelationshipAddEmptySameShard, rel_type_id, id1, id2);
         uint64_t internal_id1 = externalToInternal(id1);
         uint64_t internal_id2 = externalToInternal(id2);
         uint16_t id1_type_id = externalToTypeId(id1);
@@ -41,26 +42,10 @@ namespace ragedb {
             relationship_types.addId(rel_type_id, internal_id);
 
             // Add the relationship to the outgoing node
-            auto group = find_if(std::begin(node_types.getOutgoingRelationships(id1_type_id).at(internal_id1)), std::end(node_types.getOutgoingRelationships(id1_type_id).at(internal_id1)),
-                                 [rel_type_id] (const Group& g) { return g.rel_type_id == rel_type_id; } );
-            // See if the relationship type is already there
-            if (group != std::end(node_types.getOutgoingRelationships(id1_type_id).at(internal_id1))) {
-                group->links.emplace_back(id2, external_id);
-            } else {
-                // otherwise create a new type with the links
-                node_types.getOutgoingRelationships(id1_type_id).at(internal_id1).emplace_back(Group(rel_type_id, std::vector<Link>({Link(id2, external_id)})));
-            }
+            node_types.addOutgoingLink(id1_type_id, internal_id1, rel_type_id, id2, external_id);
 
             // Add the relationship to the incoming node
-            group = find_if(std::begin(node_types.getIncomingRelationships(id2_type_id).at(internal_id2)), std::end(node_types.getIncomingRelationships(id2_type_id).at(internal_id2)),
-                            [rel_type_id] (const Group& g) { return g.rel_type_id == rel_type_id; } );
-            // See if the relationship type is already there
-            if (group != std::end(node_types.getIncomingRelationships(id2_type_id).at(internal_id2))) {
-                group->links.emplace_back(id1, external_id);
-            } else {
-                // otherwise create a new type with the links
-                node_types.getIncomingRelationships(id2_type_id).at(internal_id2).emplace_back(Group(rel_type_id, std::vector<Link>({Link(id1, external_id)})));
-            }
+            node_types.addIncomingLink(id2_type_id, internal_id2, rel_type_id, id1, external_id);
 
             // Add relationship id to Types
             relationship_types.addId(rel_type_id, external_id);
@@ -72,6 +57,7 @@ namespace ragedb {
     }
 
     uint64_t Shard::RelationshipAddSameShard(uint16_t rel_type_id, uint64_t id1, uint64_t id2, const std::string& properties) {
+        wal.Append(LogOperation::RelationshipAddSameShard, rel_type_id, id1, id2, properties);
         uint64_t internal_id1 = externalToInternal(id1);
         uint64_t internal_id2 = externalToInternal(id2);
         uint16_t id1_type_id = externalToTypeId(id1);
@@ -95,26 +81,10 @@ namespace ragedb {
             relationship_types.addId(rel_type_id, internal_id);
 
             // Add the relationship to the outgoing node
-            auto group = find_if(std::begin(node_types.getOutgoingRelationships(id1_type_id).at(internal_id1)), std::end(node_types.getOutgoingRelationships(id1_type_id).at(internal_id1)),
-                                 [rel_type_id] (const Group& g) { return g.rel_type_id == rel_type_id; } );
-            // See if the relationship type is already there
-            if (group != std::end(node_types.getOutgoingRelationships(id1_type_id).at(internal_id1))) {
-                group->links.emplace_back(id2, external_id);
-            } else {
-                // otherwise create a new type with the links
-                node_types.getOutgoingRelationships(id1_type_id).at(internal_id1).emplace_back(Group(rel_type_id, std::vector<Link>({Link(id2, external_id)})));
-            }
+            node_types.addOutgoingLink(id1_type_id, internal_id1, rel_type_id, id2, external_id);
 
             // Add the relationship to the incoming node
-            group = find_if(std::begin(node_types.getIncomingRelationships(id2_type_id).at(internal_id2)), std::end(node_types.getIncomingRelationships(id2_type_id).at(internal_id2)),
-                            [rel_type_id] (const Group& g) { return g.rel_type_id == rel_type_id; } );
-            // See if the relationship type is already there
-            if (group != std::end(node_types.getIncomingRelationships(id2_type_id).at(internal_id2))) {
-                group->links.emplace_back(id1, external_id);
-            } else {
-                // otherwise create a new type with the links
-                node_types.getIncomingRelationships(id2_type_id).at(internal_id2).emplace_back(Group(rel_type_id, std::vector<Link>({Link(id1, external_id)})));
-            }
+            node_types.addIncomingLink(id2_type_id, internal_id2, rel_type_id, id1, external_id);
 
             // Add relationship id to Types
             relationship_types.addId(rel_type_id, external_id);
@@ -140,6 +110,7 @@ namespace ragedb {
     }
 
     uint64_t Shard::RelationshipAddEmptyToOutgoing(uint16_t rel_type_id, uint64_t id1, uint64_t id2) {
+        wal.Append(LogOperation::RelationshipAddEmptyToOutgoing, rel_type_id, id1, id2);
         uint64_t internal_id1 = externalToInternal(id1);
         uint16_t id1_type_id = externalToTypeId(id1);
         uint64_t external_id = 0;
@@ -159,15 +130,7 @@ namespace ragedb {
         relationship_types.addId(rel_type_id, external_id);
 
         // Add the relationship to the outgoing node
-        auto group = find_if(std::begin(node_types.getOutgoingRelationships(id1_type_id).at(internal_id1)), std::end(node_types.getOutgoingRelationships(id1_type_id).at(internal_id1)),
-                             [rel_type_id] (const Group& g) { return g.rel_type_id == rel_type_id; } );
-        // See if the relationship type is already there
-        if (group != std::end(node_types.getOutgoingRelationships(id1_type_id).at(internal_id1))) {
-            group->links.emplace_back(id2, external_id);
-        } else {
-            // otherwise create a new type with the links
-            node_types.getOutgoingRelationships(id1_type_id).at(internal_id1).emplace_back(Group(rel_type_id, std::vector<Link>({Link(id2, external_id)})));
-        }
+        node_types.addOutgoingLink(id1_type_id, internal_id1, rel_type_id, id2, external_id);
 
         // Add relationship id to Types
         relationship_types.addId(rel_type_id, external_id);
@@ -176,6 +139,7 @@ namespace ragedb {
     }
 
     uint64_t Shard::RelationshipAddToOutgoing(uint16_t rel_type_id, uint64_t id1, uint64_t id2, const std::string& properties) {
+        wal.Append(LogOperation::RelationshipAddToOutgoing, rel_type_id, id1, id2, properties);
         uint64_t internal_id1 = externalToInternal(id1);
         uint64_t internal_id2 = externalToInternal(id2);
         uint16_t id1_type_id = externalToTypeId(id1);
@@ -198,15 +162,7 @@ namespace ragedb {
         relationship_types.addId(rel_type_id, external_id);
 
         // Add the relationship to the outgoing node
-        auto group = find_if(std::begin(node_types.getOutgoingRelationships(id1_type_id).at(internal_id1)), std::end(node_types.getOutgoingRelationships(id1_type_id).at(internal_id1)),
-                             [rel_type_id] (const Group& g) { return g.rel_type_id == rel_type_id; } );
-        // See if the relationship type is already there
-        if (group != std::end(node_types.getOutgoingRelationships(id1_type_id).at(internal_id1))) {
-            group->links.emplace_back(id2, external_id);
-        } else {
-            // otherwise create a new type with the links
-            node_types.getOutgoingRelationships(id1_type_id).at(internal_id1).emplace_back(Group(rel_type_id, std::vector<Link>({Link(id2, external_id)})));
-        }
+        node_types.addOutgoingLink(id1_type_id, internal_id1, rel_type_id, id2, external_id);
 
         // Add relationship id to Types
         relationship_types.addId(rel_type_id, external_id);
@@ -215,23 +171,55 @@ namespace ragedb {
     }
 
     uint64_t Shard::RelationshipAddToIncoming(uint16_t rel_type_id, uint64_t rel_id, uint64_t id1, uint64_t id2) {
+        wal.Append(LogOperation::RelationshipAddToIncoming, rel_type_id, rel_id, id1, id2);
         uint64_t internal_id2 = externalToInternal(id2);
         uint16_t id1_type_id = externalToTypeId(id1);
         uint16_t id2_type_id = externalToTypeId(id2);
         // Add the relationship to the incoming node
-        auto group = find_if(std::begin(node_types.getIncomingRelationships(id2_type_id).at(internal_id2)), std::end(node_types.getIncomingRelationships(id2_type_id).at(internal_id2)),
-                             [rel_type_id] (const Group& g) { return g.rel_type_id == rel_type_id; } );
-        // See if the relationship type is already there
-        if (group != std::end(node_types.getIncomingRelationships(id2_type_id).at(internal_id2))) {
-            group->links.emplace_back(id1, rel_id);
-        } else {
-            // otherwise create a new type with the links
-            node_types.getIncomingRelationships(id2_type_id).at(internal_id2).emplace_back(Group(rel_type_id, std::vector<Link>({Link(id1, rel_id)})));
-        }
+        node_types.addIncomingLink(id2_type_id, internal_id2, rel_type_id, id1, rel_id);
 
         return rel_id;
     }
 
+    std::vector<uint64_t> Shard::RelationshipsAddToOutgoing(uint16_t rel_type_id, const std::vector<uint64_t> &ids1, const std::vector<uint64_t> &ids2, const std::vector<std::string> &properties) {
+        if (ids1.size() != ids2.size()) {
+            return std::vector<uint64_t>();
+        }
+        if (!relationship_types.ValidTypeId(rel_type_id)) {
+            return std::vector<uint64_t>(ids1.size(), 0);
+        }
+        std::vector<uint64_t> rel_ids;
+        rel_ids.reserve(ids1.size());
+        relationship_types.reserve(rel_type_id, ids1.size());
+        bool with_properties = properties.size() == ids1.size();
+        for (size_t i = 0; i < ids1.size(); i++) {
+            // The starting node may have been removed since its id was looked up
+            if (!ValidNodeId(ids1[i])) {
+                rel_ids.emplace_back(0);
+                continue;
+            }
+            if (with_properties && !properties[i].empty()) {
+                rel_ids.emplace_back(RelationshipAddToOutgoing(rel_type_id, ids1[i], ids2[i], properties[i]));
+            } else {
+                rel_ids.emplace_back(RelationshipAddEmptyToOutgoing(rel_type_id, ids1[i], ids2[i]));
+            }
+        }
+        return rel_ids;
+    }
+
+    uint64_t Shard::RelationshipsAddToIncoming(uint16_t rel_type_id, const std::vector<uint64_t> &rel_ids, const std::vector<uint64_t> &ids1, const std::vector<uint64_t> &ids2) {
+        if (ids1.size() != rel_ids.size() || ids2.size() != rel_ids.size()) {
+            return 0;
+        }
+        uint64_t count = 0;
+        for (size_t i = 0; i < rel_ids.size(); i++) {
+            if (RelationshipAddToIncoming(rel_type_id, rel_ids[i], ids1[i], ids2[i]) > 0) {
+                count++;
+            }
+        }
+        return count;
+    }
+
     std::vector<Relationship> Shard::RelationshipsGet(const std::vector<uint64_t>& rel_ids) {
         std::vector<Relationship> sharded_relationships;
 
@@ -281,6 +269,23 @@ namespace ragedb {
         return 0;
     }
 
+    /**
+     * Check if a node has an outgoing relationship of a type to another node.
+     * Large link groups are kept sorted by node id so this is a binary search instead of a scan.
+     *
+     * @param id1 starting node id, must live on this Shard
+     * @param id2 ending node id
+     * @param rel_type relationship type
+     * @return true if at least one such relationship exists
+     */
+    bool Shard::RelationshipExists(uint64_t id1, uint64_t id2, const std::string& rel_type) {
+        uint16_t rel_type_id = relationship_types.getTypeId(rel_type);
+        if (rel_type_id == 0 || !ValidNodeId(id1)) {
+            return false;
+        }
+        return node_types.hasLinkTo(externalToTypeId(id1), externalToInternal(id1), Direction::OUT, rel_type_id, id2);
+    }
+
     std::any Shard::RelationshipPropertyGet(uint64_t id, const std::string& property) {
         if (ValidRelationshipId(id)) {
             return relationship_types.getRelationshipProperty(id, property);
@@ -289,6 +294,7 @@ namespace ragedb {
     }
 
     bool Shard::RelationshipPropertySet(uint64_t id, const std::string& property, const std::any& value) {
+        wal.Append(LogOperation::RelationshipPropertySet, id, property, value);
         if (ValidRelationshipId(id)) {
             return relationship_types.setRelationshipProperty(id, property, value);
         }
@@ -296,6 +302,7 @@ namespace ragedb {
     }
 
     bool Shard::RelationshipPropertySetFromJson(uint64_t id, const std::string& property, const std::string& value) {
+        wal.Append(LogOperation::RelationshipPropertySetFromJson, id, property, value);
         if (ValidRelationshipId(id)) {
             return relationship_types.setRelationshipPropertyFromJson(id, property, value);
         }
@@ -303,6 +310,7 @@ namespace ragedb {
     }
 
     bool Shard::RelationshipPropertyDelete(uint64_t id, const std::string& property) {
+        wal.Append(LogOperation::RelationshipPropertyDelete, id, property);
         if (ValidRelationshipId(id)) {
             return relationship_types.deleteRelationshipProperty(id, property);
         }
@@ -317,6 +325,7 @@ namespace ragedb {
     }
 
     bool Shard::RelationshipPropertiesSetFromJson(uint64_t id, const std::string& value) {
+        wal.Append(LogOperation::RelationshipPropertiesSetFromJson, id, value);
         if (ValidRelationshipId(id)) {
             return relationship_types.setPropertiesFromJSON(externalToTypeId(id), externalToInternal(id), value);
         }
@@ -324,6 +333,7 @@ namespace ragedb {
     }
 
     bool Shard::RelationshipPropertiesResetFromJson(uint64_t id, const std::string& value) {
+        wal.Append(LogOperation::RelationshipPropertiesResetFromJson, id, value);
         if (ValidRelationshipId(id)) {
             relationship_types.deleteProperties(externalToTypeId(id), externalToInternal(id));
             return relationship_types.setPropertiesFromJSON(externalToTypeId(id), externalToInternal(id), value);
@@ -332,6 +342,7 @@ namespace ragedb {
     }
 
     bool Shard::RelationshipPropertiesDelete(uint64_t id) {
+        wal.Append(LogOperation::RelationshipPropertiesDelete, id);
         if (ValidRelationshipId(id)) {
             return relationship_types.deleteProperties(externalToTypeId(id), externalToInternal(id));
         }
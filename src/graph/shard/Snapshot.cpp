@@ -0,0 +1,199 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <iostream>
+#include <sstream>
+#include <seastar/core/align.hh>
+#include <seastar/core/aligned_buffer.hh>
+#include <seastar/core/file.hh>
+#include <seastar/core/seastar.hh>
+
+#include "../Shard.h"
+
+namespace ragedb {
+
+    static const size_t SNAPSHOT_CHUNK_SIZE = 4U * 1024U * 1024U;
+
+    static std::string SnapshotPath(const std::string &directory, uint shard_id) {
+        return directory + "/shard-" + std::to_string(shard_id) + ".snapshot";
+    }
+
+    /**
+     * Serialize the columnar vectors of this Shard into a snapshot image
+     *
+     * @param writer snapshot image to append to
+     */
+    void Shard::SnapshotWrite(SnapshotWriter &writer) {
+        writer(SNAPSHOT_MAGIC);
+        writer(static_cast<uint32_t>(cpus));
+        writer(static_cast<uint32_t>(shard_id));
+        writer(wal.Generation());
+        node_types.writeSnapshot(writer);
+        relationship_types.writeSnapshot(writer);
+    }
+
+    /**
+     * Replace the contents of this Shard with a snapshot image
+     *
+     * @param reader snapshot image to read from
+     * @return true if the snapshot was loaded, false if it was invalid and the Shard is left empty
+     */
+    bool Shard::SnapshotRead(SnapshotReader &reader) {
+        // External ids encode the shard, so a snapshot only fits the same core on the same number of cores
+        if (reader.read<uint64_t>() != SNAPSHOT_MAGIC || reader.read<uint32_t>() != cpus || reader.read<uint32_t>() != shard_id) {
+            return false;
+        }
+
+        // Log records up to this generation are already part of the image
+        wal.SetGeneration(reader.read<uint64_t>());
+
+        try {
+            if (node_types.readSnapshot(reader) && relationship_types.readSnapshot(reader) && reader.done()) {
+                return true;
+            }
+        } catch (...) {
+            std::cerr << "Exception reading snapshot of Shard " << shard_id << '\n';
+        }
+
+        Clear();
+        return false;
+    }
+
+    /**
+     * Write a point in time snapshot of this Shard to disk using DMA
+     *
+     * @param directory where the snapshot files are kept
+     * @return future true if the snapshot was written
+     */
+    seastar::future<bool> Shard::Snapshot(const std::string &directory) {
+        // Start a new log generation and serialize before yielding, so the image plus the newer log is the whole shard
+        seastar::future<> rotated = wal.Rotate();
+        auto writer = seastar::make_lw_shared<SnapshotWriter>();
+        SnapshotWrite(*writer);
+        uint64_t generation = wal.Generation();
+
+        return seastar::async([rotated = std::move(rotated), writer, directory, generation, this] () mutable {
+            std::string path = SnapshotPath(directory, shard_id);
+            std::string temporary = path + ".tmp";
+            try {
+                rotated.get();
+                seastar::recursive_touch_directory(directory).get();
+                seastar::file file = seastar::open_file_dma(temporary, seastar::open_flags::wo | seastar::open_flags::create | seastar::open_flags::truncate).get0();
+
+                // DMA requires aligned buffers and lengths, so copy the image out in aligned chunks
+                const std::string &image = writer->data();
+                size_t alignment = file.disk_write_dma_alignment();
+                auto chunk = seastar::allocate_aligned_buffer<char>(SNAPSHOT_CHUNK_SIZE, alignment);
+                uint64_t offset = 0;
+                while (offset < image.size()) {
+                    size_t length = std::min(SNAPSHOT_CHUNK_SIZE, image.size() - offset);
+                    size_t aligned_length = seastar::align_up(length, alignment);
+                    std::memcpy(chunk.get(), image.data() + offset, length);
+                    std::memset(chunk.get() + length, 0, aligned_length - length);
+                    size_t written = file.dma_write(offset, chunk.get(), aligned_length).get0();
+                    if (written < length) {
+                        throw std::runtime_error("short write");
+                    }
+                    offset += length;
+                }
+
+                // Drop the padding of the last chunk and only then make the snapshot visible
+                file.truncate(image.size()).get();
+                file.flush().get();
+                file.close().get();
+                seastar::rename_file(temporary, path).get();
+                seastar::sync_directory(directory).get();
+
+                // Older log generations are now covered by the snapshot
+                wal.Remove(generation).get();
+                return true;
+            } catch (...) {
+                std::cerr << "Exception writing snapshot " << path << ": " << std::current_exception() << '\n';
+                return false;
+            }
+        });
+    }
+
+    /**
+     * Replace the contents of this Shard with its snapshot on disk
+     *
+     * @param directory where the snapshot files are kept
+     * @return future true if a snapshot was found and loaded
+     */
+    seastar::future<bool> Shard::Restore(const std::string &directory) {
+        return seastar::async([directory, this] () {
+            std::string path = SnapshotPath(directory, shard_id);
+            try {
+                if (!seastar::file_exists(path).get0()) {
+                    return false;
+                }
+                seastar::file file = seastar::open_file_dma(path, seastar::open_flags::ro).get0();
+                uint64_t size = file.size().get0();
+                seastar::temporary_buffer<char> image = file.dma_read_exactly<char>(0, size).get0();
+                file.close().get();
+
+                SnapshotReader reader(image.get(), image.size());
+                return SnapshotRead(reader);
+            } catch (...) {
+                std::cerr << "Exception reading snapshot " << path << ": " << std::current_exception() << '\n';
+                Clear();
+                return false;
+            }
+        });
+    }
+
+    /**
+     * Bring this Shard back to where it was before shutting down or crashing and start logging its mutations
+     *
+     * @param directory where the snapshot and log files are kept
+     * @param commit_window how long log records wait to be grouped into a single write
+     * @return future true if the snapshot (when there is one) and the log were loaded
+     */
+    seastar::future<bool> Shard::Recover(const std::string &directory, std::chrono::microseconds commit_window) {
+        return seastar::async([directory, commit_window, this] () {
+            try {
+                // A snapshot we can not read means part of the data is missing, replaying the log on top of nothing would be wrong
+                if (seastar::file_exists(SnapshotPath(directory, shard_id)).get0() && !Restore(directory).get0()) {
+                    return false;
+                }
+                uint64_t replayed = wal.Replay(directory, shard_id, [this] (SnapshotReader &record) {
+                    ApplyLogRecord(record);
+                }).get0();
+                if (replayed > 0) {
+                    std::stringstream ss;
+                    ss << "Shard " << shard_id << " replayed " << replayed << " log records\n";
+                    std::cout << ss.str();
+                }
+                wal.Open(directory, shard_id, commit_window).get();
+                return true;
+            } catch (...) {
+                std::cerr << "Exception recovering Shard " << shard_id << ": " << std::current_exception() << '\n';
+                Clear();
+                return false;
+            }
+        });
+    }
+
+    /**
+     * Write out the pending log records and stop logging
+     *
+     * @return future once the log is closed
+     */
+    seastar::future<> Shard::CloseLog() {
+        return wal.Close();
+    }
+
+}
@@ -1009,7 +1009,7 @@ namespace ragedb {
                                         [type_id] (const Group& g) { return g.rel_type_id == type_id; } );
 
                 if (in_group != std::end(node_types.getIncomingRelationships(node_type_id).at(internal_id))) {
-                    return in_group->links;
+                    return {std::begin(in_group->links), std::end(in_group->links)};
                 }
             }
 
@@ -1018,7 +1018,7 @@ namespace ragedb {
                                          [type_id] (const Group& g) { return g.rel_type_id == type_id; } );
 
                 if (out_group != std::end(node_types.getOutgoingRelationships(node_type_id).at(internal_id))) {
-                    return out_group->links;
+                    return {std::begin(out_group->links), std::end(out_group->links)};
                 }
             }
 
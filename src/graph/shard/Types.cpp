@@ -75,10 +75,12 @@ namespace ragedb {
     }
 
     bool Shard::NodeTypeInsert(const std::string& type, uint16_t type_id) {
+        wal.Append(LogOperation::NodeTypeInsert, type, type_id);
         return node_types.addTypeId(type, type_id);
     }
 
     bool Shard::DeleteNodeType(const std::string& type) {
+        wal.Append(LogOperation::DeleteNodeType, type);
         return node_types.deleteTypeId(type);
     }
 
@@ -96,18 +98,22 @@ namespace ragedb {
     }
 
     bool Shard::RelationshipTypeInsert(const std::string& type, uint16_t type_id) {
+        wal.Append(LogOperation::RelationshipTypeInsert, type, type_id);
         return relationship_types.addTypeId(type, type_id);
     }
 
     bool Shard::DeleteRelationshipType(const std::string& type) {
+        wal.Append(LogOperation::DeleteRelationshipType, type);
         return relationship_types.deleteTypeId(type);
     }
 
     uint8_t Shard::NodePropertyTypeAdd(uint16_t type_id, const std::string& key, uint8_t property_type_id) {
+        wal.Append(LogOperation::NodePropertyTypeAdd, type_id, key, property_type_id);
         return node_types.getNodeTypeProperties(type_id).setPropertyTypeId(key, property_type_id);
     }
 
     uint8_t Shard::RelationshipPropertyTypeAdd(uint16_t type_id, const std::string& key, uint8_t property_type_id) {
+        wal.Append(LogOperation::RelationshipPropertyTypeAdd, type_id, key, property_type_id);
         return relationship_types.getProperties(type_id).setPropertyTypeId(key, property_type_id);
     }
 
@@ -122,10 +128,12 @@ namespace ragedb {
     }
 
     bool Shard::NodePropertyTypeDelete(uint16_t type_id, const std::string& key) {
+        wal.Append(LogOperation::NodePropertyTypeDelete, type_id, key);
         return node_types.deleteTypeProperty(type_id, key);
     }
 
     bool Shard::RelationshipPropertyTypeDelete(uint16_t type_id, const std::string& key) {
+        wal.Append(LogOperation::RelationshipPropertyTypeDelete, type_id, key);
         return relationship_types.deleteTypeProperty(type_id, key);
     }
 
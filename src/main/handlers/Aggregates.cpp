@@ -0,0 +1,62 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Utilities.h"
+#include "../json/JSON.h"
+#include "Aggregates.h"
+
+const sstring GROUP_BY = sstring("group_by");
+
+void Aggregates::set_routes(routes &routes) {
+    auto getNodesAggregation = new match_rule(&getNodesAggregationHandler);
+    getNodesAggregation->add_str("/db/" + graph.GetName() + "/aggregate/nodes");
+    getNodesAggregation->add_param("type");
+    routes.add(getNodesAggregation, operation_type::GET);
+
+    auto getRelationshipsAggregation = new match_rule(&getRelationshipsAggregationHandler);
+    getRelationshipsAggregation->add_str("/db/" + graph.GetName() + "/aggregate/relationships");
+    getRelationshipsAggregation->add_param("rel_type");
+    routes.add(getRelationshipsAggregation, operation_type::GET);
+}
+
+// The property to aggregate and the one to group by are optional query parameters, without a property the nodes are counted
+future<std::unique_ptr<reply>> Aggregates::GetNodesAggregationHandler::handle([[maybe_unused]] const sstring &path, std::unique_ptr<request> req, std::unique_ptr<reply> rep) {
+    bool valid_type = Utilities::validate_parameter(Utilities::TYPE, req, rep, "Invalid type");
+
+    if (valid_type) {
+        return parent.graph.shard.local().AggregateNodesPeered(req->param[Utilities::TYPE], req->get_query_param(Utilities::PROPERTY),
+                                                               req->get_query_param(GROUP_BY), std::vector<Condition>())
+                .then([rep = std::move(rep)] (const ragedb::Aggregations& aggregations) mutable {
+                    rep->write_body("json", json::stream_object(aggregations_json(aggregations)));
+                    return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+                });
+    }
+    return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+}
+
+future<std::unique_ptr<reply>> Aggregates::GetRelationshipsAggregationHandler::handle([[maybe_unused]] const sstring &path, std::unique_ptr<request> req, std::unique_ptr<reply> rep) {
+    bool valid_rel_type = Utilities::validate_parameter(Utilities::REL_TYPE, req, rep, "Invalid relationship type");
+
+    if (valid_rel_type) {
+        return parent.graph.shard.local().AggregateRelationshipsPeered(req->param[Utilities::REL_TYPE], req->get_query_param(Utilities::PROPERTY),
+                                                                       req->get_query_param(GROUP_BY), std::vector<Condition>())
+                .then([rep = std::move(rep)] (const ragedb::Aggregations& aggregations) mutable {
+                    rep->write_body("json", json::stream_object(aggregations_json(aggregations)));
+                    return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+                });
+    }
+    return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "Utilities.h"
+#include "../json/JSON.h"
+#include "Analytics.h"
+
+const sstring ALGORITHM = sstring("algorithm");
+const sstring REL_TYPES = sstring("rel_types");
+const sstring ITERATIONS = sstring("iterations");
+const sstring DAMPING = sstring("damping");
+
+void Analytics::set_routes(routes &routes) {
+    auto postAnalytics = new match_rule(&postAnalyticsHandler);
+    postAnalytics->add_str("/db/" + graph.GetName() + "/analytics");
+    postAnalytics->add_param("algorithm");
+    routes.add(postAnalytics, operation_type::POST);
+}
+
+// Runs pagerank, components, communities, triangles or clustering and writes the results to the property query parameter.
+// Relationship types, separated by commas, default to all of them, iterations to 20 and damping to 0.85.
+future<std::unique_ptr<reply>> Analytics::PostAnalyticsHandler::handle([[maybe_unused]] const sstring &path, std::unique_ptr<request> req, std::unique_ptr<reply> rep) {
+    std::string property = req->get_query_param(Utilities::PROPERTY);
+    if (property.empty()) {
+        rep->write_body("json", json::stream_object("Invalid property"));
+        rep->set_status(reply::status_type::bad_request);
+        return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+    }
+
+    uint64_t iterations = 20;
+    double damping = 0.85;
+    try {
+        sstring iterations_string = req->get_query_param(ITERATIONS);
+        if (!iterations_string.empty()) {
+            iterations = std::stoull(iterations_string);
+        }
+        sstring damping_string = req->get_query_param(DAMPING);
+        if (!damping_string.empty()) {
+            damping = std::stod(damping_string);
+        }
+    } catch (std::exception& e) {
+        rep->write_body("json", json::stream_object("Invalid iterations or damping"));
+        rep->set_status(reply::status_type::bad_request);
+        return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+    }
+
+    std::vector<std::string> rel_types;
+    std::string rel_types_string = req->get_query_param(REL_TYPES);
+    if (!rel_types_string.empty()) {
+        boost::split(rel_types, rel_types_string, [](char c){ return c == ','; });
+    }
+
+    Shard &shard = parent.graph.shard.local();
+    std::string algorithm = req->param[ALGORITHM];
+    boost::algorithm::to_lower(algorithm);
+    seastar::future<uint64_t> written = seastar::make_ready_future<uint64_t>(0);
+    if (algorithm == "pagerank") {
+        written = shard.PageRankPeered(rel_types, property, iterations, damping);
+    } else if (algorithm == "components") {
+        written = shard.ConnectedComponentsPeered(rel_types, property, iterations);
+    } else if (algorithm == "communities") {
+        written = shard.LabelPropagationPeered(rel_types, property, iterations);
+    } else if (algorithm == "triangles") {
+        written = shard.TriangleCountPeered(rel_types, property);
+    } else if (algorithm == "clustering") {
+        written = shard.ClusteringCoefficientPeered(rel_types, property);
+    } else {
+        rep->write_body("json", json::stream_object("Invalid algorithm"));
+        rep->set_status(reply::status_type::bad_request);
+        return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+    }
+
+    return written.then([rep = std::move(rep)] (uint64_t count) mutable {
+        rep->write_body("json", json::stream_object(count));
+        return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+    });
+}
@@ -0,0 +1,408 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <cctype>
+#include <cstdio>
+#include <functional>
+#include <seastar/core/fstream.hh>
+#include <seastar/core/seastar.hh>
+#include "Utilities.h"
+#include "Bulk.h"
+
+// Records are sent to the shards in batches of this size
+const size_t BATCH_SIZE = 100000;
+const sstring FILE_PARAMETER = sstring("file");
+
+void Bulk::set_routes(routes &routes) {
+    auto postNodes = new match_rule(&postNodesHandler);
+    postNodes->add_str("/db/" + graph.GetName() + "/bulk/nodes");
+    postNodes->add_param("type");
+    routes.add(postNodes, operation_type::POST);
+
+    auto postRelationships = new match_rule(&postRelationshipsHandler);
+    postRelationships->add_str("/db/" + graph.GetName() + "/bulk/relationships");
+    postRelationships->add_param("rel_type");
+    routes.add(postRelationships, operation_type::POST);
+
+    auto deleteNodes = new match_rule(&deleteNodesHandler);
+    deleteNodes->add_str("/db/" + graph.GetName() + "/bulk/nodes");
+    deleteNodes->add_param("type");
+    routes.add(deleteNodes, operation_type::DELETE);
+}
+
+static bool is_csv(const std::unique_ptr<request> &req) {
+    return req->get_header("Content-Type").find("text/csv") != sstring::npos || req->get_query_param("format") == "csv";
+}
+
+/**
+ * Call process on every non empty line of the request body, or of the local file given by the file query parameter.
+ * Files are read a buffer at a time so they never have to fit in memory. Must run in a seastar thread.
+ *
+ * @return false if the file could not be opened
+ */
+static bool for_each_line(const std::unique_ptr<request> &req, const std::function<void(std::string_view)>& process) {
+    auto visit = [&process] (std::string_view line) {
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        if (!line.empty()) {
+            process(line);
+        }
+    };
+
+    sstring file_name = req->get_query_param(FILE_PARAMETER);
+    if (file_name.empty()) {
+        std::string_view body(req->content.data(), req->content.size());
+        size_t start = 0;
+        for (size_t end = body.find('\n'); end != std::string_view::npos; end = body.find('\n', start)) {
+            visit(body.substr(start, end - start));
+            start = end + 1;
+        }
+        visit(body.substr(start));
+        return true;
+    }
+
+    seastar::file file;
+    try {
+        file = seastar::open_file_dma(file_name, seastar::open_flags::ro).get0();
+    } catch (...) {
+        return false;
+    }
+
+    auto input = seastar::make_file_input_stream(std::move(file));
+    std::string partial;
+    while (true) {
+        seastar::temporary_buffer<char> buffer = input.read().get0();
+        if (buffer.empty()) {
+            break;
+        }
+        partial.append(buffer.get(), buffer.size());
+        std::string_view chunk(partial);
+        size_t start = 0;
+        for (size_t end = chunk.find('\n'); end != std::string_view::npos; end = chunk.find('\n', start)) {
+            visit(chunk.substr(start, end - start));
+            start = end + 1;
+        }
+        partial.erase(0, start);
+    }
+    input.close().get();
+    visit(partial);
+    return true;
+}
+
+// Quoted cells may contain commas and doubled quotes, but not line breaks
+static std::vector<std::string> split_csv(std::string_view line) {
+    std::vector<std::string> cells(1);
+    bool quoted = false;
+    for (size_t i = 0; i < line.size(); i++) {
+        char c = line[i];
+        if (quoted) {
+            if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                cells.back().push_back('"');
+                i++;
+            } else if (c == '"') {
+                quoted = false;
+            } else {
+                cells.back().push_back(c);
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            cells.emplace_back();
+        } else {
+            cells.back().push_back(c);
+        }
+    }
+    return cells;
+}
+
+static bool is_json_number(const std::string& value) {
+    size_t i = 0;
+    auto digits = [&value, &i] () {
+        size_t start = i;
+        while (i < value.size() && std::isdigit(static_cast<unsigned char>(value[i]))) {
+            i++;
+        }
+        return i > start;
+    };
+
+    if (i < value.size() && value[i] == '-') {
+        i++;
+    }
+    if (!digits()) {
+        return false;
+    }
+    if (i < value.size() && value[i] == '.') {
+        i++;
+        if (!digits()) {
+            return false;
+        }
+    }
+    if (i < value.size() && (value[i] == 'e' || value[i] == 'E')) {
+        i++;
+        if (i < value.size() && (value[i] == '+' || value[i] == '-')) {
+            i++;
+        }
+        if (!digits()) {
+            return false;
+        }
+    }
+    return i == value.size();
+}
+
+static void append_json_string(std::string& json, const std::string& value) {
+    json.push_back('"');
+    for (char c : value) {
+        switch (c) {
+            case '"': json.append("\\\""); break;
+            case '\\': json.append("\\\\"); break;
+            case '\n': json.append("\\n"); break;
+            case '\r': json.append("\\r"); break;
+            case '\t': json.append("\\t"); break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[7];
+                    snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    json.append(escaped);
+                } else {
+                    json.push_back(c);
+                }
+        }
+    }
+    json.push_back('"');
+}
+
+/**
+ * Convert the cells of a CSV row after the first few columns into a JSON object keyed by the header.
+ * Numbers, booleans and arrays are kept as they are, everything else becomes a string. Empty cells are skipped.
+ */
+static std::string csv_to_json(const std::vector<std::string>& header, const std::vector<std::string>& cells, size_t first) {
+    std::string json;
+    for (size_t i = first; i < cells.size() && i < header.size(); i++) {
+        if (cells[i].empty()) {
+            continue;
+        }
+        json.append(json.empty() ? "{" : ",");
+        append_json_string(json, header[i]);
+        json.push_back(':');
+        if (cells[i] == "true" || cells[i] == "false" || cells[i].front() == '[' || is_json_number(cells[i])) {
+            json.append(cells[i]);
+        } else {
+            append_json_string(json, cells[i]);
+        }
+    }
+    if (!json.empty()) {
+        json.push_back('}');
+    }
+    return json;
+}
+
+static sstring import_result(uint64_t created, uint64_t invalid) {
+    return "{\"created\":" + to_sstring(created) + ",\"invalid\":" + to_sstring(invalid) + "}";
+}
+
+future<std::unique_ptr<reply>> Bulk::PostNodesHandler::handle([[maybe_unused]] const sstring &path, std::unique_ptr<request> req, std::unique_ptr<reply> rep) {
+    bool valid_type = Utilities::validate_parameter(Utilities::TYPE, req, rep, "Invalid type");
+
+    if (valid_type) {
+        return seastar::async([req = std::move(req), rep = std::move(rep), this] () mutable {
+            std::string type = req->param[Utilities::TYPE];
+            bool csv = is_csv(req);
+            simdjson::dom::parser parser;
+            std::vector<std::string> header;
+            std::vector<std::string> keys;
+            std::vector<std::string> properties;
+            uint64_t created = 0;
+            uint64_t invalid = 0;
+
+            auto import = [&] () {
+                if (!keys.empty()) {
+                    created += parent.graph.shard.local().NodesImportPeered(type, keys, properties).get0();
+                    keys.clear();
+                    properties.clear();
+                }
+            };
+
+            // CSV: a header row, then key,property,... rows. NDJSON: {"key":..., "properties":{...}} per line
+            bool found = for_each_line(req, [&] (std::string_view line) {
+                if (csv) {
+                    std::vector<std::string> cells = split_csv(line);
+                    if (header.empty()) {
+                        header = std::move(cells);
+                        return;
+                    }
+                    if (cells[0].empty()) {
+                        invalid++;
+                        return;
+                    }
+                    properties.emplace_back(csv_to_json(header, cells, 1));
+                    keys.emplace_back(std::move(cells[0]));
+                } else {
+                    simdjson::dom::object object;
+                    std::string_view key;
+                    if (parser.parse(line.data(), line.size()).get(object) || object["key"].get(key)) {
+                        invalid++;
+                        return;
+                    }
+                    simdjson::dom::object node_properties;
+                    keys.emplace_back(key);
+                    properties.emplace_back(object["properties"].get(node_properties) ? "" : simdjson::minify(node_properties));
+                }
+
+                if (keys.size() >= BATCH_SIZE) {
+                    import();
+                }
+            });
+
+            if (!found) {
+                rep->write_body("json", json::stream_object("Invalid file"));
+                rep->set_status(reply::status_type::bad_request);
+                return std::move(rep);
+            }
+
+            import();
+            rep->write_body("json", import_result(created, invalid));
+            return std::move(rep);
+        });
+    }
+    return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+}
+
+future<std::unique_ptr<reply>> Bulk::PostRelationshipsHandler::handle([[maybe_unused]] const sstring &path, std::unique_ptr<request> req, std::unique_ptr<reply> rep) {
+    bool valid_rel_type = Utilities::validate_parameter(Utilities::REL_TYPE, req, rep, "Invalid relationship type");
+
+    if (valid_rel_type) {
+        return seastar::async([req = std::move(req), rep = std::move(rep), this] () mutable {
+            std::string rel_type = req->param[Utilities::REL_TYPE];
+            bool csv = is_csv(req);
+            simdjson::dom::parser parser;
+            std::vector<std::string> header;
+            std::vector<std::string> types1;
+            std::vector<std::string> keys1;
+            std::vector<std::string> types2;
+            std::vector<std::string> keys2;
+            std::vector<std::string> properties;
+            uint64_t records = 0;
+            uint64_t created = 0;
+            uint64_t invalid = 0;
+
+            auto import = [&] () {
+                if (!keys1.empty()) {
+                    records += keys1.size();
+                    created += parent.graph.shard.local().RelationshipsImportPeered(rel_type, types1, keys1, types2, keys2, properties).get0();
+                    types1.clear();
+                    keys1.clear();
+                    types2.clear();
+                    keys2.clear();
+                    properties.clear();
+                }
+            };
+
+            // CSV: a header row, then type1,key1,type2,key2,property,... rows.
+            // NDJSON: {"type1":..., "key1":..., "type2":..., "key2":..., "properties":{...}} per line
+            bool found = for_each_line(req, [&] (std::string_view line) {
+                if (csv) {
+                    std::vector<std::string> cells = split_csv(line);
+                    if (header.empty()) {
+                        header = std::move(cells);
+                        return;
+                    }
+                    if (cells.size() < 4 || cells[0].empty() || cells[1].empty() || cells[2].empty() || cells[3].empty()) {
+                        invalid++;
+                        return;
+                    }
+                    properties.emplace_back(csv_to_json(header, cells, 4));
+                    types1.emplace_back(std::move(cells[0]));
+                    keys1.emplace_back(std::move(cells[1]));
+                    types2.emplace_back(std::move(cells[2]));
+                    keys2.emplace_back(std::move(cells[3]));
+                } else {
+                    simdjson::dom::object object;
+                    std::string_view type1;
+                    std::string_view key1;
+                    std::string_view type2;
+                    std::string_view key2;
+                    if (parser.parse(line.data(), line.size()).get(object) || object["type1"].get(type1) || object["key1"].get(key1)
+                        || object["type2"].get(type2) || object["key2"].get(key2)) {
+                        invalid++;
+                        return;
+                    }
+                    simdjson::dom::object relationship_properties;
+                    types1.emplace_back(type1);
+                    keys1.emplace_back(key1);
+                    types2.emplace_back(type2);
+                    keys2.emplace_back(key2);
+                    properties.emplace_back(object["properties"].get(relationship_properties) ? "" : simdjson::minify(relationship_properties));
+                }
+
+                if (keys1.size() >= BATCH_SIZE) {
+                    import();
+                }
+            });
+
+            if (!found) {
+                rep->write_body("json", json::stream_object("Invalid file"));
+                rep->set_status(reply::status_type::bad_request);
+                return std::move(rep);
+            }
+
+            import();
+            // Relationships with a missing node are not created, count them as invalid
+            rep->write_body("json", import_result(created, invalid + records - created));
+            return std::move(rep);
+        });
+    }
+    return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+}
+
+// One key per line, the nodes are removed along with their relationships in batches
+future<std::unique_ptr<reply>> Bulk::DeleteNodesHandler::handle([[maybe_unused]] const sstring &path, std::unique_ptr<request> req, std::unique_ptr<reply> rep) {
+    bool valid_type = Utilities::validate_parameter(Utilities::TYPE, req, rep, "Invalid type");
+
+    if (valid_type) {
+        return seastar::async([req = std::move(req), rep = std::move(rep), this] () mutable {
+            std::string type = req->param[Utilities::TYPE];
+            std::vector<std::string> keys;
+            uint64_t deleted = 0;
+
+            auto remove = [&] () {
+                if (!keys.empty()) {
+                    deleted += parent.graph.shard.local().NodesRemovePeered(type, keys).get0();
+                    keys.clear();
+                }
+            };
+
+            bool found = for_each_line(req, [&] (std::string_view line) {
+                keys.emplace_back(line);
+                if (keys.size() >= BATCH_SIZE) {
+                    remove();
+                }
+            });
+
+            if (!found) {
+                rep->write_body("json", json::stream_object("Invalid file"));
+                rep->set_status(reply::status_type::bad_request);
+                return std::move(rep);
+            }
+
+            remove();
+            rep->write_body("json", "{\"deleted\":" + to_sstring(deleted) + "}");
+            return std::move(rep);
+        });
+    }
+    return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+}
@@ -181,7 +181,7 @@ future<std::unique_ptr<reply>> NodeProperties::PutNodePropertyByIdHandler::handl
         uint16_t node_shard_id = Shard::CalculateShardId(id);
 
         return parent.graph.shard.invoke_on(node_shard_id, [id, req = std::move(req)] (Shard &local_shard) {
-            return local_shard.NodePropertySetFromJson(id, req->param[Utilities::PROPERTY], req->content.c_str());
+            return local_shard.Durable(local_shard.NodePropertySetFromJson(id, req->param[Utilities::PROPERTY], req->content.c_str()));
         }).then([rep = std::move(rep)] (bool success) mutable {
             if(success) {
                 rep->set_status(reply::status_type::no_content);
@@ -220,7 +220,7 @@ future<std::unique_ptr<reply>> NodeProperties::DeleteNodePropertyByIdHandler::ha
         uint16_t node_shard_id = Shard::CalculateShardId(id);
 
         return parent.graph.shard.invoke_on(node_shard_id, [id, req = std::move(req)] (Shard &local_shard) {
-            return local_shard.NodePropertyDelete(id, req->param[Utilities::PROPERTY]);
+            return local_shard.Durable(local_shard.NodePropertyDelete(id, req->param[Utilities::PROPERTY]));
         }).then([rep = std::move(rep)] (const std::any& property) mutable {
             Utilities::convert_property_to_json(rep, property);
             return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
@@ -296,7 +296,7 @@ future<std::unique_ptr<reply>> NodeProperties::PostNodePropertiesByIdHandler::ha
         if (Utilities::validate_json(req, rep)) {
             uint16_t node_shard_id = Shard::CalculateShardId(id);
             return parent.graph.shard.invoke_on(node_shard_id, [id, req = std::move(req)](Shard &local_shard) {
-                return local_shard.NodePropertiesResetFromJson(id, req->content.c_str());
+                return local_shard.Durable(local_shard.NodePropertiesResetFromJson(id, req->content.c_str()));
             }).then([rep = std::move(rep)](bool success) mutable {
                 if (success) {
                     rep->set_status(reply::status_type::no_content);
@@ -341,7 +341,7 @@ future<std::unique_ptr<reply>> NodeProperties::PutNodePropertiesByIdHandler::han
         if (Utilities::validate_json(req, rep)) {
             uint16_t node_shard_id = Shard::CalculateShardId(id);
             return parent.graph.shard.invoke_on(node_shard_id, [id, req = std::move(req)](Shard &local_shard) {
-                return local_shard.NodePropertiesSetFromJson(id, req->content.c_str());
+                return local_shard.Durable(local_shard.NodePropertiesSetFromJson(id, req->content.c_str()));
             }).then([rep = std::move(rep)](bool success) mutable {
                 if (success) {
                     rep->set_status(reply::status_type::no_content);
@@ -382,7 +382,7 @@ future<std::unique_ptr<reply>> NodeProperties::DeleteNodePropertiesByIdHandler::
     if (id > 0) {
         uint16_t node_shard_id = Shard::CalculateShardId(id);
         return parent.graph.shard.invoke_on(node_shard_id, [id] (Shard &local_shard) {
-            return local_shard.NodePropertiesDelete(id);
+            return local_shard.Durable(local_shard.NodePropertiesDelete(id));
         }).then([rep = std::move(rep)] (bool success) mutable {
             if(success) {
                 rep->set_status(reply::status_type::no_content);
@@ -46,6 +46,11 @@ void Nodes::set_routes(routes &routes) {
     postNode->add_param("key");
     routes.add(postNode, operation_type::POST);
 
+    auto postNodes = new match_rule(&postNodesHandler);
+    postNodes->add_str("/db/" + graph.GetName() + "/nodes");
+    postNodes->add_param("type");
+    routes.add(postNodes, operation_type::POST);
+
     auto deleteNode = new match_rule(&deleteNodeHandler);
     deleteNode->add_str("/db/" + graph.GetName() + "/node");
     deleteNode->add_param("type");
@@ -59,6 +64,26 @@ void Nodes::set_routes(routes &routes) {
 }
 
 future<std::unique_ptr<reply>> Nodes::GetNodesHandler::handle([[maybe_unused]] const sstring &path, std::unique_ptr<request> req, std::unique_ptr<reply> rep) {
+    // With a cursor each page resumes where the last one left off, the next cursor comes back in a header
+    if (Utilities::has_cursor(req)) {
+        uint64_t limit = Utilities::validate_page_limit(req, rep);
+        Cursor cursor;
+        if (limit == 0 || !Utilities::validate_cursor(req, rep, cursor)) {
+            return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+        }
+        return parent.graph.shard.local().AllNodesPeered(cursor, limit)
+                .then([rep = std::move(rep)](Page<Node> page) mutable {
+                    std::vector<node_json> json_array;
+                    json_array.reserve(page.results.size());
+                    for (Node& node : page.results) {
+                        json_array.emplace_back(node);
+                    }
+                    rep->add_header(Utilities::NEXT_CURSOR, page.next.encode());
+                    rep->write_body("json", json::stream_object(json_array));
+                    return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+                });
+    }
+
     uint64_t limit = Utilities::validate_limit(req, rep);
     uint64_t offset = Utilities::validate_offset(req, rep);
 
@@ -76,6 +101,26 @@ future<std::unique_ptr<reply>> Nodes::GetNodesOfTypeHandler::handle([[maybe_unus
     bool valid_type = Utilities::validate_parameter(Utilities::TYPE, req, rep, "Invalid type");
 
     if(valid_type) {
+        // With a cursor each page resumes where the last one left off, the next cursor comes back in a header
+        if (Utilities::has_cursor(req)) {
+            uint64_t limit = Utilities::validate_page_limit(req, rep);
+            Cursor cursor;
+            if (limit == 0 || !Utilities::validate_cursor(req, rep, cursor)) {
+                return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+            }
+            return parent.graph.shard.local().AllNodesPeered(req->param[Utilities::TYPE], cursor, limit)
+                    .then([rep = std::move(rep)](Page<Node> page) mutable {
+                        std::vector<node_json> json_array;
+                        json_array.reserve(page.results.size());
+                        for (Node& node : page.results) {
+                            json_array.emplace_back(node);
+                        }
+                        rep->add_header(Utilities::NEXT_CURSOR, page.next.encode());
+                        rep->write_body("json", json::stream_object(json_array));
+                        return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+                    });
+        }
+
         uint64_t limit = Utilities::validate_limit(req, rep);
         uint64_t offset = Utilities::validate_offset(req, rep);
 
@@ -178,6 +223,45 @@ future<std::unique_ptr<reply>> Nodes::PostNodeHandler::handle([[maybe_unused]] c
     return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
 }
 
+future<std::unique_ptr<reply>> Nodes::PostNodesHandler::handle([[maybe_unused]] const sstring &path, std::unique_ptr<request> req, std::unique_ptr<reply> rep) {
+    bool valid_type = Utilities::validate_parameter(Utilities::TYPE, req, rep, "Invalid type");
+
+    if(valid_type) {
+        // The body is an array of { "key": ..., "properties": { ... } } objects
+        simdjson::dom::parser parser;
+        simdjson::dom::array array;
+        if (parser.parse(req->content.c_str(), req->content.size()).get(array)) {
+            rep->write_body("json", json::stream_object("Invalid JSON"));
+            rep->set_status(reply::status_type::bad_request);
+            return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+        }
+
+        std::vector<std::string> keys;
+        std::vector<std::string> properties;
+        keys.reserve(array.size());
+        properties.reserve(array.size());
+        for (simdjson::dom::element element : array) {
+            std::string_view key;
+            if (element["key"].get(key)) {
+                rep->write_body("json", json::stream_object("Invalid key"));
+                rep->set_status(reply::status_type::bad_request);
+                return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+            }
+            simdjson::dom::object node_properties;
+            keys.emplace_back(key);
+            properties.emplace_back(element["properties"].get(node_properties) ? "" : simdjson::minify(node_properties));
+        }
+
+        return parent.graph.shard.local().NodesAddPeered(req->param[Utilities::TYPE], keys, properties)
+                .then([rep = std::move(rep)] (const std::vector<uint64_t>& ids) mutable {
+                    rep->write_body("json", json::stream_object(ids));
+                    rep->set_status(reply::status_type::created);
+                    return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+                });
+    }
+    return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+}
+
 future<std::unique_ptr<reply>> Nodes::DeleteNodeHandler::handle([[maybe_unused]] const sstring &path, std::unique_ptr<request> req, std::unique_ptr<reply> rep) {
     bool valid_type = Utilities::validate_parameter(Utilities::TYPE, req, rep, "Invalid type");
     bool valid_key = Utilities::validate_parameter(Utilities::KEY, req, rep, "Invalid key");
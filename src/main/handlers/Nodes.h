@@ -68,6 +68,14 @@ class Nodes {
         future<std::unique_ptr<reply>> handle(const sstring& path, std::unique_ptr<request> req, std::unique_ptr<reply> rep) override;
     };
 
+    class PostNodesHandler : public httpd::handler_base {
+    public:
+        explicit PostNodesHandler(Nodes& nodes) : parent(nodes) {};
+    private:
+        Nodes& parent;
+        future<std::unique_ptr<reply>> handle(const sstring& path, std::unique_ptr<request> req, std::unique_ptr<reply> rep) override;
+    };
+
     class DeleteNodeHandler : public httpd::handler_base {
     public:
         explicit DeleteNodeHandler(Nodes& nodes) : parent(nodes) {};
@@ -92,11 +100,12 @@ private:
     GetNodeHandler getNodeHandler;
     GetNodeByIdHandler getNodeByIdHandler;
     PostNodeHandler postNodeHandler;
+    PostNodesHandler postNodesHandler;
     DeleteNodeHandler deleteNodeHandler;
     DeleteNodeByIdHandler deleteNodeByIdHandler;
 
 public:
-    explicit Nodes(Graph &_graph) : graph(_graph), getNodesHandler(*this), getNodesOfTypeHandler(*this), getNodeHandler(*this), getNodeByIdHandler(*this), postNodeHandler(*this), deleteNodeHandler(*this), deleteNodeByIdHandler(*this) {}
+    explicit Nodes(Graph &_graph) : graph(_graph), getNodesHandler(*this), getNodesOfTypeHandler(*this), getNodeHandler(*this), getNodeByIdHandler(*this), postNodeHandler(*this), postNodesHandler(*this), deleteNodeHandler(*this), deleteNodeByIdHandler(*this) {}
     void set_routes(routes& routes);
 };
 
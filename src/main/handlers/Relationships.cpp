@@ -53,6 +53,11 @@ void Relationships::set_routes(routes &routes) {
     postRelationship->add_param("rel_type");
     routes.add(postRelationship, operation_type::POST);
 
+    auto postRelationships = new match_rule(&postRelationshipsHandler);
+    postRelationships->add_str("/db/" + graph.GetName() + "/relationships");
+    postRelationships->add_param("rel_type");
+    routes.add(postRelationships, operation_type::POST);
+
     auto deleteRelationship = new match_rule(&deleteRelationshipHandler);
     deleteRelationship->add_str("/db/" + graph.GetName() + "/relationship");
     deleteRelationship->add_param("id");
@@ -72,9 +77,37 @@ void Relationships::set_routes(routes &routes) {
     getRelationshipsById->add_str("/relationships");
     getRelationshipsById->add_param("options", true);
     routes.add(getRelationshipsById, operation_type::GET);
+
+    auto getRelationshipExists = new match_rule(&getRelationshipExistsHandler);
+    getRelationshipExists->add_str("/db/" + graph.GetName() + "/node");
+    getRelationshipExists->add_param("id");
+    getRelationshipExists->add_str("/relationship");
+    getRelationshipExists->add_param("id2");
+    getRelationshipExists->add_param("rel_type");
+    routes.add(getRelationshipExists, operation_type::GET);
 }
 
 future<std::unique_ptr<reply>> Relationships::GetRelationshipsHandler::handle([[maybe_unused]] const sstring &path, std::unique_ptr<request> req, std::unique_ptr<reply> rep) {
+    // With a cursor each page resumes where the last one left off, the next cursor comes back in a header
+    if (Utilities::has_cursor(req)) {
+        uint64_t limit = Utilities::validate_page_limit(req, rep);
+        Cursor cursor;
+        if (limit == 0 || !Utilities::validate_cursor(req, rep, cursor)) {
+            return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+        }
+        return parent.graph.shard.local().AllRelationshipsPeered(cursor, limit)
+                .then([rep = std::move(rep)](Page<Relationship> page) mutable {
+                    std::vector<relationship_json> json_array;
+                    json_array.reserve(page.results.size());
+                    for (Relationship& relationship : page.results) {
+                        json_array.emplace_back(relationship);
+                    }
+                    rep->add_header(Utilities::NEXT_CURSOR, page.next.encode());
+                    rep->write_body("json", json::stream_object(json_array));
+                    return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+                });
+    }
+
     uint64_t limit = Utilities::validate_limit(req, rep);
     uint64_t offset = Utilities::validate_offset(req, rep);
 
@@ -94,6 +127,26 @@ future<std::unique_ptr<reply>> Relationships::GetRelationshipsOfTypeHandler::han
     bool valid_type = Utilities::validate_parameter(Utilities::TYPE, req, rep, "Invalid type");
 
     if(valid_type) {
+        // With a cursor each page resumes where the last one left off, the next cursor comes back in a header
+        if (Utilities::has_cursor(req)) {
+            uint64_t limit = Utilities::validate_page_limit(req, rep);
+            Cursor cursor;
+            if (limit == 0 || !Utilities::validate_cursor(req, rep, cursor)) {
+                return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+            }
+            return parent.graph.shard.local().AllRelationshipsPeered(req->param[Utilities::TYPE], cursor, limit)
+                    .then([rep = std::move(rep)](Page<Relationship> page) mutable {
+                        std::vector<relationship_json> json_array;
+                        json_array.reserve(page.results.size());
+                        for (Relationship& relationship : page.results) {
+                            json_array.emplace_back(relationship);
+                        }
+                        rep->add_header(Utilities::NEXT_CURSOR, page.next.encode());
+                        rep->write_body("json", json::stream_object(json_array));
+                        return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+                    });
+        }
+
         uint64_t limit = Utilities::validate_limit(req, rep);
         uint64_t offset = Utilities::validate_offset(req, rep);
 
@@ -237,6 +290,49 @@ future<std::unique_ptr<reply>> Relationships::PostRelationshipByIdHandler::handl
     return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
 }
 
+future<std::unique_ptr<reply>> Relationships::PostRelationshipsHandler::handle([[maybe_unused]] const sstring &path, std::unique_ptr<request> req, std::unique_ptr<reply> rep) {
+    bool valid_rel_type = Utilities::validate_parameter(Utilities::REL_TYPE, req, rep, "Invalid relationship type");
+
+    if(valid_rel_type) {
+        // The body is an array of { "id1": ..., "id2": ..., "properties": { ... } } objects
+        simdjson::dom::parser parser;
+        simdjson::dom::array array;
+        if (parser.parse(req->content.c_str(), req->content.size()).get(array)) {
+            rep->write_body("json", json::stream_object("Invalid JSON"));
+            rep->set_status(reply::status_type::bad_request);
+            return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+        }
+
+        std::vector<uint64_t> ids1;
+        std::vector<uint64_t> ids2;
+        std::vector<std::string> properties;
+        ids1.reserve(array.size());
+        ids2.reserve(array.size());
+        properties.reserve(array.size());
+        for (simdjson::dom::element element : array) {
+            uint64_t id1;
+            uint64_t id2;
+            if (element["id1"].get(id1) || element["id2"].get(id2)) {
+                rep->write_body("json", json::stream_object("Invalid id"));
+                rep->set_status(reply::status_type::bad_request);
+                return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+            }
+            simdjson::dom::object relationship_properties;
+            ids1.emplace_back(id1);
+            ids2.emplace_back(id2);
+            properties.emplace_back(element["properties"].get(relationship_properties) ? "" : simdjson::minify(relationship_properties));
+        }
+
+        return parent.graph.shard.local().RelationshipsAddPeered(req->param[Utilities::REL_TYPE], ids1, ids2, properties)
+                .then([rep = std::move(rep)] (const std::vector<uint64_t>& ids) mutable {
+                    rep->write_body("json", json::stream_object(ids));
+                    rep->set_status(reply::status_type::created);
+                    return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+                });
+    }
+    return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+}
+
 future<std::unique_ptr<reply>> Relationships::DeleteRelationshipHandler::handle([[maybe_unused]] const sstring &path, std::unique_ptr<request> req, std::unique_ptr<reply> rep) {
     uint64_t id = Utilities::validate_id(req, rep);
 
@@ -439,3 +535,19 @@ future<std::unique_ptr<reply>> Relationships::GetNodeRelationshipsByIdHandler::h
 
     return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
 }
+
+future<std::unique_ptr<reply>> Relationships::GetRelationshipExistsHandler::handle([[maybe_unused]] const sstring &path, std::unique_ptr<request> req, std::unique_ptr<reply> rep) {
+    uint64_t id = Utilities::validate_id(req, rep);
+    uint64_t id2 = Utilities::validate_id2(req, rep);
+    bool valid_rel_type = Utilities::validate_parameter(Utilities::REL_TYPE, req, rep, "Invalid relationship type");
+
+    if (id > 0 && id2 > 0 && valid_rel_type) {
+        return parent.graph.shard.local().RelationshipExistsPeered(id, id2, req->param[Utilities::REL_TYPE])
+                .then([rep = std::move(rep)] (bool exists) mutable {
+                    rep->write_body("json", json::stream_object(exists));
+                    return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+                });
+    }
+
+    return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+}
@@ -68,6 +68,14 @@ class Relationships {
         future<std::unique_ptr<reply>> handle(const sstring& path, std::unique_ptr<request> req, std::unique_ptr<reply> rep) override;
     };
 
+    class PostRelationshipsHandler : public httpd::handler_base {
+    public:
+        explicit PostRelationshipsHandler(Relationships& relationships) : parent(relationships) {};
+    private:
+        Relationships& parent;
+        future<std::unique_ptr<reply>> handle(const sstring& path, std::unique_ptr<request> req, std::unique_ptr<reply> rep) override;
+    };
+
     class DeleteRelationshipHandler : public httpd::handler_base {
     public:
         explicit DeleteRelationshipHandler(Relationships& relationships) : parent(relationships) {};
@@ -92,6 +100,14 @@ class Relationships {
         future<std::unique_ptr<reply>> handle(const sstring& path, std::unique_ptr<request> req, std::unique_ptr<reply> rep) override;
     };
 
+    class GetRelationshipExistsHandler : public httpd::handler_base {
+    public:
+        explicit GetRelationshipExistsHandler(Relationships& relationships) : parent(relationships) {};
+    private:
+        Relationships& parent;
+        future<std::unique_ptr<reply>> handle(const sstring& path, std::unique_ptr<request> req, std::unique_ptr<reply> rep) override;
+    };
+
 private:
     Graph& graph;
     GetRelationshipsHandler getRelationshipsHandler;
@@ -99,14 +115,17 @@ private:
     GetRelationshipHandler getRelationshipHandler;
     PostRelationshipHandler postRelationshipHandler;
     PostRelationshipByIdHandler postRelationshipByIdHandler;
+    PostRelationshipsHandler postRelationshipsHandler;
     DeleteRelationshipHandler deleteRelationshipHandler;
     GetNodeRelationshipsHandler getNodeRelationshipsHandler;
     GetNodeRelationshipsByIdHandler getNodeRelationshipsByIdHandler;
+    GetRelationshipExistsHandler getRelationshipExistsHandler;
 
 public:
     explicit Relationships(Graph &_graph) : graph(_graph), getRelationshipsHandler(*this), getRelationshipsOfTypeHandler(*this),
-                                           getRelationshipHandler(*this), postRelationshipHandler(*this), postRelationshipByIdHandler(*this),
-                                           deleteRelationshipHandler(*this), getNodeRelationshipsHandler(*this), getNodeRelationshipsByIdHandler(*this) {}
+                                           getRelationshipHandler(*this), postRelationshipHandler(*this), postRelationshipByIdHandler(*this), postRelationshipsHandler(*this),
+                                           deleteRelationshipHandler(*this), getNodeRelationshipsHandler(*this), getNodeRelationshipsByIdHandler(*this),
+                                           getRelationshipExistsHandler(*this) {}
     void set_routes(routes& routes);
 
 };
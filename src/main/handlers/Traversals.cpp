@@ -0,0 +1,131 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Utilities.h"
+#include "../json/JSON.h"
+#include "Traversals.h"
+
+const sstring DEPTH = sstring("depth");
+const sstring DIRECTION = sstring("direction");
+const sstring REL_TYPES = sstring("rel_types");
+const sstring MAX_DEPTH = sstring("max_depth");
+const sstring WEIGHT = sstring("weight");
+const sstring DELTA = sstring("delta");
+const uint64_t DEFAULT_MAX_DEPTH = 10;
+
+static Direction parse_direction(const std::unique_ptr<request> &req) {
+    std::string direction_string = req->get_query_param(DIRECTION);
+    boost::algorithm::to_lower(direction_string);
+    if (direction_string == "in") {
+        return IN;
+    }
+    if (direction_string == "out") {
+        return OUT;
+    }
+    return BOTH;
+}
+
+static std::vector<std::string> parse_rel_types(const std::unique_ptr<request> &req) {
+    std::vector<std::string> rel_types;
+    std::string rel_types_string = req->get_query_param(REL_TYPES);
+    if (!rel_types_string.empty()) {
+        boost::split(rel_types, rel_types_string, [](char c){ return c == ','; });
+    }
+    return rel_types;
+}
+
+void Traversals::set_routes(routes &routes) {
+    auto getKHop = new match_rule(&getKHopHandler);
+    getKHop->add_str("/db/" + graph.GetName() + "/khop");
+    getKHop->add_param("id");
+    routes.add(getKHop, operation_type::GET);
+
+    auto getShortestPath = new match_rule(&getShortestPathHandler);
+    getShortestPath->add_str("/db/" + graph.GetName() + "/path");
+    getShortestPath->add_param("id");
+    getShortestPath->add_param("id2");
+    routes.add(getShortestPath, operation_type::GET);
+}
+
+// Depth defaults to 1, direction to both and relationship types, separated by commas, to all of them
+future<std::unique_ptr<reply>> Traversals::GetKHopHandler::handle([[maybe_unused]] const sstring &path, std::unique_ptr<request> req, std::unique_ptr<reply> rep) {
+    uint64_t id = Utilities::validate_id(req, rep);
+
+    if (id > 0) {
+        uint64_t depth = 1;
+        sstring depth_string = req->get_query_param(DEPTH);
+        if (!depth_string.empty()) {
+            try {
+                depth = std::stoull(depth_string);
+            } catch (std::exception& e) {
+                rep->write_body("json", json::stream_object("Invalid depth"));
+                rep->set_status(reply::status_type::bad_request);
+                return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+            }
+        }
+
+        Direction direction = parse_direction(req);
+        std::vector<std::string> rel_types = parse_rel_types(req);
+
+        return parent.graph.shard.local().TraversePeered({ id }, direction, rel_types, depth)
+                .then([rep = std::move(rep)] (const std::vector<uint64_t>& ids) mutable {
+                    rep->write_body("json", json::stream_object(ids));
+                    return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+                });
+    }
+    return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+}
+
+// Paths are weighted by the relationship property given as weight, or by number of relationships when there is none
+future<std::unique_ptr<reply>> Traversals::GetShortestPathHandler::handle([[maybe_unused]] const sstring &path, std::unique_ptr<request> req, std::unique_ptr<reply> rep) {
+    uint64_t id = Utilities::validate_id(req, rep);
+    uint64_t id2 = Utilities::validate_id2(req, rep);
+
+    if (id > 0 && id2 > 0) {
+        uint64_t max_depth = DEFAULT_MAX_DEPTH;
+        double delta = 1.0;
+        try {
+            sstring max_depth_string = req->get_query_param(MAX_DEPTH);
+            if (!max_depth_string.empty()) {
+                max_depth = std::stoull(max_depth_string);
+            }
+            sstring delta_string = req->get_query_param(DELTA);
+            if (!delta_string.empty()) {
+                delta = std::stod(delta_string);
+            }
+        } catch (std::exception& e) {
+            rep->write_body("json", json::stream_object("Invalid max_depth or delta"));
+            rep->set_status(reply::status_type::bad_request);
+            return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+        }
+
+        Direction direction = parse_direction(req);
+        std::vector<std::string> rel_types = parse_rel_types(req);
+        std::string weight = req->get_query_param(WEIGHT);
+
+        auto found = weight.empty() ? parent.graph.shard.local().ShortestPathPeered(id, id2, direction, rel_types, max_depth)
+                                    : parent.graph.shard.local().WeightedShortestPathPeered(id, id2, direction, rel_types, weight, max_depth, delta);
+        return found.then([rep = std::move(rep)] (const Path& found_path) mutable {
+            if (found_path.node_ids.empty()) {
+                rep->set_status(reply::status_type::not_found);
+            } else {
+                rep->write_body("json", json::stream_object(path_json(found_path)));
+            }
+            return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+        });
+    }
+    return make_ready_future<std::unique_ptr<reply>>(std::move(rep));
+}
@@ -90,6 +90,40 @@ uint64_t Utilities::validate_offset(std::unique_ptr<request> &req, std::unique_p
     }
 }
 
+uint64_t Utilities::validate_page_limit(std::unique_ptr<request> &req, std::unique_ptr<reply> &rep) {
+    // Validate limit is a positive unsigned long long, an empty page would hand back the same cursor forever
+
+    sstring limit_param = req->get_query_param("limit");
+    if (limit_param.empty()) {
+        return 100;
+    }
+    try {
+        uint64_t limit = std::stoull(limit_param);
+        if (limit > 0) {
+            return limit;
+        }
+    } catch (std::exception&) {
+    }
+    rep->write_body("json", json::stream_object("Invalid limit parameter"));
+    rep->set_status(reply::status_type::bad_request);
+    return 0;
+}
+
+bool Utilities::has_cursor(const std::unique_ptr<request> &req) {
+    // An empty cursor asks for the first page
+    return req->query_parameters.find(CURSOR) != req->query_parameters.end();
+}
+
+bool Utilities::validate_cursor(std::unique_ptr<request> &req, std::unique_ptr<reply> &rep, ragedb::Cursor &cursor) {
+    // Validate cursor was handed out with an earlier page
+    if (!ragedb::Cursor::decode(req->get_query_param(CURSOR), cursor)) {
+        rep->write_body("json", json::stream_object("Invalid cursor parameter"));
+        rep->set_status(reply::status_type::bad_request);
+        return false;
+    }
+    return true;
+}
+
 void Utilities::convert_property_to_json(std::unique_ptr<reply> &rep, const std::any &property) {
     if(property.type() == typeid(std::string)) {
         rep->write_body("json", json::stream_object(std::any_cast<std::string>(property)));
@@ -45,12 +45,17 @@ public:
     static inline const sstring KEY2 = sstring ("key2");
     static inline const sstring REL_TYPE = sstring ("rel_type");
     static inline const sstring OPTIONS = sstring ("options");
+    static inline const sstring CURSOR = sstring ("cursor");
+    static inline const sstring NEXT_CURSOR = sstring ("X-Next-Cursor");
 
     static bool validate_parameter(const seastar::sstring& parameter, std::unique_ptr<request> &req, std::unique_ptr<reply> &rep, std::string message);
     static uint64_t validate_id(const std::unique_ptr<request> &req, std::unique_ptr<reply> &rep);
     static uint64_t validate_id2(const std::unique_ptr<request> &req, std::unique_ptr<reply> &rep);
     static uint64_t validate_limit(std::unique_ptr<request> &req, std::unique_ptr<reply> &rep);
     static uint64_t validate_offset(std::unique_ptr<request> &req, std::unique_ptr<reply> &rep);
+    static uint64_t validate_page_limit(std::unique_ptr<request> &req, std::unique_ptr<reply> &rep);
+    static bool has_cursor(const std::unique_ptr<request> &req);
+    static bool validate_cursor(std::unique_ptr<request> &req, std::unique_ptr<reply> &rep, ragedb::Cursor &cursor);
     static bool validate_json(const std::unique_ptr<request> &req, std::unique_ptr<reply> &rep);
 
     static void convert_property_to_json(std::unique_ptr<reply> &rep, const std::any &property);
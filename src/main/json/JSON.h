@@ -19,6 +19,9 @@
 
 #include <Graph.h>
 #include <Node.h>
+#include <PropertyRecord.h>
+#include <type_traits>
+#include <variant>
 #include <seastar/core/print.hh>
 #include <seastar/http/httpd.hh>
 #include <seastar/json/json_elements.hh>
@@ -232,6 +235,37 @@ public:
         }
     }
 
+    void add_record(PropertyRecord const & record) {
+        for (const auto& [key, value] : record) {
+            std::visit([this, &key = key] (const auto& item) {
+                using T = std::decay_t<decltype(item)>;
+                if constexpr (std::is_same_v<T, std::monostate>) {
+                    return;
+                } else if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, int64_t> || std::is_same_v<T, double> || std::is_same_v<T, std::string>) {
+                    add(key, seastar::json::formatter::to_json(item));
+                } else {
+                    add_key(key);
+                    result << OPEN_ARRAY;
+
+                    bool nested_initial = true;
+                    for (const auto& nested : item) {
+                        if (!nested_initial) {
+                            result << ", ";
+                        }
+                        if constexpr (std::is_same_v<T, std::vector<std::string>>) {
+                            result << '"' << nested << "\"";
+                        } else {
+                            result << nested;
+                        }
+                        nested_initial = false;
+                    }
+
+                    result << CLOSE_ARRAY;
+                }
+            }, value);
+        }
+    }
+
     void add(seastar::json::json_base_element* element) {
         if (element == nullptr || !element->_set) {
             return;
@@ -298,20 +332,60 @@ public:
     }
 };
 
+struct aggregations_json : public json::jsonable {
+private:
+    Aggregations aggregations;
+
+public:
+    aggregations_json(const Aggregations &_aggregations) : aggregations(_aggregations) {}
+    aggregations_json() = default;
+
+    std::string to_json() const {
+        json_properties_builder groupsBuilder;
+        for (const auto& [group, aggregation] : aggregations) {
+            json_properties_builder valuesBuilder;
+            valuesBuilder.add("count", seastar::json::formatter::to_json(aggregation.count));
+            if (aggregation.numeric) {
+                valuesBuilder.add("sum", seastar::json::formatter::to_json(aggregation.sum));
+                valuesBuilder.add("min", seastar::json::formatter::to_json(aggregation.min));
+                valuesBuilder.add("max", seastar::json::formatter::to_json(aggregation.max));
+                valuesBuilder.add("avg", seastar::json::formatter::to_json(aggregation.average()));
+            }
+            groupsBuilder.add(group, valuesBuilder.as_json());
+        }
+        return groupsBuilder.as_json();
+    }
+};
+
+struct path_json : public json::jsonable {
+private:
+    Path path;
+
+public:
+    path_json(const Path &_path) : path(_path) {}
+    path_json() = default;
+
+    std::string to_json() const {
+        json_properties_builder pathBuilder;
+        pathBuilder.add("nodes", seastar::json::formatter::to_json(path.node_ids));
+        pathBuilder.add("relationships", seastar::json::formatter::to_json(path.rel_ids));
+        pathBuilder.add("weight", seastar::json::formatter::to_json(path.weight));
+        return pathBuilder.as_json();
+    }
+};
+
 struct properties_json : public json::jsonable {
 private:
-    std::map<std::string, std::any> properties;
+    PropertyRecord properties;
 
 public:
     properties_json(const std::map<std::string, std::any> &_properties) : properties(_properties) {}
+    properties_json(const PropertyRecord &_properties) : properties(_properties) {}
     properties_json() = default;
-    ~properties_json() {
-        properties.clear();
-    }
 
     std::string to_json() const {
         json_properties_builder jsonPropertiesBuilder;
-        jsonPropertiesBuilder.add_properties(properties);
+        jsonPropertiesBuilder.add_record(properties);
         return jsonPropertiesBuilder.as_json();
     }
 
@@ -373,7 +447,7 @@ public:
         this->type = r.getType();
         this->from = r.getStartingNodeId();
         this->to = r.getEndingNodeId();
-        this->properties = r.getProperties();
+        this->properties = r.getPropertyRecord();
     }
 
 };
@@ -408,7 +482,7 @@ struct node_json : public json::json_base {
         id = e.getId();
         type = e.getType();
         key = e.getKey();
-        properties = e.getProperties();
+        properties = e.getPropertyRecord();
         return *this;
     }
 
@@ -427,7 +501,7 @@ public:
         this->id = n.getId();
         this->type = n.getType();
         this->key = n.getKey();
-        this->properties = n.getProperties();
+        this->properties = n.getPropertyRecord();
     }
 
 };
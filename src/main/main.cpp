@@ -28,6 +28,10 @@
 #include "handlers/Schema.h"
 #include "handlers/Utilities.h"
 #include "handlers/Lua.h"
+#include "handlers/Bulk.h"
+#include "handlers/Aggregates.h"
+#include "handlers/Traversals.h"
+#include "handlers/Analytics.h"
 #include <seastar/http/httpd.hh>
 #include <seastar/http/function_handlers.hh>
 #include <seastar/net/inet_address.hh>
@@ -42,6 +46,11 @@ int main(int argc, char** argv) {
     //Options
     app.add_options()("address", bpo::value<seastar::sstring>()->default_value("0.0.0.0"), "HTTP Server address");
     app.add_options()("port", bpo::value<uint16_t>()->default_value(7243), "HTTP Server port");
+    app.add_options()("data-directory", bpo::value<std::string>()->default_value(""), "Directory for snapshots and write ahead logs, empty disables persistence");
+    app.add_options()("commit-window", bpo::value<uint32_t>()->default_value(1000), "Microseconds writes wait to be grouped into a single write ahead log flush");
+    app.add_options()("adjacency-merge-interval", bpo::value<uint32_t>()->default_value(0), "Seconds between merges of new links into frozen node types, 0 disables merging");
+    app.add_options()("compaction-interval", bpo::value<uint32_t>()->default_value(0), "Seconds between compactions of deleted nodes and relationships, 0 disables compaction");
+    app.add_options()("analytics-shares", bpo::value<uint32_t>()->default_value(100), "CPU shares of graph analytics jobs, requests get 1000");
 
     try {
         app.run(argc, argv, [&] {
@@ -63,6 +72,21 @@ int main(int argc, char** argv) {
 
                 ragedb::Graph graph("rage");
                 graph.Start().get();
+
+                // Warm restart from the last snapshot and the write ahead log written after it
+                std::string data_directory = config["data-directory"].as<std::string>();
+                if (!data_directory.empty()) {
+                    std::chrono::microseconds commit_window(config["commit-window"].as<uint32_t>());
+                    if (!graph.Recover(data_directory, commit_window).get0()) {
+                        graph.Stop().get();
+                        server->stop().get();
+                        throw std::runtime_error("Could not recover " + graph.GetName() + " from " + data_directory);
+                    }
+                    std::cout << "Recovered " << graph.GetName() << " from " << data_directory << "\n";
+                }
+                graph.AdjacencyMergeEvery(std::chrono::seconds(config["adjacency-merge-interval"].as<uint32_t>())).get();
+                graph.CompactEvery(std::chrono::seconds(config["compaction-interval"].as<uint32_t>())).get();
+                graph.AnalyticsShares(static_cast<float>(config["analytics-shares"].as<uint32_t>())).get();
                 HealthCheck healthCheck(graph);
                 Schema schema(graph);
                 Nodes nodes(graph);
@@ -72,6 +96,10 @@ int main(int argc, char** argv) {
                 Degrees degrees(graph);
                 Neighbors neighbors(graph);
                 Lua lua(graph);
+                Bulk bulk(graph);
+                Aggregates aggregates(graph);
+                Traversals traversals(graph);
+                Analytics analytics(graph);
 
                 server->set_routes([&healthCheck](routes& r) { healthCheck.set_routes(r); }).get();
                 server->set_routes([&schema](routes& r) { schema.set_routes(r); }).get();
@@ -82,6 +110,10 @@ int main(int argc, char** argv) {
                 server->set_routes([&degrees](routes& r) { degrees.set_routes(r); }).get();
                 server->set_routes([&neighbors](routes& r) { neighbors.set_routes(r); }).get();
                 server->set_routes([&lua](routes& r) { lua.set_routes(r); }).get();
+                server->set_routes([&bulk](routes& r) { bulk.set_routes(r); }).get();
+                server->set_routes([&aggregates](routes& r) { aggregates.set_routes(r); }).get();
+                server->set_routes([&traversals](routes& r) { traversals.set_routes(r); }).get();
+                server->set_routes([&analytics](routes& r) { analytics.set_routes(r); }).get();
 
                 server->set_routes([](seastar::routes& r) {
                     r.add(seastar::operation_type::GET,
@@ -94,9 +126,10 @@ int main(int argc, char** argv) {
                 server->listen(seastar::socket_address{addr, port}).get();
 
                 std::cout << "RageDB HTTP server listening on " << addr << ":" << port << " ...\n";
-                seastar::engine().at_exit([&server, &graph] {
+                seastar::engine().at_exit([&server, &graph, data_directory] {
                     std::cout << "Stopping RageDB HTTP server" << std::endl;
-                    return graph.Stop().then([&] () { return server->stop(); });
+                    seastar::future<bool> snapshot = data_directory.empty() ? seastar::make_ready_future<bool>(false) : graph.Snapshot(data_directory);
+                    return snapshot.discard_result().then([&] () { return graph.Stop(); }).then([&] () { return server->stop(); });
                 });
                 stop_signal.wait().get();  // this will wait till we receive SIGINT or SIGTERM signal
             });
@@ -0,0 +1,139 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <catch2/catch.hpp>
+#include <seastar/core/when_all.hh>
+#include "../src/graph/Batcher.h"
+
+using IntBatcher = ragedb::Batcher<int, int>;
+
+// Answers each request with ten times its value and remembers the batches it was sent
+static IntBatcher::Sender Recording(std::vector<std::pair<uint16_t, std::vector<int>>>& sent) {
+    return [&sent] (uint16_t their_shard, std::vector<int> requests) {
+        sent.emplace_back(their_shard, requests);
+        std::vector<int> results;
+        for (int request : requests) {
+            results.emplace_back(request * 10);
+        }
+        return seastar::make_ready_future<std::vector<int>>(std::move(results));
+    };
+}
+
+SCENARIO( "Batcher coalesces requests for the same shard", "[batcher]" ) {
+    GIVEN("A batcher on shard 0 of 4") {
+        std::vector<std::pair<uint16_t, std::vector<int>>> sent;
+        IntBatcher batcher(0, 4, Recording(sent));
+
+        WHEN("requests for other shards are added before yielding") {
+            std::vector<seastar::future<int>> futures;
+            futures.emplace_back(batcher.Add(1, 1));
+            futures.emplace_back(batcher.Add(2, 2));
+            futures.emplace_back(batcher.Add(1, 3));
+            futures.emplace_back(batcher.Add(1, 4));
+            std::vector<int> results = seastar::when_all_succeed(futures.begin(), futures.end()).get0();
+
+            THEN("each shard should get a single batch in the order the requests were added") {
+                REQUIRE(sent.size() == 2);
+                REQUIRE(sent[0].first == 1);
+                REQUIRE(sent[0].second == std::vector<int>({ 1, 3, 4 }));
+                REQUIRE(sent[1].first == 2);
+                REQUIRE(sent[1].second == std::vector<int>({ 2 }));
+            }
+
+            THEN("each request should get its own result back") {
+                REQUIRE(results == std::vector<int>({ 10, 20, 30, 40 }));
+            }
+        }
+
+        WHEN("requests for its own shard are added") {
+            seastar::future<int> first = batcher.Add(0, 5);
+            REQUIRE(sent.size() == 1);
+            seastar::future<int> second = batcher.Add(0, 6);
+
+            THEN("they should be sent on their own right away") {
+                REQUIRE(sent.size() == 2);
+                REQUIRE(first.get0() == 50);
+                REQUIRE(second.get0() == 60);
+            }
+        }
+
+        batcher.Close().get();
+    }
+}
+
+SCENARIO( "Batcher hands errors to every request of a batch", "[batcher]" ) {
+    GIVEN("A batcher whose sends fail for shard 1") {
+        std::vector<std::pair<uint16_t, std::vector<int>>> sent;
+        IntBatcher::Sender recording = Recording(sent);
+        IntBatcher batcher(0, 4, [&recording] (uint16_t their_shard, std::vector<int> requests) {
+            if (their_shard == 1) {
+                return seastar::make_exception_future<std::vector<int>>(std::runtime_error("unreachable"));
+            }
+            return recording(their_shard, std::move(requests));
+        });
+
+        WHEN("requests for shards 1 and 2 are added") {
+            seastar::future<int> first = batcher.Add(1, 1);
+            seastar::future<int> second = batcher.Add(1, 2);
+            seastar::future<int> third = batcher.Add(2, 3);
+
+            THEN("every request for shard 1 should fail and shard 2 should not") {
+                REQUIRE_THROWS_AS(first.get0(), std::runtime_error);
+                REQUIRE_THROWS_AS(second.get0(), std::runtime_error);
+                REQUIRE(third.get0() == 30);
+            }
+        }
+
+        WHEN("a send throws instead of returning a failed future") {
+            IntBatcher throwing(0, 4, [] (uint16_t, std::vector<int>) -> seastar::future<std::vector<int>> {
+                throw std::runtime_error("thrown");
+            });
+            seastar::future<int> first = throwing.Add(3, 1);
+
+            THEN("the request should fail with it") {
+                REQUIRE_THROWS_AS(first.get0(), std::runtime_error);
+            }
+            throwing.Close().get();
+        }
+
+        batcher.Close().get();
+    }
+}
+
+SCENARIO( "Batcher flushes queued requests when it is closed", "[batcher]" ) {
+    GIVEN("A batcher with requests waiting to be flushed") {
+        std::vector<std::pair<uint16_t, std::vector<int>>> sent;
+        IntBatcher batcher(0, 4, Recording(sent));
+        seastar::future<int> first = batcher.Add(1, 1);
+        seastar::future<int> second = batcher.Add(1, 2);
+
+        WHEN("it is closed") {
+            batcher.Close().get();
+
+            THEN("the queued requests should have been sent") {
+                REQUIRE(sent.size() == 1);
+                REQUIRE(first.get0() == 10);
+                REQUIRE(second.get0() == 20);
+            }
+
+            THEN("later requests should fail instead of waiting forever") {
+                REQUIRE_THROWS_AS(batcher.Add(1, 3).get0(), seastar::gate_closed_exception);
+                REQUIRE(sent.size() == 1);
+            }
+        }
+    }
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <catch2/catch.hpp>
+#include "../src/graph/Cursor.h"
+
+SCENARIO( "Cursors are opaque strings", "[cursor]" ) {
+    GIVEN("A cursor in the middle of a type on a shard") {
+        ragedb::Cursor cursor { 3, 7, 123456789, false };
+
+        THEN("it should be read back from its encoding") {
+            std::string text = cursor.encode();
+            ragedb::Cursor decoded;
+            REQUIRE(text.size() == 24);
+            REQUIRE(ragedb::Cursor::decode(text, decoded));
+            REQUIRE(decoded.shard_id == 3);
+            REQUIRE(decoded.type_id == 7);
+            REQUIRE(decoded.internal_id == 123456789);
+            REQUIRE(!decoded.done);
+        }
+
+        THEN("a finished cursor should encode as empty, which starts over") {
+            cursor.done = true;
+            ragedb::Cursor decoded { 1, 1, 1, true };
+            REQUIRE(cursor.encode().empty());
+            REQUIRE(ragedb::Cursor::decode("", decoded));
+            REQUIRE(decoded.shard_id == 0);
+            REQUIRE(decoded.type_id == 0);
+            REQUIRE(decoded.internal_id == 0);
+            REQUIRE(!decoded.done);
+        }
+
+        THEN("text it did not write should be refused") {
+            ragedb::Cursor decoded;
+            REQUIRE(!ragedb::Cursor::decode("not a cursor", decoded));
+            REQUIRE(!ragedb::Cursor::decode("00030007000000000000075bcd1g", decoded));
+            REQUIRE(!ragedb::Cursor::decode("0003000700000000075bcd1g", decoded));
+        }
+    }
+}
+
+SCENARIO( "Live ids are found by the rank of the deleted ones", "[cursor]" ) {
+    GIVEN("Ten slots where 0, 3, 4, 5 and 9 are deleted") {
+        Roaring64Map deleted;
+        deleted.add(0);
+        deleted.addRange(3, 6);
+        deleted.add(9);
+
+        THEN("the live id at a position should skip the deleted ones") {
+            REQUIRE(ragedb::LiveIdAt(deleted, 10, 0) == 1);
+            REQUIRE(ragedb::LiveIdAt(deleted, 10, 1) == 2);
+            REQUIRE(ragedb::LiveIdAt(deleted, 10, 2) == 6);
+            REQUIRE(ragedb::LiveIdAt(deleted, 10, 4) == 8);
+            REQUIRE(ragedb::LiveIdAt(deleted, 10, 5) == 10);
+            REQUIRE(ragedb::LiveIdAt(Roaring64Map(), 10, 4) == 4);
+        }
+
+        THEN("the live ids from an id on should leave the deleted ones out") {
+            REQUIRE(ragedb::LiveIds(deleted, 10, 0, 100) == std::vector<uint64_t>({ 1, 2, 6, 7, 8 }));
+            REQUIRE(ragedb::LiveIds(deleted, 10, 3, 2) == std::vector<uint64_t>({ 6, 7 }));
+            REQUIRE(ragedb::LiveIds(deleted, 10, 8, 100) == std::vector<uint64_t>({ 8 }));
+            REQUIRE(ragedb::LiveIds(deleted, 10, 10, 100).empty());
+        }
+    }
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch2/catch.hpp>
+#include "../src/graph/Kernels.h"
+
+SCENARIO( "Kernels can scan property columns", "[kernels]" ) {
+    GIVEN("An integer column with a few tombstones") {
+        const int64_t tombstone = std::numeric_limits<int64_t>::min();
+        std::vector<int64_t> column;
+        for (int64_t i = 0; i < 100; i++) {
+            column.emplace_back(i % 10 == 0 ? tombstone : i);
+        }
+
+        WHEN("it is compared to a value") {
+            std::vector<uint64_t> words = ragedb::MatchColumn(column, ragedb::Operation::GTE, int64_t(95), tombstone);
+
+            THEN("only the matching rows are selected") {
+                REQUIRE(words.size() == 2);
+                REQUIRE(ragedb::SelectRows(words) == std::vector<uint64_t>({ 95, 96, 97, 98, 99 }));
+                REQUIRE(ragedb::RowsToBitmap(words).cardinality() == 5);
+            }
+        }
+
+        WHEN("a range is asked for and deleted rows are masked") {
+            std::vector<uint64_t> words = ragedb::MatchColumnRange(column, int64_t(8), int64_t(12), tombstone);
+            Roaring64Map deleted;
+            deleted.add(11);
+            ragedb::MaskRows(words, deleted);
+
+            THEN("tombstones and deleted rows are left out") {
+                REQUIRE(ragedb::SelectRows(words) == std::vector<uint64_t>({ 8, 9, 12 }));
+            }
+        }
+
+        WHEN("it is aggregated") {
+            std::vector<uint64_t> present = ragedb::PresentInColumn(column, tombstone);
+            int64_t minimum = 0;
+            int64_t maximum = 0;
+
+            THEN("tombstones are left out") {
+                REQUIRE(ragedb::CountRows(present) == 90);
+                REQUIRE(ragedb::SumColumn(column, present) == 4950 - 450);
+                REQUIRE(ragedb::MinColumn(column, present, minimum));
+                REQUIRE(minimum == 1);
+                REQUIRE(ragedb::MaxColumn(column, present, maximum));
+                REQUIRE(maximum == 99);
+            }
+        }
+    }
+
+    GIVEN("An integer column with a validity bitmap") {
+        std::vector<int64_t> column = { 0, std::numeric_limits<int64_t>::min(), 7, 0, 9 };
+        std::vector<uint64_t> valid;
+        ragedb::SetRow(valid, 1);
+        ragedb::SetRow(valid, 2);
+        ragedb::SetRow(valid, 4);
+
+        WHEN("it is compared to a value") {
+            std::vector<uint64_t> zeros = ragedb::MatchColumn(column, ragedb::Operation::EQ, int64_t(0), valid);
+            std::vector<uint64_t> small = ragedb::MatchColumn(column, ragedb::Operation::LT, int64_t(8), valid);
+
+            THEN("only the valid rows can match, whatever value they hold") {
+                REQUIRE(ragedb::SelectRows(zeros).empty());
+                REQUIRE(ragedb::SelectRows(small) == std::vector<uint64_t>({ 1, 2 }));
+            }
+        }
+
+        WHEN("a row is cleared") {
+            ragedb::ClearRow(valid, 2);
+
+            THEN("it is no longer valid") {
+                REQUIRE(!ragedb::RowIsSet(valid, 2));
+                REQUIRE(ragedb::RowIsSet(valid, 4));
+                REQUIRE(!ragedb::RowIsSet(valid, 1000));
+            }
+        }
+    }
+
+    GIVEN("A double column") {
+        std::vector<double> column = { 0.5, 1.5, 2.5, 3.5, 4.5 };
+
+        WHEN("it is compared to a value") {
+            std::vector<uint64_t> words = ragedb::MatchColumn(column, ragedb::Operation::LT, 2.5, std::numeric_limits<double>::min());
+
+            THEN("only the matching rows are selected") {
+                REQUIRE(ragedb::SelectRows(words) == std::vector<uint64_t>({ 0, 1 }));
+            }
+        }
+    }
+}
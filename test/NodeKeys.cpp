@@ -0,0 +1,193 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <catch2/catch.hpp>
+#include "../src/graph/NodeKeys.h"
+
+SCENARIO( "Node keys are stored once and indexed", "[keys]" ) {
+    GIVEN("Node keys with a few keys") {
+        ragedb::NodeKeys keys;
+        keys.set(0, "max");
+        keys.set(1, "helene");
+        keys.set(2, "a somewhat longer key that does not fit in a small string");
+
+        THEN("each key should be found by its internal id and back") {
+            uint64_t internal_id = 99;
+            REQUIRE(keys.size() == 3);
+            REQUIRE(keys.find("helene", internal_id));
+            REQUIRE(internal_id == 1);
+            REQUIRE(keys.get(0) == "max");
+            REQUIRE(keys.get(2) == "a somewhat longer key that does not fit in a small string");
+            REQUIRE(!keys.find("missing", internal_id));
+            REQUIRE(keys.get(10).empty());
+        }
+
+        WHEN("a key is removed and its internal id is given a new key") {
+            keys.remove(1);
+            uint64_t internal_id = 99;
+            THEN("the old key should be gone") {
+                REQUIRE(keys.size() == 2);
+                REQUIRE(!keys.find("helene", internal_id));
+                REQUIRE(keys.get(1).empty());
+            }
+
+            keys.set(1, "tyler");
+            THEN("the new key should be found") {
+                REQUIRE(keys.size() == 3);
+                REQUIRE(keys.find("tyler", internal_id));
+                REQUIRE(internal_id == 1);
+            }
+        }
+
+        WHEN("the last keys are removed and the keys are compacted") {
+            keys.remove(2);
+            keys.remove(1);
+            keys.truncate(2);
+            REQUIRE(keys.compact(1024));
+            uint64_t internal_id = 99;
+            THEN("the internal ids past the count should be gone and the others kept") {
+                REQUIRE(keys.size() == 1);
+                REQUIRE(keys.slots() == 2);
+                REQUIRE(keys.get(0) == "max");
+                REQUIRE(keys.find("max", internal_id));
+                REQUIRE(internal_id == 0);
+                REQUIRE(!keys.find("helene", internal_id));
+                REQUIRE(keys.get(2).empty());
+            }
+
+            keys.set(2, "tyler");
+            THEN("the next internal id should follow the count") {
+                REQUIRE(keys.slots() == 3);
+                REQUIRE(keys.find("tyler", internal_id));
+                REQUIRE(internal_id == 2);
+            }
+        }
+
+        WHEN("an internal id past the next one is given a key") {
+            THEN("it should be refused") {
+                REQUIRE(!keys.set(5, "gap"));
+                REQUIRE(keys.size() == 3);
+            }
+        }
+
+        WHEN("the keys are written to a snapshot and read back") {
+            ragedb::SnapshotWriter writer;
+            keys.writeSnapshot(writer);
+            ragedb::NodeKeys restored;
+            ragedb::SnapshotReader reader(writer.data().data(), writer.data().size());
+            THEN("they should be found the same way") {
+                REQUIRE(restored.readSnapshot(reader));
+                REQUIRE(reader.done());
+                uint64_t internal_id = 99;
+                REQUIRE(restored.size() == 3);
+                REQUIRE(restored.find("max", internal_id));
+                REQUIRE(internal_id == 0);
+                REQUIRE(restored.get(1) == "helene");
+            }
+        }
+
+        WHEN("the keys are written to a snapshot") {
+            ragedb::SnapshotWriter writer;
+            keys.writeSnapshot(writer);
+            const std::string& bytes = writer.data();
+
+            THEN("the index should hold the FNV-1a hash of a key, which every build agrees on") {
+                uint64_t max_hash = 0x080f5119176d1ff9U;
+                std::string max_bytes(reinterpret_cast<const char*>(&max_hash), sizeof(max_hash));
+                REQUIRE(bytes.find(max_bytes) != std::string::npos);
+            }
+        }
+    }
+}
+
+SCENARIO( "Node keys pack their arena in steps", "[keys]" ) {
+    GIVEN("Node keys with thousands of keys, half of them removed") {
+        ragedb::NodeKeys keys;
+        for (uint64_t internal_id = 0; internal_id < 3000; internal_id++) {
+            keys.set(internal_id, "key" + std::to_string(internal_id));
+        }
+        for (uint64_t internal_id = 0; internal_id < 3000; internal_id += 2) {
+            keys.remove(internal_id);
+        }
+
+        WHEN("the keys are compacted") {
+            size_t steps = 1;
+            while (!keys.compact(1024)) {
+                steps++;
+            }
+
+            THEN("it should take a step for every so many keys and keep every live key") {
+                uint64_t internal_id = 0;
+                REQUIRE(steps == 3);
+                REQUIRE(keys.find("key2999", internal_id));
+                REQUIRE(internal_id == 2999);
+                REQUIRE(keys.get(1) == "key1");
+                REQUIRE(keys.get(2).empty());
+                REQUIRE(!keys.find("key2", internal_id));
+            }
+        }
+
+        WHEN("keys are given out between the steps") {
+            REQUIRE(!keys.compact(1024));
+            keys.set(0, "again");
+            keys.set(3000, "late");
+            keys.remove(5);
+            REQUIRE(!keys.compact(1024));
+            keys.set(2998, "later");
+            REQUIRE(keys.compact(1024));
+
+            THEN("every key should be found where it was given") {
+                uint64_t internal_id = 0;
+                REQUIRE(keys.get(0) == "again");
+                REQUIRE(keys.find("again", internal_id));
+                REQUIRE(internal_id == 0);
+                REQUIRE(keys.get(2998) == "later");
+                REQUIRE(keys.get(3000) == "late");
+                REQUIRE(keys.get(5).empty());
+                REQUIRE(keys.get(2999) == "key2999");
+                REQUIRE(keys.size() == 1502);
+            }
+        }
+
+        WHEN("the last keys are dropped while the keys are compacted") {
+            REQUIRE(!keys.compact(1024));
+            keys.remove(2999);
+            keys.truncate(2999);
+
+            THEN("the packing should start over") {
+                REQUIRE(!keys.compact(1024));
+                REQUIRE(!keys.compact(1024));
+                REQUIRE(keys.compact(1024));
+                REQUIRE(keys.get(2997) == "key2997");
+                REQUIRE(keys.slots() == 2999);
+            }
+        }
+    }
+
+    GIVEN("Node keys with only a few keys removed") {
+        ragedb::NodeKeys keys;
+        for (uint64_t internal_id = 0; internal_id < 3000; internal_id++) {
+            keys.set(internal_id, "key" + std::to_string(internal_id));
+        }
+        keys.remove(7);
+
+        THEN("compacting should leave the arena as it is in a single step") {
+            REQUIRE(keys.compact(1));
+            REQUIRE(keys.get(8) == "key8");
+        }
+    }
+}
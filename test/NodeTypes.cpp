@@ -0,0 +1,89 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <catch2/catch.hpp>
+#include "../src/graph/Shard.h"
+
+SCENARIO( "Node types keep the blocks their links are frozen into", "[node_types]" ) {
+    GIVEN("Freshly built node types with two linked nodes") {
+        ragedb::NodeTypes types;
+        REQUIRE(types.addTypeId("Node", 1));
+        for (int i = 0; i < 2; i++) {
+            types.getOutgoingRelationships(1).emplace_back();
+            types.getIncomingRelationships(1).emplace_back();
+            types.getOutgoingDegrees(1).emplace_back(0);
+            types.getIncomingDegrees(1).emplace_back(0);
+        }
+        types.addOutgoingLink(1, 0, 1, 2, 3);
+        types.addIncomingLink(1, 1, 1, 4, 5);
+
+        WHEN("the type is frozen") {
+            ragedb::FrozenLinks outgoing;
+            ragedb::FrozenLinks incoming;
+            REQUIRE(types.freezeNode(1, 0, outgoing, incoming) == 1);
+            REQUIRE(types.freezeNode(1, 1, outgoing, incoming) == 1);
+            REQUIRE(types.setFrozenLinks(1, std::move(outgoing), std::move(incoming)));
+
+            THEN("the links should read from the blocks the type kept") {
+                REQUIRE(types.isFrozen(1));
+                const ragedb::Links& links = types.getOutgoingRelationships(1)[0][0].links;
+                REQUIRE(links.size() == 1);
+                REQUIRE(links.begin()->node_id == 2);
+                REQUIRE(links.begin()->rel_id == 3);
+                REQUIRE(types.getIncomingRelationships(1)[1][0].links.begin()->rel_id == 5);
+            }
+        }
+
+        WHEN("the type is cleared before the freeze finishes") {
+            ragedb::FrozenLinks outgoing;
+            ragedb::FrozenLinks incoming;
+            types.freezeNode(1, 0, outgoing, incoming);
+            types.Clear();
+
+            THEN("the blocks should be refused") {
+                REQUIRE_FALSE(types.setFrozenLinks(1, std::move(outgoing), std::move(incoming)));
+                REQUIRE_FALSE(types.isFrozen(1));
+            }
+        }
+    }
+}
+
+SCENARIO( "Node types added by name have room for every node", "[node_types]" ) {
+    GIVEN("Freshly built node types") {
+        ragedb::NodeTypes types;
+
+        WHEN("a type is added by name and a node is added to it") {
+            uint16_t type_id = types.insertOrGetTypeId("Node");
+            types.getKeys(type_id).set(0, "one");
+            types.getOutgoingRelationships(type_id).emplace_back();
+            types.getIncomingRelationships(type_id).emplace_back();
+            types.getOutgoingDegrees(type_id).emplace_back(0);
+            types.getIncomingDegrees(type_id).emplace_back(0);
+            types.addId(type_id, 0);
+            types.addOutgoingLink(type_id, 0, 1, 2, 3);
+
+            THEN("the node should have its own degrees") {
+                REQUIRE(type_id == 1);
+                REQUIRE(types.insertOrGetTypeId("Node") == type_id);
+                REQUIRE(types.getOutgoingDegrees(type_id).size() == 1);
+                REQUIRE(types.getDegree(type_id, 0, Direction::OUT) == 1);
+                REQUIRE(types.getDegree(type_id, 0, Direction::IN) == 0);
+                REQUIRE(types.getNodeId(type_id, "one") == 1024);
+            }
+        }
+    }
+}
@@ -52,4 +52,172 @@ SCENARIO( "Properties can be added", "[properties]" ) {
             }
         }
     }
-}
\ No newline at end of file
+}
+SCENARIO( "Properties can be read as a record", "[properties]" ) {
+    GIVEN("Properties of a few types") {
+        ragedb::Properties properties;
+        properties.setPropertyType("valid", "boolean");
+        properties.setPropertyType("number", "integer");
+        properties.setPropertyType("name", "string");
+        properties.setPropertyType("scores", "double_list");
+
+        properties.setBooleanProperty("valid", 1, true);
+        properties.setIntegerProperty("number", 1, 123);
+        properties.setStringProperty("name", 1, "max");
+        properties.setListOfDoubleProperty("scores", 1, { 1.5, 2.5 });
+
+        WHEN("the record of item 1 is read") {
+            ragedb::PropertyRecord record = properties.getPropertyRecord(1);
+
+            THEN("it should have every property sorted by key") {
+                REQUIRE(record.size() == 4);
+                std::vector<std::string> keys;
+                for (const auto& [key, value] : record) {
+                    keys.emplace_back(key);
+                }
+                REQUIRE(keys == std::vector<std::string>({ "name", "number", "scores", "valid" }));
+                REQUIRE(std::get<bool>(*record.find("valid")) == true);
+                REQUIRE(std::get<int64_t>(*record.find("number")) == 123);
+                REQUIRE(std::get<std::string>(*record.find("name")) == "max");
+                REQUIRE(std::get<std::vector<double>>(*record.find("scores")) == std::vector<double>({ 1.5, 2.5 }));
+                REQUIRE(record.find("missing") == nullptr);
+            }
+
+            THEN("it should convert to the same map as getProperties") {
+                std::map<std::string, std::any> map = record.toMap();
+                REQUIRE(map.size() == properties.getProperties(1).size());
+                REQUIRE(std::any_cast<bool>(map["valid"]) == true);
+                REQUIRE(std::any_cast<int64_t>(map["number"]) == 123);
+                REQUIRE(ragedb::PropertyRecord(map).size() == 4);
+            }
+        }
+
+        WHEN("the record of an item past the end of the columns is read") {
+            THEN("it should be empty") {
+                REQUIRE(properties.getPropertyRecord(100).empty());
+            }
+        }
+    }
+}
+
+SCENARIO( "Properties can be used by property id", "[properties]" ) {
+    GIVEN("Properties with a few keys") {
+        ragedb::Properties properties;
+        properties.setPropertyType("valid", "boolean");
+        properties.setPropertyType("number", "integer");
+        uint16_t valid = properties.getPropertyId("valid");
+        uint16_t number = properties.getPropertyId("number");
+
+        THEN("each key should have its own id") {
+            REQUIRE(valid > 0);
+            REQUIRE(number > 0);
+            REQUIRE(valid != number);
+            REQUIRE(properties.getPropertyKey(number) == "number");
+            REQUIRE(properties.getPropertyId("missing") == 0);
+        }
+
+        WHEN("a property is set by id") {
+            REQUIRE(properties.setIntegerProperty(number, 3, 42));
+            THEN("it should be read back by id and by key") {
+                REQUIRE(properties.getIntegerProperty(number, 3) == 42);
+                REQUIRE(properties.getIntegerProperty("number", 3) == 42);
+            }
+            THEN("it should not be set as another type") {
+                REQUIRE(!properties.setBooleanProperty(number, 3, true));
+                REQUIRE(!properties.setIntegerProperty(valid, 3, 42));
+            }
+        }
+
+        WHEN("a property is removed and added back with another type") {
+            properties.setIntegerProperty(number, 1, 7);
+            properties.removePropertyType("number");
+            properties.setPropertyType("number", "string");
+            THEN("it should get a new id and an empty column") {
+                REQUIRE(properties.getPropertyId("number") != number);
+                REQUIRE(!properties.setIntegerProperty(number, 1, 7));
+                REQUIRE(properties.getStringProperty("number", 1).empty());
+                REQUIRE(properties.getPropertyTypes().at("number") == "string");
+            }
+        }
+    }
+}
+
+SCENARIO( "Properties track which rows hold a value", "[properties]" ) {
+    GIVEN("Properties with an integer and a boolean column") {
+        ragedb::Properties properties;
+        properties.setPropertyType("number", "integer");
+        properties.setPropertyType("valid", "boolean");
+
+        properties.setIntegerProperty("number", 0, 0);
+        properties.setIntegerProperty("number", 2, std::numeric_limits<int64_t>::min());
+        properties.setBooleanProperty("valid", 2, false);
+
+        WHEN("a row in between was never set") {
+            THEN("it should not be found or read as a value") {
+                REQUIRE(properties.findIds("number", ragedb::Operation::EQ, int64_t(0)).cardinality() == 1);
+                REQUIRE(properties.getPropertyRecord(1).empty());
+                double value;
+                REQUIRE(!properties.getNumericProperty("number", 1, value));
+            }
+        }
+
+        WHEN("the tombstone value is stored") {
+            THEN("it should be a value like any other") {
+                REQUIRE(properties.findIds("number", ragedb::Operation::EQ, std::numeric_limits<int64_t>::min()).contains(uint64_t(2)));
+                double value;
+                REQUIRE(properties.getNumericProperty("number", 2, value));
+                REQUIRE(properties.getPropertyRecord(2).size() == 2);
+            }
+        }
+
+        WHEN("a property is deleted") {
+            properties.deleteProperty("number", 0);
+            THEN("the row should no longer hold a value") {
+                REQUIRE(properties.findIds("number", ragedb::Operation::EQ, int64_t(0)).isEmpty());
+                REQUIRE(properties.getPropertyRecord(0).empty());
+            }
+        }
+
+        WHEN("a false boolean is stored") {
+            THEN("only the row that was set should hold it") {
+                REQUIRE(properties.findIds("valid", ragedb::Operation::EQ, false).cardinality() == 1);
+                REQUIRE(properties.getPropertyRecord(2).find("valid") != nullptr);
+            }
+        }
+    }
+}
+
+SCENARIO( "Properties filter and group string columns by dictionary code", "[properties]" ) {
+    GIVEN("Properties with a low cardinality string column") {
+        ragedb::Properties properties;
+        properties.setPropertyType("status", "string");
+        properties.setPropertyType("amount", "integer");
+        properties.setStringProperty("status", 0, "open");
+        properties.setStringProperty("status", 1, "closed");
+        properties.setStringProperty("status", 3, "open");
+        for (uint64_t row = 0; row < 4; row++) {
+            properties.setIntegerProperty("amount", row, int64_t(row + 1));
+        }
+
+        WHEN("the column is filtered by equality") {
+            THEN("it should find the rows holding the value") {
+                REQUIRE(properties.findIds("status", ragedb::Operation::EQ, std::string("open")).cardinality() == 2);
+                REQUIRE(properties.findIds("status", ragedb::Operation::NEQ, std::string("open")).cardinality() == 1);
+                REQUIRE(properties.findIds("status", ragedb::Operation::EQ, std::string("missing")).isEmpty());
+                REQUIRE(properties.findIds("status", ragedb::Operation::NEQ, std::string("missing")).cardinality() == 3);
+            }
+        }
+
+        WHEN("another column is grouped by it") {
+            Roaring64Map rows;
+            rows.addRange(0, 4);
+            ragedb::Aggregations aggregations = properties.aggregate("amount", "status", rows);
+            THEN("each value should be a group and rows without a value should be in the empty group") {
+                REQUIRE(aggregations.size() == 3);
+                REQUIRE(aggregations["open"].sum == 5);
+                REQUIRE(aggregations["closed"].sum == 2);
+                REQUIRE(aggregations[""].count == 1);
+            }
+        }
+    }
+}
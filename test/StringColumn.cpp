@@ -0,0 +1,118 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <catch2/catch.hpp>
+#include "../src/graph/StringColumn.h"
+
+SCENARIO( "String columns are dictionary encoded", "[properties]" ) {
+    GIVEN("A column with a few distinct values") {
+        ragedb::StringColumn column;
+        column.resize(4);
+        column.set(0, "red");
+        column.set(1, "blue");
+        column.set(3, "red");
+
+        THEN("it should be encoded and read back every value") {
+            REQUIRE(column.isEncoded());
+            REQUIRE(column.size() == 4);
+            REQUIRE(column[0] == "red");
+            REQUIRE(column[1] == "blue");
+            REQUIRE(column[2].empty());
+            REQUIRE(column[3] == "red");
+            REQUIRE(column.getDictionary().size() == 3);
+            REQUIRE(column.getCodes()[0] == column.getCodes()[3]);
+        }
+
+        WHEN("the last row is cut off and the column is compacted") {
+            column.resize(3);
+            column.compact();
+
+            THEN("values no row holds should leave the dictionary") {
+                REQUIRE(column.size() == 3);
+                REQUIRE(column[0] == "red");
+                REQUIRE(column[1] == "blue");
+                REQUIRE(column.getDictionary().size() == 3);
+                column.resize(1);
+                column.compact();
+                uint32_t code = 0;
+                REQUIRE(!column.findCode("blue", code));
+                REQUIRE(column[0] == "red");
+            }
+
+            THEN("the code of a value that left the dictionary should be handed out again") {
+                column.resize(1);
+                column.compact();
+                column.set(0, "green");
+                REQUIRE(column.getDictionary().size() == 3);
+                REQUIRE(column[0] == "green");
+                uint32_t code = 0;
+                REQUIRE(column.findCode("green", code));
+                REQUIRE(code == 2);
+            }
+        }
+
+        WHEN("a value is overwritten but most of the dictionary is still held") {
+            column.resize(8);
+            for (size_t row = 4; row < 8; row++) {
+                column.set(row, "color" + std::to_string(row));
+            }
+            column.set(1, "red");
+            column.compact();
+
+            THEN("the dictionary should be left as it is") {
+                uint32_t code = 0;
+                REQUIRE(column.getDictionary().size() == 7);
+                REQUIRE(column.findCode("blue", code));
+                REQUIRE(column[1] == "red");
+            }
+        }
+
+        THEN("it should find the codes of stored values only") {
+            uint32_t code = 0;
+            REQUIRE(column.findCode("blue", code));
+            REQUIRE(column.getDictionary()[code] == "blue");
+            REQUIRE(!column.findCode("green", code));
+        }
+    }
+
+    GIVEN("A column where every row holds a different value") {
+        ragedb::StringColumn column;
+        column.resize(3000);
+        for (size_t row = 0; row < 3000; row++) {
+            column.set(row, "value" + std::to_string(row));
+        }
+
+        THEN("it should fall back to plain strings") {
+            REQUIRE(!column.isEncoded());
+            REQUIRE(column.size() == 3000);
+            REQUIRE(column[0] == "value0");
+            REQUIRE(column[2999] == "value2999");
+        }
+    }
+
+    GIVEN("A list of strings with a few distinct values") {
+        std::vector<std::string> values(3000, "red");
+        values[7] = "blue";
+        ragedb::StringColumn column(values);
+
+        THEN("it should be encoded") {
+            REQUIRE(column.isEncoded());
+            REQUIRE(column[7] == "blue");
+            REQUIRE(column[8] == "red");
+        }
+    }
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch2/catch.hpp>
+#include <seastar/core/sharded.hh>
+#include "../../src/graph/Shard.h"
+
+SCENARIO( "Shards refuse batches of relationships with unequal ends", "[relationship]" ) {
+    GIVEN("A single shard with two nodes") {
+        seastar::sharded<ragedb::Shard> shards;
+        shards.start(1).get();
+        ragedb::Shard& shard = shards.local();
+        shard.NodeTypeInsert("Node", 1);
+        uint64_t one = shard.NodeAddEmpty(1, "one");
+        uint64_t two = shard.NodeAddEmpty(1, "two");
+
+        WHEN("a batch has more starting nodes than ending nodes") {
+            std::vector<uint64_t> added = shard.RelationshipsAddPeered("KNOWS", {one, two, one}, {two}, {}).get0();
+
+            THEN("nothing should be added and the relationship type should not be created") {
+                REQUIRE(added.empty());
+                REQUIRE(shard.RelationshipTypesGetCount() == 0);
+                REQUIRE(shard.NodeGetDegree(one) == 0);
+            }
+        }
+
+        WHEN("a batch of an existing type has more ending nodes than starting nodes") {
+            shard.RelationshipTypeInsert("KNOWS", 1);
+            std::vector<uint64_t> added = shard.RelationshipsAddPeered(1, {one}, {two, one}, {}).get0();
+
+            THEN("nothing should be added") {
+                REQUIRE(added.empty());
+                REQUIRE(shard.NodeGetDegree(one) == 0);
+                REQUIRE(shard.NodeGetDegree(two) == 0);
+            }
+        }
+
+        shard.StopBatching().get();
+        shards.stop().get();
+    }
+}
@@ -0,0 +1,34 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#define CATCH_CONFIG_RUNNER // The tests supply their own main so they can run inside a reactor
+
+#include <catch2/catch.hpp>
+#include <seastar/core/app-template.hh>
+#include <seastar/core/thread.hh>
+
+// Runs the tests in a seastar thread on a single core, so they can wait on futures with get
+int main(int argc, char* argv[]) {
+    seastar::app_template app;
+    char smp[] = "--smp=1";
+    char* reactor_argv[] = { argv[0], smp };
+    return app.run(2, reactor_argv, [argc, argv] {
+        return seastar::async([argc, argv] {
+            return Catch::Session().run(argc, argv);
+        });
+    });
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch2/catch.hpp>
+#include "../../src/graph/Shard.h"
+
+SCENARIO( "Shard can freeze the adjacency of a Node Type", "[adjacency]" ) {
+
+    GIVEN( "A shard with nodes and relationships" ) {
+        ragedb::Shard shard(4);
+        shard.NodeTypeInsert("Node", 1);
+        shard.RelationshipTypeInsert("FRIENDS", 1);
+        shard.RelationshipTypeInsert("ENEMIES", 2);
+        uint64_t one = shard.NodeAddEmpty(1,  "one");
+        uint64_t two = shard.NodeAddEmpty(1,  "two");
+        uint64_t three = shard.NodeAddEmpty(1,  "three");
+
+        shard.RelationshipAddEmptySameShard(2, one, two);
+        uint64_t friends = shard.RelationshipAddEmptySameShard(1, one, three);
+        shard.RelationshipAddEmptySameShard(1, two, one);
+
+        WHEN( "the node type is frozen" ) {
+            uint64_t packed = shard.NodeTypeFreeze("Node");
+
+            THEN( "every link is packed and reads the same" ) {
+                REQUIRE(packed == 6);
+                REQUIRE(shard.NodeGetDegree(one) == 3);
+                REQUIRE(shard.NodeGetDegree(one, Direction::OUT) == 2);
+                REQUIRE(shard.NodeGetDegree(one, Direction::IN) == 1);
+                std::vector<Link> links = shard.NodeGetRelationshipsIDs(one, Direction::OUT, "FRIENDS");
+                REQUIRE(links.size() == 1);
+                REQUIRE(links[0].node_id == three);
+                REQUIRE(links[0].rel_id == friends);
+            }
+
+            AND_WHEN( "relationships are added and removed afterwards" ) {
+                shard.RelationshipAddEmptySameShard(1, one, two);
+                shard.RelationshipRemoveGetIncoming(friends);
+                shard.RelationshipRemoveIncoming(1, friends, three);
+
+                THEN( "the changes are seen before and after merging them" ) {
+                    REQUIRE(shard.NodeGetDegree(one, Direction::OUT) == 2);
+                    REQUIRE(shard.NodeGetDegree(three, Direction::IN) == 0);
+                    REQUIRE(shard.NodeTypeFreeze("Node") == 6);
+                    std::vector<Link> links = shard.NodeGetRelationshipsIDs(one, Direction::OUT, "FRIENDS");
+                    REQUIRE(links.size() == 1);
+                    REQUIRE(links[0].node_id == two);
+                }
+            }
+        }
+
+        WHEN( "an invalid node type is frozen" ) {
+            THEN( "nothing is packed" ) {
+                REQUIRE(shard.NodeTypeFreeze("Nothing") == 0);
+                REQUIRE(shard.NodeTypeFreeze(99) == 0);
+            }
+        }
+    }
+}
+
+SCENARIO( "Shard can check if a relationship exists", "[adjacency]" ) {
+
+    GIVEN( "A shard with a node linked to many others" ) {
+        ragedb::Shard shard(4);
+        shard.NodeTypeInsert("Node", 1);
+        shard.RelationshipTypeInsert("FOLLOWS", 1);
+        uint64_t hub = shard.NodeAddEmpty(1, "hub");
+        std::vector<uint64_t> followed;
+        for (int i = 0; i < 100; i++) {
+            uint64_t id = shard.NodeAddEmpty(1, "node" + std::to_string(i));
+            followed.emplace_back(id);
+            shard.RelationshipAddEmptySameShard(1, hub, id);
+        }
+
+        THEN( "the relationships to each node are found" ) {
+            REQUIRE(shard.RelationshipExists(hub, followed[0], "FOLLOWS"));
+            REQUIRE(shard.RelationshipExists(hub, followed[99], "FOLLOWS"));
+            REQUIRE(!shard.RelationshipExists(followed[0], hub, "FOLLOWS"));
+            REQUIRE(!shard.RelationshipExists(hub, followed[0], "LIKES"));
+            REQUIRE(!shard.RelationshipExists(99, followed[0], "FOLLOWS"));
+        }
+
+        WHEN( "a followed node is removed" ) {
+            shard.NodeRemove(followed[50]);
+
+            THEN( "the relationship to it is gone" ) {
+                REQUIRE(!shard.RelationshipExists(hub, followed[50], "FOLLOWS"));
+                REQUIRE(shard.RelationshipExists(hub, followed[51], "FOLLOWS"));
+                REQUIRE(shard.NodeGetDegree(hub, Direction::OUT) == 99);
+            }
+        }
+    }
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch2/catch.hpp>
+#include "../../src/graph/Shard.h"
+
+SCENARIO( "Shard can aggregate node properties", "[aggregate]" ) {
+
+    GIVEN( "A shard with a few orders" ) {
+        ragedb::Shard shard(4);
+        shard.NodeTypeInsert("Order", 1);
+        shard.NodePropertyTypeAdd(1, "value", 3);
+        shard.NodePropertyTypeAdd(1, "country", 4);
+        shard.NodeAdd(1, "one", R"({ "value":10.0, "country":"us" })");
+        shard.NodeAdd(1, "two", R"({ "value":30.0, "country":"us" })");
+        uint64_t three = shard.NodeAdd(1, "three", R"({ "value":5.0, "country":"fr" })");
+        shard.NodeAdd(1, "four", R"({ "country":"fr" })");
+
+        WHEN( "the value is aggregated" ) {
+            ragedb::Aggregations aggregations = shard.AggregateNodes("Order", "value", "", {});
+
+            THEN( "the nodes without a value are left out" ) {
+                REQUIRE( aggregations.size() == 1 );
+                REQUIRE( aggregations[""].count == 3 );
+                REQUIRE( aggregations[""].sum == 45.0 );
+                REQUIRE( aggregations[""].min == 5.0 );
+                REQUIRE( aggregations[""].max == 30.0 );
+                REQUIRE( aggregations[""].average() == 15.0 );
+            }
+        }
+
+        WHEN( "the value is aggregated by country" ) {
+            shard.NodeRemove(three);
+            ragedb::Aggregations aggregations = shard.AggregateNodes("Order", "value", "country", {});
+            ragedb::Aggregations counts = shard.AggregateNodes("Order", "", "country", {});
+
+            THEN( "each country gets its own aggregation" ) {
+                REQUIRE( aggregations.size() == 2 );
+                REQUIRE( aggregations["us"].average() == 20.0 );
+                REQUIRE( aggregations["fr"].count == 0 );
+                REQUIRE( counts["fr"].count == 1 );
+                REQUIRE( counts["us"].count == 2 );
+            }
+        }
+
+        WHEN( "the value is aggregated with a condition" ) {
+            ragedb::Aggregations aggregations = shard.AggregateNodes("Order", "value", "", { { "country", ragedb::Operation::EQ, std::any(std::string("us")) } });
+
+            THEN( "only the matching nodes are aggregated" ) {
+                REQUIRE( aggregations[""].count == 2 );
+                REQUIRE( aggregations[""].sum == 40.0 );
+            }
+        }
+    }
+}
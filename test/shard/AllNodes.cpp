@@ -132,5 +132,49 @@ SCENARIO( "Shard can handle All Nodes", "[node]" ) {
                 REQUIRE(it2.size() == 3);
             }
         }
+
+        WHEN( "a node is removed and the nodes are paged through with a cursor" ) {
+            shard.NodeAddEmpty(2, "one");
+            shard.NodeAddEmpty(2, "two");
+            shard.NodeRemove(three);
+
+            THEN( "each page should pick up where the last one stopped and skip the removed node" ) {
+                ragedb::Page<ragedb::Node> page = shard.AllNodes(ragedb::Cursor(), 3);
+                REQUIRE(page.results.size() == 3);
+                REQUIRE(page.results[0].getId() == empty);
+                REQUIRE(page.results[2].getId() == four);
+                REQUIRE(page.next.type_id == 1);
+
+                page = shard.AllNodes(page.next, 3);
+                REQUIRE(page.results.size() == 3);
+                REQUIRE(page.results[0].getId() == five);
+                REQUIRE(page.results[2].getKey() == "one");
+                REQUIRE(page.next.type_id == 2);
+
+                page = shard.AllNodes(page.next, 3);
+                REQUIRE(page.results.size() == 1);
+                REQUIRE(page.results[0].getKey() == "two");
+                REQUIRE(page.next.shard_id == 1);
+                REQUIRE(page.next.internal_id == 0);
+            }
+
+            THEN( "a page of one type should not run into the next type" ) {
+                ragedb::Page<ragedb::Node> page = shard.AllNodes(1, ragedb::Cursor(), 10);
+                REQUIRE(page.results.size() == 5);
+                REQUIRE(page.next.shard_id == 1);
+                REQUIRE(page.next.type_id == 1);
+            }
+
+            THEN( "a page of no nodes should finish the paging instead of handing back the same cursor" ) {
+                ragedb::Page<ragedb::Node> page = shard.AllNodes(ragedb::Cursor(), 0);
+                REQUIRE(page.results.empty());
+                REQUIRE(page.next.done);
+                REQUIRE(page.next.encode().empty());
+
+                page = shard.AllNodes(1, ragedb::Cursor(), 0);
+                REQUIRE(page.results.empty());
+                REQUIRE(page.next.done);
+            }
+        }
     }
 }
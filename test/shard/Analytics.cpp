@@ -0,0 +1,100 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <catch2/catch.hpp>
+#include "../../src/graph/Shard.h"
+
+// Run the supersteps of a job the way AnalyticsPeered does, on a single shard
+static uint64_t Run(ragedb::Shard &shard, ragedb::Algorithm algorithm, const ragedb::Hop &hop, const std::string &property, uint64_t max_steps) {
+    uint64_t nodes = shard.AnalyticsStart(1, algorithm, hop, 0.85);
+    ragedb::AnalyticsStep step = shard.AnalyticsInitialize(1, nodes);
+    for (uint64_t i = 0; i < max_steps; i++) {
+        std::vector<ragedb::AnalyticsMessages> messages;
+        for (auto& [their_shard, shard_messages] : shard.AnalyticsSend(1)) {
+            messages.emplace_back(shard_messages);
+        }
+        step = shard.AnalyticsReceive(1, messages, step.dangling);
+        if (step.changed == 0) {
+            break;
+        }
+    }
+    return shard.AnalyticsWrite(1, property);
+}
+
+SCENARIO( "Shard can run graph analytics", "[analytics]" ) {
+
+    GIVEN( "A shard with a triangle of friends and a separate pair" ) {
+        ragedb::Shard shard(4);
+        shard.NodeTypeInsert("User", 1);
+        shard.RelationshipTypeInsert("FRIENDS", 1);
+        uint64_t a = shard.NodeAddEmpty(1, "a");
+        uint64_t b = shard.NodeAddEmpty(1, "b");
+        uint64_t c = shard.NodeAddEmpty(1, "c");
+        uint64_t d = shard.NodeAddEmpty(1, "d");
+        uint64_t e = shard.NodeAddEmpty(1, "e");
+        shard.RelationshipAddEmptySameShard(1, a, b);
+        shard.RelationshipAddEmptySameShard(1, b, c);
+        shard.RelationshipAddEmptySameShard(1, c, a);
+        shard.RelationshipAddEmptySameShard(1, d, e);
+        ragedb::Hop both;
+
+        WHEN( "connected components are found" ) {
+            shard.NodePropertyTypeAdd(1, "component", 2);
+            uint64_t written = Run(shard, ragedb::Algorithm::ConnectedComponents, both, "component", 10);
+
+            THEN( "each node gets the smallest id of its component" ) {
+                REQUIRE( written == 5 );
+                REQUIRE( std::any_cast<int64_t>(shard.NodePropertyGet(b, "component")) == static_cast<int64_t>(a) );
+                REQUIRE( std::any_cast<int64_t>(shard.NodePropertyGet(c, "component")) == static_cast<int64_t>(a) );
+                REQUIRE( std::any_cast<int64_t>(shard.NodePropertyGet(e, "component")) == static_cast<int64_t>(d) );
+            }
+        }
+
+        WHEN( "triangles and clustering coefficients are counted" ) {
+            shard.NodePropertyTypeAdd(1, "triangles", 2);
+            shard.NodePropertyTypeAdd(1, "clustering", 3);
+            Run(shard, ragedb::Algorithm::TriangleCount, both, "triangles", 2);
+            Run(shard, ragedb::Algorithm::ClusteringCoefficient, both, "clustering", 2);
+
+            THEN( "every corner of the triangle is in one and fully clustered" ) {
+                REQUIRE( std::any_cast<int64_t>(shard.NodePropertyGet(a, "triangles")) == 1 );
+                REQUIRE( std::any_cast<int64_t>(shard.NodePropertyGet(b, "triangles")) == 1 );
+                REQUIRE( std::any_cast<int64_t>(shard.NodePropertyGet(c, "triangles")) == 1 );
+                REQUIRE( std::any_cast<int64_t>(shard.NodePropertyGet(d, "triangles")) == 0 );
+                REQUIRE( std::any_cast<double>(shard.NodePropertyGet(a, "clustering")) == 1.0 );
+                REQUIRE( std::any_cast<double>(shard.NodePropertyGet(e, "clustering")) == 0.0 );
+            }
+        }
+
+        WHEN( "pagerank follows outgoing relationships" ) {
+            shard.NodePropertyTypeAdd(1, "rank", 3);
+            ragedb::Hop out;
+            out.direction = OUT;
+            Run(shard, ragedb::Algorithm::PageRank, out, "rank", 50);
+            double rank_a = std::any_cast<double>(shard.NodePropertyGet(a, "rank"));
+            double rank_d = std::any_cast<double>(shard.NodePropertyGet(d, "rank"));
+            double rank_e = std::any_cast<double>(shard.NodePropertyGet(e, "rank"));
+
+            THEN( "the ranks add up to one and the cycle shares its rank evenly" ) {
+                REQUIRE( rank_a == Approx(std::any_cast<double>(shard.NodePropertyGet(b, "rank"))) );
+                REQUIRE( rank_a == Approx(std::any_cast<double>(shard.NodePropertyGet(c, "rank"))) );
+                REQUIRE( rank_e > rank_d );
+                REQUIRE( 3 * rank_a + rank_d + rank_e == Approx(1.0) );
+            }
+        }
+    }
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <catch2/catch.hpp>
+#include "../../src/graph/Shard.h"
+
+SCENARIO( "Shard can compact deleted nodes and relationships", "[compaction]" ) {
+
+    GIVEN( "A shard with nodes and relationships" ) {
+        ragedb::Shard shard(4);
+        shard.NodeTypeInsert("Node", 1);
+        shard.NodePropertyTypeAdd(1, "name", 4);
+        shard.RelationshipTypeInsert("FRIENDS", 1);
+        uint64_t one = shard.NodeAdd(1, "one", R"({ "name":"max" })");
+        uint64_t two = shard.NodeAddEmpty(1, "two");
+        uint64_t three = shard.NodeAdd(1, "three", R"({ "name":"helene" })");
+        uint64_t four = shard.NodeAdd(1, "four", R"({ "name":"tyler" })");
+
+        uint64_t first = shard.RelationshipAddEmptySameShard(1, one, three);
+        uint64_t second = shard.RelationshipAddEmptySameShard(1, three, one);
+
+        WHEN( "a node in the middle and the last node are removed and the shard is compacted" ) {
+            shard.NodeRemove(two);
+            shard.NodeRemove(four);
+            uint64_t dropped = shard.Compact();
+
+            THEN( "only the deleted id at the end is dropped and the others keep their ids" ) {
+                REQUIRE(dropped == 1);
+                REQUIRE(shard.NodeTypesGetCount(1) == 2);
+                REQUIRE(shard.ValidNodeId(three));
+                REQUIRE(!shard.ValidNodeId(four));
+                REQUIRE(shard.NodeGetID("Node", "three") == three);
+                REQUIRE(std::any_cast<std::string>(shard.NodePropertyGet(three, "name")) == "helene");
+                REQUIRE(shard.NodeGetDegree(one) == 2);
+            }
+
+            AND_WHEN( "nodes are added again" ) {
+                uint64_t five = shard.NodeAddEmpty(1, "five");
+                uint64_t six = shard.NodeAddEmpty(1, "six");
+
+                THEN( "they get the same ids they would have without the compaction" ) {
+                    REQUIRE(five == two);
+                    REQUIRE(six == four);
+                    REQUIRE(shard.NodeTypesGetCount(1) == 4);
+                    REQUIRE(std::any_cast<std::string>(shard.NodePropertyGet(six, "name")).empty());
+                }
+            }
+        }
+
+        WHEN( "the last node is removed and a node is added while the compaction gives way" ) {
+            shard.NodeRemove(four);
+            uint64_t five = 0;
+            shard.Compact([&shard, &five] {
+                if (five == 0) {
+                    five = shard.NodeAdd(1, "five", R"({ "name":"alice" })");
+                }
+            });
+
+            THEN( "the new node takes the dropped id and keeps its key and properties" ) {
+                REQUIRE(five == four);
+                REQUIRE(shard.ValidNodeId(five));
+                REQUIRE(shard.NodeGetID("Node", "five") == five);
+                REQUIRE(shard.NodeGetID("Node", "three") == three);
+                REQUIRE(std::any_cast<std::string>(shard.NodePropertyGet(five, "name")) == "alice");
+                REQUIRE(shard.NodeTypesGetCount(1) == 4);
+            }
+        }
+
+        WHEN( "nothing was removed and the shard is compacted" ) {
+            uint64_t dropped = shard.Compact();
+
+            THEN( "nothing is dropped and every node is still there" ) {
+                REQUIRE(dropped == 0);
+                REQUIRE(shard.NodeTypesGetCount(1) == 4);
+                REQUIRE(shard.NodeGetID("Node", "four") == four);
+                REQUIRE(std::any_cast<std::string>(shard.NodePropertyGet(four, "name")) == "tyler");
+            }
+        }
+
+        WHEN( "the last relationship is removed and its type is compacted" ) {
+            shard.RelationshipRemoveGetIncoming(second);
+            shard.RelationshipRemoveIncoming(1, second, one);
+
+            THEN( "its id is dropped and handed out again next" ) {
+                REQUIRE(shard.RelationshipTypeCompact(1) == 1);
+                REQUIRE(shard.RelationshipTypesGetCount(1) == 1);
+                REQUIRE(shard.RelationshipAddEmptySameShard(1, one, two) == second);
+                REQUIRE(shard.RelationshipGet(first).getEndingNodeId() == three);
+            }
+        }
+    }
+}
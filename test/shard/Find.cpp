@@ -0,0 +1,117 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch2/catch.hpp>
+#include "../../src/graph/Shard.h"
+
+SCENARIO( "Shard can find nodes and relationships by property", "[find]" ) {
+
+    GIVEN( "A shard with a few nodes that have an age" ) {
+        ragedb::Shard shard(4);
+        shard.NodeTypeInsert("Node", 1);
+        shard.NodePropertyTypeAdd(1, "age", 2);
+        shard.NodePropertyTypeAdd(1, "name", 4);
+        uint64_t one = shard.NodeAdd(1, "one", R"({ "age":10, "name":"max" })");
+        uint64_t two = shard.NodeAdd(1, "two", R"({ "age":30, "name":"helene" })");
+        uint64_t three = shard.NodeAdd(1, "three", R"({ "age":50, "name":"max" })");
+
+        REQUIRE( one == 1024 );
+        REQUIRE( two == 67109888 );
+        REQUIRE( three == 134218752 );
+
+        WHEN( "nodes are found without an index" ) {
+            std::vector<uint64_t> older = shard.FindNodeIds("Node", "age", ragedb::Operation::GT, std::any(int64_t(20)));
+            std::vector<uint64_t> named = shard.FindNodeIds("Node", "name", ragedb::Operation::EQ, std::any(std::string("max")));
+
+            THEN( "the column is scanned" ) {
+                REQUIRE( older == std::vector<uint64_t>({ two, three }) );
+                REQUIRE( named == std::vector<uint64_t>({ one, three }) );
+            }
+        }
+
+        WHEN( "nodes are found with an index" ) {
+            REQUIRE( shard.NodePropertyIndexAdd(1, "age") );
+            REQUIRE( shard.NodePropertyIndexAdd(1, "name") );
+            std::vector<uint64_t> older = shard.FindNodeIds("Node", "age", ragedb::Operation::GT, std::any(int64_t(20)));
+            std::vector<uint64_t> named = shard.FindNodeIds("Node", "name", ragedb::Operation::EQ, std::any(std::string("max")));
+            std::vector<uint64_t> younger = shard.FindNodeIds("Node", "age", ragedb::Operation::LTE, std::any(int64_t(30)), 1, 1);
+
+            THEN( "the index returns the same nodes" ) {
+                REQUIRE( older == std::vector<uint64_t>({ two, three }) );
+                REQUIRE( named == std::vector<uint64_t>({ one, three }) );
+                REQUIRE( younger == std::vector<uint64_t>({ two }) );
+            }
+
+            AND_WHEN( "properties change and nodes are removed" ) {
+                shard.NodePropertySet(one, "age", int64_t(40));
+                shard.NodePropertyDelete(three, "name");
+                shard.NodeRemove(two);
+
+                THEN( "the index follows them" ) {
+                    REQUIRE( shard.FindNodeIds("Node", "age", ragedb::Operation::GT, std::any(int64_t(20))) == std::vector<uint64_t>({ one, three }) );
+                    REQUIRE( shard.FindNodeIds("Node", "name", ragedb::Operation::EQ, std::any(std::string("max"))) == std::vector<uint64_t>({ one }) );
+                    REQUIRE( shard.FindNodes("Node", "age", ragedb::Operation::EQ, std::any(int64_t(40)))[0].getKey() == "one" );
+                }
+            }
+        }
+
+        WHEN( "relationships with a weight are found" ) {
+            shard.RelationshipTypeInsert("LOVES", 1);
+            shard.RelationshipPropertyTypeAdd(1, "weight", 3);
+            uint64_t light = shard.RelationshipAddSameShard(1, one, two, R"({ "weight":0.5 })");
+            uint64_t heavy = shard.RelationshipAddSameShard(1, two, three, R"({ "weight":2.5 })");
+            REQUIRE( shard.RelationshipPropertyIndexAdd(1, "weight") );
+
+            THEN( "only the matching ones are returned" ) {
+                REQUIRE( shard.FindRelationshipIds("LOVES", "weight", ragedb::Operation::GTE, std::any(1.0)) == std::vector<uint64_t>({ heavy }) );
+                REQUIRE( shard.FindRelationshipIds("LOVES", "weight", ragedb::Operation::NEQ, std::any(1.0)) == std::vector<uint64_t>({ light, heavy }) );
+            }
+        }
+    }
+}
+
+SCENARIO( "Shard can filter nodes by several properties at once", "[find]" ) {
+
+    GIVEN( "A shard with nodes that have an age and an active flag" ) {
+        ragedb::Shard shard(4);
+        shard.NodeTypeInsert("Node", 1);
+        shard.NodePropertyTypeAdd(1, "age", 2);
+        shard.NodePropertyTypeAdd(1, "active", 1);
+        uint64_t one = shard.NodeAdd(1, "one", R"({ "age":20, "active":true })");
+        uint64_t two = shard.NodeAdd(1, "two", R"({ "age":40, "active":false })");
+        uint64_t three = shard.NodeAdd(1, "three", R"({ "age":50, "active":true })");
+        std::vector<ragedb::Condition> conditions = { { "age", ragedb::Operation::GT, std::any(int64_t(30)) },
+                                                      { "active", ragedb::Operation::EQ, std::any(true) } };
+
+        WHEN( "they are filtered" ) {
+            THEN( "only the nodes matching every condition are returned" ) {
+                REQUIRE( shard.FilterNodeIds("Node", conditions) == std::vector<uint64_t>({ three }) );
+                REQUIRE( shard.FilterNodes("Node", conditions)[0].getKey() == "three" );
+                REQUIRE( shard.FilterNodeIds("Node", {}) == std::vector<uint64_t>({ one, two, three }) );
+            }
+        }
+
+        WHEN( "one of the properties is indexed" ) {
+            shard.NodePropertyIndexAdd(1, "active");
+            shard.NodePropertySet(two, "active", true);
+
+            THEN( "the filter returns the same nodes" ) {
+                REQUIRE( shard.FilterNodeIds("Node", conditions) == std::vector<uint64_t>({ two, three }) );
+                REQUIRE( shard.FilterNodeIds("Node", conditions, 1, 10) == std::vector<uint64_t>({ three }) );
+            }
+        }
+    }
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch2/catch.hpp>
+#include "../../src/graph/Shard.h"
+
+SCENARIO( "Shard can take the hops of a traversal", "[hops]" ) {
+
+    GIVEN( "A shard with a chain of friends and a shortcut" ) {
+        ragedb::Shard shard(4);
+        shard.NodeTypeInsert("User", 1);
+        shard.RelationshipTypeInsert("FRIENDS", 1);
+        shard.RelationshipTypeInsert("BLOCKS", 2);
+        uint64_t a = shard.NodeAddEmpty(1, "a");
+        uint64_t b = shard.NodeAddEmpty(1, "b");
+        uint64_t c = shard.NodeAddEmpty(1, "c");
+        uint64_t d = shard.NodeAddEmpty(1, "d");
+        shard.RelationshipAddEmptySameShard(1, a, b);
+        shard.RelationshipAddEmptySameShard(1, b, c);
+        shard.RelationshipAddEmptySameShard(1, c, d);
+        shard.RelationshipAddEmptySameShard(1, a, c);
+        shard.RelationshipAddEmptySameShard(2, a, d);
+
+        ragedb::Hop friends;
+        friends.direction = OUT;
+        friends.rel_type_ids = { 1 };
+
+        WHEN( "the traversal takes two hops" ) {
+            std::map<uint16_t, std::vector<uint64_t>> first = shard.TraversalExpand(1, { a }, friends);
+            std::map<uint16_t, std::vector<uint64_t>> second = shard.TraversalExpand(1, first[0], friends);
+            std::vector<uint64_t> found = shard.TraversalFinish(1, second[0]);
+
+            THEN( "only the nodes first reached at the last hop are found" ) {
+                REQUIRE( first.size() == 1 );
+                REQUIRE( first[0] == std::vector<uint64_t>({ b, c }) );
+                REQUIRE( second[0] == std::vector<uint64_t>({ c, d }) );
+                REQUIRE( found == std::vector<uint64_t>({ d }) );
+            }
+        }
+
+        WHEN( "the traversal follows every relationship type in both directions" ) {
+            ragedb::Hop any;
+            std::map<uint16_t, std::vector<uint64_t>> first = shard.TraversalExpand(2, { d }, any);
+            std::vector<uint64_t> found = shard.TraversalFinish(2, first[0]);
+
+            THEN( "incoming relationships of every type are followed" ) {
+                REQUIRE( found == std::vector<uint64_t>({ a, c }) );
+            }
+        }
+    }
+}
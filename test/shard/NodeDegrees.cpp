@@ -240,5 +240,22 @@ SCENARIO( "Shard can handle Node Degrees", "[node]" ) {
                 REQUIRE(2 == degree);
             }
         }
+
+        WHEN( "several relationships of the same type are added and one is removed" ) {
+            shard.RelationshipAddEmptySameShard(1, four, five);
+            uint64_t removed = shard.RelationshipAddEmptySameShard(1, four, six);
+            shard.RelationshipAddEmptySameShard(1, four, three);
+            shard.RelationshipAddEmptySameShard(2, five, four);
+            shard.RelationshipRemoveGetIncoming(removed);
+            shard.RelationshipRemoveIncoming(1, removed, six);
+
+            THEN( "the shard should count relationships, not relationship types" ) {
+                REQUIRE(3 == shard.NodeGetDegree(four));
+                REQUIRE(2 == shard.NodeGetDegree(four, OUT));
+                REQUIRE(2 == shard.NodeGetDegree(four, OUT, static_cast<uint16_t>(1)));
+                REQUIRE(1 == shard.NodeGetDegree(four, BOTH, std::vector<uint16_t>{2}));
+                REQUIRE(0 == shard.NodeGetDegree(six, IN));
+            }
+        }
     }
 }
\ No newline at end of file
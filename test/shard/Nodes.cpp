@@ -50,6 +50,28 @@ SCENARIO("Shard can handle Nodes", "[node]") {
             }
         }
 
+        WHEN("a batch of nodes is added") {
+            std::vector<uint64_t> added = shard.NodesAdd(1, {"one", "existing", "two"}, {R"({ "name":"helene" })", "", ""});
+
+            THEN("the shard keeps the new ones and skips existing keys") {
+                REQUIRE(added.size() == 3);
+                REQUIRE(added[0] > 0);
+                REQUIRE(added[1] == 0);
+                REQUIRE(added[2] > 0);
+                REQUIRE(std::any_cast<std::string>(shard.NodePropertyGet(added[0], "name")) == "helene");
+                REQUIRE(shard.NodeGetIDs({"Node", "Node", "User"}, {"one", "two", "one"}) == std::vector<uint64_t>({added[0], added[2], 0}));
+            }
+        }
+
+        WHEN("a batch of nodes of an invalid type is added") {
+            std::vector<uint64_t> added = shard.NodesAdd(99, {"one", "two"}, {});
+
+            THEN("the shard ignores them") {
+                REQUIRE(added == std::vector<uint64_t>({0, 0}));
+                REQUIRE(shard.ValidNodeIds({empty, existing, 134218752}) == std::vector<bool>({true, true, false}));
+            }
+        }
+
         WHEN("an empty node is added") {
             uint64_t added = shard.NodeAddEmpty(1, "added");
 
@@ -189,5 +211,46 @@ SCENARIO("Shard can handle Nodes", "[node]") {
                 REQUIRE(degree == 0);
             }
         }
+
+        WHEN("a batch of nodes with relationships to other shards is removed") {
+            shard.RelationshipTypeInsert("KNOWS", 1);
+            shard.RelationshipAddEmptyToOutgoing(1, empty, 1025);
+            shard.RelationshipAddEmptyToOutgoing(1, empty, 1025);
+            shard.RelationshipAddEmptyToOutgoing(1, empty, 1026);
+            shard.RelationshipAddToIncoming(1, 1027, 1027, empty);
+
+            std::map<uint16_t, std::vector<ragedb::NodeRemoval>> removals = shard.NodesRemoveGetLinks({empty, 99});
+            uint64_t removed = shard.NodesRemove({empty, existing, 99});
+
+            THEN("the counterparts are grouped by shard and the valid nodes are removed") {
+                REQUIRE(removals.size() == 3);
+                REQUIRE(removals[1].size() == 1);
+                REQUIRE(removals[1][0].id == empty);
+                REQUIRE(removals[1][0].incoming[1] == std::vector<uint64_t>({1025, 1025}));
+                REQUIRE(removals[2][0].incoming[1] == std::vector<uint64_t>({1026}));
+                REQUIRE(removals[3][0].incoming.empty());
+                REQUIRE(removals[3][0].outgoing[1] == std::vector<uint64_t>({1027}));
+                REQUIRE(removed == 2);
+                REQUIRE(shard.NodeGetID("Node", "empty") == 0);
+                REQUIRE(shard.NodeGetID("Node", "existing") == 0);
+            }
+        }
+
+        WHEN("the counterparts of a node removed on another shard are deleted") {
+            shard.RelationshipTypeInsert("KNOWS", 1);
+            shard.RelationshipAddToIncoming(1, 1027, 1027, existing);
+            shard.RelationshipAddEmptyToOutgoing(1, existing, 1027);
+            REQUIRE(shard.NodeGetDegree(existing) == 2);
+
+            ragedb::NodeRemoval removal;
+            removal.id = 1027;
+            removal.incoming[1] = {existing};
+            removal.outgoing[1] = {existing};
+            shard.NodesRemoveDeleteLinks({removal});
+
+            THEN("the links to that node are gone") {
+                REQUIRE(shard.NodeGetDegree(existing) == 0);
+            }
+        }
     }
 }
\ No newline at end of file
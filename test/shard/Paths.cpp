@@ -0,0 +1,74 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <catch2/catch.hpp>
+#include "../../src/graph/Shard.h"
+
+SCENARIO( "Shard can expand nodes for a path search", "[paths]" ) {
+
+    GIVEN( "A shard with weighted roads between towns" ) {
+        ragedb::Shard shard(4);
+        shard.NodeTypeInsert("Town", 1);
+        shard.RelationshipTypeInsert("ROAD", 1);
+        shard.RelationshipTypeInsert("RAIL", 2);
+        shard.RelationshipPropertyTypeAdd(1, "distance", 3);
+        uint64_t a = shard.NodeAddEmpty(1, "a");
+        uint64_t b = shard.NodeAddEmpty(1, "b");
+        uint64_t c = shard.NodeAddEmpty(1, "c");
+        uint64_t ab = shard.RelationshipAddSameShard(1, a, b, R"({ "distance":2.5 })");
+        uint64_t bc = shard.RelationshipAddEmptySameShard(1, b, c);
+        uint64_t ac = shard.RelationshipAddEmptySameShard(2, a, c);
+
+        WHEN( "the nodes are expanded by distance along roads" ) {
+            ragedb::Hop roads;
+            roads.direction = OUT;
+            roads.rel_type_ids = { 1 };
+            std::vector<std::vector<ragedb::PathStep>> steps = shard.PathExpand({ a, b, c }, roads, "distance");
+
+            THEN( "each node gets its roads with their distance, or 1 when it has none" ) {
+                REQUIRE( steps.size() == 3 );
+                REQUIRE( steps[0].size() == 1 );
+                REQUIRE( steps[0][0].node_id == b );
+                REQUIRE( steps[0][0].rel_id == ab );
+                REQUIRE( steps[0][0].weight == 2.5 );
+                REQUIRE( steps[1].size() == 1 );
+                REQUIRE( steps[1][0].rel_id == bc );
+                REQUIRE( steps[1][0].weight == 1.0 );
+                REQUIRE( steps[2].empty() );
+            }
+        }
+
+        WHEN( "a node is expanded in both directions without a weight" ) {
+            ragedb::Hop any;
+            std::vector<std::vector<ragedb::PathStep>> steps = shard.PathExpand({ c }, any, "");
+
+            THEN( "every relationship weighs 1" ) {
+                REQUIRE( steps[0].size() == 2 );
+                REQUIRE( steps[0][0].weight == 1.0 );
+                REQUIRE( steps[0][1].weight == 1.0 );
+            }
+        }
+
+        WHEN( "the weights of relationships are read" ) {
+            std::vector<double> weights = shard.RelationshipWeights({ ab, bc, ac }, "distance");
+
+            THEN( "missing weights are 1" ) {
+                REQUIRE( weights == std::vector<double>({ 2.5, 1.0, 1.0 }) );
+            }
+        }
+    }
+}
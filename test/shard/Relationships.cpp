@@ -42,6 +42,34 @@ SCENARIO( "Shard can handle Relationships", "[relationship]" ) {
 
         shard.RelationshipTypeInsert("KNOWS", 1);
 
+        WHEN("a batch of relationships is added") {
+            uint64_t missing = 134218752;
+            std::vector<uint64_t> added = shard.RelationshipsAddToOutgoing(1, {empty, missing}, {existing, existing}, {R"({ "weight":3.0 })", ""});
+            uint64_t incoming = shard.RelationshipsAddToIncoming(1, {added[0]}, {empty}, {existing});
+
+            THEN("the shard keeps the ones starting at valid nodes") {
+                REQUIRE(added.size() == 2);
+                REQUIRE(added[0] > 0);
+                REQUIRE(added[1] == 0);
+                REQUIRE(incoming == 1);
+                REQUIRE(shard.RelationshipGetStartingNodeId(added[0]) == empty);
+                REQUIRE(shard.RelationshipGetEndingNodeId(added[0]) == existing);
+                REQUIRE(std::any_cast<double>(shard.RelationshipPropertyGet(added[0], "weight")) == 3.0);
+                REQUIRE(shard.NodeGetDegree(existing, Direction::IN) == 1);
+            }
+        }
+
+        WHEN("a batch of relationships with fewer ending nodes than starting nodes is added") {
+            std::vector<uint64_t> added = shard.RelationshipsAddToOutgoing(1, {empty, existing}, {existing}, {});
+            uint64_t incoming = shard.RelationshipsAddToIncoming(1, {1, 2}, {empty, existing}, {existing});
+
+            THEN("the shard adds none of them") {
+                REQUIRE(added.empty());
+                REQUIRE(incoming == 0);
+                REQUIRE(shard.NodeGetDegree(empty, Direction::OUT) == 0);
+            }
+        }
+
         WHEN("we print a new relationship") {
             uint64_t added = shard.RelationshipAddSameShard(1, "Node", "empty", "Node", "existing", R"({ "strength": 0.8, "color": "blue", "expired": false, "size": 9 })");
             std::stringstream out;
@@ -0,0 +1,128 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch2/catch.hpp>
+#include "../../src/graph/Shard.h"
+
+SCENARIO( "Shard can write and read snapshots", "[snapshot]" ) {
+    GIVEN("A shard with nodes, relationships and properties") {
+        ragedb::Shard shard(4);
+        shard.NodeTypeInsert("Node", 1);
+        shard.NodePropertyTypeAdd(1, "name", 4);
+        shard.NodePropertyTypeAdd(1, "age", 2);
+        shard.NodePropertyTypeAdd(1, "weight", 3);
+        shard.NodePropertyTypeAdd(1, "bald", 1);
+        shard.NodePropertyTypeAdd(1, "tags", 8);
+        shard.RelationshipTypeInsert("LOVES", 1);
+        shard.RelationshipPropertyTypeAdd(1, "since", 2);
+
+        uint64_t empty = shard.NodeAddEmpty(1, "empty");
+        uint64_t existing = shard.NodeAdd(1, "existing", R"({ "name":"max", "age":99, "weight":230.5, "bald":true, "tags":["a","b"] })");
+        uint64_t removed = shard.NodeAddEmpty(1, "removed");
+        uint64_t rel_id = shard.RelationshipAddSameShard(1, empty, existing, R"({ "since":2010 })");
+        shard.NodeRemove(removed);
+
+        ragedb::SnapshotWriter writer;
+        shard.SnapshotWrite(writer);
+
+        WHEN("the snapshot is read into an empty shard") {
+            ragedb::Shard restored(4);
+            ragedb::SnapshotReader reader(writer.data().data(), writer.data().size());
+
+            THEN("it should have the same contents") {
+                REQUIRE(restored.SnapshotRead(reader));
+                REQUIRE(restored.NodeTypesGetCount("Node") == shard.NodeTypesGetCount("Node"));
+                REQUIRE(restored.NodeGetID("Node", "existing") == existing);
+                REQUIRE(restored.NodeGetID("Node", "removed") == 0);
+                REQUIRE(restored.NodeGetKey(empty) == "empty");
+                REQUIRE(std::any_cast<std::string>(restored.NodePropertyGet(existing, "name")) == "max");
+                REQUIRE(std::any_cast<int64_t>(restored.NodePropertyGet(existing, "age")) == 99);
+                REQUIRE(std::any_cast<double>(restored.NodePropertyGet(existing, "weight")) == 230.5);
+                REQUIRE(std::any_cast<bool>(restored.NodePropertyGet(existing, "bald")));
+                REQUIRE(std::any_cast<std::vector<std::string>>(restored.NodePropertyGet(existing, "tags")) == std::vector<std::string>({"a", "b"}));
+                REQUIRE(restored.RelationshipGetStartingNodeId(rel_id) == empty);
+                REQUIRE(restored.RelationshipGetEndingNodeId(rel_id) == existing);
+                REQUIRE(std::any_cast<int64_t>(restored.RelationshipPropertyGet(rel_id, "since")) == 2010);
+                REQUIRE(restored.NodeGetDegree(empty, Direction::OUT) == 1);
+                REQUIRE(restored.NodeGetDegree(existing, Direction::IN) == 1);
+            }
+
+            THEN("it should reuse deleted ids") {
+                REQUIRE(restored.SnapshotRead(reader));
+                REQUIRE(restored.NodeAddEmpty(1, "replacement") == removed);
+            }
+        }
+
+        WHEN("the snapshot was taken with a different number of cores") {
+            ragedb::Shard restored(8);
+            ragedb::SnapshotReader reader(writer.data().data(), writer.data().size());
+
+            THEN("it should refuse it") {
+                REQUIRE_FALSE(restored.SnapshotRead(reader));
+                REQUIRE(restored.NodeTypesGetCount() == 0);
+            }
+        }
+
+        WHEN("the snapshot is truncated") {
+            ragedb::Shard restored(4);
+            ragedb::SnapshotReader reader(writer.data().data(), writer.data().size() / 2);
+
+            THEN("it should leave the shard empty") {
+                REQUIRE_FALSE(restored.SnapshotRead(reader));
+                REQUIRE(restored.NodeTypesGetCount() == 0);
+            }
+        }
+    }
+}
+
+SCENARIO( "Snapshot readers refuse corrupt bitmaps", "[snapshot]" ) {
+    GIVEN("A snapshot holding a bitmap") {
+        Roaring64Map bitmap;
+        bitmap.addRange(0, 100);
+        ragedb::SnapshotWriter writer;
+        writer.write(bitmap);
+
+        THEN("it should read back as written") {
+            ragedb::SnapshotReader reader(writer.data().data(), writer.data().size());
+            REQUIRE(reader.readBitmap().cardinality() == 100);
+            REQUIRE(reader.done());
+        }
+
+        WHEN("the bitmap claims more inner bitmaps than it holds") {
+            std::string corrupt = writer.data();
+            std::memset(corrupt.data() + sizeof(uint64_t), 0xFF, sizeof(uint64_t));
+            ragedb::SnapshotReader reader(corrupt.data(), corrupt.size());
+
+            THEN("the reader should fail instead of reading past the buffer") {
+                REQUIRE(reader.readBitmap().isEmpty());
+                REQUIRE_FALSE(reader.ok());
+            }
+        }
+
+        WHEN("the length in front of the bitmap is too short") {
+            std::string corrupt = writer.data();
+            uint64_t length = corrupt.size() - sizeof(uint64_t) - 4;
+            std::memcpy(corrupt.data(), &length, sizeof(uint64_t));
+            corrupt.resize(corrupt.size() - 4);
+            ragedb::SnapshotReader reader(corrupt.data(), corrupt.size());
+
+            THEN("the reader should fail instead of reading past the buffer") {
+                REQUIRE(reader.readBitmap().isEmpty());
+                REQUIRE_FALSE(reader.ok());
+            }
+        }
+    }
+}
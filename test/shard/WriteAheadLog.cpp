@@ -0,0 +1,101 @@
+/*
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <catch2/catch.hpp>
+#include "../../src/graph/Shard.h"
+
+static void Apply(ragedb::Shard &shard, const ragedb::SnapshotWriter &record) {
+    ragedb::SnapshotReader reader(record.data().data(), record.data().size());
+    shard.ApplyLogRecord(reader);
+}
+
+SCENARIO( "Shard can replay its write ahead log", "[wal]" ) {
+    GIVEN("An empty shard and the log records of a few mutations") {
+        ragedb::Shard shard(4);
+
+        ragedb::SnapshotWriter node_type;
+        node_type(static_cast<uint8_t>(ragedb::LogOperation::NodeTypeInsert));
+        node_type.write(std::string("Node"));
+        node_type(static_cast<uint16_t>(1));
+
+        ragedb::SnapshotWriter property_type;
+        property_type(static_cast<uint8_t>(ragedb::LogOperation::NodePropertyTypeAdd));
+        property_type(static_cast<uint16_t>(1));
+        property_type.write(std::string("name"));
+        property_type(static_cast<uint8_t>(4));
+
+        ragedb::SnapshotWriter rel_type;
+        rel_type(static_cast<uint8_t>(ragedb::LogOperation::RelationshipTypeInsert));
+        rel_type.write(std::string("LOVES"));
+        rel_type(static_cast<uint16_t>(1));
+
+        ragedb::SnapshotWriter node_one;
+        node_one(static_cast<uint8_t>(ragedb::LogOperation::NodeAdd));
+        node_one(static_cast<uint16_t>(1));
+        node_one.write(std::string("one"));
+        node_one.write(std::string(R"({ "name":"max" })"));
+
+        ragedb::SnapshotWriter node_two;
+        node_two(static_cast<uint8_t>(ragedb::LogOperation::NodeAddEmpty));
+        node_two(static_cast<uint16_t>(1));
+        node_two.write(std::string("two"));
+
+        WHEN("the records are applied in order") {
+            Apply(shard, node_type);
+            Apply(shard, property_type);
+            Apply(shard, rel_type);
+            Apply(shard, node_one);
+            Apply(shard, node_two);
+
+            uint64_t one = shard.NodeGetID("Node", "one");
+            uint64_t two = shard.NodeGetID("Node", "two");
+
+            THEN("the shard should have the nodes with the same ids and properties") {
+                REQUIRE(one == 1024);
+                REQUIRE(two == 67109888);
+                REQUIRE(std::any_cast<std::string>(shard.NodePropertyGet(one, "name")) == "max");
+            }
+
+            AND_WHEN("the relationship, property and delete records are applied") {
+                ragedb::SnapshotWriter relationship;
+                relationship(static_cast<uint8_t>(ragedb::LogOperation::RelationshipAddEmptySameShard));
+                relationship(static_cast<uint16_t>(1));
+                relationship(one);
+                relationship(two);
+                Apply(shard, relationship);
+
+                ragedb::SnapshotWriter property;
+                property(static_cast<uint8_t>(ragedb::LogOperation::NodePropertySet));
+                property(two);
+                property.write(std::string("name"));
+                property(static_cast<uint16_t>(4));
+                property.write(std::string("helene"));
+                Apply(shard, property);
+
+                ragedb::SnapshotWriter remove;
+                remove(static_cast<uint8_t>(ragedb::LogOperation::NodeRemove));
+                remove(one);
+                Apply(shard, remove);
+
+                THEN("the shard should reflect them") {
+                    REQUIRE(std::any_cast<std::string>(shard.NodePropertyGet(two, "name")) == "helene");
+                    REQUIRE(shard.NodeGetID("Node", "one") == 0);
+                    REQUIRE(shard.NodeGetDegree(two, Direction::IN) == 0);
+                }
+            }
+        }
+    }
+}